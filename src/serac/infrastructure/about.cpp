@@ -76,6 +76,12 @@ std::string about()
   about += format("CUDA:            {0}\n", off);
 #endif
 
+#ifdef SERAC_USE_OPENMP
+  about += format("OpenMP:          {0}\n", on);
+#else
+  about += format("OpenMP:          {0}\n", off);
+#endif
+
   about += "\n";
 
   //------------------------
@@ -52,6 +52,8 @@
 
 #include <memory>
 
+#include "serac/serac_config.hpp"
+
 #include "axom/core.hpp"
 
 #include "serac/infrastructure/logger.hpp"
@@ -69,7 +71,8 @@ enum class ExecutionSpace
 {
   CPU,
   GPU,
-  Dynamic  // Corresponds to execution that can "legally" happen on either the host or device
+  Dynamic,  // Corresponds to execution that can "legally" happen on either the host or device
+  OpenMP    // Corresponds to multithreaded execution on the host
 };
 
 /**
@@ -106,6 +109,12 @@ template <>
 struct execution_to_memory<ExecutionSpace::Dynamic> {
   static constexpr axom::MemorySpace value = axom::MemorySpace::Unified;
 };
+
+/// @overload
+template <>
+struct execution_to_memory<ExecutionSpace::OpenMP> {
+  static constexpr axom::MemorySpace value = axom::MemorySpace::Host;
+};
 #endif
 
 /// @brief Helper template for @p execution_to_memory trait
@@ -257,7 +266,7 @@ inline std::string getCUDAMemInfoString()
 template <ExecutionSpace exec, typename T>
 std::shared_ptr<T[]> make_shared_array(std::size_t n)
 {
-  if constexpr (exec == ExecutionSpace::CPU) {
+  if constexpr (exec == ExecutionSpace::CPU || exec == ExecutionSpace::OpenMP) {
     return std::shared_ptr<T[]>(new T[n]);
   }
 
@@ -283,6 +292,37 @@ auto make_shared_arrays(std::size_t n)
   return std::tuple{make_shared_array<exec, T>(n)...};
 }
 
+/**
+ * @brief call `f(i)` for each `i` in [0, n), using the specified execution space
+ *
+ * @tparam exec the execution space: for ExecutionSpace::OpenMP the iterations are distributed
+ * over the available threads, otherwise they are carried out serially
+ * @tparam callable the type of the loop body, with signature void(uint32_t)
+ * @param n the number of iterations
+ * @param f the loop body
+ *
+ * @note when exec == ExecutionSpace::OpenMP, different iterations may run concurrently, so the loop body must
+ * not write to any memory location that is also written by another iteration. If serac was not configured with
+ * OpenMP, the iterations are carried out serially.
+ */
+template <ExecutionSpace exec, typename callable>
+void forall(uint32_t n, const callable& f)
+{
+#ifdef SERAC_USE_OPENMP
+  if constexpr (exec == ExecutionSpace::OpenMP) {
+#pragma omp parallel for schedule(static)
+    for (uint32_t i = 0; i < n; i++) {
+      f(i);
+    }
+    return;
+  }
+#endif
+
+  for (uint32_t i = 0; i < n; i++) {
+    f(i);
+  }
+}
+
 }  // namespace accelerator
 
 }  // namespace serac
@@ -41,10 +41,11 @@ std::pair<int, int> getMPIInfo(MPI_Comm comm)
   return {num_procs, rank};
 }
 
-std::pair<int, int> initialize(int argc, char* argv[], MPI_Comm comm)
+std::pair<int, int> initialize(int argc, char* argv[], MPI_Comm comm, int mpi_thread_level)
 {
-  // Initialize MPI.
-  if (MPI_Init(&argc, &argv) != MPI_SUCCESS) {
+  // Initialize MPI. The provided thread support may be lower than requested, which output::setAsyncWrites() checks.
+  int thread_support = MPI_THREAD_SINGLE;
+  if (MPI_Init_thread(&argc, &argv, mpi_thread_level, &thread_support) != MPI_SUCCESS) {
     std::cerr << "Failed to initialize MPI" << std::endl;
     serac::exitGracefully(true);
   }
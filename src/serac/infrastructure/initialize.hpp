@@ -33,8 +33,11 @@ std::pair<int, int> getMPIInfo(MPI_Comm comm = MPI_COMM_WORLD);
  * @param argc The number of command-line arguments
  * @param argv The command-line arguments, as C-strings
  * @param comm The MPI communicator to initialize with
+ * @param mpi_thread_level The requested level of MPI thread support. Applications that enable
+ * output::setAsyncWrites() must request MPI_THREAD_MULTIPLE.
  * @return A pair containing the size and rank relative to the provided MPI communicator
  */
-std::pair<int, int> initialize(int argc, char* argv[], MPI_Comm comm = MPI_COMM_WORLD);
+std::pair<int, int> initialize(int argc, char* argv[], MPI_Comm comm = MPI_COMM_WORLD,
+                               int mpi_thread_level = MPI_THREAD_SINGLE);
 
 }  // namespace serac
@@ -6,6 +6,11 @@
 
 #include "serac/infrastructure/output.hpp"
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include "serac/infrastructure/initialize.hpp"
 #include "serac/infrastructure/logger.hpp"
 #include "serac/infrastructure/terminator.hpp"
@@ -28,6 +33,95 @@ std::string file_format_string(const FileFormat file_format)
   }
   return value;
 }
+
+/**
+ * @brief A dedicated I/O thread that runs one write task at a time
+ */
+class BackgroundWriter {
+public:
+  /// @brief Start the I/O thread
+  BackgroundWriter() : thread_([this]() { run(); }) {}
+
+  /// @brief Finish any pending write task and stop the I/O thread
+  ~BackgroundWriter()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    task_submitted_.notify_one();
+
+    // a write task that fails exits the program from the I/O thread itself, which cannot join itself
+    if (std::this_thread::get_id() == thread_.get_id()) {
+      thread_.detach();
+    } else {
+      thread_.join();
+    }
+  }
+
+  /// @brief Wait for the previous write task to finish, then hand @a task to the I/O thread
+  void submit(std::function<void()> task)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    task_finished_.wait(lock, [this]() { return !task_; });
+    task_ = std::move(task);
+    lock.unlock();
+    task_submitted_.notify_one();
+  }
+
+  /// @brief Wait for the pending write task, if any, to finish
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    task_finished_.wait(lock, [this]() { return !task_; });
+  }
+
+private:
+  /// @brief The loop of the I/O thread, which runs the submitted tasks until it is stopped
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      task_submitted_.wait(lock, [this]() { return stop_ || task_; });
+      if (!task_) {
+        return;
+      }
+
+      // the task is only reset once it has finished, which is what wait() checks for
+      lock.unlock();
+      task_();
+      lock.lock();
+
+      task_ = nullptr;
+      task_finished_.notify_all();
+    }
+  }
+
+  /// @brief The pending write task, which is empty when the I/O thread is idle
+  std::function<void()> task_;
+
+  /// @brief Whether the I/O thread should stop once the pending task has finished
+  bool stop_ = false;
+
+  /// @brief Guards task_ and stop_
+  std::mutex mutex_;
+
+  /// @brief Signals the I/O thread that a task was submitted or that it should stop
+  std::condition_variable task_submitted_;
+
+  /// @brief Signals waiting threads that the pending task has finished
+  std::condition_variable task_finished_;
+
+  /// @brief The I/O thread, which is started last so that the members above are initialized before it runs
+  std::thread thread_;
+};
+
+/// @brief The background I/O thread, which only exists while asynchronous writes are enabled
+std::unique_ptr<BackgroundWriter> background_writer;
+
+/// @brief The duplicate of MPI_COMM_WORLD used by background writes
+MPI_Comm background_write_comm = MPI_COMM_NULL;
+
 }  // namespace detail
 
 void outputSummary(const axom::sidre::DataStore& datastore, const std::string& output_directory,
@@ -45,4 +139,53 @@ void outputSummary(const axom::sidre::DataStore& datastore, const std::string& o
   datastore.getRoot()->getGroup("serac_summary")->save(path, file_format_string);
 }
 
+void setAsyncWrites(bool async_writes)
+{
+  if (async_writes == asyncWrites()) {
+    return;
+  }
+
+  if (!async_writes) {
+    // destroying the writer finishes the pending write before the communicator it uses is freed
+    detail::background_writer.reset();
+    MPI_Comm_free(&detail::background_write_comm);
+    return;
+  }
+
+  int thread_support = MPI_THREAD_SINGLE;
+  MPI_Query_thread(&thread_support);
+  if (thread_support < MPI_THREAD_MULTIPLE) {
+    SLIC_WARNING_ROOT(
+        "Asynchronous writes require MPI to be initialized with MPI_THREAD_MULTIPLE, writing synchronously instead");
+    return;
+  }
+
+  MPI_Comm_dup(MPI_COMM_WORLD, &detail::background_write_comm);
+  detail::background_writer = std::make_unique<detail::BackgroundWriter>();
+}
+
+bool asyncWrites() { return detail::background_writer != nullptr; }
+
+MPI_Comm asyncWriteComm()
+{
+  SLIC_ERROR_ROOT_IF(!asyncWrites(), "The asynchronous write communicator was requested, but writes are synchronous");
+  return detail::background_write_comm;
+}
+
+void write(std::function<void()> write_task)
+{
+  if (detail::background_writer) {
+    detail::background_writer->submit(std::move(write_task));
+  } else {
+    write_task();
+  }
+}
+
+void flush()
+{
+  if (detail::background_writer) {
+    detail::background_writer->wait();
+  }
+}
+
 }  // namespace serac::output
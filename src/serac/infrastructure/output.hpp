@@ -12,8 +12,10 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 
+#include "mpi.h"
 #include "axom/sidre.hpp"
 
 /**
@@ -42,4 +44,43 @@ enum class FileFormat
 void outputSummary(const axom::sidre::DataStore& datastore, const std::string& output_directory,
                    const FileFormat file_format = FileFormat::JSON);
 
+/**
+ * @brief Enable or disable writing output files on a dedicated background I/O thread
+ *
+ * When enabled, write() hands its task to the I/O thread and returns immediately, so that the simulation can continue
+ * while the files are written. At most one write is in flight at a time: a new write first waits for the previous one.
+ * Disabling waits for any pending write and stops the I/O thread.
+ *
+ * @param async_writes Whether to write output files in the background
+ *
+ * @pre MPI must be initialized with MPI_THREAD_MULTIPLE for the I/O thread to communicate, e.g. by passing it to
+ * serac::initialize(), otherwise a warning is issued and writes stay synchronous
+ */
+void setAsyncWrites(bool async_writes);
+
+/// @brief Whether output files are written on a background I/O thread, see setAsyncWrites()
+bool asyncWrites();
+
+/**
+ * @brief The communicator to use for any MPI communication in a background write
+ *
+ * This is a duplicate of MPI_COMM_WORLD, so that collective operations of the I/O thread cannot be matched with those
+ * of the simulation.
+ *
+ * @pre asyncWrites() must be true
+ */
+MPI_Comm asyncWriteComm();
+
+/**
+ * @brief Write output files, either immediately or on the background I/O thread
+ *
+ * @param write_task The task that writes the files
+ *
+ * @note The data read by @a write_task must not be modified until flush() is called
+ */
+void write(std::function<void()> write_task);
+
+/// @brief Wait for any pending background write to finish
+void flush();
+
 }  // namespace serac::output
@@ -6,6 +6,14 @@
 
 #include "serac/infrastructure/profiling.hpp"
 
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include "axom/fmt.hpp"
+
 #include "serac/infrastructure/logger.hpp"
 
 #ifdef SERAC_USE_CALIPER
@@ -20,8 +28,34 @@ std::optional<cali::ConfigManager> mgr;
 }  // namespace
 #endif
 
+namespace {
+/// the communicator given to initialize(), over which the counters are combined in finalize()
+MPI_Comm profiling_comm = MPI_COMM_WORLD;
+
+/// the file that finalize() writes the counters to
+std::string counters_file;
+
+/// the values of the performance counters on this rank, by name
+std::map<std::string, Counter> counters;
+
+/// guards the performance counters, which may be recorded from several threads
+std::mutex counters_mutex;
+
+/// the fields of a counter, in the order they are communicated in
+constexpr std::size_t num_fields = 6;
+
+/// the fields of a counter as doubles, so that they can be communicated in a single message
+std::array<double, num_fields> toArray(const Counter& c)
+{
+  return {double(c.calls),           c.seconds,       double(c.elements),
+          double(c.quadrature_points), double(c.bytes), double(c.iterations)};
+}
+}  // namespace
+
 void initialize([[maybe_unused]] MPI_Comm comm, [[maybe_unused]] std::string options)
 {
+  profiling_comm = comm;
+
 #ifdef SERAC_USE_ADIAK
   // Initialize Adiak
   adiak::init(&comm);
@@ -69,6 +103,120 @@ void finalize()
 
   mgr.reset();
 #endif
+
+  if (countersEnabled()) {
+    disableCounters();
+    std::string json = countersToJSON(profiling_comm);
+    if (!json.empty() && !counters_file.empty()) {
+      std::ofstream file(counters_file);
+      file << json;
+      SLIC_WARNING_IF(!file, axom::fmt::format("Could not write the performance counters to '{}'", counters_file));
+    }
+  }
+}
+
+void enableCounters(const std::string& json_file)
+{
+  counters_file            = json_file;
+  detail::counters_enabled = true;
+}
+
+void disableCounters() { detail::counters_enabled = false; }
+
+void addToCounter(const std::string& name, const Counter& increment)
+{
+  std::lock_guard<std::mutex> lock(counters_mutex);
+  counters[name] += increment;
+}
+
+Counter getCounter(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(counters_mutex);
+  auto                        it = counters.find(name);
+  return (it != counters.end()) ? it->second : Counter{};
+}
+
+std::map<std::string, Counter> getCounters()
+{
+  std::lock_guard<std::mutex> lock(counters_mutex);
+  return counters;
+}
+
+void resetCounters()
+{
+  std::lock_guard<std::mutex> lock(counters_mutex);
+  counters.clear();
+}
+
+std::string countersToJSON(MPI_Comm comm)
+{
+  int rank = 0, num_ranks = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &num_ranks);
+
+  // ranks may have recorded different counters (e.g. if they have no elements of some geometry),
+  // so the names are gathered on rank 0 along with the values
+  std::string         names;
+  std::vector<double> values;
+  for (const auto& [name, counter] : getCounters()) {
+    names += name + '\n';
+    auto fields = toArray(counter);
+    values.insert(values.end(), fields.begin(), fields.end());
+  }
+
+  int              num_chars  = int(names.size());
+  int              num_values = int(values.size());
+  std::vector<int> chars_per_rank(std::size_t(num_ranks)), values_per_rank(std::size_t(num_ranks));
+  MPI_Gather(&num_chars, 1, MPI_INT, chars_per_rank.data(), 1, MPI_INT, 0, comm);
+  MPI_Gather(&num_values, 1, MPI_INT, values_per_rank.data(), 1, MPI_INT, 0, comm);
+
+  std::vector<int> char_offsets(std::size_t(num_ranks) + 1, 0), value_offsets(std::size_t(num_ranks) + 1, 0);
+  for (std::size_t r = 0; r < std::size_t(num_ranks); r++) {
+    char_offsets[r + 1]  = char_offsets[r] + chars_per_rank[r];
+    value_offsets[r + 1] = value_offsets[r] + values_per_rank[r];
+  }
+
+  std::vector<char>   all_names(std::size_t(char_offsets.back()));
+  std::vector<double> all_values(std::size_t(value_offsets.back()));
+  MPI_Gatherv(names.data(), num_chars, MPI_CHAR, all_names.data(), chars_per_rank.data(), char_offsets.data(),
+              MPI_CHAR, 0, comm);
+  MPI_Gatherv(values.data(), num_values, MPI_DOUBLE, all_values.data(), values_per_rank.data(),
+              value_offsets.data(), MPI_DOUBLE, 0, comm);
+
+  if (rank != 0) {
+    return "";
+  }
+
+  // the work is summed over the ranks, and the time is the maximum over the ranks
+  std::map<std::string, std::array<double, num_fields>> combined;
+  std::size_t                                           begin = 0;
+  std::size_t                                           index = 0;
+  for (std::size_t end = 0; end < all_names.size(); end++) {
+    if (all_names[end] != '\n') {
+      continue;
+    }
+
+    auto& fields = combined[std::string(&all_names[begin], end - begin)];
+    for (std::size_t i = 0; i < num_fields; i++) {
+      double value = all_values[index * num_fields + i];
+      fields[i]    = (i == 1) ? std::max(fields[i], value) : fields[i] + value;
+    }
+    begin = end + 1;
+    index++;
+  }
+
+  std::string json = "{\n  \"counters\": {";
+  for (auto it = combined.begin(); it != combined.end(); ++it) {
+    const auto& v = it->second;
+    json += axom::fmt::format(
+        "{}\n    \"{}\": {{\"calls\": {}, \"seconds\": {}, \"elements\": {}, \"quadrature_points\": {}, "
+        "\"bytes\": {}, \"iterations\": {}}}",
+        (it == combined.begin()) ? "" : ",", it->first, std::int64_t(v[0]), v[1], std::int64_t(v[2]),
+        std::int64_t(v[3]), std::int64_t(v[4]), std::int64_t(v[5]));
+  }
+  json += "\n  }\n}\n";
+
+  return json;
 }
 
 }  // namespace serac::profiling
@@ -7,11 +7,14 @@
 /**
  * @file profiling.hpp
  *
- * @brief Various helper functions and macros for profiling using Caliper
+ * @brief Various helper functions and macros for profiling using Caliper, and built-in performance counters
  */
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <map>
 #include <string>
 #include <sstream>
 
@@ -109,9 +112,176 @@ void initialize([[maybe_unused]] MPI_Comm comm = MPI_COMM_WORLD, [[maybe_unused]
 
 /**
  * @brief Concludes performance monitoring and writes collected data to a file
+ *
+ * If the built-in performance counters are enabled, they are also written to their JSON file, see enableCounters()
  */
 void finalize();
 
+/**
+ * @brief The work and time accumulated by a region of code instrumented with serac's built-in performance counters
+ *
+ * Unlike the Caliper annotations, these counters are always compiled in. When they are disabled, an instrumented
+ * region costs a single check of a global flag.
+ */
+struct Counter {
+  /// @brief The number of times the region was executed
+  std::int64_t calls = 0;
+
+  /// @brief The total wall-clock time spent in the region, in seconds
+  double seconds = 0.0;
+
+  /// @brief The number of elements processed, counting each element once per vector for batched operations
+  std::int64_t elements = 0;
+
+  /// @brief The number of quadrature points processed, counting each point once per vector for batched operations
+  std::int64_t quadrature_points = 0;
+
+  /// @brief An estimate of the number of bytes read and written by the region
+  std::int64_t bytes = 0;
+
+  /// @brief The number of solver iterations performed in the region
+  std::int64_t iterations = 0;
+
+  /// @brief Accumulate the work and time of another counter into this one
+  Counter& operator+=(const Counter& other)
+  {
+    calls += other.calls;
+    seconds += other.seconds;
+    elements += other.elements;
+    quadrature_points += other.quadrature_points;
+    bytes += other.bytes;
+    iterations += other.iterations;
+    return *this;
+  }
+};
+
+namespace detail {
+/// @brief Whether the built-in performance counters are recording, see enableCounters()
+inline bool counters_enabled = false;
+}  // namespace detail
+
+/**
+ * @brief Start recording the built-in performance counters
+ *
+ * @param json_file The file that finalize() writes the counters to, or an empty string to not write them
+ */
+void enableCounters(const std::string& json_file = "serac_counters.json");
+
+/// @brief Stop recording the built-in performance counters, keeping the values recorded so far
+void disableCounters();
+
+/// @brief Whether the built-in performance counters are recording
+inline bool countersEnabled() { return detail::counters_enabled; }
+
+/**
+ * @brief Add work and time to a performance counter, creating it if necessary
+ *
+ * @param name The name of the counter, where '/' separates the levels of its hierarchy
+ * @param increment The work and time to add
+ */
+void addToCounter(const std::string& name, const Counter& increment);
+
+/**
+ * @brief Get the value of a performance counter on this rank
+ *
+ * @param name The name of the counter
+ * @return The accumulated work and time, which is zero if nothing was recorded under that name
+ */
+Counter getCounter(const std::string& name);
+
+/// @brief Get the values of all of the performance counters on this rank, by name
+std::map<std::string, Counter> getCounters();
+
+/// @brief Discard the values of all of the performance counters
+void resetCounters();
+
+/**
+ * @brief Combine the performance counters of all ranks and format them as JSON
+ *
+ * The work is summed over the ranks, while the time is the maximum over the ranks, as the slowest rank determines
+ * the time to solution.
+ *
+ * @param comm The communicator of the ranks to combine, all of which must call this function
+ * @return The JSON document on rank 0, and an empty string on the other ranks
+ */
+std::string countersToJSON(MPI_Comm comm = MPI_COMM_WORLD);
+
+/**
+ * @brief Records the wall-clock time and work of a region of code in a performance counter when it goes out of scope
+ *
+ * Since building the name of a counter allocates, instrumented code only starts the timer when the counters are
+ * enabled:
+ * @code{.cpp}
+ * profiling::ScopedCounter counter;
+ * if (profiling::countersEnabled()) {
+ *   counter.start(name, {.elements = num_elements});
+ * }
+ * @endcode
+ */
+class ScopedCounter {
+public:
+  /// @brief Create an inactive counter, which records nothing unless it is started
+  ScopedCounter() = default;
+
+  /**
+   * @brief Create a counter and start timing immediately, if the counters are enabled
+   *
+   * @param name The name of the counter to record into
+   * @param work The work done by the region, whose calls default to one
+   */
+  explicit ScopedCounter(const std::string& name, Counter work = {})
+  {
+    if (countersEnabled()) {
+      start(name, work);
+    }
+  }
+
+  /// @brief Scoped counters record into a single counter, so they cannot be copied
+  ScopedCounter(const ScopedCounter&) = delete;
+
+  /// @brief Scoped counters record into a single counter, so they cannot be copied
+  ScopedCounter& operator=(const ScopedCounter&) = delete;
+
+  /**
+   * @brief Start timing a region of code
+   *
+   * @param name The name of the counter to record into
+   * @param work The work done by the region, whose calls default to one
+   */
+  void start(const std::string& name, Counter work = {})
+  {
+    name_ = name;
+    work_ = work;
+    if (work_.calls == 0) {
+      work_.calls = 1;
+    }
+    active_ = true;
+    begin_  = std::chrono::steady_clock::now();
+  }
+
+  /// @brief Record the time and work of the region, if it was started
+  ~ScopedCounter()
+  {
+    if (active_) {
+      work_.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin_).count();
+      addToCounter(name_, work_);
+    }
+  }
+
+private:
+  /// @brief Whether the region is being timed
+  bool active_ = false;
+
+  /// @brief The name of the counter to record into
+  std::string name_;
+
+  /// @brief The work done by the region
+  Counter work_;
+
+  /// @brief When the region started
+  std::chrono::steady_clock::time_point begin_;
+};
+
 /// Produces a string by applying << to all arguments
 template <typename... T>
 std::string concat(T... args)
@@ -12,6 +12,7 @@
 
 #include "serac/infrastructure/accelerator.hpp"
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/output.hpp"
 #include "serac/infrastructure/profiling.hpp"
 
 #include "mfem.hpp"
@@ -45,6 +46,10 @@ void registerSignals()
 
 void exitGracefully(bool error)
 {
+  // Finish writing any output files in the background before MPI is finalized, also on error so that a restart file is
+  // not left half-written
+  output::setAsyncWrites(false);
+
   if (axom::slic::isInitialized()) {
     serac::logger::flush();
     serac::logger::finalize();
@@ -0,0 +1,91 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <future>
+
+#include <gtest/gtest.h>
+
+#include "serac/infrastructure/initialize.hpp"
+#include "serac/infrastructure/output.hpp"
+#include "serac/infrastructure/terminator.hpp"
+#include "serac/mesh/mesh_utils.hpp"
+#include "serac/physics/state/state_manager.hpp"
+#include "serac/serac_config.hpp"
+
+namespace serac {
+
+TEST(Output, AsyncWriteReturnsBeforeTheWriteFinishes)
+{
+  output::setAsyncWrites(true);
+  if (!output::asyncWrites()) {
+    GTEST_SKIP() << "MPI does not support MPI_THREAD_MULTIPLE";
+  }
+
+  // the write cannot finish until write() has returned, so this would deadlock if writes were synchronous
+  std::promise<void> write_submitted;
+  bool               written = false;
+  output::write([&]() {
+    write_submitted.get_future().wait();
+    written = true;
+  });
+  write_submitted.set_value();
+
+  output::flush();
+  EXPECT_TRUE(written);
+
+  output::setAsyncWrites(false);
+  EXPECT_FALSE(output::asyncWrites());
+}
+
+TEST(Output, AsyncSaveWritesTheStagedStates)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  axom::sidre::DataStore datastore;
+  StateManager::initialize(datastore, "async_output");
+
+  std::string filename = std::string(SERAC_REPO_DIR) + "/data/meshes/patch2D.mesh";
+  std::string mesh_tag{"mesh"};
+  StateManager::setMesh(mesh::refineAndDistribute(buildMeshFromFile(filename)), mesh_tag);
+
+  auto state = StateManager::newState(H1<1>{}, "temperature", mesh_tag);
+
+  output::setAsyncWrites(true);
+
+  // modifying the state after saving must not change what is written
+  state = 1.0;
+  StateManager::updateState(state);
+  StateManager::save(0.0, 1, mesh_tag);
+  state = 2.0;
+  StateManager::updateState(state);
+  StateManager::save(1.0, 2, mesh_tag);
+
+  output::setAsyncWrites(false);
+
+  StateManager::loadCheckpointedStates(1, {&state});
+  EXPECT_DOUBLE_EQ(state.Max(), 1.0);
+  EXPECT_DOUBLE_EQ(state.Min(), 1.0);
+
+  StateManager::loadCheckpointedStates(2, {&state});
+  EXPECT_DOUBLE_EQ(state.Max(), 2.0);
+  EXPECT_DOUBLE_EQ(state.Min(), 2.0);
+
+  StateManager::reset();
+}
+
+}  // namespace serac
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  // the background I/O thread needs MPI_THREAD_MULTIPLE support
+  serac::initialize(argc, argv, MPI_COMM_WORLD, MPI_THREAD_MULTIPLE);
+
+  int result = RUN_ALL_TESTS();
+
+  serac::exitGracefully(result);
+}
@@ -8,6 +8,7 @@
 #include <cstring>
 #include <exception>
 
+#include "axom/core.hpp"
 #include "axom/slic/core/SimpleLogger.hpp"
 #include <gtest/gtest.h>
 
@@ -99,6 +100,62 @@ TEST(Profiling, Exception)
   MPI_Barrier(MPI_COMM_WORLD);
 }
 
+TEST(Profiling, Counters)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  serac::profiling::initialize();
+
+  // nothing is recorded until the counters are enabled
+  { profiling::ScopedCounter counter("disabled"); }
+  EXPECT_EQ(profiling::getCounter("disabled").calls, 0);
+
+  std::string json_file = "profiling_counters.json";
+  profiling::enableCounters(json_file);
+  EXPECT_TRUE(profiling::countersEnabled());
+
+  for (int i = 0; i < 3; i++) {
+    profiling::ScopedCounter counter("test/region", {0, 0.0, 10, 40, 320, 0});
+  }
+
+  profiling::Counter iterations;
+  iterations.iterations = 7;
+  profiling::addToCounter("test/solver", iterations);
+
+  auto region = profiling::getCounter("test/region");
+  EXPECT_EQ(region.calls, 3);
+  EXPECT_EQ(region.elements, 30);
+  EXPECT_EQ(region.quadrature_points, 120);
+  EXPECT_EQ(region.bytes, 960);
+  EXPECT_GE(region.seconds, 0.0);
+  EXPECT_EQ(profiling::getCounter("test/solver").iterations, 7);
+  EXPECT_EQ(profiling::getCounters().size(), std::size_t(2));
+
+  int rank = 0, num_ranks = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  // the work is summed over all of the ranks
+  std::string json = profiling::countersToJSON();
+  if (rank == 0) {
+    EXPECT_NE(json.find("\"test/region\": {\"calls\": " + std::to_string(3 * num_ranks)), std::string::npos);
+    EXPECT_NE(json.find("\"test/solver\""), std::string::npos);
+  } else {
+    EXPECT_TRUE(json.empty());
+  }
+
+  // finalizing writes the counters to the file given to enableCounters()
+  serac::profiling::finalize();
+  EXPECT_FALSE(profiling::countersEnabled());
+  if (rank == 0) {
+    EXPECT_TRUE(axom::utilities::filesystem::pathExists(json_file));
+  }
+
+  profiling::resetCounters();
+  EXPECT_TRUE(profiling::getCounters().empty());
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
 }  // namespace serac
 
 int main(int argc, char* argv[])
@@ -18,6 +18,50 @@
 
 namespace serac {
 
+/// Forwards Mult() to an existing preconditioner, but ignores SetOperator() so that the preconditioner is not rebuilt
+class ReusedPreconditioner : public mfem::Solver {
+public:
+  /// constructor
+  ReusedPreconditioner(const mfem::Solver& preconditioner)
+      : mfem::Solver(preconditioner.Height(), preconditioner.Width()), preconditioner_(preconditioner)
+  {
+  }
+
+  /// only update the sizes, keeping the existing preconditioner
+  void SetOperator(const mfem::Operator& op) override
+  {
+    height = op.Height();
+    width  = op.Width();
+  }
+
+  /// apply the existing preconditioner
+  void Mult(const mfem::Vector& x, mfem::Vector& y) const override { preconditioner_.Mult(x, y); }
+
+private:
+  /// the preconditioner being reused
+  const mfem::Solver& preconditioner_;
+};
+
+/**
+ * @brief Run the setup of a hypre preconditioner right away, so that it is timed as preconditioner setup
+ *
+ * hypre solvers such as HypreBoomerAMG only store the matrix in SetOperator() and defer their actual setup to the
+ * first Mult(), which would otherwise be timed as part of the linear solve.
+ *
+ * @param preconditioner The preconditioner, which is only set up if it is a hypre solver
+ * @param op The operator that was just passed to the SetOperator() of the preconditioner
+ */
+void setupHyprePreconditioner(mfem::Solver* preconditioner, const mfem::Operator& op)
+{
+  if (auto* hypre_preconditioner = dynamic_cast<mfem::HypreSolver*>(preconditioner)) {
+    // the right hand side and initial guess only provide the layout of the vectors to hypre
+    mfem::Vector b(op.Height()), x(op.Width());
+    b = 0.0;
+    x = 0.0;
+    hypre_preconditioner->Setup(b, x);
+  }
+}
+
 /// Newton solver with a 2-way line-search.  Reverts to regular Newton if max_line_search_iterations is set to 0.
 class NewtonSolver : public mfem::NewtonSolver {
 protected:
@@ -25,8 +69,26 @@ protected:
   mutable mfem::Vector x0;
   /// nonlinear solver options
   NonlinearSolverOptions nonlinear_options;
+  /// the preconditioner of the linear solver, used to keep it across solves when reuse_preconditioner is set
+  mfem::Solver* preconditioner = nullptr;
+  /// whether `preconditioner` has been set up with a Jacobian at least once
+  mutable bool preconditioner_initialized = false;
+  /**
+   * @brief a copy of the Jacobian that `preconditioner` was set up with, when reuse_preconditioner is set
+   *
+   * The preconditioner keeps a pointer to the matrix it was built from, but the physics modules free their Jacobian
+   * each time it is reassembled, so the solver keeps its own copy alive until the preconditioner is rebuilt.
+   */
+  mutable std::unique_ptr<mfem::HypreParMatrix> preconditioner_matrix;
 
 public:
+  /// the number of Jacobian assemblies performed during the last call to Mult()
+  mutable int num_jacobian_assemblies = 0;
+  /// the number of preconditioner setups performed during the last call to Mult()
+  mutable int num_preconditioner_setups = 0;
+  /// the number of linear solver iterations performed during the last call to Mult()
+  mutable int num_linear_iterations = 0;
+
   /// constructor
   NewtonSolver(const NonlinearSolverOptions& nonlinear_opts) : nonlinear_options(nonlinear_opts) {}
 
@@ -42,7 +104,8 @@ public:
   double evaluateNorm(const mfem::Vector& x, mfem::Vector& rOut) const
   {
     SERAC_MARK_FUNCTION;
-    double normEval = std::numeric_limits<double>::max();
+    profiling::ScopedCounter counter("EquationSolver/residual");
+    double                   normEval = std::numeric_limits<double>::max();
     try {
       oper->Mult(x, rOut);
       normEval = Norm(rOut);
@@ -52,29 +115,98 @@ public:
     return normEval;
   }
 
+  /// @brief set the preconditioner used by the linear solver, so that it can be kept across solves
+  void setReusablePreconditioner(mfem::Solver* reusable_preconditioner) { preconditioner = reusable_preconditioner; }
+
   /// assemble the jacobian
   void assembleJacobian(const mfem::Vector& x) const
   {
     SERAC_MARK_FUNCTION;
+    profiling::ScopedCounter counter("EquationSolver/jacobian_assembly");
     grad = &oper->GetGradient(x);
     if (nonlinear_options.force_monolithic) {
       auto* grad_blocked = dynamic_cast<mfem::BlockOperator*>(grad);
       if (grad_blocked) grad = buildMonolithicMatrix(*grad_blocked).release();
     }
+    num_jacobian_assemblies++;
   }
 
   /// set the preconditioner for the linear solver
   void setPreconditioner() const
   {
     SERAC_MARK_FUNCTION;
-    prec->SetOperator(*grad);
+    auto* iterative_solver = dynamic_cast<mfem::IterativeSolver*>(prec);
+    auto* hypre_grad       = dynamic_cast<mfem::HypreParMatrix*>(grad);
+
+    // only Jacobians that can be copied (see preconditioner_matrix) are eligible for reuse
+    bool reusable = nonlinear_options.reuse_preconditioner && preconditioner && iterative_solver && hypre_grad;
+
+    if (reusable && preconditioner_initialized && iterative_solver->GetConverged()) {
+      // refresh the operator of the linear solver, without rebuilding its preconditioner
+      refreshOperator(*iterative_solver);
+    } else if (reusable) {
+      profiling::ScopedCounter counter("EquationSolver/preconditioner_setup");
+      // the previous copy is only freed after the preconditioner stops referring to it
+      auto copy = std::make_unique<mfem::HypreParMatrix>(*hypre_grad);
+      preconditioner->SetOperator(*copy);
+      setupHyprePreconditioner(preconditioner, *copy);
+      preconditioner_matrix = std::move(copy);
+      refreshOperator(*iterative_solver);
+      preconditioner_initialized = true;
+      num_preconditioner_setups++;
+    } else {
+      profiling::ScopedCounter counter("EquationSolver/preconditioner_setup");
+      prec->SetOperator(*grad);
+      // only an iterative linear solver passes its operator on to the preconditioner
+      if (iterative_solver) {
+        setupHyprePreconditioner(preconditioner, *grad);
+      }
+      preconditioner_matrix.reset();
+      preconditioner_initialized = false;
+      num_preconditioner_setups++;
+    }
+  }
+
+  /// set the operator of the linear solver to the current Jacobian, without calling SetOperator() on `preconditioner`
+  void refreshOperator(mfem::IterativeSolver& iterative_solver) const
+  {
+    ReusedPreconditioner reused(*preconditioner);
+    iterative_solver.SetPreconditioner(reused);
+    iterative_solver.SetOperator(*grad);
+    iterative_solver.SetPreconditioner(*preconditioner);
   }
 
   /// solve the linear system
   void solveLinearSystem(const mfem::Vector& r_, mfem::Vector& c_) const
   {
     SERAC_MARK_FUNCTION;
+    profiling::ScopedCounter counter("EquationSolver/linear_solve");
     prec->Mult(r_, c_);  // c = [DF(x_i)]^{-1} [F(x_i)-b]
+
+    if (auto* iterative_solver = dynamic_cast<mfem::IterativeSolver*>(prec)) {
+      num_linear_iterations += iterative_solver->GetNumIterations();
+      if (profiling::countersEnabled()) {
+        profiling::Counter iterations;
+        iterations.iterations = iterative_solver->GetNumIterations();
+        profiling::addToCounter("EquationSolver/linear_solve", iterations);
+      }
+    }
+  }
+
+  /// decide whether the Jacobian should be reassembled at Newton iteration `it`
+  bool shouldReassemble(int it, int iterations_since_assembly, double norm, double previous_norm) const
+  {
+    if (it == 0) return true;
+
+    int interval = nonlinear_options.jacobian_reassembly_interval;
+    if (interval > 0 && iterations_since_assembly >= interval) return true;
+
+    double ratio = nonlinear_options.jacobian_reassembly_ratio;
+    if (ratio > 0.0 && norm > ratio * previous_norm) return true;
+
+    // a stale Jacobian is not worth keeping if the linear solver couldn't use it
+    auto* iterative_solver = dynamic_cast<mfem::IterativeSolver*>(prec);
+    return iterative_solver && !iterative_solver->GetConverged();
   }
 
   /// @overload
@@ -95,6 +227,13 @@ public:
     norm_goal            = std::max(rel_tol * initial_norm, abs_tol);
     prec->iterative_mode = false;
 
+    num_jacobian_assemblies   = 0;
+    num_preconditioner_setups = 0;
+    num_linear_iterations     = 0;
+
+    int    iterations_since_assembly = 0;
+    real_t previous_norm             = norm;
+
     int it = 0;
     for (; true; it++) {
       MFEM_ASSERT(mfem::IsFinite(norm), "norm = " << norm);
@@ -122,8 +261,14 @@ public:
 
       real_t norm_nm1 = norm;
 
-      assembleJacobian(x);
-      setPreconditioner();
+      if (shouldReassemble(it, iterations_since_assembly, norm, previous_norm)) {
+        assembleJacobian(x);
+        setPreconditioner();
+        iterations_since_assembly = 0;
+      }
+      iterations_since_assembly++;
+      previous_norm = norm_nm1;
+
       solveLinearSystem(r, c);
 
       // there must be a better way to do this?
@@ -194,6 +339,9 @@ public:
 
     if (print_options.summary || (!converged && print_options.warnings) || print_options.first_and_last) {
       mfem::out << "Newton: Number of iterations: " << final_iter << '\n' << "   ||r|| = " << final_norm << '\n';
+      mfem::out << "   Jacobian assemblies: " << num_jacobian_assemblies
+                << ", preconditioner setups: " << num_preconditioner_setups
+                << ", linear iterations: " << num_linear_iterations << '\n';
     }
     if (!converged && (print_options.summary || print_options.warnings)) {
       mfem::out << "Newton: No convergence!\n";
@@ -442,6 +590,7 @@ public:
   void assembleJacobian(const mfem::Vector& x) const
   {
     SERAC_MARK_FUNCTION;
+    profiling::ScopedCounter counter("EquationSolver/jacobian_assembly");
     grad = &oper->GetGradient(x);
     if (nonlinear_options.force_monolithic) {
       auto* grad_blocked = dynamic_cast<mfem::BlockOperator*>(grad);
@@ -453,6 +602,7 @@ public:
   mfem::real_t computeResidual(const mfem::Vector& x_, mfem::Vector& r_) const
   {
     SERAC_MARK_FUNCTION;
+    profiling::ScopedCounter counter("EquationSolver/residual");
     oper->Mult(x_, r_);
     return Norm(r_);
   }
@@ -543,7 +693,11 @@ public:
 
       if (it == 0 || (trResults.cg_iterations_count >= settings.max_cg_iterations ||
                       cumulative_cg_iters_from_last_precond_update >= settings.max_cumulative_iteration)) {
-        tr_precond.SetOperator(*grad);
+        {
+          profiling::ScopedCounter counter("EquationSolver/preconditioner_setup");
+          tr_precond.SetOperator(*grad);
+          setupHyprePreconditioner(&tr_precond, *grad);
+        }
         cumulative_cg_iters_from_last_precond_update = 0;
         if (print_options.iterations) {
           // currently it will always be updated
@@ -582,7 +736,13 @@ public:
         trResults.interior_status     = TrustRegionResults::Status::OnBoundary;
       } else {
         settings.cg_tol = std::max(0.5 * norm_goal, 5e-5 * norm);
+        profiling::ScopedCounter counter("EquationSolver/linear_solve");
         solveTrustRegionModelProblem(r, scratch, hess_vec_func, precond_func, settings, tr_size, trResults);
+        if (profiling::countersEnabled()) {
+          profiling::Counter iterations;
+          iterations.iterations = std::int64_t(trResults.cg_iterations_count);
+          profiling::addToCounter("EquationSolver/linear_solve", iterations);
+        }
       }
       cumulative_cg_iters_from_last_precond_update += trResults.cg_iterations_count;
 
@@ -683,6 +843,7 @@ public:
 };
 
 EquationSolver::EquationSolver(NonlinearSolverOptions nonlinear_opts, LinearSolverOptions lin_opts, MPI_Comm comm)
+    : matrix_free_(lin_opts.matrix_free)
 {
   auto [lin_solver, preconditioner] = buildLinearSolverAndPreconditioner(lin_opts, comm);
 
@@ -710,6 +871,9 @@ void EquationSolver::setOperator(const mfem::Operator& op)
   // Now that the nonlinear solver knows about the operator, we can set its linear solver
   if (!nonlin_solver_set_solver_called_) {
     nonlin_solver_->SetSolver(linearSolver());
+    if (auto* newton = dynamic_cast<NewtonSolver*>(nonlin_solver_.get())) {
+      newton->setReusablePreconditioner(preconditioner_.get());
+    }
     nonlin_solver_set_solver_called_ = true;
   }
 }
@@ -718,9 +882,27 @@ void EquationSolver::solve(mfem::Vector& x) const
 {
   mfem::Vector zero(x);
   zero = 0.0;
-  // KINSOL does not handle non-zero RHS, so we enforce that the RHS
-  // of the nonlinear system is zero
-  nonlin_solver_->Mult(zero, x);
+
+  {
+    profiling::ScopedCounter counter("EquationSolver/solve");
+    // KINSOL does not handle non-zero RHS, so we enforce that the RHS
+    // of the nonlinear system is zero
+    nonlin_solver_->Mult(zero, x);
+  }
+
+  counts_.solves++;
+  counts_.nonlinear_iterations += nonlin_solver_->GetNumIterations();
+  if (auto* newton = dynamic_cast<const NewtonSolver*>(nonlin_solver_.get())) {
+    counts_.jacobian_assemblies += newton->num_jacobian_assemblies;
+    counts_.preconditioner_setups += newton->num_preconditioner_setups;
+    counts_.linear_iterations += newton->num_linear_iterations;
+  }
+
+  if (profiling::countersEnabled()) {
+    profiling::Counter nonlinear;
+    nonlinear.iterations = nonlin_solver_->GetNumIterations();
+    profiling::addToCounter("EquationSolver/solve", nonlinear);
+  }
 }
 
 void SuperLUSolver::Mult(const mfem::Vector& input, mfem::Vector& output) const
@@ -731,6 +913,42 @@ void SuperLUSolver::Mult(const mfem::Vector& input, mfem::Vector& output) const
   superlu_solver_.Mult(input, output);
 }
 
+BlockDiagonalPreconditioner::BlockDiagonalPreconditioner(std::vector<std::unique_ptr<mfem::Solver>> preconditioners)
+    : preconditioners_(std::move(preconditioners))
+{
+}
+
+void BlockDiagonalPreconditioner::Mult(const mfem::Vector& input, mfem::Vector& output) const
+{
+  SLIC_ERROR_ROOT_IF(!block_preconditioner_, "Operator must be set prior to applying a block diagonal preconditioner");
+
+  block_preconditioner_->Mult(input, output);
+}
+
+void BlockDiagonalPreconditioner::SetOperator(const mfem::Operator& op)
+{
+  auto* block_operator = dynamic_cast<const mfem::BlockOperator*>(&op);
+
+  SLIC_ERROR_ROOT_IF(!block_operator, "Block diagonal preconditioners require a BlockOperator");
+  SLIC_ERROR_ROOT_IF(block_operator->NumRowBlocks() != static_cast<int>(preconditioners_.size()),
+                     axom::fmt::format("Block diagonal preconditioner has {} blocks, but the operator has {}",
+                                       preconditioners_.size(), block_operator->NumRowBlocks()));
+
+  height = block_operator->Height();
+  width  = block_operator->Width();
+
+  offsets_              = block_operator->RowOffsets();
+  block_preconditioner_ = std::make_unique<mfem::BlockDiagonalPreconditioner>(offsets_);
+
+  for (int i = 0; i < block_operator->NumRowBlocks(); ++i) {
+    auto& preconditioner = preconditioners_[static_cast<size_t>(i)];
+    if (preconditioner) {
+      preconditioner->SetOperator(block_operator->GetBlock(i, i));
+      block_preconditioner_->SetDiagonalBlock(i, preconditioner.get());
+    }
+  }
+}
+
 std::unique_ptr<mfem::HypreParMatrix> buildMonolithicMatrix(const mfem::BlockOperator& block_operator)
 {
   int row_blocks = block_operator.NumRowBlocks();
@@ -821,6 +1039,14 @@ std::unique_ptr<mfem::NewtonSolver> buildNonlinearSolver(const NonlinearSolverOp
 {
   std::unique_ptr<mfem::NewtonSolver> nonlinear_solver;
 
+  bool reuses_jacobian = nonlinear_opts.jacobian_reassembly_interval != 1 ||
+                         nonlinear_opts.jacobian_reassembly_ratio > 0.0 || nonlinear_opts.reuse_preconditioner;
+  SLIC_ERROR_ROOT_IF(reuses_jacobian && nonlinear_opts.nonlin_solver != NonlinearSolver::Newton &&
+                         nonlinear_opts.nonlin_solver != NonlinearSolver::NewtonLineSearch,
+                     "Jacobian and preconditioner reuse are only supported by Newton and NewtonLineSearch");
+  SLIC_ERROR_ROOT_IF(nonlinear_opts.jacobian_reassembly_interval < 0,
+                     "jacobian_reassembly_interval must be nonnegative");
+
   if (nonlinear_opts.nonlin_solver == NonlinearSolver::Newton) {
     SLIC_ERROR_ROOT_IF(nonlinear_opts.min_iterations != 0 || nonlinear_opts.max_line_search_iterations != 0,
                        "Newton's method does not support nonzero min_iterations or max_line_search_iterations");
@@ -891,6 +1117,12 @@ std::unique_ptr<mfem::NewtonSolver> buildNonlinearSolver(const NonlinearSolverOp
 std::pair<std::unique_ptr<mfem::Solver>, std::unique_ptr<mfem::Solver>> buildLinearSolverAndPreconditioner(
     LinearSolverOptions linear_opts, MPI_Comm comm)
 {
+  bool is_krylov = linear_opts.linear_solver == LinearSolver::CG || linear_opts.linear_solver == LinearSolver::GMRES;
+  bool is_matrix_free_preconditioner = linear_opts.preconditioner == Preconditioner::OperatorJacobi ||
+                                       linear_opts.preconditioner == Preconditioner::None;
+  SLIC_ERROR_ROOT_IF(linear_opts.matrix_free && !(is_krylov && is_matrix_free_preconditioner),
+                     "Matrix-free Jacobians require CG or GMRES, and the OperatorJacobi or None preconditioners");
+
   auto preconditioner = buildPreconditioner(linear_opts, comm);
 
   if (linear_opts.linear_solver == LinearSolver::SuperLU) {
@@ -1030,6 +1262,9 @@ std::unique_ptr<mfem::Solver> buildPreconditioner(LinearSolverOptions linear_opt
     ilu_preconditioner->SetLevelOfFill(1);
     ilu_preconditioner->SetPrintLevel(print_level);
     preconditioner_solver = std::move(ilu_preconditioner);
+  } else if (preconditioner == Preconditioner::OperatorJacobi) {
+    // the diagonal comes from Operator::AssembleDiagonal(), so this also works for matrix-free operators
+    preconditioner_solver = std::make_unique<mfem::OperatorJacobiSmoother>();
   } else if (preconditioner == Preconditioner::AMGX) {
 #ifdef MFEM_USE_AMGX
     preconditioner_solver = buildAMGX(linear_opts.amgx_options, comm);
@@ -1072,8 +1307,11 @@ void EquationSolver::defineInputFileSchema(axom::inlet::Container& container)
   iterative_container.addInt("max_iter", "Maximum iterations for the linear solve.").defaultValue(5000);
   iterative_container.addInt("print_level", "Linear print level.").defaultValue(0);
   iterative_container.addString("solver_type", "Solver type (gmres|minres|cg).").defaultValue("gmres");
-  iterative_container.addString("prec_type", "Preconditioner type (JacobiSmoother|L1JacobiSmoother|AMG|ILU|Petsc).")
+  iterative_container
+      .addString("prec_type", "Preconditioner type (JacobiSmoother|L1JacobiSmoother|AMG|ILU|OperatorJacobi|Petsc).")
       .defaultValue("JacobiSmoother");
+  iterative_container.addBool("matrix_free", "Keep the Jacobian matrix-free instead of assembling it.")
+      .defaultValue(false);
   iterative_container.addString("petsc_prec_type", "Type of PETSc preconditioner to use.").defaultValue("jacobi");
 
   auto& direct_container = linear_container.addStruct("direct_options", "Direct solver parameters");
@@ -1086,6 +1324,13 @@ void EquationSolver::defineInputFileSchema(axom::inlet::Container& container)
   nonlinear_container.addInt("max_iter", "Maximum iterations for the Newton solve.").defaultValue(500);
   nonlinear_container.addInt("print_level", "Nonlinear print level.").defaultValue(0);
   nonlinear_container.addString("solver_type", "Solver type (Newton|KINFullStep|KINLineSearch)").defaultValue("Newton");
+  nonlinear_container.addInt("jacobian_reassembly_interval", "Newton iterations between Jacobian reassemblies.")
+      .defaultValue(1);
+  nonlinear_container
+      .addDouble("jacobian_reassembly_ratio", "Reassemble the Jacobian when ||r_k|| / ||r_{k-1}|| exceeds this value.")
+      .defaultValue(0.0);
+  nonlinear_container.addBool("reuse_preconditioner", "Keep the preconditioner across Newton iterations and solves.")
+      .defaultValue(false);
 }
 
 }  // namespace serac
@@ -1110,6 +1355,7 @@ serac::LinearSolverOptions FromInlet<serac::LinearSolverOptions>::operator()(con
   options.absolute_tol    = config["abs_tol"];
   options.max_iterations  = config["max_iter"];
   options.print_level     = config["print_level"];
+  options.matrix_free     = config["matrix_free"];
   std::string solver_type = config["solver_type"];
   if (solver_type == "gmres") {
     options.linear_solver = serac::LinearSolver::GMRES;
@@ -1128,6 +1374,8 @@ serac::LinearSolverOptions FromInlet<serac::LinearSolverOptions>::operator()(con
     options.preconditioner = serac::Preconditioner::HypreAMG;
   } else if (prec_type == "ILU") {
     options.preconditioner = serac::Preconditioner::HypreILU;
+  } else if (prec_type == "OperatorJacobi") {
+    options.preconditioner = serac::Preconditioner::OperatorJacobi;
 #ifdef MFEM_USE_AMGX
   } else if (prec_type == "AMGX") {
     options.preconditioner = serac::Preconditioner::AMGX;
@@ -1151,11 +1399,14 @@ serac::LinearSolverOptions FromInlet<serac::LinearSolverOptions>::operator()(con
 serac::NonlinearSolverOptions FromInlet<serac::NonlinearSolverOptions>::operator()(const axom::inlet::Container& base)
 {
   NonlinearSolverOptions options;
-  options.relative_tol          = base["rel_tol"];
-  options.absolute_tol          = base["abs_tol"];
-  options.max_iterations        = base["max_iter"];
-  options.print_level           = base["print_level"];
-  const std::string solver_type = base["solver_type"];
+  options.relative_tol                 = base["rel_tol"];
+  options.absolute_tol                 = base["abs_tol"];
+  options.max_iterations               = base["max_iter"];
+  options.print_level                  = base["print_level"];
+  options.jacobian_reassembly_interval = base["jacobian_reassembly_interval"];
+  options.jacobian_reassembly_ratio    = base["jacobian_reassembly_ratio"];
+  options.reuse_preconditioner         = base["reuse_preconditioner"];
+  const std::string solver_type        = base["solver_type"];
   if (solver_type == "Newton") {
     options.nonlin_solver = serac::NonlinearSolver::Newton;
   } else if (solver_type == "KINFullStep") {
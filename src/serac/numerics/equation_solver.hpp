@@ -15,6 +15,7 @@
 #include <memory>
 #include <optional>
 #include <variant>
+#include <vector>
 
 #include "mfem.hpp"
 
@@ -24,6 +25,24 @@
 
 namespace serac {
 
+/// @brief cumulative counts of the work done by an EquationSolver, used to tune time-to-solution
+struct EquationSolverCounts {
+  /// the number of calls to EquationSolver::solve()
+  int solves = 0;
+
+  /// the total number of nonlinear iterations
+  int nonlinear_iterations = 0;
+
+  /// the total number of linear solver iterations (only reported by Newton and NewtonLineSearch)
+  int linear_iterations = 0;
+
+  /// the total number of Jacobian assemblies (only reported by Newton and NewtonLineSearch)
+  int jacobian_assemblies = 0;
+
+  /// the total number of preconditioner setups (only reported by Newton and NewtonLineSearch)
+  int preconditioner_setups = 0;
+};
+
 /**
  * @brief This class manages the objects typically required to solve a nonlinear set of equations arising from
  * discretization of a PDE of the form F(x) = 0. Specifically, it has
@@ -115,6 +134,17 @@ public:
    */
   const mfem::Solver& preconditioner() const { return *preconditioner_; }
 
+  /**
+   * @brief Whether the physics modules should provide a matrix-free Jacobian operator
+   * @see LinearSolverOptions::matrix_free
+   */
+  bool matrixFree() const { return matrix_free_; }
+
+  /**
+   * @brief Returns the iteration and assembly counts accumulated over all calls to solve()
+   */
+  const EquationSolverCounts& counts() const { return counts_; }
+
   /**
    * Input file parameters specific to this class
    **/
@@ -142,6 +172,16 @@ private:
    * before SetSolver
    */
   bool nonlin_solver_set_solver_called_ = false;
+
+  /**
+   * @brief Whether the physics modules should provide a matrix-free Jacobian operator
+   */
+  bool matrix_free_ = false;
+
+  /**
+   * @brief The iteration and assembly counts accumulated over all calls to solve()
+   */
+  mutable EquationSolverCounts counts_;
 };
 
 /**
@@ -250,6 +290,46 @@ private:
 
 #endif
 
+/**
+ * @brief A block Jacobi preconditioner for a block system, which applies a separate preconditioner to each of its
+ * diagonal blocks and ignores the off-diagonal blocks
+ */
+class BlockDiagonalPreconditioner : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs a block diagonal preconditioner
+   * @param[in] preconditioners The preconditioners of the diagonal blocks, in block order, where a null preconditioner
+   * applies the identity to its block
+   */
+  BlockDiagonalPreconditioner(std::vector<std::unique_ptr<mfem::Solver>> preconditioners);
+
+  /**
+   * @brief Apply the preconditioner of each diagonal block to the corresponding block of @a input
+   *
+   * @param input The input vector
+   * @param output The preconditioned vector
+   */
+  void Mult(const mfem::Vector& input, mfem::Vector& output) const;
+
+  /**
+   * @brief Set up the preconditioner of each diagonal block of the operator
+   *
+   * @param op The block system to precondition
+   * @pre This operator must be a BlockOperator with one block row for each preconditioner
+   */
+  void SetOperator(const mfem::Operator& op);
+
+private:
+  /// @brief The preconditioners of the diagonal blocks
+  std::vector<std::unique_ptr<mfem::Solver>> preconditioners_;
+
+  /// @brief The offsets of the blocks of the last operator
+  mfem::Array<int> offsets_;
+
+  /// @brief The MFEM block preconditioner, which refers to (but does not own) the preconditioners of the blocks
+  std::unique_ptr<mfem::BlockDiagonalPreconditioner> block_preconditioner_;
+};
+
 /**
  * @brief Function for building a monolithic parallel Hypre matrix from a block system of smaller Hypre matrices
  *
@@ -109,6 +109,14 @@ auto get_derivative_type(lambda qf)
                zero{}};
 };
 
+template <int i, int j, int dim, typename... trials, typename lambda>
+auto get_combined_derivative_type(lambda qf)
+{
+  using qf_arguments = serac::tuple<typename QFunctionArgument<trials, serac::Dimension<dim>>::type...>;
+  return tuple{get_gradient(apply_qf(qf, double{}, tensor<double, dim + 1>{}, make_dual_wrt<i, j>(qf_arguments{}))),
+               zero{}};
+};
+
 template <typename lambda, int n, typename... T>
 SERAC_HOST_DEVICE auto batch_apply_qf(lambda qf, double t, const tensor<double, 2, n>& positions,
                                       const tensor<double, 1, 2, n>& jacobians, const T&... inputs)
@@ -156,12 +164,14 @@ SERAC_HOST_DEVICE auto batch_apply_qf(lambda qf, double t, const tensor<double,
 }
 
 /// @trial_elements the element type for each trial space
-template <uint32_t differentiation_index, int Q, mfem::Geometry::Type geom, typename test_element,
-          typename trial_element_type, typename lambda_type, typename derivative_type, int... indices>
+template <uint32_t differentiation_index, uint32_t second_differentiation_index, int Q, mfem::Geometry::Type geom,
+          ExecutionSpace exec, typename test_element, typename trial_element_type, typename lambda_type,
+          typename derivative_type, int... indices>
 void evaluation_kernel_impl(trial_element_type trial_elements, test_element, double t,
                             const std::vector<const double*>& inputs, double* outputs, const double* positions,
                             const double* jacobians, lambda_type qf, [[maybe_unused]] derivative_type* qf_derivatives,
-                            const int* elements, uint32_t num_elements, camp::int_seq<int, indices...>)
+                            const int* elements, uint32_t num_elements, [[maybe_unused]] std::array<double, 2> weights,
+                            camp::int_seq<int, indices...>)
 {
   // mfem provides this information as opaque arrays of doubles,
   // so we reinterpret the pointer with
@@ -178,14 +188,19 @@ void evaluation_kernel_impl(trial_element_type trial_elements, test_element, dou
       reinterpret_cast<const typename decltype(type<indices>(trial_elements))::dof_type*>(inputs[indices])...};
 
   // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; e++) {
+  //
+  // note: each element only writes to its own entries of `outputs` and `qf_derivatives`,
+  // so the elements can be processed concurrently
+  accelerator::forall<exec>(num_elements, [&](uint32_t e) {
     // load the jacobians and positions for each quadrature point in this element
     auto J_e = J[e];
     auto x_e = x[e];
 
     // batch-calculate values / derivatives of each trial space, at each quadrature point
-    [[maybe_unused]] tuple qf_inputs = {promote_each_to_dual_when<indices == differentiation_index>(
-        get<indices>(trial_elements).interpolate(get<indices>(u)[elements[e]], rule))...};
+    [[maybe_unused]] tuple qf_inputs = {
+        promote_each_to_dual_when<indices == differentiation_index || indices == second_differentiation_index>(
+            get<indices>(trial_elements).interpolate(get<indices>(u)[elements[e]], rule),
+            weights[indices == second_differentiation_index])...};
 
     // (batch) evalute the q-function at each quadrature point
     auto qf_outputs = batch_apply_qf(qf, t, x_e, J_e, get<indices>(qf_inputs)...);
@@ -201,7 +216,7 @@ void evaluation_kernel_impl(trial_element_type trial_elements, test_element, dou
 
     // (batch) integrate the material response against the test-space basis functions
     test_element::integrate(get_value(qf_outputs), rule, &r[elements[e]]);
-  }
+  });
 }
 
 //clang-format off
@@ -236,6 +251,7 @@ SERAC_HOST_DEVICE auto batch_apply_chain_rule(derivative_type* qf_derivatives, c
  * and are erased through the @p std::function members of @p BoundaryIntegral
  * @tparam g The shape of the element (only quadrilateral and hexahedron are supported at present)
  * @tparam Q parameter describing number of quadrature points (see num_quadrature_points() function for more details)
+ * @tparam exec the execution space used for the loop over elements
  * @tparam derivatives_type Type representing the derivative of the q-function w.r.t. its input arguments
  *
  * @note lambda does not appear as a template argument, as the directional derivative is
@@ -248,32 +264,42 @@ SERAC_HOST_DEVICE auto batch_apply_chain_rule(derivative_type* qf_derivatives, c
  * @param[in] J_ The Jacobians of the element transformations at all quadrature points
  * @see mfem::GeometricFactors
  * @param[in] num_elements The number of elements in the mesh
+ * @param[in] num_vectors The number of directions to differentiate in, whose element values are stored one after
+ * another in @p dU (and @p dR)
+ * @param[in] du_stride The distance between the values of consecutive directions in @p dU
+ * @param[in] dr_stride The distance between the values of consecutive directions in @p dR
  */
-template <int Q, mfem::Geometry::Type geom, typename test, typename trial, typename derivatives_type>
+template <int Q, mfem::Geometry::Type geom, typename test, typename trial, ExecutionSpace exec,
+          typename derivatives_type>
 void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* qf_derivatives, const int* elements,
-                               std::size_t num_elements)
+                               std::size_t num_elements, uint32_t num_vectors = 1, std::size_t du_stride = 0,
+                               std::size_t dr_stride = 0)
 {
   using test_element  = finite_element<geom, test>;
   using trial_element = finite_element<geom, trial>;
 
-  // mfem provides this information in 1D arrays, so we reshape it
-  // into strided multidimensional arrays before using
   constexpr int                                   nqp = num_quadrature_points(geom, Q);
-  auto                                            du  = reinterpret_cast<const typename trial_element::dof_type*>(dU);
-  auto                                            dr  = reinterpret_cast<typename test_element::dof_type*>(dR);
   static constexpr TensorProductQuadratureRule<Q> rule{};
 
   // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; e++) {
-    // (batch) interpolate each quadrature point's value
-    auto qf_inputs = trial_element::interpolate(du[elements[e]], rule);
-
-    // (batch) evalute the q-function at each quadrature point
-    auto qf_outputs = batch_apply_chain_rule(qf_derivatives + e * nqp, qf_inputs);
-
-    // (batch) integrate the material response against the test-space basis functions
-    test_element::integrate(qf_outputs, rule, &dr[elements[e]]);
-  }
+  accelerator::forall<exec>(uint32_t(num_elements), [&](uint32_t e) {
+    // every direction is applied while this element's q-function derivatives are still in cache
+    for (uint32_t k = 0; k < num_vectors; k++) {
+      // mfem provides this information in 1D arrays, so we reshape it
+      // into strided multidimensional arrays before using
+      auto du = reinterpret_cast<const typename trial_element::dof_type*>(dU + k * du_stride);
+      auto dr = reinterpret_cast<typename test_element::dof_type*>(dR + k * dr_stride);
+
+      // (batch) interpolate each quadrature point's value
+      auto qf_inputs = trial_element::interpolate(du[elements[e]], rule);
+
+      // (batch) evalute the q-function at each quadrature point
+      auto qf_outputs = batch_apply_chain_rule(qf_derivatives + e * nqp, qf_inputs);
+
+      // (batch) integrate the material response against the test-space basis functions
+      test_element::integrate(qf_outputs, rule, &dr[elements[e]]);
+    }
+  });
 }
 
 /**
@@ -288,6 +314,7 @@ void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* q
  * and are erased through the @p std::function members of @p Integral
  * @tparam g The shape of the element (only quadrilateral and hexahedron are supported at present)
  * @tparam Q parameter describing number of quadrature points (see num_quadrature_points() function for more details)
+ * @tparam exec the execution space used for the loop over elements
  * @tparam derivatives_type Type representing the derivative of the q-function w.r.t. its input arguments
  *
  *
@@ -297,7 +324,7 @@ void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* q
  * @see mfem::GeometricFactors
  * @param[in] num_elements The number of elements in the mesh
  */
-template <mfem::Geometry::Type g, typename test, typename trial, int Q, typename derivatives_type>
+template <mfem::Geometry::Type g, typename test, typename trial, int Q, ExecutionSpace exec, typename derivatives_type>
 void element_gradient_kernel(ExecArrayView<double, 3, ExecutionSpace::CPU> dK, derivatives_type* qf_derivatives,
                              const int* elements, std::size_t num_elements)
 {
@@ -308,54 +335,151 @@ void element_gradient_kernel(ExecArrayView<double, 3, ExecutionSpace::CPU> dK, d
 
   static constexpr TensorProductQuadratureRule<Q> rule{};
 
+  // H1 elements on quadrilaterals compute the whole element matrix at once with sum-factorization,
+  // rather than forming one column at a time
+  constexpr bool sum_factorization =
+      test::family == Family::H1 && trial::family == Family::H1 && g == mfem::Geometry::SQUARE;
+
   // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; e++) {
+  accelerator::forall<exec>(uint32_t(num_elements), [&](uint32_t e) {
     auto* output_ptr = reinterpret_cast<typename test_element::dof_type*>(&dK(elements[e], 0, 0));
 
-    tensor<derivatives_type, nquad> derivatives{};
-    for (int q = 0; q < nquad; q++) {
-      derivatives(q) = qf_derivatives[e * nquad + uint32_t(q)];
+    if constexpr (sum_factorization) {
+      test_element::template element_gradient<trial_element>(qf_derivatives + e * nquad, rule, output_ptr);
+    } else {
+      tensor<derivatives_type, nquad> derivatives{};
+      for (int q = 0; q < nquad; q++) {
+        derivatives(q) = qf_derivatives[e * nquad + uint32_t(q)];
+      }
+
+      for (int J = 0; J < trial_element::ndof; J++) {
+        auto source_and_flux = trial_element::batch_apply_shape_fn(J, derivatives, rule);
+        test_element::integrate(source_and_flux, rule, output_ptr + J, trial_element::ndof);
+      }
     }
+  });
+}
 
-    for (int J = 0; J < trial_element::ndof; J++) {
-      auto source_and_flux = trial_element::batch_apply_shape_fn(J, derivatives, rule);
-      test_element::integrate(source_and_flux, rule, output_ptr + J, trial_element::ndof);
+/**
+ * @brief The base kernel template used to compute only the diagonal entries of the element gradients,
+ * without forming the element gradients themselves
+ *
+ * @tparam g The shape of the element
+ * @tparam test The type of the test function space
+ * @tparam trial The type of the trial function space (must be the same as the test space)
+ * @tparam Q parameter describing number of quadrature points (see num_quadrature_points() function for more details)
+ * @tparam exec the execution space used for the loop over elements
+ * @tparam derivatives_type Type representing the derivative of the q-function w.r.t. its input arguments
+ *
+ * @param[inout] dD The per-element diagonal entries, with the same layout as an E-vector of the test space
+ * @param[in] qf_derivatives pointer to data describing the derivatives of the q-function with respect to its arguments
+ * @param[in] elements the indices of the elements in the domain
+ * @param[in] num_elements The number of elements in the domain
+ *
+ * @note quadrilateral H1 elements use sum-factorization, other elements compute
+ * each column of the element gradient in turn and keep only its diagonal entry
+ */
+template <mfem::Geometry::Type g, typename test, typename trial, int Q, ExecutionSpace exec, typename derivatives_type>
+void element_diagonal_kernel(double* dD, derivatives_type* qf_derivatives, const int* elements,
+                             std::size_t num_elements)
+{
+  static_assert(std::is_same_v<test, trial>, "element diagonals require identical test and trial spaces");
+
+  using element = finite_element<g, test>;
+
+  constexpr int nquad = num_quadrature_points(g, Q);
+
+  auto                                            dd = reinterpret_cast<typename element::dof_type*>(dD);
+  static constexpr TensorProductQuadratureRule<Q> rule{};
+
+  // for each element in the domain
+  accelerator::forall<exec>(uint32_t(num_elements), [&](uint32_t e) {
+    if constexpr (element::family == Family::H1 && g == mfem::Geometry::SQUARE) {
+      element::diagonal(qf_derivatives + e * nquad, rule, &dd[elements[e]]);
+    } else {
+      tensor<derivatives_type, nquad> derivatives{};
+      for (int q = 0; q < nquad; q++) {
+        derivatives(q) = qf_derivatives[e * nquad + uint32_t(q)];
+      }
+
+      auto* output_ptr = reinterpret_cast<double*>(&dd[elements[e]]);
+      for (int J = 0; J < element::ndof; J++) {
+        // column J of the element gradient, one block for each component of the trial space
+        tensor<typename element::dof_type, element::components> columns{};
+        auto source_and_flux = element::batch_apply_shape_fn(J, derivatives, rule);
+        element::integrate(source_and_flux, rule, &columns[0]);
+        for (int i = 0; i < element::components; i++) {
+          output_ptr[i * element::ndof + J] += reinterpret_cast<const double*>(&columns[i])[i * element::ndof + J];
+        }
+      }
     }
-  }
+  });
 }
 
-template <uint32_t wrt, int Q, mfem::Geometry::Type geom, typename signature, typename lambda_type,
-          typename derivative_type>
+template <uint32_t wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature,
+          typename lambda_type, typename derivative_type>
 auto evaluation_kernel(signature s, lambda_type qf, const double* positions, const double* jacobians,
                        std::shared_ptr<derivative_type> qf_derivatives, const int* elements, uint32_t num_elements)
 {
   auto trial_elements = trial_elements_tuple<geom>(s);
   auto test_element   = get_test_element<geom>(s);
   return [=](double time, const std::vector<const double*>& inputs, double* outputs, bool /* update state */) {
-    evaluation_kernel_impl<wrt, Q, geom>(trial_elements, test_element, time, inputs, outputs, positions, jacobians, qf,
-                                         qf_derivatives.get(), elements, num_elements, s.index_seq);
+    evaluation_kernel_impl<wrt, NO_DIFFERENTIATION, Q, geom, exec>(trial_elements, test_element, time, inputs,
+                                                                   outputs, positions, jacobians, qf,
+                                                                   qf_derivatives.get(), elements, num_elements,
+                                                                   {1.0, 1.0}, s.index_seq);
   };
 }
 
-template <int wrt, int Q, mfem::Geometry::Type geom, typename signature, typename derivative_type>
-std::function<void(const double*, double*)> jacobian_vector_product_kernel(
+template <uint32_t i, uint32_t j, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature,
+          typename lambda_type, typename derivative_type>
+auto combined_evaluation_kernel(signature s, lambda_type qf, const double* positions, const double* jacobians,
+                                std::shared_ptr<derivative_type> qf_derivatives, const int* elements,
+                                uint32_t num_elements)
+{
+  auto trial_elements = trial_elements_tuple<geom>(s);
+  auto test_element   = get_test_element<geom>(s);
+  return [=](double time, const std::vector<const double*>& inputs, double* outputs, bool /* update state */,
+             std::array<double, 2> weights) {
+    evaluation_kernel_impl<i, j, Q, geom, exec>(trial_elements, test_element, time, inputs, outputs, positions,
+                                                jacobians, qf, qf_derivatives.get(), elements, num_elements, weights,
+                                                s.index_seq);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename derivative_type>
+std::function<void(const double*, double*, uint32_t, std::size_t, std::size_t)> jacobian_vector_product_kernel(
     signature, std::shared_ptr<derivative_type> qf_derivatives, const int* elements, uint32_t num_elements)
 {
-  return [=](const double* du, double* dr) {
+  return [=](const double* du, double* dr, uint32_t num_vectors, std::size_t du_stride, std::size_t dr_stride) {
     using test_space  = typename signature::return_type;
     using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
-    action_of_gradient_kernel<Q, geom, test_space, trial_space>(du, dr, qf_derivatives.get(), elements, num_elements);
+    action_of_gradient_kernel<Q, geom, test_space, trial_space, exec>(du, dr, qf_derivatives.get(), elements,
+                                                                      num_elements, num_vectors, du_stride, dr_stride);
   };
 }
 
-template <int wrt, int Q, mfem::Geometry::Type geom, typename signature, typename derivative_type>
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename derivative_type>
 std::function<void(ExecArrayView<double, 3, ExecutionSpace::CPU>)> element_gradient_kernel(
     signature, std::shared_ptr<derivative_type> qf_derivatives, const int* elements, uint32_t num_elements)
 {
   return [=](ExecArrayView<double, 3, ExecutionSpace::CPU> K_elem) {
     using test_space  = typename signature::return_type;
     using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
-    element_gradient_kernel<geom, test_space, trial_space, Q>(K_elem, qf_derivatives.get(), elements, num_elements);
+    element_gradient_kernel<geom, test_space, trial_space, Q, exec>(K_elem, qf_derivatives.get(), elements,
+                                                                    num_elements);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename derivative_type>
+std::function<void(double*)> element_diagonal_kernel(signature, std::shared_ptr<derivative_type> qf_derivatives,
+                                                     const int* elements, uint32_t num_elements)
+{
+  return [=](double* D_elem) {
+    using test_space  = typename signature::return_type;
+    using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
+    element_diagonal_kernel<geom, test_space, trial_space, Q, exec>(D_elem, qf_derivatives.get(), elements,
+                                                                    num_elements);
   };
 }
 
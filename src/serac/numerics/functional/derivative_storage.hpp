@@ -0,0 +1,267 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file derivative_storage.hpp
+ *
+ * @brief Policies for how the derivatives of a q-function are kept between evaluating an integral and applying its
+ * gradient
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <utility>
+
+#include "serac/infrastructure/accelerator.hpp"
+#include "serac/numerics/functional/tensor.hpp"
+#include "serac/numerics/functional/tuple.hpp"
+
+namespace serac {
+
+/**
+ * @brief How the derivatives of a q-function w.r.t. its arguments are kept, between evaluating an integral with
+ * `differentiate_wrt()` and applying (or assembling) the resulting gradient
+ *
+ * For 3D solids, the derivative of the stress w.r.t. the displacement gradient is a `tensor<double, 3, 3, 3, 3>`, so
+ * storing it at every quadrature point can take more memory than the rest of the simulation. The policies other than
+ * `All` trade some of that memory for extra work.
+ */
+enum class DerivativeStorage
+{
+  All,             ///< allocate storage for the derivatives w.r.t. every argument when the integral is added
+  Differentiated,  ///< allocate storage for the derivatives w.r.t. an argument when it is first differentiated
+  Symmetric,       ///< like Differentiated, but only store the upper triangle of 4th order tangents (see below)
+  Recompute        ///< store no derivatives, and recompute them each time the gradient is applied
+};
+
+/**
+ * @brief A q-function whose integrals keep their derivatives according to a DerivativeStorage policy, see
+ * with_derivative_storage()
+ *
+ * @tparam policy how the derivatives of the q-function are kept
+ * @tparam lambda the type of the q-function
+ */
+template <DerivativeStorage policy, typename lambda>
+struct WithDerivativeStorage {
+  lambda qf;  ///< the q-function
+};
+
+/**
+ * @brief Choose how the integral of a q-function keeps the derivatives of the q-function
+ *
+ * - `DerivativeStorage::All` is the default for q-functions that aren't wrapped by this function.
+ *
+ * - `DerivativeStorage::Differentiated` only allocates storage for the derivatives w.r.t. an argument the first time
+ *   that argument is differentiated, which avoids storing the derivatives w.r.t. parameters that are never (or only
+ *   occasionally) differentiated.
+ *
+ * - `DerivativeStorage::Symmetric` is like `Differentiated`, except that any `tensor<double, m, n, m, n>` in the
+ *   derivatives (e.g. the elasticity tangent, the derivative of the stress w.r.t. the displacement gradient) is assumed
+ *   to have major symmetry, \f$A_{ijkl} = A_{klij}\f$, and only its upper triangle is stored (45 of 81 entries in 3D).
+ *   This holds for the derivatives of the first Piola stress of hyperelastic materials, but not for those of viscous
+ *   or path-dependent models, in general. The minor symmetries of the small-strain tangent do not hold for the first
+ *   Piola stress, nor after the derivatives are transformed to the parent element, so they are not used.
+ *
+ * - `DerivativeStorage::Recompute` stores no derivatives, only the element values of the arguments at the point of
+ *   linearization, and evaluates the q-function again (with dual numbers) each time the gradient is applied,
+ *   assembled, or its diagonal is computed. It is only supported by domain integrals of q-functions without internal
+ *   variables, and the gradient remains valid only while the mesh nodes are not moved.
+ *
+ * Boundary integrals have no 4th order tangents, and store their (much smaller) derivatives with the
+ * `Differentiated` policy when any policy other than `All` is requested.
+ *
+ * \code{.cpp}
+ * residual.AddDomainIntegral(Dimension<3>{}, DependsOn<0, 1>{},
+ *                            with_derivative_storage<DerivativeStorage::Symmetric>(MyQFunction{}), domain);
+ * \endcode
+ *
+ * @note to also evaluate the q-function with simd numbers, apply this function to the result of vectorize()
+ *
+ * @tparam policy how the derivatives of the q-function are kept
+ * @param qf the q-function
+ */
+template <DerivativeStorage policy, typename lambda>
+auto with_derivative_storage(lambda qf)
+{
+  return WithDerivativeStorage<policy, lambda>{qf};
+}
+
+/** @brief class for getting the DerivativeStorage policy of a q-function type */
+template <typename T>
+struct derivative_storage_policy {
+  static constexpr DerivativeStorage value = DerivativeStorage::All;  ///< the policy of q-functions of type T
+};
+
+/** @brief class for getting the DerivativeStorage policy of a q-function type */
+template <DerivativeStorage policy, typename lambda>
+struct derivative_storage_policy<WithDerivativeStorage<policy, lambda> > {
+  static constexpr DerivativeStorage value = policy;  ///< the policy of q-functions of type T
+};
+
+/// @brief the q-function itself, for q-functions that weren't wrapped by with_derivative_storage()
+template <typename lambda>
+const lambda& unwrap_derivative_storage(const lambda& qf)
+{
+  return qf;
+}
+
+/// @overload
+template <DerivativeStorage policy, typename lambda>
+const lambda& unwrap_derivative_storage(const WithDerivativeStorage<policy, lambda>& qf)
+{
+  return qf.qf;
+}
+
+/**
+ * @brief Conversion between a derivative type and its compressed representation under the assumption of major
+ * symmetry, which only differs from the derivative type for `tensor<double, m, n, m, n>` (or tuples containing them)
+ *
+ * @tparam T the derivative type
+ */
+template <typename T>
+struct major_symmetry {
+  using type = T;  ///< the compressed representation
+
+  /// @brief compress a derivative
+  SERAC_HOST_DEVICE static type compress(const T& A) { return A; }
+
+  /// @brief recover a derivative from its compressed representation
+  SERAC_HOST_DEVICE static T decompress(const type& a) { return a; }
+};
+
+/// @overload
+template <int m, int n>
+struct major_symmetry<tensor<double, m, n, m, n> > {
+  static constexpr int N = m * n;                            ///< the size of the equivalent square matrix
+  using type             = tensor<double, N * (N + 1) / 2>;  ///< the compressed representation
+
+  /// @brief compress a derivative by keeping the upper triangle of the equivalent N x N matrix, row by row
+  SERAC_HOST_DEVICE static type compress(const tensor<double, m, n, m, n>& A)
+  {
+    type a{};
+    int  k = 0;
+    for (int I = 0; I < N; I++) {
+      for (int J = I; J < N; J++) {
+        a[k++] = A[I / n][I % n][J / n][J % n];
+      }
+    }
+    return a;
+  }
+
+  /// @brief recover a derivative from its compressed representation
+  SERAC_HOST_DEVICE static tensor<double, m, n, m, n> decompress(const type& a)
+  {
+    tensor<double, m, n, m, n> A{};
+    int                        k = 0;
+    for (int I = 0; I < N; I++) {
+      for (int J = I; J < N; J++) {
+        A[I / n][I % n][J / n][J % n] = a[k];
+        A[J / n][J % n][I / n][I % n] = a[k];
+        k++;
+      }
+    }
+    return A;
+  }
+};
+
+/// @overload
+template <typename... T>
+struct major_symmetry<tuple<T...> > {
+  using type = tuple<typename major_symmetry<T>::type...>;  ///< the compressed representation
+
+  /// @brief compress each of the derivatives in a tuple
+  SERAC_HOST_DEVICE static type compress(const tuple<T...>& A)
+  {
+    return compress(A, std::make_integer_sequence<int, sizeof...(T)>{});
+  }
+
+  /// @brief recover each of the derivatives in a tuple from their compressed representations
+  SERAC_HOST_DEVICE static tuple<T...> decompress(const type& a)
+  {
+    return decompress(a, std::make_integer_sequence<int, sizeof...(T)>{});
+  }
+
+  /// @overload
+  template <int... i>
+  SERAC_HOST_DEVICE static type compress(const tuple<T...>& A, std::integer_sequence<int, i...>)
+  {
+    return type{major_symmetry<T>::compress(get<i>(A))...};
+  }
+
+  /// @overload
+  template <int... i>
+  SERAC_HOST_DEVICE static tuple<T...> decompress(const type& a, std::integer_sequence<int, i...>)
+  {
+    return tuple<T...>{major_symmetry<T>::decompress(get<i>(a))...};
+  }
+};
+
+/**
+ * @brief The q-function derivatives stored at one quadrature point by DerivativeStorage::Symmetric
+ *
+ * @tparam T the derivative type
+ */
+template <typename T>
+struct SymmetricDerivative {
+  /// @brief compress and store a derivative
+  SERAC_HOST_DEVICE SymmetricDerivative& operator=(const T& A)
+  {
+    data = major_symmetry<T>::compress(A);
+    return *this;
+  }
+
+  /// @brief recover the stored derivative
+  SERAC_HOST_DEVICE T get() const { return major_symmetry<T>::decompress(data); }
+
+  typename major_symmetry<T>::type data;  ///< the compressed derivative
+};
+
+/**
+ * @brief The data that an integral keeps (for one derivative and element geometry) in order to apply its gradient
+ *
+ * This is usually the q-function derivatives at each quadrature point, but for DerivativeStorage::Recompute it is the
+ * element values of the arguments at the point of linearization. The type of the data is erased, so that the
+ * Integral that owns it can report how much memory it uses.
+ */
+struct DerivativeBuffer {
+  /**
+   * @brief allocate space for `n` values of type T, unless it was already allocated
+   *
+   * @return the allocated values
+   */
+  template <typename T>
+  T* allocate(std::size_t n)
+  {
+    if (!data) {
+      data  = accelerator::make_shared_array<ExecutionSpace::CPU, T>(n);
+      bytes = n * sizeof(T);
+    }
+    return get<T>();
+  }
+
+  /// @brief the allocated values, which must be of type T
+  template <typename T>
+  T* get() const
+  {
+    return static_cast<T*>(data.get());
+  }
+
+  /// @brief whether or not the values have been allocated
+  bool allocated() const { return data != nullptr; }
+
+  std::shared_ptr<void> data;       ///< the values, or nullptr if they haven't been allocated yet
+  std::size_t           bytes = 0;  ///< the number of bytes allocated
+
+  /// @brief the time at the point of linearization (only used by DerivativeStorage::Recompute)
+  double time = 0.0;
+
+  /// @brief the weights of a combined derivative at the point of linearization (only used by Recompute)
+  std::array<double, 2> weights = {1.0, 1.0};
+};
+
+}  // namespace serac
@@ -279,6 +279,218 @@ struct finite_element<mfem::Geometry::CUBE, H1<p, c> > {
     }
   }
 
+  /**
+   * @brief T(k, i, j) is the quadrature-weighted product of two 1D shape functions (or their derivatives)
+   *  associated with the jth node, evaluated at the ith 1D quadrature point, where
+   *    k == 0 : B(i, j) * B(i, j)
+   *    k == 1 : B(i, j) * G(i, j)
+   *    k == 2 : G(i, j) * G(i, j)
+   *
+   * @tparam q the number of quadrature points in the 1D rule
+   */
+  template <int q>
+  static constexpr auto calculate_diagonal_factors()
+  {
+    constexpr auto          B  = calculate_B<false, q>();
+    constexpr auto          G  = calculate_G<false, q>();
+    constexpr auto          wB = calculate_B<true, q>();
+    constexpr auto          wG = calculate_G<true, q>();
+    tensor<double, 3, q, n> T{};
+    for (int i = 0; i < q; i++) {
+      for (int j = 0; j < n; j++) {
+        T(0, i, j) = wB(i, j) * B(i, j);
+        T(1, i, j) = wB(i, j) * G(i, j);
+        T(2, i, j) = wG(i, j) * G(i, j);
+      }
+    }
+    return T;
+  }
+
+  template <typename derivative_type, int q>
+  SERAC_HOST_DEVICE static void diagonal(const derivative_type* qf_derivatives, const TensorProductQuadratureRule<q>&,
+                                         dof_type* element_diagonal)
+  {
+    // we want to compute the diagonal entries of the element gradient:
+    //
+    // D(i, jz, jy, jx) := sum_Q {phi_j(Q), dphi_j_dxi(Q)}^T . M_i(Q) . {phi_j(Q), dphi_j_dxi(Q)} * w(Q)
+    //
+    // where M_i(Q) are the q-function derivatives coupling component i to itself (see derivative_block()).
+    //
+    // each term in that product factors into 1D quantities, e.g.
+    //
+    //   M_i(Q)(1, 2) * dphi_j_dx(Q) * dphi_j_dy(Q) * w(Q) == M_i(Q)(1, 2) * T(1, qx, jx) * T(1, qy, jy) * T(0, qz, jz)
+    //
+    // so terms with the same factors are summed at each quadrature point, and then
+    // contracted one dimension at a time, like in interpolate() and integrate()
+    static constexpr auto T = calculate_diagonal_factors<q>();
+
+    // which of the 1D factors in T appear in each term, in the {x, y, z} directions
+    constexpr int num_terms               = 10;
+    constexpr int factors[num_terms][dim] = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {2, 0, 0},
+                                             {0, 2, 0}, {0, 0, 2}, {1, 1, 0}, {1, 0, 1}, {0, 1, 1}};
+
+    for (int i = 0; i < c; i++) {
+      tensor<double, num_terms, q, q, q> coefficients{};
+      for (int qz = 0; qz < q; qz++) {
+        for (int qy = 0; qy < q; qy++) {
+          for (int qx = 0; qx < q; qx++) {
+            int  Q = (qz * q + qy) * q + qx;
+            auto M = derivative_block<c, c, dim>(qf_derivatives[Q], i, i);
+
+            coefficients(0, qz, qy, qx) = M(0, 0);
+            for (int k = 0; k < dim; k++) {
+              coefficients(1 + k, qz, qy, qx) = M(0, 1 + k) + M(1 + k, 0);
+              coefficients(4 + k, qz, qy, qx) = M(1 + k, 1 + k);
+            }
+            coefficients(7, qz, qy, qx) = M(1, 2) + M(2, 1);
+            coefficients(8, qz, qy, qx) = M(1, 3) + M(3, 1);
+            coefficients(9, qz, qy, qx) = M(2, 3) + M(3, 2);
+          }
+        }
+      }
+
+      for (int t = 0; t < num_terms; t++) {
+        auto A2 = contract<2, 0>(coefficients(t), T(factors[t][0]));
+        auto A1 = contract<1, 0>(A2, T(factors[t][1]));
+        element_diagonal[0](i) += contract<0, 0>(A1, T(factors[t][2]));
+      }
+    }
+  }
+
+  /**
+   * @brief F(k, i, I * m + J) is the quadrature-weighted product of a 1D test shape function (or its derivative)
+   *  associated with node I, and a 1D trial shape function (or its derivative) associated with node J,
+   *  evaluated at the ith 1D quadrature point, where
+   *    k == 0 : B_test(i, I) * B_trial(i, J)
+   *    k == 1 : B_test(i, I) * G_trial(i, J)
+   *    k == 2 : G_test(i, I) * B_trial(i, J)
+   *    k == 3 : G_test(i, I) * G_trial(i, J)
+   *  and m is the number of trial nodes per dimension
+   *
+   * @tparam trial_element the finite_element type of the trial space
+   * @tparam q the number of quadrature points in the 1D rule
+   */
+  template <typename trial_element, int q>
+  static constexpr auto calculate_gradient_factors()
+  {
+    constexpr int               m       = trial_element::n;
+    constexpr auto              wB      = calculate_B<true, q>();
+    constexpr auto              wG      = calculate_G<true, q>();
+    constexpr auto              B_trial = trial_element::template calculate_B<false, q>();
+    constexpr auto              G_trial = trial_element::template calculate_G<false, q>();
+    tensor<double, 4, q, n * m> F{};
+    for (int i = 0; i < q; i++) {
+      for (int I = 0; I < n; I++) {
+        for (int J = 0; J < m; J++) {
+          F(0, i, I * m + J) = wB(i, I) * B_trial(i, J);
+          F(1, i, I * m + J) = wB(i, I) * G_trial(i, J);
+          F(2, i, I * m + J) = wG(i, I) * B_trial(i, J);
+          F(3, i, I * m + J) = wG(i, I) * G_trial(i, J);
+        }
+      }
+    }
+    return F;
+  }
+
+  template <typename trial_element, typename derivative_type, int q>
+  SERAC_HOST_DEVICE static void element_gradient(const derivative_type* qf_derivatives,
+                                                 const TensorProductQuadratureRule<q>&, dof_type* dK)
+  {
+    // we want to compute the entries of the element gradient:
+    //
+    // dK(j, Jz, Jy, Jx)(i, Iz, Iy, Ix) :=
+    //   sum_Q {phi_I(Q), dphi_I_dxi(Q)}^T . M_ij(Q) . {psi_J(Q), dpsi_J_dxi(Q)} * w(Q)
+    //
+    // where phi, psi are the test and trial shape functions, and M_ij(Q) are the q-function derivatives
+    // coupling trial component j to test component i (see derivative_block()).
+    //
+    // each of the (dim + 1)^2 terms in that product factors into 1D quantities, e.g.
+    //
+    //   M_ij(Q)(1, 2) * dphi_I_dx(Q) * dpsi_J_dy(Q) * w(Q) ==
+    //   M_ij(Q)(1, 2) * F(2, qx, IJx) * F(1, qy, IJy) * F(0, qz, IJz)
+    //
+    // so the terms are contracted with their 1D factors one dimension at a time, summing the partial results
+    // that share the same remaining factors before each subsequent contraction:
+    //
+    // A1(fy, fz)(qz, qy, IJx) := sum_{terms} sum_qx M(qz, qy, qx) * F(fx, qx, IJx)
+    // A2(fz)(qz, IJy, IJx)    := sum_{fy}    sum_qy A1(fy, fz)(qz, qy, IJx) * F(fy, qy, IJy)
+    // K(IJz, IJy, IJx)        := sum_{fz}    sum_qz A2(fz)(qz, IJy, IJx) * F(fz, qz, IJz)
+    constexpr int m  = trial_element::n;
+    constexpr int nm = n * m;
+    constexpr int ci = c;
+    constexpr int cj = trial_element::components;
+
+    static constexpr auto F = calculate_gradient_factors<trial_element, q>();
+
+    for (int i = 0; i < ci; i++) {
+      for (int j = 0; j < cj; j++) {
+        tensor<double, dim + 1, dim + 1, q, q, q> coefficients{};
+        for (int qz = 0; qz < q; qz++) {
+          for (int qy = 0; qy < q; qy++) {
+            for (int qx = 0; qx < q; qx++) {
+              int  Q = (qz * q + qy) * q + qx;
+              auto M = derivative_block<ci, cj, dim>(qf_derivatives[Q], i, j);
+              for (int s = 0; s < dim + 1; s++) {
+                for (int t = 0; t < dim + 1; t++) {
+                  coefficients(s, t, qz, qy, qx) = M(s, t);
+                }
+              }
+            }
+          }
+        }
+
+        tensor<double, 4, 4, q, q, nm> A1{};
+        tensor<double, 4, q, nm, nm>   A2{};
+        bool                           A1_nonzero[4][4]{};
+        bool                           A2_nonzero[4]{};
+
+        for (int s = 0; s < dim + 1; s++) {
+          for (int t = 0; t < dim + 1; t++) {
+            if (!is_nonzero_block<derivative_type>(s > 0, t > 0)) continue;
+
+            // which 1D factor appears in each direction
+            int f[dim];
+            for (int k = 0; k < dim; k++) {
+              f[k] = 2 * (s == k + 1) + (t == k + 1);
+            }
+
+            A1(f[1], f[2]) += contract<2, 0>(coefficients(s, t), F(f[0]));
+            A1_nonzero[f[1]][f[2]] = true;
+          }
+        }
+
+        for (int fy = 0; fy < 4; fy++) {
+          for (int fz = 0; fz < 4; fz++) {
+            if (!A1_nonzero[fy][fz]) continue;
+            A2(fz) += contract<1, 0>(A1(fy, fz), F(fy));
+            A2_nonzero[fz] = true;
+          }
+        }
+
+        tensor<double, nm, nm, nm> K{};
+        for (int fz = 0; fz < 4; fz++) {
+          if (!A2_nonzero[fz]) continue;
+          K += contract<0, 0>(A2(fz), F(fz));
+        }
+
+        for (int Iz = 0; Iz < n; Iz++) {
+          for (int Jz = 0; Jz < m; Jz++) {
+            for (int Iy = 0; Iy < n; Iy++) {
+              for (int Jy = 0; Jy < m; Jy++) {
+                for (int Ix = 0; Ix < n; Ix++) {
+                  for (int Jx = 0; Jx < m; Jx++) {
+                    int J = (Jz * m + Jy) * m + Jx;
+                    dK[j * trial_element::ndof + J](i, Iz, Iy, Ix) += K(Iz * m + Jz, Iy * m + Jy, Ix * m + Jx);
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
 #if 0
 
   template <int q>
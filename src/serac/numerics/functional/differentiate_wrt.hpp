@@ -15,12 +15,52 @@ template <uint32_t i>
 struct DifferentiateWRT {
 };
 
+/**
+ * @brief the index used to refer to the weighted sum of the derivatives w.r.t. trial spaces `i` and `j` (i < j)
+ *
+ * @see CombinedDerivative
+ */
+constexpr uint32_t combined_derivative_index(uint32_t i, uint32_t j) { return (uint32_t(1) << 30) | (i << 15) | j; }
+
+/// @brief whether or not an index refers to a combined derivative (see `combined_derivative_index`)
+constexpr bool is_combined_derivative_index(uint32_t index)
+{
+  return index != NO_DIFFERENTIATION && (index & (uint32_t(1) << 30));
+}
+
+/// @brief the index of the first trial space of a combined derivative
+constexpr uint32_t first_combined_argument(uint32_t index) { return (index >> 15) & 0x7fff; }
+
+/// @brief the index of the second trial space of a combined derivative
+constexpr uint32_t second_combined_argument(uint32_t index) { return index & 0x7fff; }
+
+/**
+ * @brief a tag type used when adding integrals to a `serac::Functional`, to request that kernels also be generated
+ * for the weighted sum of the derivatives w.r.t. trial spaces `i` and `j` (which must be the same space).
+ *
+ * Those derivatives can then be evaluated in a single pass, by passing both arguments through
+ * `differentiate_wrt(value, weight)`, e.g.
+ * @code{.cpp}
+ *     f.AddDomainIntegral(Dimension<dim>{}, DependsOn<0, 1>{}, CombinedDerivative<0, 1>{}, integrand, domain);
+ *     ...
+ *     // J := a * df/du + b * df/dv
+ *     auto [value, J] = f(t, differentiate_wrt(u, a), differentiate_wrt(v, b));
+ * @endcode
+ */
+template <uint32_t i, uint32_t j>
+struct CombinedDerivative {
+};
+
+/// @brief the tag type used for integrals that don't generate combined derivative kernels
+using NoCombinedDerivative = CombinedDerivative<NO_DIFFERENTIATION, NO_DIFFERENTIATION>;
+
 /**
  * @brief this type exists solely as a way to signal to `serac::Functional` that the function
  * serac::Functional::operator()` should differentiate w.r.t. a specific argument
  */
 struct differentiate_wrt_this {
-  const mfem::Vector& ref;  ///< the actual data wrapped by this type
+  const mfem::Vector& ref;           ///< the actual data wrapped by this type
+  double              weight = 1.0;  ///< the coefficient of this derivative, when combined with another one
 
   /// @brief implicitly convert back to `mfem::Vector` to extract the actual data
   operator const mfem::Vector&() const { return ref; }
@@ -41,4 +81,16 @@ struct differentiate_wrt_this {
  */
 inline auto differentiate_wrt(const mfem::Vector& v) { return differentiate_wrt_this{v}; }
 
+/**
+ * @brief this overload is used to differentiate w.r.t. two arguments at once, returning the weighted sum of
+ *   the two derivatives (see `CombinedDerivative`)
+ *
+ * For example:
+ * @code{.cpp}
+ *     // J := a * df/d(arg0) + b * df/d(arg1)
+ *     auto [value, J] = my_functional(differentiate_wrt(arg0, a), differentiate_wrt(arg1, b));
+ * @endcode
+ */
+inline auto differentiate_wrt(const mfem::Vector& v, double weight) { return differentiate_wrt_this{v, weight}; }
+
 }  // namespace serac
@@ -347,9 +347,58 @@ struct GradientAssemblyLookupTables {
 
     row_ptr.back() = static_cast<int>(nnz);
 
+    initElementLUT(Domain::Type::Elements, block_test_dofs, block_trial_dofs);
+
     initialized = true;
   }
 
+  /**
+   * @param type which kind of Integral (domain or boundary) the restriction operators are associated with
+   * @param block_test_dofs object containing information about dofs for the test space
+   * @param block_trial_dofs object containing information about dofs for the trial space
+   *
+   * @brief for each element of each geometry, record which nonzero entry (and with what sign)
+   * every entry of the element "stiffness" matrix contributes to, so that assembly can be done
+   * without looking anything up in `nz_LUT`.
+   *
+   * @note this relies on the sparsity pattern discovered in `init()`, so it must be called afterwards
+   */
+  void initElementLUT(Domain::Type type, const serac::BlockElementRestriction& block_test_dofs,
+                      const serac::BlockElementRestriction& block_trial_dofs)
+  {
+    for (const auto& [geometry, trial_dofs] : block_trial_dofs.restrictions) {
+      const auto& test_dofs = block_test_dofs.restrictions.at(geometry);
+
+      std::vector<DoF> test_vdofs(test_dofs.nodes_per_elem * test_dofs.components);
+      std::vector<DoF> trial_vdofs(trial_dofs.nodes_per_elem * trial_dofs.components);
+
+      auto num_elements = static_cast<axom::IndexType>(trial_dofs.num_elements);
+      auto num_trial    = static_cast<axom::IndexType>(trial_vdofs.size());
+      auto num_test     = static_cast<axom::IndexType>(test_vdofs.size());
+
+      auto& nonzeros = element_nonzero_LUT[type][geometry];
+      auto& signs    = element_signs[type][geometry];
+      nonzeros       = CPUArray<uint32_t, 3>(num_elements, num_trial, num_test);
+      signs          = CPUArray<int8_t, 3>(num_elements, num_trial, num_test);
+
+      for (axom::IndexType e = 0; e < num_elements; e++) {
+        test_dofs.GetElementVDofs(int(e), test_vdofs);
+        trial_dofs.GetElementVDofs(int(e), trial_vdofs);
+
+        // note: the element matrices are stored "transposed" (i.e. trial index first, then test index),
+        //       so the tables use that same layout to allow a flat traversal during assembly
+        for (axom::IndexType i = 0; i < num_trial; i++) {
+          auto col = trial_vdofs[uint64_t(i)];
+          for (axom::IndexType j = 0; j < num_test; j++) {
+            auto row          = test_vdofs[uint64_t(j)];
+            nonzeros(e, i, j) = (*this)(int(row.index()), int(col.index()));
+            signs(e, i, j)    = static_cast<int8_t>(row.sign() * col.sign());
+          }
+        }
+      }
+    }
+  }
+
   /**
    * @brief return the index (into the nonzero entries) corresponding to entry (i,j)
    * @param i the row
@@ -375,6 +424,15 @@ struct GradientAssemblyLookupTables {
    */
   std::unordered_map<Entry, uint32_t, Entry::Hasher> nz_LUT;
 
+  /**
+   * @brief `element_nonzero_LUT[type][geom](e, i, j)` is the index into the `col_ind` / `value` CSR arrays
+   * where the (i,j) entry of the element matrix for element `e` (of geometry `geom`) is accumulated
+   */
+  std::map<mfem::Geometry::Type, CPUArray<uint32_t, 3> > element_nonzero_LUT[Domain::num_types];
+
+  /// @brief `element_signs[type][geom](e, i, j)` is the sign (+1 or -1) of the corresponding element matrix entry
+  std::map<mfem::Geometry::Type, CPUArray<int8_t, 3> > element_signs[Domain::num_types];
+
   /// @brief specifies if the table has already been initialized or not
   bool initialized;
 };
@@ -10,6 +10,7 @@
 #include "serac/numerics/functional/quadrature_data.hpp"
 #include "serac/numerics/functional/function_signature.hpp"
 #include "serac/numerics/functional/differentiate_wrt.hpp"
+#include "serac/numerics/functional/simd.hpp"
 #include "RAJA/RAJA.hpp"
 
 #include <array>
@@ -102,12 +103,74 @@ auto get_derivative_type(const lambda& qf, qpt_data_type qpt_data)
                                make_dual_wrt<i>(qf_arguments{})));
 };
 
+template <int i, int j, int dim, typename... trials, typename lambda, typename qpt_data_type>
+auto get_combined_derivative_type(const lambda& qf, qpt_data_type qpt_data)
+{
+  using qf_arguments = serac::tuple<typename QFunctionArgument<trials, serac::Dimension<dim>>::type...>;
+  return get_gradient(apply_qf(qf, double{}, serac::tuple<tensor<double, dim>, tensor<double, dim, dim>>{}, qpt_data,
+                               make_dual_wrt<i, j>(qf_arguments{})));
+};
+
+/**
+ * @brief pack the values of a q-function input at quadrature points [i, i + W) into `simd<W>` numbers, repeating
+ * the last quadrature point in the lanes past the end
+ */
+template <int W, typename T, int n>
+SERAC_HOST_DEVICE auto pack_quadrature_points(const tensor<T, n>& input, int i)
+{
+  simd_pack_t<W, T> packed{};
+  for (int lane = 0; lane < W; lane++) {
+    insert_lane(packed, lane, input[(i + lane < n) ? i + lane : n - 1]);
+  }
+  return packed;
+}
+
+/**
+ * @brief evaluate a vectorized q-function (see serac::vectorize()) at the quadrature points of an element, W at a time
+ *
+ * The positions, jacobians and inputs at W consecutive quadrature points are packed into `simd<W>` numbers, and the
+ * q-function is evaluated once for each pack. When the number of quadrature points is not a multiple of W, the
+ * lanes of the last pack are filled with copies of the last quadrature point, and their outputs are discarded.
+ *
+ * @tparam return_type the type of the q-function output at a single quadrature point
+ * @tparam W the number of quadrature points evaluated at once
+ * @param call_qf a callable that evaluates the q-function, given the time, packed position and packed inputs
+ */
+template <typename return_type, int W, typename lambda, int dim, int n, typename... T>
+SERAC_HOST_DEVICE auto batch_apply_qf_vectorized(const lambda& call_qf, double t, const tensor<double, dim, n>& x,
+                                                 const tensor<double, dim, dim, n>& J, const T&... inputs)
+{
+  using position_t = serac::tuple<tensor<simd<W>, dim>, tensor<simd<W>, dim, dim>>;
+  tensor<return_type, n> outputs{};
+  for (int i = 0; i < n; i += W) {
+    position_t X{};
+    for (int lane = 0; lane < W; lane++) {
+      int q = (i + lane < n) ? i + lane : n - 1;
+      for (int j = 0; j < dim; j++) {
+        for (int k = 0; k < dim; k++) {
+          get<1>(X)[j][k][lane] = J(k, j, q);
+        }
+        get<0>(X)[j][lane] = x(j, q);
+      }
+    }
+    auto packed_outputs = call_qf(t, X, pack_quadrature_points<W>(inputs, i)...);
+    for (int lane = 0; lane < W && i + lane < n; lane++) {
+      extract_lane(packed_outputs, lane, outputs[i + lane]);
+    }
+  }
+  return outputs;
+}
+
 template <typename lambda, int dim, int n, typename... T>
 SERAC_HOST_DEVICE auto batch_apply_qf_no_qdata(const lambda& qf, double t, const tensor<double, dim, n>& x,
                                                const tensor<double, dim, dim, n>& J, const T&... inputs)
 {
   using position_t  = serac::tuple<tensor<double, dim>, tensor<double, dim, dim>>;
   using return_type = decltype(qf(double{}, position_t{}, T{}[0]...));
+  if constexpr (is_vectorized<lambda>::value) {
+    auto call_qf = [&](double time, const auto& X, const auto&... packed) { return qf.qf(time, X, packed...); };
+    return batch_apply_qf_vectorized<return_type, lambda::width>(call_qf, t, x, J, inputs...);
+  }
   tensor<return_type, n> outputs{};
   for (int i = 0; i < n; i++) {
     tensor<double, dim>      x_q;
@@ -130,6 +193,14 @@ SERAC_HOST_DEVICE auto batch_apply_qf(const lambda& qf, double t, const tensor<d
 {
   using position_t  = serac::tuple<tensor<double, dim>, tensor<double, dim, dim>>;
   using return_type = decltype(qf(double{}, position_t{}, qpt_data[0], T{}[0]...));
+  // only q-functions without internal variables are vectorized, since the state types are not packed
+  if constexpr (is_vectorized<lambda>::value && std::is_same_v<qpt_data_type, Empty>) {
+    auto call_qf = [&](double time, const auto& X, const auto&... packed) {
+      Empty qdata{};
+      return qf.qf(time, X, qdata, packed...);
+    };
+    return batch_apply_qf_vectorized<return_type, lambda::width>(call_qf, t, x, J, inputs...);
+  }
   tensor<return_type, n> outputs{};
   for (int i = 0; i < n; i++) {
     tensor<double, dim>      x_q;
@@ -149,15 +220,21 @@ SERAC_HOST_DEVICE auto batch_apply_qf(const lambda& qf, double t, const tensor<d
   return outputs;
 }
 
-template <uint32_t differentiation_index, int Q, mfem::Geometry::Type geom, typename test_element,
-          typename trial_element_tuple, typename lambda_type, typename state_type, typename derivative_type,
-          int... indices>
-void evaluation_kernel_impl(trial_element_tuple trial_elements, test_element, double t,
-                            const std::vector<const double*>& inputs, double* outputs, const double* positions,
-                            const double* jacobians, lambda_type qf,
+/**
+ * @note when `second_differentiation_index != NO_DIFFERENTIATION`, the stored q-function derivatives are the weighted
+ * sum (with coefficients `weights`) of the derivatives w.r.t. the two arguments, which must be of the same type
+ * @note `inputs` is any indexable container of the pointers to the dofs of each argument, so that callers evaluating
+ * a single element can pass a std::array instead of allocating a std::vector
+ */
+template <uint32_t differentiation_index, uint32_t second_differentiation_index, int Q, mfem::Geometry::Type geom,
+          ExecutionSpace exec, typename test_element, typename trial_element_tuple, typename input_pointers,
+          typename lambda_type, typename state_type, typename derivative_type, int... indices>
+void evaluation_kernel_impl(trial_element_tuple trial_elements, test_element, double t, const input_pointers& inputs,
+                            double* outputs, const double* positions, const double* jacobians, lambda_type qf,
                             [[maybe_unused]] axom::ArrayView<state_type, 2> qf_state,
                             [[maybe_unused]] derivative_type* qf_derivatives, const int* elements,
-                            uint32_t num_elements, bool update_state, camp::int_seq<int, indices...>)
+                            uint32_t num_elements, bool update_state, [[maybe_unused]] std::array<double, 2> weights,
+                            camp::int_seq<int, indices...>)
 {
   // mfem provides this information as opaque arrays of doubles,
   // so we reinterpret the pointer with
@@ -172,15 +249,20 @@ void evaluation_kernel_impl(trial_element_tuple trial_elements, test_element, do
       reinterpret_cast<const typename decltype(type<indices>(trial_elements))::dof_type*>(inputs[indices])...};
 
   // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; ++e) {
+  //
+  // note: each element only writes to its own entries of `outputs`, `qf_state` and `qf_derivatives`,
+  // so the elements can be processed concurrently
+  accelerator::forall<exec>(num_elements, [&](uint32_t e) {
     // load the jacobians and positions for each quadrature point in this element
     auto J_e = J[e];
     auto x_e = x[e];
 
     //[[maybe_unused]] static constexpr trial_element_tuple trial_element_tuple{};
     // batch-calculate values / derivatives of each trial space, at each quadrature point
-    [[maybe_unused]] tuple qf_inputs = {promote_each_to_dual_when<indices == differentiation_index>(
-        get<indices>(trial_elements).interpolate(get<indices>(u)[elements[e]], rule))...};
+    [[maybe_unused]] tuple qf_inputs = {
+        promote_each_to_dual_when<indices == differentiation_index || indices == second_differentiation_index>(
+            get<indices>(trial_elements).interpolate(get<indices>(u)[elements[e]], rule),
+            weights[indices == second_differentiation_index])...};
 
     // use J_e to transform values / derivatives on the parent element
     // to the to the corresponding values / derivatives on the physical element
@@ -214,7 +296,7 @@ void evaluation_kernel_impl(trial_element_tuple trial_elements, test_element, do
 
     // (batch) integrate the material response against the test-space basis functions
     test_element::integrate(get_value(qf_outputs), rule, &r[elements[e]]);
-  }
+  });
 
   return;
 }
@@ -260,6 +342,7 @@ SERAC_HOST_DEVICE auto batch_apply_chain_rule(derivative_type* qf_derivatives, c
  * and are erased through the @p std::function members of @p DomainIntegral
  * @tparam g The shape of the element (only quadrilateral and hexahedron are supported at present)
  * @tparam Q parameter describing number of quadrature points (see num_quadrature_points() function for more details)
+ * @tparam exec the execution space used for the loop over elements
  * @tparam derivatives_type Type representing the derivative of the q-function w.r.t. its input arguments
  *
  * @note lambda does not appear as a template argument, as the directional derivative is
@@ -272,11 +355,16 @@ SERAC_HOST_DEVICE auto batch_apply_chain_rule(derivative_type* qf_derivatives, c
  * @param[in] J_ The Jacobians of the element transformations at all quadrature points
  * @see mfem::GeometricFactors
  * @param[in] num_elements The number of elements in the mesh
+ * @param[in] num_vectors The number of directions to differentiate in, whose element values are stored one after
+ * another in @p dU (and @p dR)
+ * @param[in] du_stride The distance between the values of consecutive directions in @p dU
+ * @param[in] dr_stride The distance between the values of consecutive directions in @p dR
  */
 
-template <int Q, mfem::Geometry::Type g, typename test, typename trial, typename derivatives_type>
+template <int Q, mfem::Geometry::Type g, typename test, typename trial, ExecutionSpace exec, typename derivatives_type>
 void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* qf_derivatives, const int* elements,
-                               std::size_t num_elements)
+                               std::size_t num_elements, uint32_t num_vectors = 1, std::size_t du_stride = 0,
+                               std::size_t dr_stride = 0)
 {
   using test_element  = finite_element<g, test>;
   using trial_element = finite_element<g, trial>;
@@ -284,23 +372,27 @@ void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* q
   constexpr bool is_QOI   = (test::family == Family::QOI);
   constexpr int  num_qpts = num_quadrature_points(g, Q);
 
-  // mfem provides this information in 1D arrays, so we reshape it
-  // into strided multidimensional arrays before using
-  auto                                     du = reinterpret_cast<const typename trial_element::dof_type*>(dU);
-  auto                                     dr = reinterpret_cast<typename test_element::dof_type*>(dR);
   constexpr TensorProductQuadratureRule<Q> rule{};
 
   // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; e++) {
-    // (batch) interpolate each quadrature point's value
-    auto qf_inputs = trial_element::interpolate(du[elements[e]], rule);
-
-    // (batch) evalute the q-function at each quadrature point
-    auto qf_outputs = batch_apply_chain_rule<is_QOI>(qf_derivatives + e * num_qpts, qf_inputs);
-
-    // (batch) integrate the material response against the test-space basis functions
-    test_element::integrate(qf_outputs, rule, &dr[elements[e]]);
-  }
+  accelerator::forall<exec>(uint32_t(num_elements), [&](uint32_t e) {
+    // every direction is applied while this element's q-function derivatives are still in cache
+    for (uint32_t k = 0; k < num_vectors; k++) {
+      // mfem provides this information in 1D arrays, so we reshape it
+      // into strided multidimensional arrays before using
+      auto du = reinterpret_cast<const typename trial_element::dof_type*>(dU + k * du_stride);
+      auto dr = reinterpret_cast<typename test_element::dof_type*>(dR + k * dr_stride);
+
+      // (batch) interpolate each quadrature point's value
+      auto qf_inputs = trial_element::interpolate(du[elements[e]], rule);
+
+      // (batch) evalute the q-function at each quadrature point
+      auto qf_outputs = batch_apply_chain_rule<is_QOI>(qf_derivatives + e * num_qpts, qf_inputs);
+
+      // (batch) integrate the material response against the test-space basis functions
+      test_element::integrate(qf_outputs, rule, &dr[elements[e]]);
+    }
+  });
 }
 
 /**
@@ -315,6 +407,7 @@ void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* q
  * and are erased through the @p std::function members of @p Integral
  * @tparam g The shape of the element (only quadrilateral and hexahedron are supported at present)
  * @tparam Q parameter describing number of quadrature points (see num_quadrature_points() function for more details)
+ * @tparam exec the execution space used for the loop over elements
  * @tparam derivatives_type Type representing the derivative of the q-function w.r.t. its input arguments
  *
  *
@@ -324,7 +417,7 @@ void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* q
  * @see mfem::GeometricFactors
  * @param[in] num_elements The number of elements in the mesh
  */
-template <mfem::Geometry::Type g, typename test, typename trial, int Q, typename derivatives_type>
+template <mfem::Geometry::Type g, typename test, typename trial, int Q, ExecutionSpace exec, typename derivatives_type>
 void element_gradient_kernel(ExecArrayView<double, 3, ExecutionSpace::CPU> dK, derivatives_type* qf_derivatives,
                              const int* elements, std::size_t num_elements)
 {
@@ -340,28 +433,93 @@ void element_gradient_kernel(ExecArrayView<double, 3, ExecutionSpace::CPU> dK, d
 
   static constexpr TensorProductQuadratureRule<Q> rule{};
 
+  // H1 elements on quadrilaterals and hexahedra compute the whole element matrix at once with sum-factorization,
+  // rather than forming one column at a time
+  constexpr bool sum_factorization = !is_QOI && test::family == Family::H1 && trial::family == Family::H1 &&
+                                     (g == mfem::Geometry::SQUARE || g == mfem::Geometry::CUBE);
+
   // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; e++) {
+  accelerator::forall<exec>(uint32_t(num_elements), [&](uint32_t e) {
     auto* output_ptr = reinterpret_cast<typename test_element::dof_type*>(&dK(elements[e], 0, 0));
 
-    tensor<padded_derivative_type, nquad> derivatives{};
-    for (int q = 0; q < nquad; q++) {
-      if constexpr (is_QOI) {
-        get<0>(derivatives(q)) = qf_derivatives[e * nquad + uint32_t(q)];
-      } else {
-        derivatives(q) = qf_derivatives[e * nquad + uint32_t(q)];
+    if constexpr (sum_factorization) {
+      test_element::template element_gradient<trial_element>(qf_derivatives + e * nquad, rule, output_ptr);
+    } else {
+      tensor<padded_derivative_type, nquad> derivatives{};
+      for (int q = 0; q < nquad; q++) {
+        if constexpr (is_QOI) {
+          get<0>(derivatives(q)) = qf_derivatives[e * nquad + uint32_t(q)];
+        } else {
+          derivatives(q) = qf_derivatives[e * nquad + uint32_t(q)];
+        }
+      }
+
+      for (int J = 0; J < trial_element::ndof; J++) {
+        auto source_and_flux = trial_element::batch_apply_shape_fn(J, derivatives, rule);
+        test_element::integrate(source_and_flux, rule, output_ptr + J, trial_element::ndof);
       }
     }
+  });
+}
 
-    for (int J = 0; J < trial_element::ndof; J++) {
-      auto source_and_flux = trial_element::batch_apply_shape_fn(J, derivatives, rule);
-      test_element::integrate(source_and_flux, rule, output_ptr + J, trial_element::ndof);
+/**
+ * @brief The base kernel template used to compute only the diagonal entries of the element gradients,
+ * without forming the element gradients themselves
+ *
+ * @tparam g The shape of the element
+ * @tparam test The type of the test function space
+ * @tparam trial The type of the trial function space (must be the same as the test space)
+ * @tparam Q parameter describing number of quadrature points (see num_quadrature_points() function for more details)
+ * @tparam exec the execution space used for the loop over elements
+ * @tparam derivatives_type Type representing the derivative of the q-function w.r.t. its input arguments
+ *
+ * @param[inout] dD The per-element diagonal entries, with the same layout as an E-vector of the test space
+ * @param[in] qf_derivatives pointer to data describing the derivatives of the q-function with respect to its arguments
+ * @param[in] elements the indices of the elements in the domain
+ * @param[in] num_elements The number of elements in the domain
+ *
+ * @note quadrilateral and hexahedral H1 elements use sum-factorization, other elements
+ * compute each column of the element gradient in turn and keep only its diagonal entry
+ */
+template <mfem::Geometry::Type g, typename test, typename trial, int Q, ExecutionSpace exec, typename derivatives_type>
+void element_diagonal_kernel(double* dD, derivatives_type* qf_derivatives, const int* elements,
+                             std::size_t num_elements)
+{
+  static_assert(std::is_same_v<test, trial>, "element diagonals require identical test and trial spaces");
+
+  using element = finite_element<g, test>;
+
+  constexpr int nquad = num_quadrature_points(g, Q);
+
+  auto                                            dd = reinterpret_cast<typename element::dof_type*>(dD);
+  static constexpr TensorProductQuadratureRule<Q> rule{};
+
+  // for each element in the domain
+  accelerator::forall<exec>(uint32_t(num_elements), [&](uint32_t e) {
+    if constexpr (element::family == Family::H1 && (g == mfem::Geometry::SQUARE || g == mfem::Geometry::CUBE)) {
+      element::diagonal(qf_derivatives + e * nquad, rule, &dd[elements[e]]);
+    } else {
+      tensor<derivatives_type, nquad> derivatives{};
+      for (int q = 0; q < nquad; q++) {
+        derivatives(q) = qf_derivatives[e * nquad + uint32_t(q)];
+      }
+
+      auto* output_ptr = reinterpret_cast<double*>(&dd[elements[e]]);
+      for (int J = 0; J < element::ndof; J++) {
+        // column J of the element gradient, one block for each component of the trial space
+        tensor<typename element::dof_type, element::components> columns{};
+        auto source_and_flux = element::batch_apply_shape_fn(J, derivatives, rule);
+        element::integrate(source_and_flux, rule, &columns[0]);
+        for (int i = 0; i < element::components; i++) {
+          output_ptr[i * element::ndof + J] += reinterpret_cast<const double*>(&columns[i])[i * element::ndof + J];
+        }
+      }
     }
-  }
+  });
 }
 
-template <uint32_t wrt, int Q, mfem::Geometry::Type geom, typename signature, typename lambda_type, typename state_type,
-          typename derivative_type>
+template <uint32_t wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature,
+          typename lambda_type, typename state_type, typename derivative_type>
 auto evaluation_kernel(signature s, const lambda_type& qf, const double* positions, const double* jacobians,
                        std::shared_ptr<QuadratureData<state_type>> qf_state,
                        std::shared_ptr<derivative_type> qf_derivatives, const int* elements, uint32_t num_elements)
@@ -369,31 +527,62 @@ auto evaluation_kernel(signature s, const lambda_type& qf, const double* positio
   auto trial_elements = trial_elements_tuple<geom>(s);
   auto test_element   = get_test_element<geom>(s);
   return [=](double time, const std::vector<const double*>& inputs, double* outputs, bool update_state) {
-    domain_integral::evaluation_kernel_impl<wrt, Q, geom>(
+    domain_integral::evaluation_kernel_impl<wrt, NO_DIFFERENTIATION, Q, geom, exec>(
+        trial_elements, test_element, time, inputs, outputs, positions, jacobians, qf, (*qf_state)[geom],
+        qf_derivatives.get(), elements, num_elements, update_state, {1.0, 1.0}, s.index_seq);
+  };
+}
+
+template <uint32_t i, uint32_t j, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature,
+          typename lambda_type, typename state_type, typename derivative_type>
+auto combined_evaluation_kernel(signature s, const lambda_type& qf, const double* positions, const double* jacobians,
+                                std::shared_ptr<QuadratureData<state_type>> qf_state,
+                                std::shared_ptr<derivative_type> qf_derivatives, const int* elements,
+                                uint32_t num_elements)
+{
+  auto trial_elements = trial_elements_tuple<geom>(s);
+  auto test_element   = get_test_element<geom>(s);
+  return [=](double time, const std::vector<const double*>& inputs, double* outputs, bool update_state,
+             std::array<double, 2> weights) {
+    domain_integral::evaluation_kernel_impl<i, j, Q, geom, exec>(
         trial_elements, test_element, time, inputs, outputs, positions, jacobians, qf, (*qf_state)[geom],
-        qf_derivatives.get(), elements, num_elements, update_state, s.index_seq);
+        qf_derivatives.get(), elements, num_elements, update_state, weights, s.index_seq);
   };
 }
 
-template <int wrt, int Q, mfem::Geometry::Type geom, typename signature, typename derivative_type>
-std::function<void(const double*, double*)> jacobian_vector_product_kernel(
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename derivative_type>
+std::function<void(const double*, double*, uint32_t, std::size_t, std::size_t)> jacobian_vector_product_kernel(
     signature, std::shared_ptr<derivative_type> qf_derivatives, const int* elements, uint32_t num_elements)
 {
-  return [=](const double* du, double* dr) {
+  return [=](const double* du, double* dr, uint32_t num_vectors, std::size_t du_stride, std::size_t dr_stride) {
     using test_space  = typename signature::return_type;
     using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
-    action_of_gradient_kernel<Q, geom, test_space, trial_space>(du, dr, qf_derivatives.get(), elements, num_elements);
+    action_of_gradient_kernel<Q, geom, test_space, trial_space, exec>(du, dr, qf_derivatives.get(), elements,
+                                                                      num_elements, num_vectors, du_stride, dr_stride);
   };
 }
 
-template <int wrt, int Q, mfem::Geometry::Type geom, typename signature, typename derivative_type>
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename derivative_type>
 std::function<void(ExecArrayView<double, 3, ExecutionSpace::CPU>)> element_gradient_kernel(
     signature, std::shared_ptr<derivative_type> qf_derivatives, const int* elements, uint32_t num_elements)
 {
   return [=](ExecArrayView<double, 3, ExecutionSpace::CPU> K_elem) {
     using test_space  = typename signature::return_type;
     using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
-    element_gradient_kernel<geom, test_space, trial_space, Q>(K_elem, qf_derivatives.get(), elements, num_elements);
+    element_gradient_kernel<geom, test_space, trial_space, Q, exec>(K_elem, qf_derivatives.get(), elements,
+                                                                    num_elements);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, ExecutionSpace exec, typename signature, typename derivative_type>
+std::function<void(double*)> element_diagonal_kernel(signature, std::shared_ptr<derivative_type> qf_derivatives,
+                                                     const int* elements, uint32_t num_elements)
+{
+  return [=](double* D_elem) {
+    using test_space  = typename signature::return_type;
+    using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
+    element_diagonal_kernel<geom, test_space, trial_space, Q, exec>(D_elem, qf_derivatives.get(), elements,
+                                                                    num_elements);
   };
 }
 
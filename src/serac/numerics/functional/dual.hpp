@@ -17,17 +17,57 @@
 #include <cmath>
 
 #include "serac/infrastructure/accelerator.hpp"
+#include "serac/numerics/functional/simd.hpp"
 
 namespace serac {
 
+/// @cond
+template <typename T, int... n>
+struct tensor;
+
+template <typename... T>
+struct tuple;
+
+namespace detail {
+
+/**
+ * @brief the type of the value of a dual number with a given type of gradient: `simd<W>` when the gradient
+ * is made of `simd<W>` numbers, and `double` otherwise
+ */
+template <typename gradient_type>
+struct dual_value {
+  using type = double;
+};
+
+template <int W>
+struct dual_value<simd<W> > {
+  using type = simd<W>;
+};
+
+template <typename T, int... n>
+struct dual_value<tensor<T, n...> > : dual_value<T> {
+};
+
+template <typename... T>
+struct dual_value<tuple<T...> > {
+  using type = decltype((typename dual_value<T>::type{} * ... * 1.0));
+};
+
+}  // namespace detail
+/// @endcond
+
 /**
  * @brief Dual number struct (value plus gradient)
  * @tparam gradient_type The type of the gradient (should support addition, scalar multiplication/division, and unary
  * negation operators)
+ *
+ * @note the value is a `double`, unless the gradient is made of `simd<W>` numbers, in which case it is a `simd<W>`
  */
 template <typename gradient_type>
 struct dual {
-  double        value;     ///< the actual numerical value
+  using value_type = typename detail::dual_value<gradient_type>::type;  ///< the type of the value
+
+  value_type    value;     ///< the actual numerical value
   gradient_type gradient;  ///< the partial derivatives of value w.r.t. some other quantity
 
   /**
@@ -55,6 +95,10 @@ struct dual {
 template <typename T>
 dual(double, T) -> dual<T>;
 
+/// @overload
+template <int W, typename T>
+dual(simd<W>, T) -> dual<T>;
+
 /** @brief addition of a dual number and a non-dual number */
 template <typename gradient_type>
 SERAC_HOST_DEVICE constexpr auto operator+(dual<gradient_type> a, double b)
@@ -146,26 +190,83 @@ SERAC_HOST_DEVICE constexpr auto operator/(dual<gradient_type_a> a, dual<gradien
   return dual{a.value / b.value, (a.gradient / b.value) - (a.value * b.gradient) / (b.value * b.value)};
 }
 
+/** @brief addition of a dual number and a simd number */
+template <int W, typename gradient_type>
+SERAC_HOST_DEVICE constexpr auto operator+(const dual<gradient_type>& a, const simd<W>& b)
+{
+  return dual{a.value + b, a.gradient};
+}
+
+/** @brief addition of a simd number and a dual number */
+template <int W, typename gradient_type>
+SERAC_HOST_DEVICE constexpr auto operator+(const simd<W>& a, const dual<gradient_type>& b)
+{
+  return dual{a + b.value, b.gradient};
+}
+
+/** @brief subtraction of a simd number from a dual number */
+template <int W, typename gradient_type>
+SERAC_HOST_DEVICE constexpr auto operator-(const dual<gradient_type>& a, const simd<W>& b)
+{
+  return dual{a.value - b, a.gradient};
+}
+
+/** @brief subtraction of a dual number from a simd number */
+template <int W, typename gradient_type>
+SERAC_HOST_DEVICE constexpr auto operator-(const simd<W>& a, const dual<gradient_type>& b)
+{
+  return dual{a - b.value, -b.gradient};
+}
+
+/** @brief multiplication of a dual number and a simd number */
+template <int W, typename gradient_type>
+SERAC_HOST_DEVICE constexpr auto operator*(const dual<gradient_type>& a, const simd<W>& b)
+{
+  return dual{a.value * b, a.gradient * b};
+}
+
+/** @brief multiplication of a simd number and a dual number */
+template <int W, typename gradient_type>
+SERAC_HOST_DEVICE constexpr auto operator*(const simd<W>& a, const dual<gradient_type>& b)
+{
+  return dual{a * b.value, a * b.gradient};
+}
+
+/** @brief division of a dual number by a simd number */
+template <int W, typename gradient_type>
+SERAC_HOST_DEVICE constexpr auto operator/(const dual<gradient_type>& a, const simd<W>& b)
+{
+  return dual{a.value / b, a.gradient / b};
+}
+
+/** @brief division of a simd number by a dual number */
+template <int W, typename gradient_type>
+SERAC_HOST_DEVICE constexpr auto operator/(const simd<W>& a, const dual<gradient_type>& b)
+{
+  return dual{a / b.value, -(a / (b.value * b.value)) * b.gradient};
+}
+
 /**
  * @brief Generates const + non-const overloads for a binary comparison operator
- * Comparisons are conducted against the "value" part of the dual number
+ * Comparisons are conducted against the "value" part of the dual number, and return a `simd_mask`
+ * for dual numbers with `simd` values
  * @param[in] x The comparison operator to overload
  */
 #define binary_comparator_overload(x)                                             \
   template <typename T>                                                           \
-  SERAC_HOST_DEVICE constexpr bool operator x(const dual<T>& a, double b)         \
+  SERAC_HOST_DEVICE constexpr auto operator x(const dual<T>& a, double b)         \
   {                                                                               \
     return a.value x b;                                                           \
   }                                                                               \
                                                                                   \
   template <typename T>                                                           \
-  SERAC_HOST_DEVICE constexpr bool operator x(double a, const dual<T>& b)         \
+  SERAC_HOST_DEVICE constexpr auto operator x(double a, const dual<T>& b)         \
   {                                                                               \
     return a x b.value;                                                           \
   };                                                                              \
                                                                                   \
   template <typename T, typename U>                                               \
-  SERAC_HOST_DEVICE constexpr bool operator x(const dual<T>& a, const dual<U>& b) \
+  SERAC_HOST_DEVICE constexpr auto operator x(const dual<T>& a, const dual<U>& b) \
   {                                                                               \
     return a.value x b.value;                                                     \
   };
@@ -212,6 +313,24 @@ SERAC_HOST_DEVICE constexpr auto& operator-=(dual<gradient_type>& a, double b)
   return a;
 }
 
+/** @brief the branch-free equivalent of `condition ? a : b` for dual numbers */
+template <typename gradient_type>
+SERAC_HOST_DEVICE constexpr auto select(bool condition, const dual<gradient_type>& a, const dual<gradient_type>& b)
+{
+  return condition ? a : b;
+}
+
+/**
+ * @brief the branch-free equivalent of `condition ? a : b` for dual numbers with `simd` values,
+ * evaluated in each lane
+ */
+template <int W, typename gradient_type>
+SERAC_HOST_DEVICE constexpr auto select(const simd_mask<W>& condition, const dual<gradient_type>& a,
+                                        const dual<gradient_type>& b)
+{
+  return dual<gradient_type>{select(condition, a.value, b.value), select(condition, a.gradient, b.gradient)};
+}
+
 /**
  * @brief Implementation of absolute value function for dual numbers
  * @note This is not differentiable at x = 0.0. At that point, the gradient is calculated as the gradient of x.
@@ -219,7 +338,7 @@ SERAC_HOST_DEVICE constexpr auto& operator-=(dual<gradient_type>& a, double b)
 template <typename gradient_type>
 SERAC_HOST_DEVICE auto abs(dual<gradient_type> x)
 {
-  return (x.value >= 0) ? x : -x;
+  return select(x.value >= 0, x, -x);
 }
 
 /**
@@ -230,7 +349,7 @@ template <typename gradient_type>
 SERAC_HOST_DEVICE auto max(dual<gradient_type> a, double b)
 {
   dual<gradient_type> b_dual{b, 0.0 * a.gradient};
-  return (a > b_dual) ? a : b_dual;
+  return select(a > b_dual, a, b_dual);
 }
 
 /// @overload
@@ -238,14 +357,14 @@ template <typename gradient_type>
 SERAC_HOST_DEVICE auto max(double a, dual<gradient_type> b)
 {
   dual<gradient_type> a_dual{a, 0.0 * b.gradient};
-  return (a_dual > b) ? a_dual : b;
+  return select(a_dual > b, a_dual, b);
 }
 
 /// @overload
 template <typename gradient_type>
 SERAC_HOST_DEVICE auto max(dual<gradient_type> a, dual<gradient_type> b)
 {
-  return (a > b) ? a : b;
+  return select(a > b, a, b);
 }
 
 /**
@@ -256,7 +375,7 @@ template <typename gradient_type>
 SERAC_HOST_DEVICE auto min(dual<gradient_type> a, double b)
 {
   dual<gradient_type> b_dual{b, 0.0 * a.gradient};
-  return (a < b_dual) ? a : b_dual;
+  return select(a < b_dual, a, b_dual);
 }
 
 /// @overload
@@ -264,14 +383,14 @@ template <typename gradient_type>
 SERAC_HOST_DEVICE auto min(double a, dual<gradient_type> b)
 {
   dual<gradient_type> a_dual{a, 0.0 * b.gradient};
-  return (a_dual < b) ? a_dual : b;
+  return select(a_dual < b, a_dual, b);
 }
 
 /// @overload
 template <typename gradient_type>
 SERAC_HOST_DEVICE auto min(dual<gradient_type> a, dual<gradient_type> b)
 {
-  return (a < b) ? a : b;
+  return select(a < b, a, b);
 }
 
 /** @brief implementation of square root for dual numbers */
@@ -376,7 +495,7 @@ template <typename gradient_type>
 SERAC_HOST_DEVICE auto pow(dual<gradient_type> a, dual<gradient_type> b)
 {
   using std::pow, std::log;
-  double        value = pow(a.value, b.value);
+  auto          value = pow(a.value, b.value);
   gradient_type grad  = pow(a.value, b.value - 1) * (a.gradient * b.value + b.gradient * a.value * log(a.value));
   return dual<gradient_type>{value, grad};
 }
@@ -386,7 +505,7 @@ template <typename gradient_type>
 SERAC_HOST_DEVICE auto pow(double a, dual<gradient_type> b)
 {
   using std::pow, std::log;
-  double value = pow(a, b.value);
+  auto value = pow(a, b.value);
   return dual<gradient_type>{value, value * b.gradient * log(a)};
 }
 
@@ -395,7 +514,7 @@ template <typename gradient_type>
 SERAC_HOST_DEVICE auto pow(dual<gradient_type> a, double b)
 {
   using std::pow;
-  double        value = pow(a.value, b);
+  auto          value = pow(a.value, b);
   gradient_type grad  = b * pow(a.value, b - 1) * a.gradient;
   return dual<gradient_type>{value, grad};
 }
@@ -1,7 +1,10 @@
 #include "serac/numerics/functional/element_restriction.hpp"
 
+#include <numeric>
+
 #include "mfem.hpp"
 
+#include "serac/infrastructure/accelerator.hpp"
 #include "serac/numerics/functional/geometry.hpp"
 
 std::vector<std::vector<int> > lexicographic_permutations(int p)
@@ -401,6 +404,8 @@ ElementRestriction::ElementRestriction(const mfem::FiniteElementSpace* fes, mfem
   num_elements   = uint64_t(dof_info.shape()[0]);
   nodes_per_elem = uint64_t(dof_info.shape()[1]);
   esize          = num_elements * nodes_per_elem * components;
+
+  InitLookupTables();
 }
 
 ElementRestriction::ElementRestriction(const mfem::FiniteElementSpace* fes, mfem::Geometry::Type face_geom,
@@ -416,6 +421,8 @@ ElementRestriction::ElementRestriction(const mfem::FiniteElementSpace* fes, mfem
   num_elements   = uint64_t(dof_info.shape()[0]);
   nodes_per_elem = uint64_t(dof_info.shape()[1]);
   esize          = num_elements * nodes_per_elem * components;
+
+  InitLookupTables();
 }
 
 uint64_t ElementRestriction::ESize() const { return esize; }
@@ -442,27 +449,158 @@ void ElementRestriction::GetElementVDofs(int i, std::vector<DoF>& vdofs) const
 
 void ElementRestriction::Gather(const mfem::Vector& L_vector, mfem::Vector& E_vector) const
 {
-  for (uint64_t i = 0; i < num_elements; i++) {
-    for (uint64_t c = 0; c < components; c++) {
-      for (uint64_t j = 0; j < nodes_per_elem; j++) {
-        uint64_t E_id       = (i * components + c) * nodes_per_elem + j;
-        uint64_t L_id       = GetVDof(dof_info(i, j), c).index();
-        E_vector[int(E_id)] = L_vector[int(L_id)];
-      }
-    }
+  if (esize == 0) return;
+
+  const double* L = L_vector.HostRead();
+  double*       E = E_vector.HostWrite();
+  for (uint64_t E_id = 0; E_id < esize; E_id++) {
+    E[E_id] = L[E_to_L[E_id]];
   }
 }
 
-void ElementRestriction::ScatterAdd(const mfem::Vector& E_vector, mfem::Vector& L_vector) const
+void ElementRestriction::InitLookupTables()
 {
+  // E->L map:
+  //
+  // decode the DoF information once up front, so that Gather / ScatterAdd
+  // only have to do a single integer lookup for each entry of the E-vector
+  E_to_L.resize(esize);
   for (uint64_t i = 0; i < num_elements; i++) {
     for (uint64_t c = 0; c < components; c++) {
       for (uint64_t j = 0; j < nodes_per_elem; j++) {
         uint64_t E_id = (i * components + c) * nodes_per_elem + j;
-        uint64_t L_id = GetVDof(dof_info(i, j), c).index();
-        L_vector[int(L_id)] += E_vector[int(E_id)];
+        E_to_L[E_id]  = int(GetVDof(dof_info(i, j), c).index());
+      }
+    }
+  }
+
+  // element coloring:
+  //
+  // first, find which elements touch each node
+  std::vector<int> node_offsets(num_nodes + 1, 0);
+  for (uint64_t i = 0; i < num_elements; i++) {
+    for (uint64_t j = 0; j < nodes_per_elem; j++) {
+      node_offsets[dof_info(i, j).index() + 1]++;
+    }
+  }
+  std::partial_sum(node_offsets.begin(), node_offsets.end(), node_offsets.begin());
+
+  std::vector<int> node_elements(num_elements * nodes_per_elem);
+  std::vector<int> next(node_offsets.begin(), node_offsets.end() - 1);
+  for (uint64_t i = 0; i < num_elements; i++) {
+    for (uint64_t j = 0; j < nodes_per_elem; j++) {
+      node_elements[uint64_t(next[dof_info(i, j).index()]++)] = int(i);
+    }
+  }
+
+  // then, greedily assign each element the smallest color that
+  // isn't already used by an element that it shares a node with
+  //
+  // note: forbidden[c] == i means color `c` is unavailable to element `i`
+  std::vector<int> element_color(num_elements, -1);
+  std::vector<int> forbidden;
+  for (uint64_t i = 0; i < num_elements; i++) {
+    for (uint64_t j = 0; j < nodes_per_elem; j++) {
+      uint64_t n = dof_info(i, j).index();
+      for (int k = node_offsets[n]; k < node_offsets[n + 1]; k++) {
+        int c = element_color[uint64_t(node_elements[uint64_t(k)])];
+        if (c >= 0) {
+          forbidden[uint64_t(c)] = int(i);
+        }
       }
     }
+
+    uint64_t c = 0;
+    while (c < forbidden.size() && forbidden[c] == int(i)) {
+      c++;
+    }
+
+    if (c == forbidden.size()) {
+      forbidden.push_back(-1);
+    }
+
+    element_color[i] = int(c);
+  }
+
+  // finally, sort the elements by color
+  color_offsets.assign(forbidden.size() + 1, 0);
+  for (uint64_t i = 0; i < num_elements; i++) {
+    color_offsets[uint64_t(element_color[i]) + 1]++;
+  }
+  std::partial_sum(color_offsets.begin(), color_offsets.end(), color_offsets.begin());
+
+  colored_elements.resize(num_elements);
+  next.assign(color_offsets.begin(), color_offsets.end() - 1);
+  for (uint64_t i = 0; i < num_elements; i++) {
+    colored_elements[uint64_t(next[uint64_t(element_color[i])]++)] = int(i);
+  }
+
+  // L->E map:
+  //
+  // for each L-vector entry, list the E-vector entries that are added to it. The E-vector
+  // entries are visited in ascending order, which is the same order that the serial loop uses
+  std::vector<int> L_offsets(lsize + 1, 0);
+  for (uint64_t E_id = 0; E_id < esize; E_id++) {
+    L_offsets[uint64_t(E_to_L[E_id]) + 1]++;
+  }
+
+  // only keep the L-vector entries that actually receive contributions
+  scatter_L_ids.clear();
+  scatter_offsets.assign(1, 0);
+  for (uint64_t i = 0; i < lsize; i++) {
+    if (L_offsets[i + 1] > 0) {
+      scatter_L_ids.push_back(int(i));
+      scatter_offsets.push_back(scatter_offsets.back() + L_offsets[i + 1]);
+    }
+  }
+  std::partial_sum(L_offsets.begin(), L_offsets.end(), L_offsets.begin());
+
+  scatter_E_ids.resize(esize);
+  next.assign(L_offsets.begin(), L_offsets.end() - 1);
+  for (uint64_t E_id = 0; E_id < esize; E_id++) {
+    scatter_E_ids[uint64_t(next[uint64_t(E_to_L[E_id])]++)] = int(E_id);
+  }
+}
+
+void ElementRestriction::ScatterAdd(const mfem::Vector& E_vector, mfem::Vector& L_vector,
+                                    ScatterAddStrategy strategy) const
+{
+  if (esize == 0) return;
+
+  const double* E = E_vector.HostRead();
+  double*       L = L_vector.HostReadWrite();
+
+  if (strategy == ScatterAddStrategy::ElementColoring) {
+
+    // elements of the same color don't share any nodes, so
+    // they can't write to the same entries of the L-vector
+    for (uint64_t color = 0; color + 1 < color_offsets.size(); color++) {
+      const int* elements = &colored_elements[uint64_t(color_offsets[color])];
+      uint32_t   n        = uint32_t(color_offsets[color + 1] - color_offsets[color]);
+      accelerator::forall<ExecutionSpace::OpenMP>(n, [&](uint32_t k) {
+        uint64_t offset = uint64_t(elements[k]) * components * nodes_per_elem;
+        for (uint64_t E_id = offset; E_id < offset + components * nodes_per_elem; E_id++) {
+          L[E_to_L[E_id]] += E[E_id];
+        }
+      });
+    }
+    return;
+  }
+
+  if (strategy == ScatterAddStrategy::LDofReduction) {
+    // each L-vector entry sums its own contributions, so there are no conflicting writes
+    accelerator::forall<ExecutionSpace::OpenMP>(uint32_t(scatter_L_ids.size()), [&](uint32_t k) {
+      double total = L[scatter_L_ids[k]];
+      for (int m = scatter_offsets[k]; m < scatter_offsets[k + 1]; m++) {
+        total += E[scatter_E_ids[uint64_t(m)]];
+      }
+      L[scatter_L_ids[k]] = total;
+    });
+    return;
+  }
+
+  for (uint64_t E_id = 0; E_id < esize; E_id++) {
+    L[E_to_L[E_id]] += E[E_id];
   }
 }
 
@@ -523,15 +661,16 @@ mfem::Array<int> BlockElementRestriction::bOffsets() const
 
 void BlockElementRestriction::Gather(const mfem::Vector& L_vector, mfem::BlockVector& E_block_vector) const
 {
-  for (auto [geom, restriction] : restrictions) {
+  for (const auto& [geom, restriction] : restrictions) {
     restriction.Gather(L_vector, E_block_vector.GetBlock(geom));
   }
 }
 
-void BlockElementRestriction::ScatterAdd(const mfem::BlockVector& E_block_vector, mfem::Vector& L_vector) const
+void BlockElementRestriction::ScatterAdd(const mfem::BlockVector& E_block_vector, mfem::Vector& L_vector,
+                                         ScatterAddStrategy strategy) const
 {
-  for (auto [geom, restriction] : restrictions) {
-    restriction.ScatterAdd(E_block_vector.GetBlock(geom), L_vector);
+  for (const auto& [geom, restriction] : restrictions) {
+    restriction.ScatterAdd(E_block_vector.GetBlock(geom), L_vector, strategy);
   }
 }
 
@@ -141,6 +141,14 @@ struct Array2D {
 
 namespace serac {
 
+/// the different algorithms available for the "E->L" (scatter-add) operation
+enum class ScatterAddStrategy
+{
+  Serial,           ///< loop over each element on a single thread
+  ElementColoring,  ///< concurrently process groups of elements that share no nodes, one color at a time
+  LDofReduction     ///< each L-dof concurrently sums its contributions, in the same order as `Serial`
+};
+
 /// a more complete version of mfem::ElementRestriction that works with {H1, Hcurl, L2} spaces (including on the
 /// boundary)
 struct ElementRestriction {
@@ -173,8 +181,20 @@ struct ElementRestriction {
   /// "L->E" in mfem parlance, each element gathers the values that belong to it, and stores them in the "E-vector"
   void Gather(const mfem::Vector& L_vector, mfem::Vector& E_vector) const;
 
-  /// "E->L" in mfem parlance, each element scatter-adds its local vector into the appropriate place in the "L-vector"
-  void ScatterAdd(const mfem::Vector& E_vector, mfem::Vector& L_vector) const;
+  /**
+   * @brief "E->L" in mfem parlance, each element scatter-adds its local vector into the appropriate place in the
+   * "L-vector"
+   *
+   * @param E_vector the values associated with each element
+   * @param L_vector the values associated with each dof, to be incremented by the element contributions
+   * @param strategy which algorithm to use. The multithreaded strategies are race-free, and `LDofReduction`
+   * produces results that are bitwise identical to `Serial`, regardless of the number of threads.
+   */
+  void ScatterAdd(const mfem::Vector& E_vector, mfem::Vector& L_vector,
+                  ScatterAddStrategy strategy = ScatterAddStrategy::Serial) const;
+
+  /// build the E->L map used by Gather / ScatterAdd, and the tables used by the multithreaded ScatterAdd strategies
+  void InitLookupTables();
 
   /// the size of the "E-vector"
   uint64_t esize;
@@ -199,6 +219,32 @@ struct ElementRestriction {
 
   /// whether the underlying dofs are arranged "byNodes" or "byVDim"
   mfem::Ordering::Type ordering;
+
+  /// the L-vector id for each entry of the E-vector, i.e. E_vector[i] corresponds to L_vector[E_to_L[i]]
+  std::vector<int> E_to_L;
+
+  /**
+   * @brief the elements of color `c` are
+   * colored_elements[color_offsets[c]], ..., colored_elements[color_offsets[c+1]-1]
+   *
+   * note: elements with the same color do not share any nodes
+   */
+  std::vector<int> color_offsets;
+
+  /// the element ids, sorted by color
+  std::vector<int> colored_elements;
+
+  /// the L-vector ids that receive at least one contribution from the E-vector
+  std::vector<int> scatter_L_ids;
+
+  /**
+   * @brief the E-vector ids that contribute to L-vector id scatter_L_ids[i] are
+   * scatter_E_ids[scatter_offsets[i]], ..., scatter_E_ids[scatter_offsets[i+1]-1], in ascending order
+   */
+  std::vector<int> scatter_offsets;
+
+  /// the E-vector ids that contribute to each entry of `scatter_L_ids`, see `scatter_offsets`
+  std::vector<int> scatter_E_ids;
 };
 
 /**
@@ -229,7 +275,8 @@ struct BlockElementRestriction {
   void Gather(const mfem::Vector& L_vector, mfem::BlockVector& E_block_vector) const;
 
   /// "E->L" in mfem parlance, each element scatter-adds its local vector into the appropriate place in the "L-vector"
-  void ScatterAdd(const mfem::BlockVector& E_block_vector, mfem::Vector& L_vector) const;
+  void ScatterAdd(const mfem::BlockVector& E_block_vector, mfem::Vector& L_vector,
+                  ScatterAddStrategy strategy = ScatterAddStrategy::Serial) const;
 
   /// the individual ElementRestriction operators for each element geometry
   std::map<mfem::Geometry::Type, ElementRestriction> restrictions;
@@ -321,6 +321,82 @@ SERAC_HOST_DEVICE void physical_to_parent(tensor<T, q>& qf_output, const tensor<
   }
 }
 
+/**
+ * @brief gather the q-function derivatives that couple component `j` of the trial function
+ * to component `i` of the test function, at a single quadrature point:
+ *
+ *   M(0, 0)         := d(source_i) / d(value_j)
+ *   M(0, 1 + l)     := d(source_i) / d(gradient_jl)
+ *   M(1 + k, 0)     := d(flux_ik)  / d(value_j)
+ *   M(1 + k, 1 + l) := d(flux_ik)  / d(gradient_jl)
+ *
+ * @tparam test_components the number of components in the test space
+ * @tparam trial_components the number of components in the trial space
+ * @tparam dim the number of parent element coordinates
+ * @tparam derivative_type the type of the q-function derivatives, {{dsource/dvalue, dsource/dgradient},
+ * {dflux/dvalue, dflux/dgradient}}, where any of the entries may be `zero`
+ * @param derivatives the q-function derivatives at a quadrature point
+ * @param i which component of the test space
+ * @param j which component of the trial space
+ */
+template <int test_components, int trial_components, int dim, typename derivative_type>
+SERAC_HOST_DEVICE tensor<double, dim + 1, dim + 1> derivative_block(const derivative_type& derivatives, int i, int j)
+{
+  constexpr int ci = test_components;
+  constexpr int cj = trial_components;
+
+  const auto& d00 = get<0>(get<0>(derivatives));
+  const auto& d01 = get<1>(get<0>(derivatives));
+  const auto& d10 = get<0>(get<1>(derivatives));
+  const auto& d11 = get<1>(get<1>(derivatives));
+
+  // note: each derivative is either `zero` or a tensor with the dimensions listed above,
+  // so the entries are accessed through their flattened (row-major) index
+  tensor<double, dim + 1, dim + 1> M{};
+  if constexpr (!is_zero<std::decay_t<decltype(d00)>>{}) {
+    static_assert(sizeof(d00) == sizeof(double) * ci * cj);
+    M(0, 0) = reinterpret_cast<const double*>(&d00)[i * cj + j];
+  }
+  for (int k = 0; k < dim; k++) {
+    if constexpr (!is_zero<std::decay_t<decltype(d01)>>{}) {
+      static_assert(sizeof(d01) == sizeof(double) * ci * cj * dim);
+      M(0, 1 + k) = reinterpret_cast<const double*>(&d01)[(i * cj + j) * dim + k];
+    }
+    if constexpr (!is_zero<std::decay_t<decltype(d10)>>{}) {
+      static_assert(sizeof(d10) == sizeof(double) * ci * dim * cj);
+      M(1 + k, 0) = reinterpret_cast<const double*>(&d10)[(i * dim + k) * cj + j];
+    }
+    if constexpr (!is_zero<std::decay_t<decltype(d11)>>{}) {
+      static_assert(sizeof(d11) == sizeof(double) * ci * dim * cj * dim);
+      for (int l = 0; l < dim; l++) {
+        M(1 + k, 1 + l) = reinterpret_cast<const double*>(&d11)[((i * dim + k) * cj + j) * dim + l];
+      }
+    }
+  }
+  return M;
+}
+
+/**
+ * @brief indicates which blocks of the q-function derivatives are not `zero`, i.e.
+ * whether M(s, t) from derivative_block() can be nonzero for s, t == 0 (value) or s, t > 0 (gradient)
+ *
+ * @tparam derivative_type the type of the q-function derivatives
+ * @param s 0 for the source term, 1 for the flux term
+ * @param t 0 for the value of the trial function, 1 for its gradient
+ */
+template <typename derivative_type>
+SERAC_HOST_DEVICE constexpr bool is_nonzero_block(int s, int t)
+{
+  using d00_type = std::decay_t<decltype(get<0>(get<0>(derivative_type{})))>;
+  using d01_type = std::decay_t<decltype(get<1>(get<0>(derivative_type{})))>;
+  using d10_type = std::decay_t<decltype(get<0>(get<1>(derivative_type{})))>;
+  using d11_type = std::decay_t<decltype(get<1>(get<1>(derivative_type{})))>;
+  if (s == 0 && t == 0) return !is_zero<d00_type>{};
+  if (s == 0 && t == 1) return !is_zero<d01_type>{};
+  if (s == 1 && t == 0) return !is_zero<d10_type>{};
+  return !is_zero<d11_type>{};
+}
+
 /**
  * @brief Template prototype for finite element implementations
  * @tparam g The geometry of the element
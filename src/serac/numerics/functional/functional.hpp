@@ -27,7 +27,10 @@
 
 #include "serac/numerics/functional/domain.hpp"
 
+#include <algorithm>
 #include <array>
+#include <map>
+#include <memory>
 #include <vector>
 
 namespace serac {
@@ -59,6 +62,28 @@ constexpr uint32_t index_of_differentiation()
   return NO_DIFFERENTIATION;
 }
 
+/**
+ * @brief given a list of types, this function returns the index of the second `differentiate_wrt_this`
+ *
+ * @tparam T a list of types, containing at most 2 `differentiate_wrt_this`
+ */
+template <typename... T>
+constexpr uint32_t index_of_second_differentiation()
+{
+  constexpr uint32_t n          = sizeof...(T);
+  bool               matching[] = {std::is_same_v<T, differentiate_wrt_this>...};
+  bool               found      = false;
+  for (uint32_t i = 0; i < n; i++) {
+    if (matching[i]) {
+      if (found) {
+        return i;
+      }
+      found = true;
+    }
+  }
+  return NO_DIFFERENTIATION;
+}
+
 /**
  * @brief Compile-time alias for index of differentiation
  */
@@ -163,7 +188,8 @@ class Functional;
  *
  * @tparam test The space of test functions to use
  * @tparam trial The space of trial functions to use
- * @tparam exec whether to carry out calculations on CPU or GPU
+ * @tparam exec whether to carry out calculations on CPU or GPU. ExecutionSpace::OpenMP runs the element loops of each
+ * integral on multiple threads of the host, e.g. for hybrid MPI + threads runs
  *
  * To use this class, you use the methods @p Functional::Add****Integral(integrand,domain_of_integration)
  * where @p integrand is a q-function lambda or functor and @p domain_of_integration is an @p mfem::mesh
@@ -197,6 +223,10 @@ class Functional<test(trials...), exec> {
   static constexpr mfem::Geometry::Type simplex_geom[4] = {mfem::Geometry::INVALID, mfem::Geometry::SEGMENT,
                                                            mfem::Geometry::TRIANGLE, mfem::Geometry::TETRAHEDRON};
 
+  /// @brief how element contributions are summed into the L-vector, only threaded for the OpenMP backend
+  static constexpr ScatterAddStrategy scatter_add_strategy =
+      (exec == ExecutionSpace::OpenMP) ? ScatterAddStrategy::LDofReduction : ScatterAddStrategy::Serial;
+
   class Gradient;
 
   // clang-format off
@@ -286,6 +316,18 @@ public:
   template <int dim, int... args, typename Integrand, typename qpt_data_type = Nothing>
   void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, const Integrand& integrand, mfem::Mesh& domain,
                          std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  {
+    AddDomainIntegral(Dimension<dim>{}, DependsOn<args...>{}, NoCombinedDerivative{}, integrand, domain, qdata);
+  }
+
+  /**
+   * @overload
+   * @note the CombinedDerivative tag requests kernels for the weighted sum of the derivatives
+   * w.r.t. trial spaces i and j, both of which must appear in @p DependsOn
+   */
+  template <int dim, int... args, uint32_t i, uint32_t j, typename Integrand, typename qpt_data_type = Nothing>
+  void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, CombinedDerivative<i, j>, const Integrand& integrand,
+                         mfem::Mesh& domain, std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
   {
     if (domain.GetNE() == 0) return;
 
@@ -295,14 +337,23 @@ public:
     check_for_missing_nodal_gridfunc(domain);
 
     using signature = test(decltype(serac::type<args>(trial_spaces))...);
-    integrals_.push_back(
-        MakeDomainIntegral<signature, Q, dim>(EntireDomain(domain), integrand, qdata, std::vector<uint32_t>{args...}));
+    integrals_.push_back(MakeDomainIntegral<signature, Q, dim, exec>(
+        EntireDomain(domain), integrand, qdata, std::vector<uint32_t>{args...},
+        integral_combined_derivative(DependsOn<args...>{}, CombinedDerivative<i, j>{})));
   }
 
   /// @overload
   template <int dim, int... args, typename lambda, typename qpt_data_type = Nothing>
   void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand, Domain& domain,
                          std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  {
+    AddDomainIntegral(Dimension<dim>{}, DependsOn<args...>{}, NoCombinedDerivative{}, integrand, domain, qdata);
+  }
+
+  /// @overload
+  template <int dim, int... args, uint32_t i, uint32_t j, typename lambda, typename qpt_data_type = Nothing>
+  void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, CombinedDerivative<i, j>, const lambda& integrand,
+                         Domain& domain, std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
   {
     if (domain.mesh_.GetNE() == 0) return;
 
@@ -312,8 +363,9 @@ public:
     check_for_missing_nodal_gridfunc(domain.mesh_);
 
     using signature = test(decltype(serac::type<args>(trial_spaces))...);
-    integrals_.push_back(
-        MakeDomainIntegral<signature, Q, dim>(domain, integrand, qdata, std::vector<uint32_t>{args...}));
+    integrals_.push_back(MakeDomainIntegral<signature, Q, dim, exec>(
+        domain, integrand, qdata, std::vector<uint32_t>{args...},
+        integral_combined_derivative(DependsOn<args...>{}, CombinedDerivative<i, j>{})));
   }
 
   /**
@@ -327,6 +379,18 @@ public:
    */
   template <int dim, int... args, typename Integrand>
   void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, const Integrand& integrand, mfem::Mesh& domain)
+  {
+    AddBoundaryIntegral(Dimension<dim>{}, DependsOn<args...>{}, NoCombinedDerivative{}, integrand, domain);
+  }
+
+  /**
+   * @overload
+   * @note the CombinedDerivative tag requests kernels for the weighted sum of the derivatives
+   * w.r.t. trial spaces i and j, both of which must appear in @p DependsOn
+   */
+  template <int dim, int... args, uint32_t i, uint32_t j, typename Integrand>
+  void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, CombinedDerivative<i, j>, const Integrand& integrand,
+                           mfem::Mesh& domain)
   {
     auto num_bdr_elements = domain.GetNBE();
     if (num_bdr_elements == 0) return;
@@ -334,13 +398,22 @@ public:
     check_for_missing_nodal_gridfunc(domain);
 
     using signature = test(decltype(serac::type<args>(trial_spaces))...);
-    integrals_.push_back(
-        MakeBoundaryIntegral<signature, Q, dim>(EntireBoundary(domain), integrand, std::vector<uint32_t>{args...}));
+    integrals_.push_back(MakeBoundaryIntegral<signature, Q, dim, exec>(
+        EntireBoundary(domain), integrand, std::vector<uint32_t>{args...},
+        integral_combined_derivative(DependsOn<args...>{}, CombinedDerivative<i, j>{})));
   }
 
   /// @overload
   template <int dim, int... args, typename lambda>
   void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand, const Domain& domain)
+  {
+    AddBoundaryIntegral(Dimension<dim>{}, DependsOn<args...>{}, NoCombinedDerivative{}, integrand, domain);
+  }
+
+  /// @overload
+  template <int dim, int... args, uint32_t i, uint32_t j, typename lambda>
+  void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, CombinedDerivative<i, j>, const lambda& integrand,
+                           const Domain& domain)
   {
     auto num_bdr_elements = domain.mesh_.GetNBE();
     if (num_bdr_elements == 0) return;
@@ -350,7 +423,9 @@ public:
     check_for_missing_nodal_gridfunc(domain.mesh_);
 
     using signature = test(decltype(serac::type<args>(trial_spaces))...);
-    integrals_.push_back(MakeBoundaryIntegral<signature, Q, dim>(domain, integrand, std::vector<uint32_t>{args...}));
+    integrals_.push_back(MakeBoundaryIntegral<signature, Q, dim, exec>(
+        domain, integrand, std::vector<uint32_t>{args...},
+        integral_combined_derivative(DependsOn<args...>{}, CombinedDerivative<i, j>{})));
   }
 
   /**
@@ -398,12 +473,15 @@ public:
    * @param input_T the T-vector to apply the action of gradient to
    * @param output_T the T-vector where the resulting values are stored
    * @param which describes which trial space input_T corresponds to
+   * @param derivative which derivative to apply: either `which`, or a combined derivative index
+   *        (see combined_derivative_index()) whose first trial space is `which`
    *
    * @note: it accepts exactly `num_trial_spaces` arguments of type mfem::Vector. Additionally, one of those
    * arguments may be a dual_vector, to indicate that Functional::operator() should not only evaluate the
    * element calculations, but also differentiate them w.r.t. the specified dual_vector argument
    */
-  void ActionOfGradient(const mfem::Vector& input_T, mfem::Vector& output_T, uint32_t which) const
+  void ActionOfGradient(const mfem::Vector& input_T, mfem::Vector& output_T, uint32_t which,
+                        uint32_t derivative) const
   {
     P_trial_[which]->Mult(input_T, input_L_[which]);
 
@@ -421,30 +499,231 @@ public:
         already_computed[type] = true;
       }
 
-      integral.GradientMult(input_E_[type][which], output_E_[type], which);
+      integral.GradientMult(input_E_[type][which], output_E_[type], derivative);
 
       // scatter-add to compute residuals on the local processor
-      G_test_[type].ScatterAdd(output_E_[type], output_L_);
+      G_test_[type].ScatterAdd(output_E_[type], output_L_, scatter_add_strategy);
     }
 
     // scatter-add to compute global residuals
     P_test_->MultTranspose(output_L_, output_T);
   }
 
+  /**
+   * @brief this function computes the directional derivatives of `serac::Functional::operator()` in several
+   * directions at once
+   *
+   * The element calculations for all of the directions are done in a single pass over the elements, so that the
+   * q-function derivatives of each element are only loaded from memory once, rather than once per direction.
+   *
+   * @param input_T the T-vectors to apply the action of gradient to, one per column
+   * @param output_T the T-vectors where the resulting values are stored, one per column
+   * @param which describes which trial space input_T corresponds to
+   * @param derivative which derivative to apply: either `which`, or a combined derivative index
+   *        (see combined_derivative_index()) whose first trial space is `which`
+   */
+  void ActionOfGradient(const mfem::DenseMatrix& input_T, mfem::DenseMatrix& output_T, uint32_t which,
+                        uint32_t derivative) const
+  {
+    SLIC_ERROR_ROOT_IF(input_T.Height() != trial_space_[which]->GetTrueVSize(),
+                       axom::fmt::format("The directions have {} rows, but trial space {} has {} true dofs",
+                                         input_T.Height(), which, trial_space_[which]->GetTrueVSize()));
+
+    int num_vectors = input_T.Width();
+    int input_size  = input_L_[which].Size();
+
+    // the L-vectors of all directions, stored one after another
+    batch_input_L_.SetSize(input_size * num_vectors);
+    batch_output_L_.SetSize(output_L_.Size() * num_vectors);
+    batch_output_L_ = 0.0;
+    for (int k = 0; k < num_vectors; k++) {
+      // mfem::Vector has no const views, but the column is only read from
+      mfem::Vector column(const_cast<double*>(input_T.GetColumn(k)), input_T.Height());
+      mfem::Vector input_L(batch_input_L_, k * input_size, input_size);
+      P_trial_[which]->Mult(column, input_L);
+    }
+
+    // this is used to mark when gather operations have been performed,
+    // to avoid doing them more than once per trial space
+    bool already_computed[Domain::num_types]{};  // default initializes to `false`
+
+    for (auto& integral : integrals_) {
+      auto type           = integral.domain_.type_;
+      auto input_offsets  = G_trial_[type][which].bOffsets();
+      auto output_offsets = G_test_[type].bOffsets();
+      int  input_E_size   = input_offsets.Last();
+      int  output_E_size  = output_offsets.Last();
+
+      if (!already_computed[type]) {
+        batch_input_E_[type].SetSize(input_E_size * num_vectors);
+        for (int k = 0; k < num_vectors; k++) {
+          mfem::Vector      input_L(batch_input_L_, k * input_size, input_size);
+          mfem::BlockVector input_E(batch_input_E_[type].GetData() + k * input_E_size, input_offsets);
+          G_trial_[type][which].Gather(input_L, input_E);
+        }
+        already_computed[type] = true;
+      }
+
+      batch_output_E_[type].SetSize(output_E_size * num_vectors);
+      integral.GradientMult(batch_input_E_[type], batch_output_E_[type], input_offsets, output_offsets,
+                            uint32_t(num_vectors), derivative);
+
+      // scatter-add to compute residuals on the local processor
+      for (int k = 0; k < num_vectors; k++) {
+        mfem::BlockVector output_E(batch_output_E_[type].GetData() + k * output_E_size, output_offsets);
+        mfem::Vector      output_L(batch_output_L_, k * output_L_.Size(), output_L_.Size());
+        G_test_[type].ScatterAdd(output_E, output_L, scatter_add_strategy);
+      }
+    }
+
+    // scatter-add to compute global residuals
+    output_T.SetSize(test_space_->GetTrueVSize(), num_vectors);
+    for (int k = 0; k < num_vectors; k++) {
+      mfem::Vector output_L(batch_output_L_, k * output_L_.Size(), output_L_.Size());
+      mfem::Vector column(output_T.GetColumn(k), output_T.Height());
+      P_test_->MultTranspose(output_L, column);
+    }
+  }
+
   /**
    * @brief this function lets the user evaluate the serac::Functional with the given trial space values
    *
    * note: it accepts exactly `num_trial_spaces` arguments of type mfem::Vector. Additionally, one of those
    * arguments may be a dual_vector, to indicate that Functional::operator() should not only evaluate the
-   * element calculations, but also differentiate them w.r.t. the specified dual_vector argument
+   * element calculations, but also differentiate them w.r.t. the specified dual_vector argument.
+   *
+   * If two arguments are dual_vectors (of the same trial space, and the integrals were added with the matching
+   * `CombinedDerivative` tag), the returned gradient is the weighted sum of the derivatives w.r.t. both of them,
+   * with the weights given to `differentiate_wrt(value, weight)`.
    *
    * @tparam T the types of the arguments passed in
    * @param t the time
    * @param args the trial space dofs used to carry out the calculation,
-   *  at most one of which may be of the type `differentiate_wrt_this(mfem::Vector)`
+   *  at most two of which may be of the type `differentiate_wrt_this(mfem::Vector)`
    */
   template <uint32_t wrt, typename... T>
   typename operator_paren_return<wrt>::type operator()(DifferentiateWRT<wrt>, double t, const T&... args)
+  {
+    return evaluate<wrt>({1.0, 1.0}, t, args...);
+  }
+
+  /// @overload
+  template <typename... T>
+  auto operator()(double t, const T&... args)
+  {
+    constexpr int num_differentiated_arguments = (std::is_same_v<T, differentiate_wrt_this> + ...);
+    static_assert(num_differentiated_arguments <= 2,
+                  "Error: Functional::operator() can only differentiate w.r.t. 1 argument a time "
+                  "(or 2 arguments, whose derivatives are combined)");
+    static_assert(sizeof...(T) == num_trial_spaces,
+                  "Error: Functional::operator() must take exactly as many arguments as trial spaces");
+
+    [[maybe_unused]] constexpr uint32_t i = index_of_differentiation<T...>();
+
+    if constexpr (num_differentiated_arguments == 2) {
+      constexpr uint32_t j = index_of_second_differentiation<T...>();
+      static_assert(std::is_same_v<decltype(type<i>(trial_spaces)), decltype(type<j>(trial_spaces))>,
+                    "Error: combined derivatives require both arguments to have the same trial space");
+
+      const double weights[] = {differentiation_weight(args)...};
+      return evaluate<combined_derivative_index(i, j)>({weights[i], weights[j]}, t, args...);
+    } else {
+      return evaluate<i>({1.0, 1.0}, t, args...);
+    }
+  }
+
+  /**
+   * @brief A flag to update the quadrature data for this operator following the computation
+   *
+   * Typically this is set to false during nonlinear solution iterations and is set to true for the
+   * final pass once equilibrium is found.
+   *
+   * @param update_flag A flag to update the related quadrature data
+   */
+  void updateQdata(bool update_flag) { update_qdata_ = update_flag; }
+
+  /**
+   * @brief Recalculate the geometric factors of each integral after the nodes of the mesh have moved
+   *
+   * This is much cheaper than constructing a new Functional, since the existing kernels and allocations are reused.
+   *
+   * @note The connectivity of the mesh must not have changed since the integrals were added
+   */
+  void updateMeshNodes()
+  {
+    for (auto& integral : integrals_) {
+      integral.updateGeometry();
+    }
+  }
+
+  /**
+   * @brief the memory currently used by the integrals to store q-function derivatives, see DerivativeStorage
+   *
+   * @return the number of bytes allocated on this rank
+   */
+  std::size_t storedDerivativeBytes() const
+  {
+    std::size_t bytes = 0;
+    for (auto& integral : integrals_) {
+      bytes += integral.storedDerivativeBytes();
+    }
+    return bytes;
+  }
+
+private:
+  /**
+   * @brief translate a CombinedDerivative tag from the trial space indices of this Functional
+   * to the argument indices of an integral that depends on the trial spaces `args...`
+   */
+  template <int... args, uint32_t i, uint32_t j>
+  static constexpr auto integral_combined_derivative(DependsOn<args...>, CombinedDerivative<i, j>)
+  {
+    if constexpr (i == NO_DIFFERENTIATION) {
+      return NoCombinedDerivative{};
+    } else {
+      static_assert(i < j, "Error: CombinedDerivative<i, j> requires i < j");
+      static_assert(std::is_same_v<decltype(type<i>(trial_spaces)), decltype(type<j>(trial_spaces))>,
+                    "Error: combined derivatives require both arguments to have the same trial space");
+
+      constexpr uint32_t local_i = index_in<args...>(i);
+      constexpr uint32_t local_j = index_in<args...>(j);
+      static_assert(local_i != NO_DIFFERENTIATION && local_j != NO_DIFFERENTIATION,
+                    "Error: integrals with CombinedDerivative<i, j> must depend on both trial spaces i and j");
+
+      return CombinedDerivative<local_i, local_j>{};
+    }
+  }
+
+  /// @brief the position of `value` in the list `args...` (or NO_DIFFERENTIATION, if it doesn't appear)
+  template <int... args>
+  static constexpr uint32_t index_in(uint32_t value)
+  {
+    constexpr int list[] = {args..., -1};
+    for (uint32_t k = 0; k < sizeof...(args); k++) {
+      if (uint32_t(list[k]) == value) {
+        return k;
+      }
+    }
+    return NO_DIFFERENTIATION;
+  }
+
+  /// @brief the weight of a differentiated argument (unused for the others)
+  static double differentiation_weight(const mfem::Vector&) { return 1.0; }
+
+  /// @overload
+  static double differentiation_weight(const differentiate_wrt_this& arg) { return arg.weight; }
+
+  /**
+   * @brief implementation of operator(), evaluating the Functional and (optionally) its derivative
+   *
+   * @tparam wrt which derivative to compute: NO_DIFFERENTIATION, the index of a trial space,
+   *   or a combined derivative index (see combined_derivative_index())
+   * @param weights the coefficients of the two derivatives that make up a combined derivative
+   * @param t the time
+   * @param args the trial space dofs used to carry out the calculation
+   */
+  template <uint32_t wrt, typename... T>
+  typename operator_paren_return<wrt>::type evaluate(std::array<double, 2> weights, double t, const T&... args)
   {
     const mfem::Vector* input_T[] = {&static_cast<const mfem::Vector&>(args)...};
 
@@ -469,10 +748,21 @@ public:
         }
       }
 
-      integral.Mult(t, input_E_[type], output_E_[type], wrt, update_qdata_);
+      if constexpr (is_combined_derivative_index(wrt)) {
+        constexpr uint32_t i = first_combined_argument(wrt);
+        constexpr uint32_t j = second_combined_argument(wrt);
+        SLIC_ERROR_ROOT_IF(integral.functional_to_integral_index_.count(wrt) == 0 &&
+                               (integral.functional_to_integral_index_.count(i) > 0 ||
+                                integral.functional_to_integral_index_.count(j) > 0),
+                           axom::fmt::format("integrals that depend on arguments {} or {} must be added with "
+                                             "CombinedDerivative<{}, {}> to evaluate their combined derivative",
+                                             i, j, i, j));
+      }
+
+      integral.Mult(t, input_E_[type], output_E_[type], wrt, update_qdata_, weights);
 
       // scatter-add to compute residuals on the local processor
-      G_test_[type].ScatterAdd(output_E_[type], output_L_);
+      G_test_[type].ScatterAdd(output_E_[type], output_L_, scatter_add_strategy);
     }
 
     // scatter-add to compute global residuals
@@ -485,7 +775,13 @@ public:
       // mfem::Vector arg0 = ...;
       // mfem::Vector arg1 = ...;
       // e.g. auto [value, gradient_wrt_arg1] = my_functional(arg0, differentiate_wrt(arg1));
-      return {output_T_, grad_[wrt]};
+      if constexpr (is_combined_derivative_index(wrt)) {
+        // the combined derivative acts on the (shared) trial space of its first argument
+        auto it = combined_grad_.try_emplace(wrt, *this, first_combined_argument(wrt), wrt).first;
+        return {output_T_, it->second};
+      } else {
+        return {output_T_, grad_[wrt]};
+      }
     }
     if constexpr (wrt == NO_DIFFERENTIATION) {
       // if the user passes only `mfem::Vector`s then we assume they only want the output value
@@ -497,32 +793,6 @@ public:
     }
   }
 
-  /// @overload
-  template <typename... T>
-  auto operator()(double t, const T&... args)
-  {
-    constexpr int num_differentiated_arguments = (std::is_same_v<T, differentiate_wrt_this> + ...);
-    static_assert(num_differentiated_arguments <= 1,
-                  "Error: Functional::operator() can only differentiate w.r.t. 1 argument a time");
-    static_assert(sizeof...(T) == num_trial_spaces,
-                  "Error: Functional::operator() must take exactly as many arguments as trial spaces");
-
-    [[maybe_unused]] constexpr uint32_t i = index_of_differentiation<T...>();
-
-    return (*this)(DifferentiateWRT<i>{}, t, args...);
-  }
-
-  /**
-   * @brief A flag to update the quadrature data for this operator following the computation
-   *
-   * Typically this is set to false during nonlinear solution iterations and is set to true for the
-   * final pass once equilibrium is found.
-   *
-   * @param update_flag A flag to update the related quadrature data
-   */
-  void updateQdata(bool update_flag) { update_qdata_ = update_flag; }
-
-private:
   /// @brief flag for denoting when a residual evaluation should update the material state buffers
   bool update_qdata_;
 
@@ -536,11 +806,15 @@ private:
     /**
      * @brief Constructs a Gradient wrapper that references a parent @p Functional
      * @param[in] f The @p Functional to use for gradient calculations
+     * @param[in] which The trial space this gradient acts on
+     * @param[in] derivative Which derivative this gradient represents: NO_DIFFERENTIATION (meaning the
+     * derivative w.r.t. trial space @p which), or a combined derivative index whose first trial space is @p which
      */
-    Gradient(Functional<test(trials...), exec>& f, uint32_t which = 0)
+    Gradient(Functional<test(trials...), exec>& f, uint32_t which = 0, uint32_t derivative = NO_DIFFERENTIATION)
         : mfem::Operator(f.test_space_->GetTrueVSize(), f.trial_space_[which]->GetTrueVSize()),
           form_(f),
           which_argument(which),
+          which_derivative((derivative == NO_DIFFERENTIATION) ? which : derivative),
           test_space_(f.test_space_),
           trial_space_(f.trial_space_[which]),
           df_(f.test_space_->GetTrueVSize())
@@ -555,16 +829,55 @@ private:
      */
     virtual void Mult(const mfem::Vector& dx, mfem::Vector& df) const override
     {
-      form_.ActionOfGradient(dx, df, which_argument);
+      form_.ActionOfGradient(dx, df, which_argument, which_derivative);
+    }
+
+    /**
+     * @brief implement the action of the gradient on several perturbations at once: df := df_dx * dx, column by column
+     *
+     * This gives the same result as calling Mult() on each column, but processes all of them in a single pass over
+     * the elements, which is considerably faster when applying the same gradient to many vectors.
+     *
+     * @param[in] dx the small perturbations in the trial space, one per column
+     * @param[out] df the resulting small perturbations in the residuals, one per column
+     */
+    void Mult(const mfem::DenseMatrix& dx, mfem::DenseMatrix& df) const
+    {
+      form_.ActionOfGradient(dx, df, which_argument, which_derivative);
     }
 
     /// @brief syntactic sugar:  df_dx.Mult(dx, df)  <=>  mfem::Vector df = df_dx(dx);
     mfem::Vector& operator()(const mfem::Vector& dx)
     {
-      form_.ActionOfGradient(dx, df_, which_argument);
+      form_.ActionOfGradient(dx, df_, which_argument, which_derivative);
       return df_;
     }
 
+    /**
+     * @brief compute the diagonal of the gradient (on the true dofs), without forming the sparse matrix
+     *
+     * @param diag the diagonal entries of the gradient, one for each true dof
+     *
+     * @note this requires the test space and the trial space to be the same
+     */
+    void AssembleDiagonal(mfem::Vector& diag) const override
+    {
+      SLIC_ERROR_ROOT_IF(Height() != Width(), "AssembleDiagonal() requires a square gradient");
+
+      form_.output_L_ = 0.0;
+
+      // each element's diagonal entries are ordered the same way as its entries in the E-vector,
+      // so they can be scattered directly (the sign of a diagonal entry is sign(row) * sign(col) == 1)
+      for (auto& integral : form_.integrals_) {
+        auto type = integral.domain_.type_;
+        integral.ComputeElementDiagonals(form_.output_E_[type], which_derivative);
+        form_.G_test_[type].ScatterAdd(form_.output_E_[type], form_.output_L_, scatter_add_strategy);
+      }
+
+      diag.SetSize(Height());
+      form_.P_test_->MultTranspose(form_.output_L_, diag);
+    }
+
     /// @brief assemble element matrices and form an mfem::HypreParMatrix
     std::unique_ptr<mfem::HypreParMatrix> assemble()
     {
@@ -578,70 +891,11 @@ private:
 
       constexpr bool col_ind_is_sorted = true;
 
-      if (!lookup_tables.initialized) {
-        lookup_tables.init(form_.G_test_[Domain::Type::Elements],
-                           form_.G_trial_[Domain::Type::Elements][which_argument]);
-      }
+      initializeLookupTables();
 
       double* values = new double[lookup_tables.nnz]{};
 
-      std::map<mfem::Geometry::Type, ExecArray<double, 3, exec>> element_gradients[Domain::num_types];
-
-      for (auto& integral : form_.integrals_) {
-        auto& K_elem             = element_gradients[integral.domain_.type_];
-        auto& test_restrictions  = form_.G_test_[integral.domain_.type_].restrictions;
-        auto& trial_restrictions = form_.G_trial_[integral.domain_.type_][which_argument].restrictions;
-
-        if (K_elem.empty()) {
-          for (auto& [geom, test_restriction] : test_restrictions) {
-            auto& trial_restriction = trial_restrictions[geom];
-
-            K_elem[geom] = ExecArray<double, 3, exec>(test_restriction.num_elements,
-                                                      trial_restriction.nodes_per_elem * trial_restriction.components,
-                                                      test_restriction.nodes_per_elem * test_restriction.components);
-
-            detail::zero_out(K_elem[geom]);
-          }
-        }
-
-        integral.ComputeElementGradients(K_elem, which_argument);
-      }
-
-      for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements}) {
-        auto& K_elem             = element_gradients[type];
-        auto& test_restrictions  = form_.G_test_[type].restrictions;
-        auto& trial_restrictions = form_.G_trial_[type][which_argument].restrictions;
-
-        if (!K_elem.empty()) {
-          for (auto [geom, elem_matrices] : K_elem) {
-            std::vector<DoF> test_vdofs(test_restrictions[geom].nodes_per_elem * test_restrictions[geom].components);
-            std::vector<DoF> trial_vdofs(trial_restrictions[geom].nodes_per_elem * trial_restrictions[geom].components);
-
-            for (axom::IndexType e = 0; e < elem_matrices.shape()[0]; e++) {
-              test_restrictions[geom].GetElementVDofs(e, test_vdofs);
-              trial_restrictions[geom].GetElementVDofs(e, trial_vdofs);
-
-              for (uint32_t i = 0; i < uint32_t(elem_matrices.shape()[1]); i++) {
-                int col = int(trial_vdofs[i].index());
-
-                for (uint32_t j = 0; j < uint32_t(elem_matrices.shape()[2]); j++) {
-                  int row = int(test_vdofs[j].index());
-
-                  int sign = test_vdofs[j].sign() * trial_vdofs[i].sign();
-
-                  // note: col / row appear backwards here, because the element matrix kernel
-                  //       is actually transposed, as a result of being row-major storage.
-                  //
-                  //       This is kind of confusing, and will be fixed in a future refactor
-                  //       of the element gradient kernel implementation
-                  [[maybe_unused]] auto nz = lookup_tables(row, col);
-                  values[lookup_tables(row, col)] += sign * elem_matrices(e, i, j);
-                }
-              }
-            }
-          }
-        }
-      }
+      assembleValues(values);
 
       // Copy the column indices to an auxilliary array as MFEM can mutate these during HypreParMatrix construction
       col_ind_copy_ = lookup_tables.col_ind;
@@ -666,9 +920,187 @@ private:
       return K;
     };
 
+    /**
+     * @brief assemble element matrices into a persistent mfem::HypreParMatrix, updating its values in place
+     *
+     * The first call allocates the matrix and records where each nonzero of the CSR values array lives
+     * in hypre's storage. Later calls only recompute the values and write them into that same matrix,
+     * so the returned reference stays valid (and keeps its sparsity pattern) for the lifetime of this Gradient.
+     *
+     * When neither the test space nor the trial space has shared or constrained dofs on any rank, the
+     * prolongation operators are identities and the local matrix is already the true-dof matrix, so the
+     * RAP product is skipped entirely. Otherwise, the local matrix is still updated in place, but the RAP
+     * product is recomputed and its values are copied into the persistent matrix.
+     *
+     * @note any modifications made to the returned matrix (e.g. eliminating essential dofs)
+     *   are overwritten by the next call to assembleInPlace()
+     */
+    mfem::HypreParMatrix& assembleInPlace()
+    {
+      initializeLookupTables();
+
+      values_.resize(lookup_tables.nnz);
+      std::fill(values_.begin(), values_.end(), 0.0);
+
+      assembleValues(values_.data());
+
+      if (!A_) {
+        constexpr bool sparse_matrix_frees_graph_ptrs = false;
+        constexpr bool sparse_matrix_frees_values_ptr = false;
+        constexpr bool col_ind_is_sorted              = true;
+
+        // MFEM may alias (and reorder) these arrays in the HypreParMatrix,
+        // so they must outlive A_ and can't be shared with values_
+        col_ind_copy_ = lookup_tables.col_ind;
+        A_values_     = values_;
+
+        auto J_local =
+            mfem::SparseMatrix(lookup_tables.row_ptr.data(), col_ind_copy_.data(), A_values_.data(),
+                               form_.output_L_.Size(), form_.input_L_[which_argument].Size(),
+                               sparse_matrix_frees_graph_ptrs, sparse_matrix_frees_values_ptr, col_ind_is_sorted);
+
+        A_ = std::make_unique<mfem::HypreParMatrix>(test_space_->GetComm(), test_space_->GlobalVSize(),
+                                                    trial_space_->GlobalVSize(), test_space_->GetDofOffsets(),
+                                                    trial_space_->GetDofOffsets(), &J_local);
+
+        // hypre may reorder the entries in each row (e.g. to put the diagonal entry first),
+        // so find where each entry of the CSR values array ended up
+        mfem::SparseMatrix diag;
+        A_->GetDiag(diag);
+        const int* I = diag.HostReadI();
+        const int* J = diag.HostReadJ();
+
+        nonzero_to_hypre_.resize(lookup_tables.nnz);
+        for (int row = 0; row < diag.Height(); row++) {
+          auto row_begin = lookup_tables.col_ind.begin() + lookup_tables.row_ptr[uint32_t(row)];
+          auto row_end   = lookup_tables.col_ind.begin() + lookup_tables.row_ptr[uint32_t(row) + 1];
+          for (int k = I[row]; k < I[row + 1]; k++) {
+            auto nz = std::lower_bound(row_begin, row_end, J[k]) - lookup_tables.col_ind.begin();
+            nonzero_to_hypre_[uint32_t(nz)] = k;
+          }
+        }
+
+        trivial_prolongation_ =
+            !has_nontrivial_prolongation(*test_space_) && !has_nontrivial_prolongation(*trial_space_);
+      } else {
+        mfem::SparseMatrix diag;
+        A_->GetDiag(diag);
+        double* A_data = diag.HostReadWriteData();
+        for (uint32_t nz = 0; nz < lookup_tables.nnz; nz++) {
+          A_data[nonzero_to_hypre_[nz]] = values_[nz];
+        }
+      }
+
+      if (trivial_prolongation_) {
+        return *A_;
+      }
+
+      auto* R = form_.test_space_->Dof_TrueDof_Matrix();
+      auto* P = trial_space_->Dof_TrueDof_Matrix();
+
+      std::unique_ptr<mfem::HypreParMatrix> K(mfem::RAP(R, A_.get(), P));
+
+      if (!K_) {
+        K_ = std::move(K);
+      } else {
+        copy_values(*K, *K_);
+      }
+
+      return *K_;
+    }
+
     friend auto assemble(Gradient& g) { return g.assemble(); }
 
   private:
+    /// @brief initialize the lookup tables that map element gradient entries to CSR nonzeros (first call only)
+    void initializeLookupTables()
+    {
+      if (!lookup_tables.initialized) {
+        lookup_tables.init(form_.G_test_[Domain::Type::Elements],
+                           form_.G_trial_[Domain::Type::Elements][which_argument]);
+        lookup_tables.initElementLUT(Domain::Type::BoundaryElements, form_.G_test_[Domain::Type::BoundaryElements],
+                                     form_.G_trial_[Domain::Type::BoundaryElements][which_argument]);
+      }
+    }
+
+    /**
+     * @brief compute the element gradients and accumulate them into the values array of the local CSR matrix
+     * @param values the CSR values (with `lookup_tables.nnz` entries), assumed to be zero-initialized
+     */
+    void assembleValues(double* values)
+    {
+      bool zeroed[Domain::num_types]{};
+
+      for (auto& integral : form_.integrals_) {
+        auto  type   = integral.domain_.type_;
+        auto& K_elem = element_gradients_[type];
+
+        if (!zeroed[type]) {
+          if (K_elem.empty()) {
+            auto& test_restrictions  = form_.G_test_[type].restrictions;
+            auto& trial_restrictions = form_.G_trial_[type][which_argument].restrictions;
+            for (auto& [geom, test_restriction] : test_restrictions) {
+              auto& trial_restriction = trial_restrictions[geom];
+
+              K_elem[geom] = ExecArray<double, 3, exec>(test_restriction.num_elements,
+                                                        trial_restriction.nodes_per_elem * trial_restriction.components,
+                                                        test_restriction.nodes_per_elem * test_restriction.components);
+            }
+          }
+
+          for (auto& [geom, elem_matrices] : K_elem) {
+            detail::zero_out(elem_matrices);
+          }
+
+          zeroed[type] = true;
+        }
+
+        integral.ComputeElementGradients(K_elem, which_derivative);
+      }
+
+      for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements}) {
+        for (auto& [geom, elem_matrices] : element_gradients_[type]) {
+          // the lookup tables have the same layout as the element matrices, so each
+          // entry is accumulated directly into its precomputed location in the CSR values
+          const uint32_t* nonzeros = lookup_tables.element_nonzero_LUT[type].at(geom).data();
+          const int8_t*   signs    = lookup_tables.element_signs[type].at(geom).data();
+          const double*   K        = elem_matrices.data();
+
+          for (axom::IndexType k = 0; k < elem_matrices.size(); k++) {
+            values[nonzeros[k]] += signs[k] * K[k];
+          }
+        }
+      }
+    }
+
+    /// @brief returns true if any rank has local dofs that are not true dofs (shared or constrained)
+    static bool has_nontrivial_prolongation(const mfem::ParFiniteElementSpace& space)
+    {
+      int local  = (space.GetVSize() != space.GetTrueVSize());
+      int global = 0;
+      MPI_Allreduce(&local, &global, 1, MPI_INT, MPI_MAX, space.GetComm());
+      return global != 0;
+    }
+
+    /// @brief copy the values of one HypreParMatrix into another with the same sparsity pattern
+    static void copy_values(const mfem::HypreParMatrix& from, mfem::HypreParMatrix& to)
+    {
+      mfem::SparseMatrix from_diag, to_diag, from_offd, to_offd;
+      HYPRE_BigInt*      from_cmap;
+      HYPRE_BigInt*      to_cmap;
+      from.GetDiag(from_diag);
+      to.GetDiag(to_diag);
+      from.GetOffd(from_offd, from_cmap);
+      to.GetOffd(to_offd, to_cmap);
+
+      SLIC_ERROR_IF(from_diag.NumNonZeroElems() != to_diag.NumNonZeroElems() ||
+                        from_offd.NumNonZeroElems() != to_offd.NumNonZeroElems(),
+                    "sparsity pattern of the assembled gradient changed between calls to assembleInPlace()");
+
+      std::copy_n(from_diag.HostReadData(), from_diag.NumNonZeroElems(), to_diag.HostReadWriteData());
+      std::copy_n(from_offd.HostReadData(), from_offd.NumNonZeroElems(), to_offd.HostReadWriteData());
+    }
+
     /// @brief The "parent" @p Functional to calculate gradients with
     Functional<test(trials...), exec>& form_;
 
@@ -685,6 +1117,27 @@ private:
      */
     std::vector<int> col_ind_copy_;
 
+    /// @brief element gradients, reused between calls to assemble()
+    std::map<mfem::Geometry::Type, ExecArray<double, 3, exec>> element_gradients_[Domain::num_types];
+
+    /// @brief CSR values accumulated by assembleInPlace()
+    std::vector<double> values_;
+
+    /// @brief CSR values passed to the constructor of A_ (mfem may keep referencing them)
+    std::vector<double> A_values_;
+
+    /// @brief for each CSR nonzero, its index in the data array of the diagonal block of A_
+    std::vector<int> nonzero_to_hypre_;
+
+    /// @brief the block-diagonal matrix of local (L-dof) gradients, updated in place by assembleInPlace()
+    std::unique_ptr<mfem::HypreParMatrix> A_;
+
+    /// @brief the true-dof gradient matrix returned by assembleInPlace(), when the prolongation is nontrivial
+    std::unique_ptr<mfem::HypreParMatrix> K_;
+
+    /// @brief whether the test and trial prolongation operators are identities on every rank
+    bool trivial_prolongation_ = false;
+
     /**
      * @brief this member variable tells us which argument the associated Functional this gradient
      *  corresponds to:
@@ -697,6 +1150,9 @@ private:
      */
     uint32_t which_argument;
 
+    /// @brief the index the integrals use to identify this derivative (a trial space or combined derivative index)
+    uint32_t which_derivative;
+
     /// @brief shallow copy of the test space from the associated Functional
     const mfem::ParFiniteElementSpace* test_space_;
 
@@ -740,8 +1196,23 @@ private:
   /// @brief The set of true DOF values, a reference to this member is returned by @p operator()
   mutable mfem::Vector output_T_;
 
+  /// @brief The input L-vectors of batched gradient actions, stored one after another
+  mutable mfem::Vector batch_input_L_;
+
+  /// @brief The input E-vectors of batched gradient actions, stored one after another
+  mutable mfem::Vector batch_input_E_[Domain::num_types];
+
+  /// @brief The output E-vectors of batched gradient actions, stored one after another
+  mutable mfem::Vector batch_output_E_[Domain::num_types];
+
+  /// @brief The output L-vectors of batched gradient actions, stored one after another
+  mutable mfem::Vector batch_output_L_;
+
   /// @brief The objects representing the gradients w.r.t. each input argument of the Functional
   mutable std::vector<Gradient> grad_;
+
+  /// @brief The objects representing combined derivatives, created the first time each is evaluated
+  std::map<uint32_t, Gradient> combined_grad_;
 };
 
 }  // namespace serac
@@ -128,6 +128,7 @@ public:
       }
 
       output_E_[type].Update(offsets, mem_type);
+      output_offsets_[type] = offsets;
     }
 
     G_test_ = QoIElementRestriction();
@@ -168,8 +169,8 @@ public:
     check_for_missing_nodal_gridfunc(mesh);
 
     using signature = test(decltype(serac::type<args>(trial_spaces))...);
-    integrals_.push_back(
-        MakeDomainIntegral<signature, Q, dim>(EntireDomain(mesh), integrand, qdata, std::vector<uint32_t>{args...}));
+    integrals_.push_back(MakeDomainIntegral<signature, Q, dim, exec>(EntireDomain(mesh), integrand, qdata,
+                                                                     std::vector<uint32_t>{args...}));
   }
 
   /// @overload
@@ -186,7 +187,7 @@ public:
 
     using signature = test(decltype(serac::type<args>(trial_spaces))...);
     integrals_.push_back(
-        MakeDomainIntegral<signature, Q, dim>(domain, integrand, qdata, std::vector<uint32_t>{args...}));
+        MakeDomainIntegral<signature, Q, dim, exec>(domain, integrand, qdata, std::vector<uint32_t>{args...}));
   }
 
   /**
@@ -210,7 +211,7 @@ public:
 
     using signature = test(decltype(serac::type<args>(trial_spaces))...);
     integrals_.push_back(
-        MakeBoundaryIntegral<signature, Q, dim>(EntireBoundary(mesh), integrand, std::vector<uint32_t>{args...}));
+        MakeBoundaryIntegral<signature, Q, dim, exec>(EntireBoundary(mesh), integrand, std::vector<uint32_t>{args...}));
   }
 
   /// @overload
@@ -225,7 +226,8 @@ public:
     check_for_missing_nodal_gridfunc(domain.mesh_);
 
     using signature = test(decltype(serac::type<args>(trial_spaces))...);
-    integrals_.push_back(MakeBoundaryIntegral<signature, Q, dim>(domain, integrand, std::vector<uint32_t>{args...}));
+    integrals_.push_back(MakeBoundaryIntegral<signature, Q, dim, exec>(domain, integrand,
+                                                                       std::vector<uint32_t>{args...}));
   }
 
   /**
@@ -269,6 +271,32 @@ public:
     AddBoundaryIntegral(Dimension<2>{}, which_args, integrand, domain);
   }
 
+  /**
+   * @brief Recalculate the geometric factors of each integral after the nodes of the mesh have moved
+   *
+   * @note The connectivity of the mesh must not have changed since the integrals were added
+   */
+  void updateMeshNodes()
+  {
+    for (auto& integral : integrals_) {
+      integral.updateGeometry();
+    }
+  }
+
+  /**
+   * @brief the memory currently used by the integrals to store q-function derivatives, see DerivativeStorage
+   *
+   * @return the number of bytes allocated on this rank
+   */
+  std::size_t storedDerivativeBytes() const
+  {
+    std::size_t bytes = 0;
+    for (auto& integral : integrals_) {
+      bytes += integral.storedDerivativeBytes();
+    }
+    return bytes;
+  }
+
   /**
    * @brief this function computes the directional derivative of the quantity of interest functional
    *
@@ -309,6 +337,76 @@ public:
     return output_T_[0];
   }
 
+  /**
+   * @brief this function computes the directional derivatives of the quantity of interest functional in several
+   * directions at once
+   *
+   * The element calculations for all of the directions are done in a single pass over the elements, and the values
+   * from different processors are summed with a single reduction.
+   *
+   * @param input_T the T-vectors to apply the action of gradient to, one per column
+   * @param which describes which trial space input_T corresponds to
+   * @return the directional derivative in the direction of each column
+   */
+  mfem::Vector ActionOfGradient(const mfem::DenseMatrix& input_T, uint32_t which) const
+  {
+    SLIC_ERROR_ROOT_IF(input_T.Height() != trial_space_[which]->GetTrueVSize(),
+                       axom::fmt::format("The directions have {} rows, but trial space {} has {} true dofs",
+                                         input_T.Height(), which, trial_space_[which]->GetTrueVSize()));
+
+    int num_vectors = input_T.Width();
+    int input_size  = input_L_[which].Size();
+
+    // the L-vectors of all directions, stored one after another
+    batch_input_L_.SetSize(input_size * num_vectors);
+    for (int k = 0; k < num_vectors; k++) {
+      // mfem::Vector has no const views, but the column is only read from
+      mfem::Vector column(const_cast<double*>(input_T.GetColumn(k)), input_T.Height());
+      mfem::Vector input_L(batch_input_L_, k * input_size, input_size);
+      P_trial_[which]->Mult(column, input_L);
+    }
+
+    mfem::Vector local_values(num_vectors);
+    local_values = 0.0;
+
+    // this is used to mark when gather operations have been performed,
+    // to avoid doing them more than once per trial space
+    bool already_computed[Domain::num_types]{};  // default initializes to `false`
+
+    for (auto& integral : integrals_) {
+      auto type          = integral.domain_.type_;
+      auto input_offsets = G_trial_[type][which].bOffsets();
+      int  input_E_size  = input_offsets.Last();
+      int  output_E_size = output_offsets_[type].Last();
+
+      if (!already_computed[type]) {
+        batch_input_E_[type].SetSize(input_E_size * num_vectors);
+        for (int k = 0; k < num_vectors; k++) {
+          mfem::Vector      input_L(batch_input_L_, k * input_size, input_size);
+          mfem::BlockVector input_E(batch_input_E_[type].GetData() + k * input_E_size, input_offsets);
+          G_trial_[type][which].Gather(input_L, input_E);
+        }
+        already_computed[type] = true;
+      }
+
+      batch_output_E_[type].SetSize(output_E_size * num_vectors);
+      integral.GradientMult(batch_input_E_[type], batch_output_E_[type], input_offsets, output_offsets_[type],
+                            uint32_t(num_vectors), which);
+
+      // sum the element values of each direction on the local processor
+      for (int k = 0; k < num_vectors; k++) {
+        mfem::Vector output_E(batch_output_E_[type], k * output_E_size, output_E_size);
+        local_values[k] += output_E.Sum();
+      }
+    }
+
+    // sum the values of all the directions over the processors at once
+    mfem::Vector values(num_vectors);
+    MPI_Allreduce(local_values.GetData(), values.GetData(), num_vectors, MPI_DOUBLE, MPI_SUM, P_test_.comm);
+
+    return values;
+  }
+
   /**
    * @brief this function lets the user evaluate the serac::Functional with the given trial space values
    *
@@ -419,6 +517,9 @@ private:
 
     double operator()(const mfem::Vector& x) const { return form_.ActionOfGradient(x, which_argument); }
 
+    /// @brief the directional derivatives in the directions of each column of @p dx, computed in a single pass
+    mfem::Vector operator()(const mfem::DenseMatrix& dx) const { return form_.ActionOfGradient(dx, which_argument); }
+
     std::unique_ptr<mfem::HypreParVector> assemble()
     {
       // The mfem method ParFiniteElementSpace.NewTrueDofVector should really be marked const
@@ -511,6 +612,9 @@ private:
 
   mutable mfem::BlockVector output_E_[Domain::num_types];
 
+  /// @brief The block offsets (by element geometry) of output_E_
+  mfem::Array<int> output_offsets_[Domain::num_types];
+
   QoIElementRestriction G_test_;
 
   /// @brief The output set of local DOF values (i.e., on the current rank)
@@ -521,6 +625,15 @@ private:
   /// @brief The set of true DOF values, a reference to this member is returned by @p operator()
   mutable mfem::Vector output_T_;
 
+  /// @brief The input L-vectors of batched gradient actions, stored one after another
+  mutable mfem::Vector batch_input_L_;
+
+  /// @brief The input E-vectors of batched gradient actions, stored one after another
+  mutable mfem::Vector batch_input_E_[Domain::num_types];
+
+  /// @brief The output E-vectors of batched gradient actions, stored one after another
+  mutable mfem::Vector batch_output_E_[Domain::num_types];
+
   /// @brief The objects representing the gradients w.r.t. each input argument of the Functional
   mutable std::vector<Gradient> grad_;
 };
@@ -1,4 +1,5 @@
 #include "serac/numerics/functional/geometric_factors.hpp"
+#include "serac/infrastructure/accelerator.hpp"
 #include "serac/numerics/functional/finite_element.hpp"
 
 namespace serac {
@@ -31,10 +32,10 @@ void compute_geometric_factors(mfem::Vector& positions_q, mfem::Vector& jacobian
   auto J_q = reinterpret_cast<jacobian_type*>(jacobians_q.ReadWrite());
   auto X   = reinterpret_cast<const typename element_type::dof_type*>(positions_e.Read());
 
-  std::size_t num_elements = elements.size();
+  uint32_t num_elements = uint32_t(elements.size());
 
-  // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; e++) {
+  // for each element in the domain (the elements write to separate locations, so they can be processed concurrently)
+  accelerator::forall<ExecutionSpace::OpenMP>(num_elements, [&](uint32_t e) {
     // load the positions for the nodes in this element
     auto X_e = X[elements[e]];
 
@@ -56,21 +57,12 @@ void compute_geometric_factors(mfem::Vector& positions_q, mfem::Vector& jacobian
         }
       }
     }
-  }
+  });
 }
 
 GeometricFactors::GeometricFactors(const Domain& d, int q, mfem::Geometry::Type g)
+    : q_parameter(q), geometry(g), on_boundary(false)
 {
-  auto* nodes = d.mesh_.GetNodes();
-  auto* fes   = nodes->FESpace();
-
-  auto         restriction = serac::ElementRestriction(fes, g);
-  mfem::Vector X_e(int(restriction.ESize()));
-  restriction.Gather(*nodes, X_e);
-
-  // assumes all elements are the same order
-  int p = fes->GetElementOrder(0);
-
   int spatial_dim   = d.mesh_.SpaceDimension();
   int geometry_dim  = dimension_of(g);
   int qpts_per_elem = num_quadrature_points(g, q);
@@ -85,6 +77,55 @@ GeometricFactors::GeometricFactors(const Domain& d, int q, mfem::Geometry::Type
   X = mfem::Vector(int(num_elements) * qpts_per_elem * spatial_dim);
   J = mfem::Vector(int(num_elements) * qpts_per_elem * spatial_dim * geometry_dim);
 
+  restriction = serac::ElementRestriction(d.mesh_.GetNodes()->FESpace(), g);
+  positions_e.SetSize(int(restriction.ESize()));
+
+  update(d);
+}
+
+GeometricFactors::GeometricFactors(const Domain& d, int q, mfem::Geometry::Type g, FaceType type)
+    : q_parameter(q), geometry(g), on_boundary(true)
+{
+  int spatial_dim   = d.mesh_.SpaceDimension();
+  int geometry_dim  = dimension_of(g);
+  int qpts_per_elem = num_quadrature_points(g, q);
+
+  // NB: we only want the number of elements with the specified
+  // geometry, which is not the same as mesh->GetNE() in general
+  elements = d.get(g);
+
+  num_elements = std::size_t(elements.size());
+
+  X = mfem::Vector(int(num_elements) * qpts_per_elem * spatial_dim);
+  J = mfem::Vector(int(num_elements) * qpts_per_elem * spatial_dim * geometry_dim);
+
+  restriction = serac::ElementRestriction(d.mesh_.GetNodes()->FESpace(), g, type);
+  positions_e.SetSize(int(restriction.ESize()));
+
+  update(d);
+}
+
+void GeometricFactors::update(const Domain& d)
+{
+  auto* nodes = d.mesh_.GetNodes();
+  restriction.Gather(*nodes, positions_e);
+
+  // assumes all elements are the same order
+  int p = nodes->FESpace()->GetElementOrder(0);
+
+  if (on_boundary) {
+    updateBoundary(p);
+  } else {
+    updateDomain(p);
+  }
+}
+
+void GeometricFactors::updateDomain(int p)
+{
+  const auto& g   = geometry;
+  const auto& q   = q_parameter;
+  const auto& X_e = positions_e;
+
 #define DISPATCH_KERNEL(GEOM, P, Q)                                                                           \
   if (g == mfem::Geometry::GEOM && p == P && q == Q) {                                                        \
     compute_geometric_factors<Q, mfem::Geometry::GEOM, H1<P, dimension_of(mfem::Geometry::GEOM)> >(X, J, X_e, \
@@ -137,30 +178,11 @@ GeometricFactors::GeometricFactors(const Domain& d, int q, mfem::Geometry::Type
   std::cout << "should never be reached " << std::endl;
 }
 
-GeometricFactors::GeometricFactors(const Domain& d, int q, mfem::Geometry::Type g, FaceType type)
+void GeometricFactors::updateBoundary(int p)
 {
-  auto* nodes = d.mesh_.GetNodes();
-  auto* fes   = nodes->FESpace();
-
-  auto         restriction = serac::ElementRestriction(fes, g, type);
-  mfem::Vector X_e(int(restriction.ESize()));
-  restriction.Gather(*nodes, X_e);
-
-  // assumes all elements are the same order
-  int p = fes->GetElementOrder(0);
-
-  int spatial_dim   = d.mesh_.SpaceDimension();
-  int geometry_dim  = dimension_of(g);
-  int qpts_per_elem = num_quadrature_points(g, q);
-
-  // NB: we only want the number of elements with the specified
-  // geometry, which is not the same as mesh->GetNE() in general
-  elements = d.get(g);
-
-  num_elements = std::size_t(elements.size());
-
-  X = mfem::Vector(int(num_elements) * qpts_per_elem * spatial_dim);
-  J = mfem::Vector(int(num_elements) * qpts_per_elem * spatial_dim * geometry_dim);
+  const auto& g   = geometry;
+  const auto& q   = q_parameter;
+  const auto& X_e = positions_e;
 
 #define DISPATCH_KERNEL(GEOM, P, Q)                                                                               \
   if (g == mfem::Geometry::GEOM && p == P && q == Q) {                                                            \
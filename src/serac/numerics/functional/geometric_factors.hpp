@@ -38,6 +38,16 @@ struct GeometricFactors {
    */
   GeometricFactors(const Domain& domain, int q, mfem::Geometry::Type elem_geom, FaceType type);
 
+  /**
+   * @brief recalculate the positions and jacobians in place, after the nodes of the mesh have moved
+   *
+   * The storage of X and J is reused, so pointers to them (e.g. those held by the integral kernels) remain valid.
+   *
+   * @param domain the domain of integration that these factors were constructed with
+   * @note the connectivity of the mesh and its nodal finite element space must not have changed
+   */
+  void update(const Domain& domain);
+
   // descriptions copied from mfem
 
   /// Mapped (physical) coordinates of all quadrature points.
@@ -62,6 +72,28 @@ struct GeometricFactors {
 
   /// the number of elements in the domain
   std::size_t num_elements;
+
+  /// @brief the parameter controlling the number of quadrature points per element
+  int q_parameter;
+
+  /// @brief the element geometry
+  mfem::Geometry::Type geometry;
+
+  /// @brief whether the elements are boundary elements
+  bool on_boundary;
+
+  /// @brief the restriction of the mesh nodes to the elements
+  ElementRestriction restriction;
+
+  /// @brief the "e-vector" of mesh node positions, reused by each call to update()
+  mfem::Vector positions_e;
+
+private:
+  /// @brief calculate the positions and jacobians of domain elements from positions_e
+  void updateDomain(int p);
+
+  /// @brief calculate the positions and jacobians of boundary elements from positions_e
+  void updateBoundary(int p);
 };
 
 }  // namespace serac
@@ -6,17 +6,21 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <memory>
+#include <string>
 
 #include "mfem.hpp"
 
 #include "serac/infrastructure/accelerator.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/numerics/functional/geometric_factors.hpp"
 #include "serac/numerics/functional/function_signature.hpp"
 #include "serac/numerics/functional/domain_integral_kernels.hpp"
 #include "serac/numerics/functional/boundary_integral_kernels.hpp"
 #include "serac/numerics/functional/differentiate_wrt.hpp"
+#include "serac/numerics/functional/derivative_storage.hpp"
 
 namespace serac {
 
@@ -33,18 +37,32 @@ struct Integral {
    *
    * @param d the domain of integration
    * @param trial_space_indices a list of which trial spaces are used in the integrand
+   * @param combined_index if not NO_DIFFERENTIATION, the (functional) index of a combined derivative
+   *        (see combined_derivative_index()), whose kernels are stored after those of the trial spaces
    */
-  Integral(const Domain& d, std::vector<uint32_t> trial_space_indices)
-      : domain_(d), active_trial_spaces_(trial_space_indices)
+  Integral(const Domain& d, std::vector<uint32_t> trial_space_indices,
+           uint32_t combined_index = NO_DIFFERENTIATION)
+      : domain_(d), active_trial_spaces_(trial_space_indices), inputs_(trial_space_indices.size())
   {
     std::size_t num_trial_spaces = trial_space_indices.size();
+    std::size_t num_derivatives  = num_trial_spaces + (combined_index != NO_DIFFERENTIATION);
     evaluation_with_AD_.resize(num_trial_spaces);
-    jvp_.resize(num_trial_spaces);
-    element_gradient_.resize(num_trial_spaces);
+    jvp_.resize(num_derivatives);
+    element_gradient_.resize(num_derivatives);
+    element_diagonal_.resize(num_derivatives);
+    derivative_bytes_.resize(num_derivatives);
+
+    static uint32_t num_integrals = 0;
+    counter_prefix_ = "Functional/integral_" + std::to_string(num_integrals++) +
+                      ((d.type_ == Domain::Type::Elements) ? "/domain/" : "/boundary/");
 
     for (uint32_t i = 0; i < num_trial_spaces; i++) {
       functional_to_integral_index_[active_trial_spaces_[i]] = i;
     }
+
+    if (combined_index != NO_DIFFERENTIATION) {
+      functional_to_integral_index_[combined_index] = uint32_t(num_trial_spaces);
+    }
   }
 
   /**
@@ -61,22 +79,45 @@ struct Integral {
    * @param update_state whether or not to store the updated state values computed in the q-function. For plasticity and
    * other path-dependent materials, this flag should only be set to `true` once a solution to the nonlinear system has
    * been found.
+   * @param weights when differentiation_index refers to a combined derivative, the coefficients of the derivatives
+   * w.r.t. its two trial spaces
    */
   void Mult(double t, const std::vector<mfem::BlockVector>& input_E, mfem::BlockVector& output_E,
-            uint32_t differentiation_index, bool update_state) const
+            uint32_t differentiation_index, bool update_state, std::array<double, 2> weights = {1.0, 1.0}) const
   {
     output_E = 0.0;
 
+    if (functional_to_integral_index_.count(differentiation_index) > 0 &&
+        functional_to_integral_index_.at(differentiation_index) == evaluation_with_AD_.size()) {
+      for (auto& [geometry, func] : evaluation_with_combined_AD_) {
+        profiling::ScopedCounter counter;
+        if (profiling::countersEnabled()) {
+          startCounter(counter, geometry, "evaluate",
+                       evaluationBytes(input_E, output_E, geometry, uint32_t(evaluation_with_AD_.size())));
+        }
+
+        for (std::size_t i = 0; i < active_trial_spaces_.size(); i++) {
+          inputs_[i] = input_E[uint32_t(active_trial_spaces_[i])].GetBlock(geometry).Read();
+        }
+        func(t, inputs_, output_E.GetBlock(geometry).ReadWrite(), update_state, weights);
+      }
+      return;
+    }
+
     bool with_AD =
         (functional_to_integral_index_.count(differentiation_index) > 0 && differentiation_index != NO_DIFFERENTIATION);
-    auto& kernels =
-        (with_AD) ? evaluation_with_AD_[functional_to_integral_index_.at(differentiation_index)] : evaluation_;
+    uint32_t derivative = (with_AD) ? functional_to_integral_index_.at(differentiation_index) : NO_DIFFERENTIATION;
+    auto&    kernels    = (with_AD) ? evaluation_with_AD_[derivative] : evaluation_;
     for (auto& [geometry, func] : kernels) {
-      std::vector<const double*> inputs(active_trial_spaces_.size());
+      profiling::ScopedCounter counter;
+      if (profiling::countersEnabled()) {
+        startCounter(counter, geometry, "evaluate", evaluationBytes(input_E, output_E, geometry, derivative));
+      }
+
       for (std::size_t i = 0; i < active_trial_spaces_.size(); i++) {
-        inputs[i] = input_E[uint32_t(active_trial_spaces_[i])].GetBlock(geometry).Read();
+        inputs_[i] = input_E[uint32_t(active_trial_spaces_[i])].GetBlock(geometry).Read();
       }
-      func(t, inputs, output_E.GetBlock(geometry).ReadWrite(), update_state);
+      func(t, inputs_, output_E.GetBlock(geometry).ReadWrite(), update_state);
     }
   }
 
@@ -96,8 +137,57 @@ struct Integral {
 
     // if this integral actually depends on the specified variable
     if (functional_to_integral_index_.count(differentiation_index) > 0) {
-      for (auto& [geometry, func] : jvp_[functional_to_integral_index_.at(differentiation_index)]) {
-        func(input_E.GetBlock(geometry).Read(), output_E.GetBlock(geometry).ReadWrite());
+      uint32_t derivative = functional_to_integral_index_.at(differentiation_index);
+      for (auto& [geometry, func] : jvp_[derivative]) {
+        profiling::ScopedCounter counter;
+        if (profiling::countersEnabled()) {
+          std::size_t vector_bytes = std::size_t(input_E.BlockSize(geometry) + output_E.BlockSize(geometry));
+          startCounter(counter, geometry, "jvp",
+                       vector_bytes * sizeof(double) + derivative_bytes_[derivative].at(geometry));
+        }
+
+        func(input_E.GetBlock(geometry).Read(), output_E.GetBlock(geometry).ReadWrite(), 1, 0, 0);
+      }
+    }
+  }
+
+  /**
+   * @brief evaluate the jacobian(with respect to some trial space)-vector products of this integral with several
+   * vectors, in a single pass over the elements
+   *
+   * @param input_E the element values of each vector, stored one after another, where each vector is laid out like a
+   * block vector with the block offsets @p input_offsets
+   * @param output_E the output values of each vector, stored one after another, where each vector is laid out like a
+   * block vector with the block offsets @p output_offsets
+   * @param input_offsets the block offsets (by element geometry) of the element values of one input vector
+   * @param output_offsets the block offsets (by element geometry) of the output values of one vector
+   * @param num_vectors the number of vectors
+   * @param differentiation_index a non-negative value indicates directional derivative with respect to the trial space
+   * with that index.
+   */
+  void GradientMult(const mfem::Vector& input_E, mfem::Vector& output_E, const mfem::Array<int>& input_offsets,
+                    const mfem::Array<int>& output_offsets, uint32_t num_vectors, uint32_t differentiation_index) const
+  {
+    output_E = 0.0;
+
+    // if this integral actually depends on the specified variable
+    if (functional_to_integral_index_.count(differentiation_index) > 0) {
+      auto     input_stride  = static_cast<std::size_t>(input_offsets.Last());
+      auto     output_stride = static_cast<std::size_t>(output_offsets.Last());
+      uint32_t derivative    = functional_to_integral_index_.at(differentiation_index);
+      for (auto& [geometry, func] : jvp_[derivative]) {
+        // the derivatives of each element are read from memory once, and reused for all of the vectors
+        profiling::ScopedCounter counter;
+        if (profiling::countersEnabled()) {
+          std::size_t vector_bytes = std::size_t(input_offsets[geometry + 1] - input_offsets[geometry] +
+                                                 output_offsets[geometry + 1] - output_offsets[geometry]);
+          startCounter(counter, geometry, "jvp",
+                       num_vectors * vector_bytes * sizeof(double) + derivative_bytes_[derivative].at(geometry),
+                       num_vectors);
+        }
+
+        func(input_E.Read() + input_offsets[geometry], output_E.ReadWrite() + output_offsets[geometry], num_vectors,
+             input_stride, output_stride);
       }
     }
   }
@@ -114,12 +204,122 @@ struct Integral {
   {
     // if this integral actually depends on the specified variable
     if (functional_to_integral_index_.count(differentiation_index) > 0) {
-      for (auto& [geometry, func] : element_gradient_[functional_to_integral_index_.at(differentiation_index)]) {
+      uint32_t derivative = functional_to_integral_index_.at(differentiation_index);
+      for (auto& [geometry, func] : element_gradient_[derivative]) {
+        profiling::ScopedCounter counter;
+        if (profiling::countersEnabled()) {
+          startCounter(counter, geometry, "assemble",
+                       K_e[geometry].size() * sizeof(double) + derivative_bytes_[derivative].at(geometry));
+        }
+
         func(view(K_e[geometry]));
       }
     }
   }
 
+  /**
+   * @brief evaluate the diagonal entries of the element jacobians (with respect to some trial space) of this integral
+   *
+   * @param output_E a block vector (block index corresponds to the element geometry) of the diagonal entries of each
+   * element jacobian, with the same layout as the element values of the test space
+   * @param differentiation_index the index of the trial space being differentiated
+   */
+  void ComputeElementDiagonals(mfem::BlockVector& output_E, uint32_t differentiation_index) const
+  {
+    output_E = 0.0;
+
+    // if this integral actually depends on the specified variable
+    if (functional_to_integral_index_.count(differentiation_index) > 0) {
+      uint32_t index = functional_to_integral_index_.at(differentiation_index);
+      SLIC_ERROR_IF(element_diagonal_[index].size() != element_gradient_[index].size(),
+                    "Error: element diagonals require the test space and trial space to be the same");
+      for (auto& [geometry, func] : element_diagonal_[index]) {
+        profiling::ScopedCounter counter;
+        if (profiling::countersEnabled()) {
+          std::size_t output_bytes = std::size_t(output_E.BlockSize(geometry)) * sizeof(double);
+          startCounter(counter, geometry, "diagonal", output_bytes + derivative_bytes_[index].at(geometry));
+        }
+
+        func(output_E.GetBlock(geometry).ReadWrite());
+      }
+    }
+  }
+
+  /**
+   * @brief recalculate the quadrature point positions and jacobians after the nodes of the mesh have moved
+   *
+   * The kernels of this integral keep pointers to the geometric factors, so they are updated in place rather than
+   * regenerated.
+   */
+  void updateGeometry()
+  {
+    for (auto& [geometry, gf] : geometric_factors_) {
+      if (gf.num_elements > 0) {
+        gf.update(domain_);
+      }
+    }
+  }
+
+  /**
+   * @brief the memory currently used to store q-function derivatives (or, for DerivativeStorage::Recompute, the element
+   * values that they are recomputed from)
+   *
+   * @return the number of bytes allocated
+   */
+  std::size_t storedDerivativeBytes() const
+  {
+    std::size_t bytes = 0;
+    for (auto& buffer : derivative_buffers_) {
+      bytes += buffer->bytes;
+    }
+    return bytes;
+  }
+
+  /**
+   * @brief estimate the number of bytes read and written by an evaluation kernel, for the performance counters
+   *
+   * @param input_E the element values of each trial space
+   * @param output_E the output values for each element
+   * @param geometry the element geometry of the kernel
+   * @param derivative the (integral) index of the derivative written by the kernel, or NO_DIFFERENTIATION
+   */
+  std::size_t evaluationBytes(const std::vector<mfem::BlockVector>& input_E, const mfem::BlockVector& output_E,
+                              mfem::Geometry::Type geometry, uint32_t derivative) const
+  {
+    const GeometricFactors& gf = geometric_factors_.at(geometry);
+
+    std::size_t values = std::size_t(gf.X.Size() + gf.J.Size() + output_E.BlockSize(geometry));
+    for (auto trial_space : active_trial_spaces_) {
+      values += std::size_t(input_E[trial_space].BlockSize(geometry));
+    }
+
+    std::size_t bytes = values * sizeof(double);
+    if (derivative != NO_DIFFERENTIATION) {
+      bytes += derivative_bytes_[derivative].at(geometry);
+    }
+    return bytes;
+  }
+
+  /**
+   * @brief start recording the performance counter of one of this integral's kernels
+   *
+   * The counters are named `Functional/integral_<id>/<domain|boundary>/<geometry>/<operation>`.
+   *
+   * @param counter the counter to start
+   * @param geometry the element geometry of the kernel
+   * @param operation the kind of kernel: "evaluate", "jvp", "assemble" or "diagonal"
+   * @param bytes an estimate of the number of bytes read and written by the kernel
+   * @param num_vectors the number of vectors the kernel is applied to
+   */
+  void startCounter(profiling::ScopedCounter& counter, mfem::Geometry::Type geometry, const char* operation,
+                    std::size_t bytes, uint32_t num_vectors = 1) const
+  {
+    auto elements = std::int64_t(geometric_factors_.at(geometry).num_elements) * num_vectors;
+    auto qpts     = elements * std::int64_t(qpts_per_element_.at(geometry));
+    counter.start(counter_prefix_ + mfem::Geometry::Name[geometry] + "/" + operation,
+                  {1, 0.0, elements, qpts, std::int64_t(bytes), 0});
+  }
+
   /// @brief information about which elements to integrate over
   Domain domain_;
 
@@ -132,8 +332,15 @@ struct Integral {
   /// @brief kernels for integral evaluation + derivative w.r.t. specified argument over each type of element
   std::vector<std::map<mfem::Geometry::Type, eval_func> > evaluation_with_AD_;
 
-  /// @brief signature of element jvp kernel
-  using jacobian_vector_product_func = std::function<void(const double*, double*)>;
+  /// @brief signature of integral evaluation kernel that also computes a combined derivative
+  using combined_eval_func =
+      std::function<void(double, const std::vector<const double*>&, double*, bool, std::array<double, 2>)>;
+
+  /// @brief kernels for integral evaluation + weighted sum of the derivatives w.r.t. two arguments (if requested)
+  std::map<mfem::Geometry::Type, combined_eval_func> evaluation_with_combined_AD_;
+
+  /// @brief signature of element jvp kernel, which applies the jacobian to a number of vectors stored with some stride
+  using jacobian_vector_product_func = std::function<void(const double*, double*, uint32_t, std::size_t, std::size_t)>;
 
   /// @brief kernels for jacobian-vector product of integral calculation
   std::vector<std::map<mfem::Geometry::Type, jacobian_vector_product_func> > jvp_;
@@ -144,6 +351,12 @@ struct Integral {
   /// @brief kernels for calculation of element jacobians
   std::vector<std::map<mfem::Geometry::Type, grad_func> > element_gradient_;
 
+  /// @brief signature of element diagonal kernel
+  using diag_func = std::function<void(double*)>;
+
+  /// @brief kernels for calculation of the diagonal entries of the element jacobians
+  std::vector<std::map<mfem::Geometry::Type, diag_func> > element_diagonal_;
+
   /// @brief a list of the trial spaces that take part in this integrand
   std::vector<uint32_t> active_trial_spaces_;
 
@@ -165,26 +378,265 @@ struct Integral {
 
   /// @brief the spatial positions and jacobians (dx_dxi) for each element type and quadrature point
   std::map<mfem::Geometry::Type, GeometricFactors> geometric_factors_;
+
+  /// @brief the number of quadrature points per element, for each element type
+  std::map<mfem::Geometry::Type, uint32_t> qpts_per_element_;
+
+  /// @brief the size (in bytes) of the stored q-function derivatives, for each derivative and element type
+  std::vector<std::map<mfem::Geometry::Type, std::size_t> > derivative_bytes_;
+
+  /// @brief the data kept by each derivative and element type in order to apply the gradient, see DerivativeStorage
+  std::vector<std::shared_ptr<DerivativeBuffer> > derivative_buffers_;
+
+  /// @brief the prefix of the names of this integral's performance counters
+  std::string counter_prefix_;
+
+  /// @brief scratch space for the input pointers passed to the evaluation kernels, to avoid allocating in `Mult()`
+  mutable std::vector<const double*> inputs_;
 };
 
 /**
- * @brief function to generate kernels held by an `Integral` object of type "Domain", with a specific element type
+ * @brief function to generate the kernels held by an `Integral` object of type "Domain" for one of its derivatives,
+ * with a specific element type
  *
  * @tparam geom the element geometry
  * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam exec the execution space used by the element kernels
+ * @tparam policy how the q-function derivatives are kept, see DerivativeStorage
+ * @tparam i the (integral) index of the trial space being differentiated
+ * @tparam j the (integral) index of the other trial space of a combined derivative, or NO_DIFFERENTIATION
+ * @tparam derivative_type the type of the q-function derivatives at each quadrature point
  * @tparam test the kind of test functions used in the integral
  * @tparam trials the trial space(s) of the integral's inputs
  * @tparam lambda_type a callable object that implements the q-function concept
  * @tparam qpt_data_type any quadrature point data needed by the material model
  * @param s an object used to pass around test/trial information
  * @param integral the Integral object to initialize
+ * @param index the (integral) index of the derivative
  * @param qf the quadrature function
  * @param qdata the values of any quadrature point data for the material
  */
-template <mfem::Geometry::Type geom, int Q, typename test, typename... trials, typename lambda_type,
-          typename qpt_data_type>
-void generate_kernels(FunctionSignature<test(trials...)> s, Integral& integral, const lambda_type& qf,
-                      std::shared_ptr<QuadratureData<qpt_data_type> > qdata)
+template <mfem::Geometry::Type geom, int Q, ExecutionSpace exec, DerivativeStorage policy, uint32_t i, uint32_t j,
+          typename derivative_type, typename test, typename... trials, typename lambda_type, typename qpt_data_type>
+void generate_derivative_kernels(FunctionSignature<test(trials...)> s, Integral& integral, uint32_t index,
+                                 const lambda_type& qf, std::shared_ptr<QuadratureData<qpt_data_type> > qdata)
+{
+  const GeometricFactors& gf               = integral.geometric_factors_[geom];
+  const double*           positions        = gf.X.Read();
+  const double*           jacobians        = gf.J.Read();
+  const int*              elements         = &integral.domain_.get(geom)[0];
+  const uint32_t          num_elements     = uint32_t(gf.num_elements);
+  constexpr uint32_t      qpts_per_element = num_quadrature_points(geom, Q);
+  const std::size_t       num_qpts         = std::size_t(num_elements) * qpts_per_element;
+
+  using trial_space       = typename std::tuple_element<i, std::tuple<trials...> >::type;
+  constexpr bool combined = (j != NO_DIFFERENTIATION);
+  constexpr bool diagonal = std::is_same_v<test, trial_space>;
+
+  // allocate memory for the derivatives of the q-function at each quadrature point
+  //
+  // Note: the buffer's lifetime is managed in an unusual way! It is captured by-value in the
+  // kernels below to augment the reference count, and extend its lifetime to match
+  // that of the DomainIntegral that allocated it.
+  auto buffer = std::make_shared<DerivativeBuffer>();
+  integral.derivative_buffers_.push_back(buffer);
+
+  if constexpr (policy == DerivativeStorage::All) {
+    derivative_type* derivatives = buffer->allocate<derivative_type>(num_qpts);
+    auto             ptr         = std::shared_ptr<derivative_type>(buffer->data, derivatives);
+    integral.derivative_bytes_[index][geom] = buffer->bytes;
+
+    if constexpr (combined) {
+      integral.evaluation_with_combined_AD_[geom] = domain_integral::combined_evaluation_kernel<i, j, Q, geom, exec>(
+          s, qf, positions, jacobians, qdata, ptr, elements, num_elements);
+    } else {
+      integral.evaluation_with_AD_[index][geom] = domain_integral::evaluation_kernel<i, Q, geom, exec>(
+          s, qf, positions, jacobians, qdata, ptr, elements, num_elements);
+    }
+
+    integral.jvp_[index][geom] =
+        domain_integral::jacobian_vector_product_kernel<i, Q, geom, exec>(s, ptr, elements, num_elements);
+    integral.element_gradient_[index][geom] =
+        domain_integral::element_gradient_kernel<i, Q, geom, exec>(s, ptr, elements, num_elements);
+    if constexpr (diagonal) {
+      integral.element_diagonal_[index][geom] =
+          domain_integral::element_diagonal_kernel<i, Q, geom, exec>(s, ptr, elements, num_elements);
+    }
+  } else {
+    auto trial_elements = trial_elements_tuple<geom>(s);
+    auto test_element   = get_test_element<geom>(s);
+
+    Integral::combined_eval_func evaluate;
+
+    // for DerivativeStorage::Symmetric and DerivativeStorage::Recompute, the derivatives of element e
+    // are written to a local buffer by `load(e, buffer)` each time the gradient is applied
+    std::function<void(uint32_t, derivative_type*)> load;
+
+    if constexpr (policy == DerivativeStorage::Recompute) {
+      static_assert(std::is_same_v<qpt_data_type, Nothing> || std::is_same_v<qpt_data_type, Empty>,
+                    "DerivativeStorage::Recompute only supports q-functions without internal variables");
+
+      // the element values of each argument are stored contiguously, one argument after another
+      constexpr std::size_t num_args                   = sizeof...(trials);
+      constexpr std::size_t dofs_per_element[num_args] = {
+          (sizeof(typename finite_element<geom, trials>::dof_type) / sizeof(double))...};
+      std::array<std::size_t, num_args> offsets{};
+      std::size_t                       values_per_element = 0;
+      for (std::size_t k = 0; k < num_args; k++) {
+        offsets[k] = values_per_element * num_elements;
+        values_per_element += dofs_per_element[k];
+      }
+      integral.derivative_bytes_[index][geom] = values_per_element * num_elements * sizeof(double);
+
+      // the residual is evaluated as usual, without derivatives, and the point of linearization is recorded
+      auto evaluate_without_AD = integral.evaluation_[geom];
+      evaluate = [=](double t, const std::vector<const double*>& inputs, double* outputs, bool update_state,
+                     std::array<double, 2> weights) {
+        double* values = buffer->allocate<double>(values_per_element * num_elements);
+        for (std::size_t k = 0; k < num_args; k++) {
+          for (uint32_t e = 0; e < num_elements; e++) {
+            std::copy_n(inputs[k] + std::size_t(elements[e]) * dofs_per_element[k], dofs_per_element[k],
+                        values + offsets[k] + e * dofs_per_element[k]);
+          }
+        }
+        buffer->time    = t;
+        buffer->weights = weights;
+        evaluate_without_AD(t, inputs, outputs, update_state);
+      };
+
+      // the q-function derivatives of element e are recomputed by evaluating that element alone
+      std::size_t x_stride = std::size_t(gf.X.Size()) / num_elements;
+      std::size_t J_stride = std::size_t(gf.J.Size()) / num_elements;
+      load                 = [=](uint32_t e, derivative_type* derivatives) {
+        const double*                       values = buffer->get<double>();
+        std::array<const double*, num_args> element_inputs;
+        for (std::size_t k = 0; k < num_args; k++) {
+          element_inputs[k] = values + offsets[k] + e * dofs_per_element[k];
+        }
+
+        const int                                 first_element = 0;
+        typename decltype(test_element)::dof_type residual{};
+        domain_integral::evaluation_kernel_impl<i, j, Q, geom, ExecutionSpace::CPU>(
+            trial_elements, test_element, buffer->time, element_inputs, reinterpret_cast<double*>(&residual),
+            positions + e * x_stride, jacobians + e * J_stride, qf, (*qdata)[geom], derivatives, &first_element, 1,
+            false, buffer->weights, s.index_seq);
+      };
+    } else {
+      // DerivativeStorage::Symmetric stores compressed derivatives, which are expanded again one element at a time
+      using stored_type =
+          std::conditional_t<policy == DerivativeStorage::Symmetric, SymmetricDerivative<derivative_type>,
+                             derivative_type>;
+      integral.derivative_bytes_[index][geom] = sizeof(stored_type) * num_qpts;
+
+      evaluate = [=](double t, const std::vector<const double*>& inputs, double* outputs, bool update_state,
+                     std::array<double, 2> weights) {
+        stored_type* derivatives = buffer->allocate<stored_type>(num_qpts);
+        domain_integral::evaluation_kernel_impl<i, j, Q, geom, exec>(
+            trial_elements, test_element, t, inputs, outputs, positions, jacobians, qf, (*qdata)[geom], derivatives,
+            elements, num_elements, update_state, weights, s.index_seq);
+      };
+
+      if constexpr (policy == DerivativeStorage::Symmetric) {
+        load = [=](uint32_t e, derivative_type* derivatives) {
+          const stored_type* stored = buffer->get<stored_type>() + std::size_t(e) * qpts_per_element;
+          for (uint32_t q = 0; q < qpts_per_element; q++) {
+            derivatives[q] = stored[q].get();
+          }
+        };
+      }
+    }
+
+    if constexpr (combined) {
+      integral.evaluation_with_combined_AD_[geom] = evaluate;
+    } else {
+      integral.evaluation_with_AD_[index][geom] = [evaluate](double t, const std::vector<const double*>& inputs,
+                                                             double* outputs, bool update_state) {
+        evaluate(t, inputs, outputs, update_state, {1.0, 1.0});
+      };
+    }
+
+    auto check_linearized = [buffer]() {
+      SLIC_ERROR_IF(!buffer->allocated(),
+                    "the gradient of an integral was used before it was evaluated with differentiate_wrt()");
+    };
+
+    if constexpr (policy == DerivativeStorage::Differentiated) {
+      integral.jvp_[index][geom] = [=](const double* du, double* dr, uint32_t num_vectors, std::size_t du_stride,
+                                       std::size_t dr_stride) {
+        check_linearized();
+        domain_integral::action_of_gradient_kernel<Q, geom, test, trial_space, exec>(
+            du, dr, buffer->get<derivative_type>(), elements, num_elements, num_vectors, du_stride, dr_stride);
+      };
+      integral.element_gradient_[index][geom] = [=](ExecArrayView<double, 3, ExecutionSpace::CPU> dK) {
+        check_linearized();
+        domain_integral::element_gradient_kernel<geom, test, trial_space, Q, exec>(
+            dK, buffer->get<derivative_type>(), elements, num_elements);
+      };
+      if constexpr (diagonal) {
+        integral.element_diagonal_[index][geom] = [=](double* dD) {
+          check_linearized();
+          domain_integral::element_diagonal_kernel<geom, test, trial_space, Q, exec>(
+              dD, buffer->get<derivative_type>(), elements, num_elements);
+        };
+      }
+    } else {
+      // each element's derivatives are loaded into a buffer on the stack, and the
+      // usual kernels are applied to that element alone
+      integral.jvp_[index][geom] = [=](const double* du, double* dr, uint32_t num_vectors, std::size_t du_stride,
+                                       std::size_t dr_stride) {
+        check_linearized();
+        accelerator::forall<exec>(num_elements, [&](uint32_t e) {
+          derivative_type derivatives[qpts_per_element];
+          load(e, derivatives);
+          domain_integral::action_of_gradient_kernel<Q, geom, test, trial_space, ExecutionSpace::CPU>(
+              du, dr, derivatives, elements + e, 1, num_vectors, du_stride, dr_stride);
+        });
+      };
+      integral.element_gradient_[index][geom] = [=](ExecArrayView<double, 3, ExecutionSpace::CPU> dK) {
+        check_linearized();
+        accelerator::forall<exec>(num_elements, [&](uint32_t e) {
+          derivative_type derivatives[qpts_per_element];
+          load(e, derivatives);
+          domain_integral::element_gradient_kernel<geom, test, trial_space, Q, ExecutionSpace::CPU>(
+              dK, derivatives, elements + e, 1);
+        });
+      };
+      if constexpr (diagonal) {
+        integral.element_diagonal_[index][geom] = [=](double* dD) {
+          check_linearized();
+          accelerator::forall<exec>(num_elements, [&](uint32_t e) {
+            derivative_type derivatives[qpts_per_element];
+            load(e, derivatives);
+            domain_integral::element_diagonal_kernel<geom, test, trial_space, Q, ExecutionSpace::CPU>(
+                dD, derivatives, elements + e, 1);
+          });
+        };
+      }
+    }
+  }
+}
+
+/**
+ * @brief function to generate kernels held by an `Integral` object of type "Domain", with a specific element type
+ *
+ * @tparam geom the element geometry
+ * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam exec the execution space used by the element kernels
+ * @tparam test the kind of test functions used in the integral
+ * @tparam trials the trial space(s) of the integral's inputs
+ * @tparam lambda_type a callable object that implements the q-function concept, optionally wrapped by
+ * with_derivative_storage()
+ * @tparam qpt_data_type any quadrature point data needed by the material model
+ * @tparam i, j the (integral) indices of the trial spaces of a combined derivative, if any
+ * @param s an object used to pass around test/trial information
+ * @param integral the Integral object to initialize
+ * @param integrand the quadrature function
+ * @param qdata the values of any quadrature point data for the material
+ */
+template <mfem::Geometry::Type geom, int Q, ExecutionSpace exec, typename test, typename... trials,
+          typename lambda_type, typename qpt_data_type, uint32_t i, uint32_t j>
+void generate_kernels(FunctionSignature<test(trials...)> s, Integral& integral, const lambda_type& integrand,
+                      std::shared_ptr<QuadratureData<qpt_data_type> > qdata, CombinedDerivative<i, j>)
 {
   integral.geometric_factors_[geom] = GeometricFactors(integral.domain_, Q, geom);
   GeometricFactors& gf              = integral.geometric_factors_[geom];
@@ -195,30 +647,36 @@ void generate_kernels(FunctionSignature<test(trials...)> s, Integral& integral,
   const int*     elements         = &integral.domain_.get(geom)[0];
   const uint32_t num_elements     = uint32_t(gf.num_elements);
   const uint32_t qpts_per_element = num_quadrature_points(geom, Q);
+  integral.qpts_per_element_[geom] = qpts_per_element;
+
+  constexpr DerivativeStorage policy = derivative_storage_policy<lambda_type>::value;
+  const auto&                 qf     = unwrap_derivative_storage(integrand);
 
   std::shared_ptr<zero> dummy_derivatives;
-  integral.evaluation_[geom] = domain_integral::evaluation_kernel<NO_DIFFERENTIATION, Q, geom>(
+  integral.evaluation_[geom] = domain_integral::evaluation_kernel<NO_DIFFERENTIATION, Q, geom, exec>(
       s, qf, positions, jacobians, qdata, dummy_derivatives, elements, num_elements);
 
   constexpr std::size_t                 num_args = s.num_args;
   [[maybe_unused]] static constexpr int dim      = dimension_of(geom);
   for_constexpr<num_args>([&](auto index) {
-    // allocate memory for the derivatives of the q-function at each quadrature point
-    //
-    // Note: ptrs' lifetime is managed in an unusual way! It is captured by-value in the
-    // action_of_gradient functor below to augment the reference count, and extend its lifetime to match
-    // that of the DomainIntegral that allocated it.
     using derivative_type = decltype(domain_integral::get_derivative_type<index, dim, trials...>(qf, qpt_data_type{}));
-    auto ptr = accelerator::make_shared_array<ExecutionSpace::CPU, derivative_type>(num_elements * qpts_per_element);
-
-    integral.evaluation_with_AD_[index][geom] = domain_integral::evaluation_kernel<index, Q, geom>(
-        s, qf, positions, jacobians, qdata, ptr, elements, num_elements);
-
-    integral.jvp_[index][geom] =
-        domain_integral::jacobian_vector_product_kernel<index, Q, geom>(s, ptr, elements, num_elements);
-    integral.element_gradient_[index][geom] =
-        domain_integral::element_gradient_kernel<index, Q, geom>(s, ptr, elements, num_elements);
+    generate_derivative_kernels<geom, Q, exec, policy, index, NO_DIFFERENTIATION, derivative_type>(
+        s, integral, uint32_t(index), qf, qdata);
   });
+
+  // kernels for the weighted sum of the derivatives w.r.t. arguments i and j, which are
+  // stored after the kernels for the individual arguments and use the trial space of argument i
+  //
+  // note: the combined derivative is only used by some solves (e.g. implicit dynamics), so its
+  // storage is allocated the first time it is evaluated, unless a more compact policy was requested
+  if constexpr (i != NO_DIFFERENTIATION) {
+    using derivative_type =
+        decltype(domain_integral::get_combined_derivative_type<i, j, dim, trials...>(qf, qpt_data_type{}));
+    constexpr DerivativeStorage combined_policy =
+        (policy == DerivativeStorage::All) ? DerivativeStorage::Differentiated : policy;
+    generate_derivative_kernels<geom, Q, exec, combined_policy, i, j, derivative_type>(
+        s, integral, uint32_t(num_args), qf, qdata);
+  }
 }
 
 /**
@@ -227,53 +685,183 @@ void generate_kernels(FunctionSignature<test(trials...)> s, Integral& integral,
  * @tparam s a function signature type containing test/trial space informationa type containing a function signature
  * @tparam Q a parameter that controls the number of quadrature points
  * @tparam dim the dimension of the domain
- * @tparam lambda_type a callable object that implements the q-function concept
+ * @tparam exec the execution space used by the element kernels
+ * @tparam lambda_type a callable object that implements the q-function concept, optionally wrapped by
+ * with_derivative_storage()
  * @tparam qpt_data_type any quadrature point data needed by the material model
  * @param domain the domain of integration
  * @param qf the quadrature function
  * @param qdata the values of any quadrature point data for the material
  * @param argument_indices the indices of trial space arguments used in the Integral
+ * @param combined the (integral) indices of the trial spaces of a combined derivative, if any
  * @return Integral the initialized `Integral` object
  */
-template <typename s, int Q, int dim, typename lambda_type, typename qpt_data_type>
+template <typename s, int Q, int dim, ExecutionSpace exec = ExecutionSpace::CPU, typename lambda_type,
+          typename qpt_data_type, uint32_t i = NO_DIFFERENTIATION, uint32_t j = NO_DIFFERENTIATION>
 Integral MakeDomainIntegral(const Domain& domain, const lambda_type& qf,
                             std::shared_ptr<QuadratureData<qpt_data_type> > qdata,
-                            std::vector<uint32_t>                           argument_indices)
+                            std::vector<uint32_t> argument_indices, CombinedDerivative<i, j> combined = {})
 {
   FunctionSignature<s> signature;
 
   SLIC_ERROR_IF(domain.type_ != Domain::Type::Elements, "Error: trying to evaluate a domain integral over a boundary");
 
-  Integral integral(domain, argument_indices);
+  uint32_t combined_index = NO_DIFFERENTIATION;
+  if constexpr (i != NO_DIFFERENTIATION) {
+    combined_index = combined_derivative_index(argument_indices[i], argument_indices[j]);
+  }
+
+  Integral integral(domain, argument_indices, combined_index);
 
   if constexpr (dim == 2) {
-    generate_kernels<mfem::Geometry::TRIANGLE, Q>(signature, integral, qf, qdata);
-    generate_kernels<mfem::Geometry::SQUARE, Q>(signature, integral, qf, qdata);
+    generate_kernels<mfem::Geometry::TRIANGLE, Q, exec>(signature, integral, qf, qdata, combined);
+    generate_kernels<mfem::Geometry::SQUARE, Q, exec>(signature, integral, qf, qdata, combined);
   }
 
   if constexpr (dim == 3) {
-    generate_kernels<mfem::Geometry::TETRAHEDRON, Q>(signature, integral, qf, qdata);
-    generate_kernels<mfem::Geometry::CUBE, Q>(signature, integral, qf, qdata);
+    generate_kernels<mfem::Geometry::TETRAHEDRON, Q, exec>(signature, integral, qf, qdata, combined);
+    generate_kernels<mfem::Geometry::CUBE, Q, exec>(signature, integral, qf, qdata, combined);
   }
 
   return integral;
 }
 
 /**
- * @brief function to generate kernels held by an `Integral` object of type "BoundaryDomain", with a specific element
- * type
+ * @brief function to generate the kernels held by an `Integral` object of type "BoundaryDomain" for one of its
+ * derivatives, with a specific element type
  *
  * @tparam geom the element geometry
  * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam exec the execution space used by the element kernels
+ * @tparam policy how the q-function derivatives are kept, see DerivativeStorage
+ * @tparam i the (integral) index of the trial space being differentiated
+ * @tparam j the (integral) index of the other trial space of a combined derivative, or NO_DIFFERENTIATION
+ * @tparam derivative_type the type of the q-function derivatives at each quadrature point
  * @tparam test the kind of test functions used in the integral
  * @tparam trials the trial space(s) of the integral's inputs
  * @tparam lambda_type a callable object that implements the q-function concept
  * @param s an object used to pass around test/trial information
  * @param integral the Integral object to initialize
+ * @param index the (integral) index of the derivative
  * @param qf the quadrature function
+ *
+ * @note boundary q-functions have no 4th order tangents to compress, and recomputing their derivatives is not
+ * supported, so every policy other than DerivativeStorage::All is treated like DerivativeStorage::Differentiated
+ */
+template <mfem::Geometry::Type geom, int Q, ExecutionSpace exec, DerivativeStorage policy, uint32_t i, uint32_t j,
+          typename derivative_type, typename test, typename... trials, typename lambda_type>
+void generate_bdr_derivative_kernels(FunctionSignature<test(trials...)> s, Integral& integral, uint32_t index,
+                                     const lambda_type& qf)
+{
+  const GeometricFactors& gf               = integral.geometric_factors_[geom];
+  const double*           positions        = gf.X.Read();
+  const double*           jacobians        = gf.J.Read();
+  const uint32_t          num_elements     = uint32_t(gf.num_elements);
+  const uint32_t          qpts_per_element = num_quadrature_points(geom, Q);
+  const int*              elements         = &gf.elements[0];
+  const std::size_t       num_qpts         = std::size_t(num_elements) * qpts_per_element;
+
+  using trial_space       = typename std::tuple_element<i, std::tuple<trials...> >::type;
+  constexpr bool combined = (j != NO_DIFFERENTIATION);
+  constexpr bool diagonal = std::is_same_v<test, trial_space>;
+
+  // allocate memory for the derivatives of the q-function at each quadrature point
+  //
+  // Note: the buffer's lifetime is managed in an unusual way! It is captured by-value in the
+  // kernels below to augment the reference count, and extend its lifetime to match
+  // that of the boundaryIntegral that allocated it.
+  auto buffer = std::make_shared<DerivativeBuffer>();
+  integral.derivative_buffers_.push_back(buffer);
+  integral.derivative_bytes_[index][geom] = sizeof(derivative_type) * num_qpts;
+
+  if constexpr (policy == DerivativeStorage::All) {
+    derivative_type* derivatives = buffer->allocate<derivative_type>(num_qpts);
+    auto             ptr         = std::shared_ptr<derivative_type>(buffer->data, derivatives);
+
+    if constexpr (combined) {
+      integral.evaluation_with_combined_AD_[geom] = boundary_integral::combined_evaluation_kernel<i, j, Q, geom, exec>(
+          s, qf, positions, jacobians, ptr, elements, num_elements);
+    } else {
+      integral.evaluation_with_AD_[index][geom] = boundary_integral::evaluation_kernel<i, Q, geom, exec>(
+          s, qf, positions, jacobians, ptr, elements, num_elements);
+    }
+
+    integral.jvp_[index][geom] =
+        boundary_integral::jacobian_vector_product_kernel<i, Q, geom, exec>(s, ptr, elements, num_elements);
+    integral.element_gradient_[index][geom] =
+        boundary_integral::element_gradient_kernel<i, Q, geom, exec>(s, ptr, elements, num_elements);
+    if constexpr (diagonal) {
+      integral.element_diagonal_[index][geom] =
+          boundary_integral::element_diagonal_kernel<i, Q, geom, exec>(s, ptr, elements, num_elements);
+    }
+  } else {
+    auto trial_elements = trial_elements_tuple<geom>(s);
+    auto test_element   = get_test_element<geom>(s);
+
+    // the derivatives are only allocated when they are first computed
+    Integral::combined_eval_func evaluate = [=](double t, const std::vector<const double*>& inputs, double* outputs,
+                                                bool /* update state */, std::array<double, 2> weights) {
+      derivative_type* derivatives = buffer->allocate<derivative_type>(num_qpts);
+      boundary_integral::evaluation_kernel_impl<i, j, Q, geom, exec>(trial_elements, test_element, t, inputs, outputs,
+                                                                     positions, jacobians, qf, derivatives, elements,
+                                                                     num_elements, weights, s.index_seq);
+    };
+
+    if constexpr (combined) {
+      integral.evaluation_with_combined_AD_[geom] = evaluate;
+    } else {
+      integral.evaluation_with_AD_[index][geom] = [evaluate](double t, const std::vector<const double*>& inputs,
+                                                             double* outputs, bool update_state) {
+        evaluate(t, inputs, outputs, update_state, {1.0, 1.0});
+      };
+    }
+
+    auto check_linearized = [buffer]() {
+      SLIC_ERROR_IF(!buffer->allocated(),
+                    "the gradient of an integral was used before it was evaluated with differentiate_wrt()");
+    };
+
+    integral.jvp_[index][geom] = [=](const double* du, double* dr, uint32_t num_vectors, std::size_t du_stride,
+                                     std::size_t dr_stride) {
+      check_linearized();
+      boundary_integral::action_of_gradient_kernel<Q, geom, test, trial_space, exec>(
+          du, dr, buffer->get<derivative_type>(), elements, num_elements, num_vectors, du_stride, dr_stride);
+    };
+    integral.element_gradient_[index][geom] = [=](ExecArrayView<double, 3, ExecutionSpace::CPU> dK) {
+      check_linearized();
+      boundary_integral::element_gradient_kernel<geom, test, trial_space, Q, exec>(
+          dK, buffer->get<derivative_type>(), elements, num_elements);
+    };
+    if constexpr (diagonal) {
+      integral.element_diagonal_[index][geom] = [=](double* dD) {
+        check_linearized();
+        boundary_integral::element_diagonal_kernel<geom, test, trial_space, Q, exec>(
+            dD, buffer->get<derivative_type>(), elements, num_elements);
+      };
+    }
+  }
+}
+
+/**
+ * @brief function to generate kernels held by an `Integral` object of type "BoundaryDomain", with a specific element
+ * type
+ *
+ * @tparam geom the element geometry
+ * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam exec the execution space used by the element kernels
+ * @tparam test the kind of test functions used in the integral
+ * @tparam trials the trial space(s) of the integral's inputs
+ * @tparam lambda_type a callable object that implements the q-function concept, optionally wrapped by
+ * with_derivative_storage()
+ * @tparam i, j the (integral) indices of the trial spaces of a combined derivative, if any
+ * @param s an object used to pass around test/trial information
+ * @param integral the Integral object to initialize
+ * @param integrand the quadrature function
  */
-template <mfem::Geometry::Type geom, int Q, typename test, typename... trials, typename lambda_type>
-void generate_bdr_kernels(FunctionSignature<test(trials...)> s, Integral& integral, const lambda_type& qf)
+template <mfem::Geometry::Type geom, int Q, ExecutionSpace exec, typename test, typename... trials,
+          typename lambda_type, uint32_t i, uint32_t j>
+void generate_bdr_kernels(FunctionSignature<test(trials...)> s, Integral& integral, const lambda_type& integrand,
+                          CombinedDerivative<i, j>)
 {
   integral.geometric_factors_[geom] = GeometricFactors(integral.domain_, Q, geom, FaceType::BOUNDARY);
   GeometricFactors& gf              = integral.geometric_factors_[geom];
@@ -284,30 +872,31 @@ void generate_bdr_kernels(FunctionSignature<test(trials...)> s, Integral& integr
   const uint32_t num_elements     = uint32_t(gf.num_elements);
   const uint32_t qpts_per_element = num_quadrature_points(geom, Q);
   const int*     elements         = &gf.elements[0];
+  integral.qpts_per_element_[geom] = qpts_per_element;
+
+  constexpr DerivativeStorage policy = derivative_storage_policy<lambda_type>::value;
+  const auto&                 qf     = unwrap_derivative_storage(integrand);
 
   std::shared_ptr<zero> dummy_derivatives;
-  integral.evaluation_[geom] = boundary_integral::evaluation_kernel<NO_DIFFERENTIATION, Q, geom>(
+  integral.evaluation_[geom] = boundary_integral::evaluation_kernel<NO_DIFFERENTIATION, Q, geom, exec>(
       s, qf, positions, jacobians, dummy_derivatives, elements, num_elements);
 
   constexpr std::size_t                 num_args = s.num_args;
   [[maybe_unused]] static constexpr int dim      = dimension_of(geom);
   for_constexpr<num_args>([&](auto index) {
-    // allocate memory for the derivatives of the q-function at each quadrature point
-    //
-    // Note: ptrs' lifetime is managed in an unusual way! It is captured by-value in the
-    // action_of_gradient functor below to augment the reference count, and extend its lifetime to match
-    // that of the boundaryIntegral that allocated it.
     using derivative_type = decltype(boundary_integral::get_derivative_type<index, dim, trials...>(qf));
-    auto ptr = accelerator::make_shared_array<ExecutionSpace::CPU, derivative_type>(num_elements * qpts_per_element);
-
-    integral.evaluation_with_AD_[index][geom] =
-        boundary_integral::evaluation_kernel<index, Q, geom>(s, qf, positions, jacobians, ptr, elements, num_elements);
-
-    integral.jvp_[index][geom] =
-        boundary_integral::jacobian_vector_product_kernel<index, Q, geom>(s, ptr, elements, num_elements);
-    integral.element_gradient_[index][geom] =
-        boundary_integral::element_gradient_kernel<index, Q, geom>(s, ptr, elements, num_elements);
+    generate_bdr_derivative_kernels<geom, Q, exec, policy, index, NO_DIFFERENTIATION, derivative_type>(
+        s, integral, uint32_t(index), qf);
   });
+
+  // kernels for the weighted sum of the derivatives w.r.t. arguments i and j, which are
+  // stored after the kernels for the individual arguments and use the trial space of argument i
+  // (and, like for domain integrals, are only allocated the first time they are evaluated)
+  if constexpr (i != NO_DIFFERENTIATION) {
+    using derivative_type = decltype(boundary_integral::get_combined_derivative_type<i, j, dim, trials...>(qf));
+    generate_bdr_derivative_kernels<geom, Q, exec, DerivativeStorage::Differentiated, i, j, derivative_type>(
+        s, integral, uint32_t(num_args), qf);
+  }
 }
 
 /**
@@ -316,31 +905,41 @@ void generate_bdr_kernels(FunctionSignature<test(trials...)> s, Integral& integr
  * @tparam s a function signature type containing test/trial space informationa type containing a function signature
  * @tparam Q a parameter that controls the number of quadrature points
  * @tparam dim the dimension of the domain
- * @tparam lambda_type a callable object that implements the q-function concept
+ * @tparam exec the execution space used by the element kernels
+ * @tparam lambda_type a callable object that implements the q-function concept, optionally wrapped by
+ * with_derivative_storage()
  * @param domain the domain of integration
  * @param qf the quadrature function
  * @param argument_indices the indices of trial space arguments used in the Integral
+ * @param combined the (integral) indices of the trial spaces of a combined derivative, if any
  * @return Integral the initialized `Integral` object
  *
  * @note this function is not meant to be called by users
  */
-template <typename s, int Q, int dim, typename lambda_type>
-Integral MakeBoundaryIntegral(const Domain& domain, const lambda_type& qf, std::vector<uint32_t> argument_indices)
+template <typename s, int Q, int dim, ExecutionSpace exec = ExecutionSpace::CPU, typename lambda_type,
+          uint32_t i = NO_DIFFERENTIATION, uint32_t j = NO_DIFFERENTIATION>
+Integral MakeBoundaryIntegral(const Domain& domain, const lambda_type& qf, std::vector<uint32_t> argument_indices,
+                              CombinedDerivative<i, j> combined = {})
 {
   FunctionSignature<s> signature;
 
   SLIC_ERROR_IF(domain.type_ != Domain::Type::BoundaryElements,
                 "Error: trying to evaluate a boundary integral over a non-boundary domain of integration");
 
-  Integral integral(domain, argument_indices);
+  uint32_t combined_index = NO_DIFFERENTIATION;
+  if constexpr (i != NO_DIFFERENTIATION) {
+    combined_index = combined_derivative_index(argument_indices[i], argument_indices[j]);
+  }
+
+  Integral integral(domain, argument_indices, combined_index);
 
   if constexpr (dim == 1) {
-    generate_bdr_kernels<mfem::Geometry::SEGMENT, Q>(signature, integral, qf);
+    generate_bdr_kernels<mfem::Geometry::SEGMENT, Q, exec>(signature, integral, qf, combined);
   }
 
   if constexpr (dim == 2) {
-    generate_bdr_kernels<mfem::Geometry::TRIANGLE, Q>(signature, integral, qf);
-    generate_bdr_kernels<mfem::Geometry::SQUARE, Q>(signature, integral, qf);
+    generate_bdr_kernels<mfem::Geometry::TRIANGLE, Q, exec>(signature, integral, qf, combined);
+    generate_bdr_kernels<mfem::Geometry::SQUARE, Q, exec>(signature, integral, qf, combined);
   }
 
   return integral;
@@ -457,11 +457,25 @@ public:
   void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand, domain_type& domain,
                          std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
   {
+    AddDomainIntegral(Dimension<dim>{}, DependsOn<args...>{}, NoCombinedDerivative{}, integrand, domain, qdata);
+  }
+
+  /**
+   * @overload
+   * @note the CombinedDerivative tag requests kernels for the weighted sum of the derivatives
+   * w.r.t. trial spaces i and j (not counting the shape displacement), see serac::CombinedDerivative
+   */
+  template <int dim, int... args, uint32_t i, uint32_t j, typename lambda, typename domain_type,
+            typename qpt_data_type = Nothing>
+  void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, CombinedDerivative<i, j>, const lambda& integrand,
+                         domain_type& domain, std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  {
+    using combined = CombinedDerivative<shifted_index(i), shifted_index(j)>;
     if constexpr (std::is_same_v<qpt_data_type, Nothing>) {
-      functional_->AddDomainIntegral(Dimension<dim>{}, DependsOn<0, (args + 1)...>{},
+      functional_->AddDomainIntegral(Dimension<dim>{}, DependsOn<0, (args + 1)...>{}, combined{},
                                      ShapeAwareIntegrandWrapper<lambda, dim, args...>(integrand), domain, qdata);
     } else {
-      functional_->AddDomainIntegral(Dimension<dim>{}, DependsOn<0, (args + 1)...>{},
+      functional_->AddDomainIntegral(Dimension<dim>{}, DependsOn<0, (args + 1)...>{}, combined{},
                                      ShapeAwareIntegrandWrapperWithState<lambda, dim, args...>(integrand), domain,
                                      qdata);
     }
@@ -515,7 +529,20 @@ public:
   template <int dim, int... args, typename lambda, typename domain_type>
   void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand, domain_type& domain)
   {
-    functional_->AddBoundaryIntegral(Dimension<dim>{}, DependsOn<0, (args + 1)...>{},
+    AddBoundaryIntegral(Dimension<dim>{}, DependsOn<args...>{}, NoCombinedDerivative{}, integrand, domain);
+  }
+
+  /**
+   * @overload
+   * @note the CombinedDerivative tag requests kernels for the weighted sum of the derivatives
+   * w.r.t. trial spaces i and j (not counting the shape displacement), see serac::CombinedDerivative
+   */
+  template <int dim, int... args, uint32_t i, uint32_t j, typename lambda, typename domain_type>
+  void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, CombinedDerivative<i, j>, const lambda& integrand,
+                           domain_type& domain)
+  {
+    using combined = CombinedDerivative<shifted_index(i), shifted_index(j)>;
+    functional_->AddBoundaryIntegral(Dimension<dim>{}, DependsOn<0, (args + 1)...>{}, combined{},
                                      ShapeAwareBoundaryIntegrandWrapper<lambda, dim, args...>(integrand), domain);
   }
 
@@ -549,7 +576,8 @@ public:
    *
    * @param t The time
    * @param args The trial space dofs used to carry out the calculation. The first argument is always the shape
-   * displacement. To compute a derivative, at most one argument can be of type `differentiate_wrt_this(mfem::Vector)`.
+   * displacement. To compute a derivative, at most one argument can be of type `differentiate_wrt_this(mfem::Vector)`,
+   * or two arguments if the integrals were registered with the matching CombinedDerivative tag.
    *
    * @return Either the evaluated integral value or a tuple of the integral value and the requested derivative.
    */
@@ -570,6 +598,9 @@ public:
   void updateQdata(bool update_flag) { functional_->updateQdata(update_flag); }
 
 private:
+  /// @brief the index of a trial space in the underlying Functional, which has the shape displacement prepended
+  static constexpr uint32_t shifted_index(uint32_t i) { return (i == NO_DIFFERENTIATION) ? i : i + 1; }
+
   /// @brief The underlying pure Functional object
   std::unique_ptr<Functional<test(shape, trials...), exec>> functional_;
 };
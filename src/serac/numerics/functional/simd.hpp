@@ -0,0 +1,434 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file simd.hpp
+ *
+ * @brief A number type that holds several doubles, so that q-functions can be evaluated at several quadrature points
+ * at once
+ */
+
+#pragma once
+
+#include <cmath>
+#include <utility>
+
+#include "serac/infrastructure/accelerator.hpp"
+
+namespace serac {
+
+/**
+ * @brief The number of doubles that fit in the widest vector registers the compiler was told it can use
+ * (8 for AVX-512, 4 for AVX/AVX2, and 2 for SSE2/NEON)
+ */
+#if defined(__AVX512F__)
+inline constexpr int default_simd_width = 8;
+#elif defined(__AVX__)
+inline constexpr int default_simd_width = 4;
+#else
+inline constexpr int default_simd_width = 2;
+#endif
+
+/**
+ * @brief The result of comparing two simd numbers, one bool per lane
+ * @tparam W the number of lanes
+ */
+template <int W>
+struct simd_mask {
+  SERAC_HOST_DEVICE constexpr bool&       operator[](int i) { return lanes[i]; }        ///< access lane i
+  SERAC_HOST_DEVICE constexpr const bool& operator[](int i) const { return lanes[i]; }  ///< access lane i
+
+  bool lanes[W];  ///< the result of the comparison in each lane
+};
+
+/**
+ * @brief A number made of W doubles, where every arithmetic operation and math function acts on each lane separately
+ *
+ * The fixed-size loops over the lanes are vectorized by the compiler, so that templated q-functions and material
+ * models that are instantiated with `simd<W>` in place of `double` (and `dual<...simd<W>...>` in place of
+ * `dual<...double...>`) evaluate W quadrature points with the same instructions it takes to evaluate one.
+ *
+ * @note Comparisons return a `simd_mask`, which can not be used in an `if` statement or `?:` expression, since the
+ * lanes may disagree. Code that branches on its arguments has to use select() instead.
+ *
+ * @tparam W the number of lanes
+ */
+template <int W>
+struct simd {
+  static_assert(W > 0 && (W & (W - 1)) == 0, "the width of a simd number must be a power of 2");
+
+  static constexpr int width = W;  ///< the number of lanes
+
+  /// @brief a simd number with every lane equal to zero
+  SERAC_HOST_DEVICE constexpr simd() : lanes{} {}
+
+  /// @brief a simd number with every lane equal to @p value
+  SERAC_HOST_DEVICE constexpr simd(double value) : lanes{}
+  {
+    for (int i = 0; i < W; i++) {
+      lanes[i] = value;
+    }
+  }
+
+  SERAC_HOST_DEVICE constexpr double&       operator[](int i) { return lanes[i]; }        ///< access lane i
+  SERAC_HOST_DEVICE constexpr const double& operator[](int i) const { return lanes[i]; }  ///< access lane i
+
+  /// @brief lane-wise compound addition
+  SERAC_HOST_DEVICE constexpr simd& operator+=(const simd& other)
+  {
+    for (int i = 0; i < W; i++) {
+      lanes[i] += other.lanes[i];
+    }
+    return *this;
+  }
+
+  /// @brief lane-wise compound subtraction
+  SERAC_HOST_DEVICE constexpr simd& operator-=(const simd& other)
+  {
+    for (int i = 0; i < W; i++) {
+      lanes[i] -= other.lanes[i];
+    }
+    return *this;
+  }
+
+  /// @brief lane-wise compound multiplication
+  SERAC_HOST_DEVICE constexpr simd& operator*=(const simd& other)
+  {
+    for (int i = 0; i < W; i++) {
+      lanes[i] *= other.lanes[i];
+    }
+    return *this;
+  }
+
+  /// @brief lane-wise compound division
+  SERAC_HOST_DEVICE constexpr simd& operator/=(const simd& other)
+  {
+    for (int i = 0; i < W; i++) {
+      lanes[i] /= other.lanes[i];
+    }
+    return *this;
+  }
+
+  alignas(W * sizeof(double)) double lanes[W];  ///< the value in each lane
+};
+
+/** @brief class for checking if a type is a simd number or not */
+template <typename T>
+struct is_simd {
+  static constexpr bool value = false;  ///< whether or not type T is a simd number
+};
+
+/** @brief class for checking if a type is a simd number or not */
+template <int W>
+struct is_simd<simd<W> > {
+  static constexpr bool value = true;  ///< whether or not type T is a simd number
+};
+
+/** @brief unary plus of a simd number */
+template <int W>
+SERAC_HOST_DEVICE constexpr simd<W> operator+(const simd<W>& x)
+{
+  return x;
+}
+
+/** @brief unary negation of a simd number */
+template <int W>
+SERAC_HOST_DEVICE constexpr simd<W> operator-(const simd<W>& x)
+{
+  simd<W> y;
+  for (int i = 0; i < W; i++) {
+    y[i] = -x[i];
+  }
+  return y;
+}
+
+/**
+ * @brief Generates the lane-wise overloads of a binary arithmetic operator for simd numbers and doubles
+ * @param[in] x The operator to overload
+ */
+#define simd_binary_operator_overload(x)                                                \
+  template <int W>                                                                      \
+  SERAC_HOST_DEVICE constexpr simd<W> operator x(const simd<W>& a, const simd<W>& b)    \
+  {                                                                                     \
+    simd<W> c;                                                                          \
+    for (int i = 0; i < W; i++) {                                                       \
+      c[i] = a[i] x b[i];                                                               \
+    }                                                                                   \
+    return c;                                                                           \
+  }                                                                                     \
+                                                                                        \
+  template <int W>                                                                      \
+  SERAC_HOST_DEVICE constexpr simd<W> operator x(const simd<W>& a, double b)            \
+  {                                                                                     \
+    simd<W> c;                                                                          \
+    for (int i = 0; i < W; i++) {                                                       \
+      c[i] = a[i] x b;                                                                  \
+    }                                                                                   \
+    return c;                                                                           \
+  }                                                                                     \
+                                                                                        \
+  template <int W>                                                                      \
+  SERAC_HOST_DEVICE constexpr simd<W> operator x(double a, const simd<W>& b)            \
+  {                                                                                     \
+    simd<W> c;                                                                          \
+    for (int i = 0; i < W; i++) {                                                       \
+      c[i] = a x b[i];                                                                  \
+    }                                                                                   \
+    return c;                                                                           \
+  }
+
+simd_binary_operator_overload(+);  ///< implement operator+ for simd numbers
+simd_binary_operator_overload(-);  ///< implement operator- for simd numbers
+simd_binary_operator_overload(*);  ///< implement operator* for simd numbers
+simd_binary_operator_overload(/);  ///< implement operator/ for simd numbers
+
+#undef simd_binary_operator_overload
+
+/**
+ * @brief Generates the lane-wise overloads of a binary comparison operator for simd numbers and doubles
+ * @param[in] x The comparison operator to overload
+ */
+#define simd_binary_comparator_overload(x)                                                  \
+  template <int W>                                                                          \
+  SERAC_HOST_DEVICE constexpr simd_mask<W> operator x(const simd<W>& a, const simd<W>& b)   \
+  {                                                                                         \
+    simd_mask<W> c{};                                                                       \
+    for (int i = 0; i < W; i++) {                                                           \
+      c[i] = a[i] x b[i];                                                                   \
+    }                                                                                       \
+    return c;                                                                               \
+  }                                                                                         \
+                                                                                            \
+  template <int W>                                                                          \
+  SERAC_HOST_DEVICE constexpr simd_mask<W> operator x(const simd<W>& a, double b)           \
+  {                                                                                         \
+    simd_mask<W> c{};                                                                       \
+    for (int i = 0; i < W; i++) {                                                           \
+      c[i] = a[i] x b;                                                                      \
+    }                                                                                       \
+    return c;                                                                               \
+  }                                                                                         \
+                                                                                            \
+  template <int W>                                                                          \
+  SERAC_HOST_DEVICE constexpr simd_mask<W> operator x(double a, const simd<W>& b)           \
+  {                                                                                         \
+    simd_mask<W> c{};                                                                       \
+    for (int i = 0; i < W; i++) {                                                           \
+      c[i] = a x b[i];                                                                      \
+    }                                                                                       \
+    return c;                                                                               \
+  }
+
+simd_binary_comparator_overload(<);   ///< implement operator<  for simd numbers
+simd_binary_comparator_overload(<=);  ///< implement operator<= for simd numbers
+simd_binary_comparator_overload(==);  ///< implement operator== for simd numbers
+simd_binary_comparator_overload(!=);  ///< implement operator!= for simd numbers
+simd_binary_comparator_overload(>=);  ///< implement operator>= for simd numbers
+simd_binary_comparator_overload(>);   ///< implement operator>  for simd numbers
+
+#undef simd_binary_comparator_overload
+
+/** @brief lane-wise logical and of two masks */
+template <int W>
+SERAC_HOST_DEVICE constexpr simd_mask<W> operator&&(const simd_mask<W>& a, const simd_mask<W>& b)
+{
+  simd_mask<W> c{};
+  for (int i = 0; i < W; i++) {
+    c[i] = a[i] && b[i];
+  }
+  return c;
+}
+
+/** @brief lane-wise logical or of two masks */
+template <int W>
+SERAC_HOST_DEVICE constexpr simd_mask<W> operator||(const simd_mask<W>& a, const simd_mask<W>& b)
+{
+  simd_mask<W> c{};
+  for (int i = 0; i < W; i++) {
+    c[i] = a[i] || b[i];
+  }
+  return c;
+}
+
+/** @brief lane-wise logical negation of a mask */
+template <int W>
+SERAC_HOST_DEVICE constexpr simd_mask<W> operator!(const simd_mask<W>& a)
+{
+  simd_mask<W> c{};
+  for (int i = 0; i < W; i++) {
+    c[i] = !a[i];
+  }
+  return c;
+}
+
+/** @brief whether the comparison is true in any lane */
+template <int W>
+SERAC_HOST_DEVICE constexpr bool any(const simd_mask<W>& a)
+{
+  bool result = false;
+  for (int i = 0; i < W; i++) {
+    result = result || a[i];
+  }
+  return result;
+}
+
+/** @brief whether the comparison is true in every lane */
+template <int W>
+SERAC_HOST_DEVICE constexpr bool all(const simd_mask<W>& a)
+{
+  bool result = true;
+  for (int i = 0; i < W; i++) {
+    result = result && a[i];
+  }
+  return result;
+}
+
+/** @brief the branch-free equivalent of `condition ? a : b` for doubles */
+SERAC_HOST_DEVICE constexpr double select(bool condition, double a, double b) { return condition ? a : b; }
+
+/** @brief the branch-free equivalent of `condition ? a : b`, evaluated in each lane */
+template <int W>
+SERAC_HOST_DEVICE constexpr simd<W> select(const simd_mask<W>& condition, const simd<W>& a, const simd<W>& b)
+{
+  simd<W> c;
+  for (int i = 0; i < W; i++) {
+    c[i] = condition[i] ? a[i] : b[i];
+  }
+  return c;
+}
+
+/**
+ * @brief Generates the lane-wise overload of a unary math function for simd numbers
+ * @param[in] f The function to overload
+ */
+#define simd_unary_function_overload(f)                   \
+  template <int W>                                        \
+  SERAC_HOST_DEVICE simd<W> f(const simd<W>& x)           \
+  {                                                       \
+    using std::f;                                         \
+    simd<W> y;                                            \
+    for (int i = 0; i < W; i++) {                         \
+      y[i] = f(x[i]);                                     \
+    }                                                     \
+    return y;                                             \
+  }
+
+simd_unary_function_overload(abs);    ///< implement abs   for simd numbers
+simd_unary_function_overload(sqrt);   ///< implement sqrt  for simd numbers
+simd_unary_function_overload(cbrt);   ///< implement cbrt  for simd numbers
+simd_unary_function_overload(exp);    ///< implement exp   for simd numbers
+simd_unary_function_overload(expm1);  ///< implement expm1 for simd numbers
+simd_unary_function_overload(log);    ///< implement log   for simd numbers
+simd_unary_function_overload(log1p);  ///< implement log1p for simd numbers
+simd_unary_function_overload(sin);    ///< implement sin   for simd numbers
+simd_unary_function_overload(cos);    ///< implement cos   for simd numbers
+simd_unary_function_overload(tan);    ///< implement tan   for simd numbers
+simd_unary_function_overload(asin);   ///< implement asin  for simd numbers
+simd_unary_function_overload(acos);   ///< implement acos  for simd numbers
+simd_unary_function_overload(atan);   ///< implement atan  for simd numbers
+
+#undef simd_unary_function_overload
+
+/**
+ * @brief Generates the lane-wise overloads of a binary math function for simd numbers and doubles
+ * @param[in] f The function to overload
+ */
+#define simd_binary_function_overload(f)                              \
+  template <int W>                                                    \
+  SERAC_HOST_DEVICE simd<W> f(const simd<W>& a, const simd<W>& b)     \
+  {                                                                   \
+    using std::f;                                                     \
+    simd<W> c;                                                        \
+    for (int i = 0; i < W; i++) {                                     \
+      c[i] = f(a[i], b[i]);                                           \
+    }                                                                 \
+    return c;                                                         \
+  }                                                                   \
+                                                                      \
+  template <int W>                                                    \
+  SERAC_HOST_DEVICE simd<W> f(const simd<W>& a, double b)             \
+  {                                                                   \
+    using std::f;                                                     \
+    simd<W> c;                                                        \
+    for (int i = 0; i < W; i++) {                                     \
+      c[i] = f(a[i], b);                                              \
+    }                                                                 \
+    return c;                                                         \
+  }                                                                   \
+                                                                      \
+  template <int W>                                                    \
+  SERAC_HOST_DEVICE simd<W> f(double a, const simd<W>& b)             \
+  {                                                                   \
+    using std::f;                                                     \
+    simd<W> c;                                                        \
+    for (int i = 0; i < W; i++) {                                     \
+      c[i] = f(a, b[i]);                                              \
+    }                                                                 \
+    return c;                                                         \
+  }
+
+simd_binary_function_overload(pow);    ///< implement pow   for simd numbers
+simd_binary_function_overload(atan2);  ///< implement atan2 for simd numbers
+simd_binary_function_overload(max);    ///< implement max   for simd numbers
+simd_binary_function_overload(min);    ///< implement min   for simd numbers
+
+#undef simd_binary_function_overload
+
+/**
+ * @brief A q-function that Functional may evaluate at W quadrature points at once, see vectorize()
+ *
+ * @tparam W the number of quadrature points evaluated at once
+ * @tparam lambda the type of the q-function
+ */
+template <int W, typename lambda>
+struct Vectorized {
+  static constexpr int width = W;  ///< the number of quadrature points evaluated at once
+
+  /// @brief evaluate the q-function, with arguments that are either packed with simd<W> or not
+  template <typename... arg_types>
+  SERAC_HOST_DEVICE auto operator()(arg_types&&... args) const
+  {
+    return qf(std::forward<arg_types>(args)...);
+  }
+
+  lambda qf;  ///< the q-function
+};
+
+/** @brief class for checking if a q-function type is marked for vectorized evaluation */
+template <typename T>
+struct is_vectorized {
+  static constexpr bool value = false;  ///< whether or not type T is a Vectorized q-function
+};
+
+/** @brief class for checking if a q-function type is marked for vectorized evaluation */
+template <int W, typename lambda>
+struct is_vectorized<Vectorized<W, lambda> > {
+  static constexpr bool value = true;  ///< whether or not type T is a Vectorized q-function
+};
+
+/**
+ * @brief Mark a q-function for evaluation at W quadrature points at once
+ *
+ * Domain integrals evaluate a vectorized q-function with each `double` in its arguments replaced by a `simd<W>`,
+ * holding the values at W consecutive quadrature points of an element. So, the q-function (and any material model it
+ * calls) must be templated on its number types, and must not branch on them. The time, and the internal variables of
+ * q-functions with state, are not packed, so only q-functions without internal variables (or with `Empty` ones) are
+ * evaluated this way. Other integrals evaluate the q-function one quadrature point at a time, as usual.
+ *
+ * \code{.cpp}
+ * residual.AddDomainIntegral(Dimension<3>{}, DependsOn<0>{}, vectorize(MyQFunction{}), domain);
+ * \endcode
+ *
+ * @tparam W the number of quadrature points evaluated at once, which defaults to the native vector width
+ * @param qf the q-function
+ */
+template <int W = default_simd_width, typename lambda>
+auto vectorize(lambda qf)
+{
+  return Vectorized<W, lambda>{qf};
+}
+
+}  // namespace serac
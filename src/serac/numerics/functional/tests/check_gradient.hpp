@@ -44,6 +44,31 @@ void check_gradient(serac::Functional<T, exec>& f, double t, mfem::Vector& U, do
     EXPECT_NEAR(0., relative_error, 5.e-6);
   }
 
+  // assembling in place should reproduce the same matrix, and keep returning the same object
+  if constexpr (exec != serac::ExecutionSpace::GPU) {
+    mfem::HypreParMatrix& first  = dfdU.assembleInPlace();
+    mfem::HypreParMatrix& second = dfdU.assembleInPlace();
+    EXPECT_EQ(&first, &second);
+
+    mfem::Vector df_jvp3(df_jvp2.Size());
+    second.Mult(dU, df_jvp3);
+    if (df_jvp2.Norml2() != 0) {
+      EXPECT_NEAR(0., df_jvp3.DistanceTo(df_jvp2.GetData()) / df_jvp2.Norml2(), 1.e-12);
+    }
+  }
+
+  // the matrix-free diagonal should agree with the diagonal of the assembled matrix
+  using test_space = typename serac::FunctionSignature<T>::return_type;
+  using trial_space = typename std::tuple_element<0, typename serac::FunctionSignature<T>::parameter_types>::type;
+  if constexpr (exec != serac::ExecutionSpace::GPU && std::is_same_v<test_space, trial_space>) {
+    mfem::Vector diag1, diag2;
+    dfdU.AssembleDiagonal(diag1);
+    dfdU_matrix->GetDiag(diag2);
+    if (diag2.Norml2() != 0) {
+      EXPECT_NEAR(0., diag1.DistanceTo(diag2.GetData()) / diag2.Norml2(), 1.e-12);
+    }
+  }
+
   // {f(x - 2 * h), f(x - h), f(x), f(x + h), f(x + 2 * h)}
   mfem::Vector f_values[5];
   for (int i = 0; i < 5; i++) {
@@ -0,0 +1,184 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <cstdlib>
+#include <new>
+
+#include <gtest/gtest.h>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include "mfem.hpp"
+
+#include "serac/numerics/functional/element_restriction.hpp"
+#include "serac/numerics/functional/functional.hpp"
+
+using namespace serac;
+
+std::string mesh_dir = SERAC_REPO_DIR "/data/meshes/";
+
+// count the number of heap allocations, to check that Gather / ScatterAdd
+// and Functional residual evaluations don't allocate in steady state
+static uint64_t num_allocations = 0;
+
+void* operator new(std::size_t size)
+{
+  num_allocations++;
+  if (void* ptr = std::malloc(size > 0 ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+void check_scatter_add_strategies(std::string meshfile, int p, int components)
+{
+  mfem::Mesh mesh(mesh_dir + meshfile, 1, 1);
+  mesh.UniformRefinement();
+
+  mfem::H1_FECollection    fec(p, mesh.Dimension());
+  mfem::FiniteElementSpace fes(&mesh, &fec, components, mfem::Ordering::byNODES);
+
+  BlockElementRestriction G(&fes);
+
+  for (auto& [geom, restriction] : G.restrictions) {
+    // elements with the same color must not share any nodes
+    for (uint64_t color = 0; color + 1 < restriction.color_offsets.size(); color++) {
+      std::vector<int> owner(restriction.num_nodes, -1);
+      for (int k = restriction.color_offsets[color]; k < restriction.color_offsets[color + 1]; k++) {
+        uint64_t e = uint64_t(restriction.colored_elements[uint64_t(k)]);
+        for (uint64_t j = 0; j < restriction.nodes_per_elem; j++) {
+          uint64_t n = restriction.dof_info(e, j).index();
+          EXPECT_TRUE(owner[n] == -1 || owner[n] == int(e));
+          owner[n] = int(e);
+        }
+      }
+    }
+
+    // every element is assigned exactly one color
+    EXPECT_EQ(uint64_t(restriction.color_offsets.back()), restriction.num_elements);
+  }
+
+  mfem::BlockVector E(G.bOffsets());
+  for (int i = 0; i < E.Size(); i++) {
+    E[i] = std::sin(double(i));
+  }
+
+  mfem::Vector L_serial(fes.GetVSize());
+  mfem::Vector L_coloring(fes.GetVSize());
+  mfem::Vector L_reduction(fes.GetVSize());
+  L_serial    = 1.0;
+  L_coloring  = 1.0;
+  L_reduction = 1.0;
+
+  G.ScatterAdd(E, L_serial, ScatterAddStrategy::Serial);
+  G.ScatterAdd(E, L_coloring, ScatterAddStrategy::ElementColoring);
+  G.ScatterAdd(E, L_reduction, ScatterAddStrategy::LDofReduction);
+
+  for (int i = 0; i < L_serial.Size(); i++) {
+    // the L-dof reduction visits contributions in the same order as the serial loop
+    EXPECT_EQ(L_serial[i], L_reduction[i]);
+
+    // element coloring may sum the contributions in a different order
+    EXPECT_NEAR(L_serial[i], L_coloring[i], 1.0e-12 * (1.0 + std::abs(L_serial[i])));
+  }
+}
+
+TEST(element_restriction, scatter_add_strategies_2D)
+{
+  for (int p = 1; p <= 3; p++) {
+    check_scatter_add_strategies("patch2D_tris_and_quads.mesh", p, 1);
+    check_scatter_add_strategies("patch2D_tris_and_quads.mesh", p, 2);
+  }
+}
+
+TEST(element_restriction, scatter_add_strategies_3D)
+{
+  for (int p = 1; p <= 3; p++) {
+    check_scatter_add_strategies("patch3D_tets_and_hexes.mesh", p, 1);
+    check_scatter_add_strategies("patch3D_tets_and_hexes.mesh", p, 3);
+  }
+}
+
+TEST(element_restriction, gather_and_scatter_add_do_not_allocate)
+{
+  mfem::Mesh mesh(mesh_dir + "patch3D_tets_and_hexes.mesh", 1, 1);
+  mesh.UniformRefinement();
+
+  mfem::H1_FECollection    fec(2, mesh.Dimension());
+  mfem::FiniteElementSpace fes(&mesh, &fec, 3, mfem::Ordering::byVDIM);
+
+  BlockElementRestriction G(&fes);
+
+  mfem::Vector L(fes.GetVSize());
+  L.Randomize();
+
+  mfem::BlockVector E(G.bOffsets());
+
+  for (auto strategy :
+       {ScatterAddStrategy::Serial, ScatterAddStrategy::ElementColoring, ScatterAddStrategy::LDofReduction}) {
+    uint64_t before = num_allocations;
+    for (int i = 0; i < 3; i++) {
+      G.Gather(L, E);
+      G.ScatterAdd(E, L, strategy);
+    }
+    EXPECT_EQ(num_allocations, before);
+  }
+}
+
+TEST(element_restriction, functional_residual_does_not_allocate)
+{
+  constexpr int p   = 2;
+  constexpr int dim = 3;
+
+  mfem::Mesh serial_mesh(mesh_dir + "patch3D_tets_and_hexes.mesh", 1, 1);
+  serial_mesh.UniformRefinement();
+  mfem::ParMesh mesh(MPI_COMM_WORLD, serial_mesh);
+
+  using space = H1<p, dim>;
+
+  auto [fespace, fec] = serac::generateParFiniteElementSpace<space>(&mesh);
+
+  Functional<space(space)> residual(fespace.get(), {fespace.get()});
+  residual.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0>{},
+      [](double /*t*/, auto /*x*/, auto displacement) {
+        auto [u, du_dX] = displacement;
+        return serac::tuple{u, du_dX + transpose(du_dX)};
+      },
+      mesh);
+
+  mfem::Vector U(fespace->TrueVSize());
+  U.Randomize();
+
+  double t = 0.0;
+
+  // the first evaluation may allocate (e.g. mfem's work vectors for the prolongation operators)
+  residual(t, U);
+
+  uint64_t before = num_allocations;
+  for (int i = 0; i < 3; i++) {
+    residual(t, U);
+  }
+  EXPECT_EQ(num_allocations, before);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  int result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
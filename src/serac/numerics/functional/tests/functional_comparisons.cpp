@@ -32,8 +32,10 @@ std::unique_ptr<mfem::ParMesh> mesh3D;
 static constexpr double a = 1.7;
 static constexpr double b = 2.1;
 
-#ifdef SERAC_USE_CUDA_KERNEL_EVALUATION
+#if defined(SERAC_USE_CUDA_KERNEL_EVALUATION)
 constexpr auto exec_space = serac::ExecutionSpace::GPU;
+#elif defined(SERAC_USE_OPENMP)
+constexpr auto exec_space = serac::ExecutionSpace::OpenMP;
 #else
 constexpr auto exec_space = serac::ExecutionSpace::CPU;
 #endif
@@ -427,6 +429,94 @@ void functional_test(mfem::ParMesh& mesh, Hcurl<p> test, Hcurl<p> trial, Dimensi
   EXPECT_NEAR(0., diff2.Norml2() / g1.Norml2(), 1.e-13);
 }
 
+/// @brief the q-function derivatives for a test space with `ci` components and a trial space with `cj` components
+template <int ci, int cj, int dim>
+using derivatives_t = serac::tuple<serac::tuple<tensor<double, ci, cj>, tensor<double, ci, cj, dim>>,
+                                   serac::tuple<tensor<double, ci, dim, cj>, tensor<double, ci, dim, cj, dim>>>;
+
+/// @brief the q-function derivatives for a scalar-valued test and trial space
+template <int dim>
+using scalar_derivatives_t = serac::tuple<serac::tuple<double, tensor<double, dim>>,
+                                          serac::tuple<tensor<double, dim>, tensor<double, dim, dim>>>;
+
+/// @brief the q-function derivatives for a q-function with a flux that only depends on the trial function gradient
+template <int c, int dim>
+using flux_only_derivatives_t =
+    serac::tuple<serac::tuple<zero, zero>, serac::tuple<zero, tensor<double, c, dim, c, dim>>>;
+
+template <typename T>
+void fill_with_arbitrary_values(T& x, double& counter)
+{
+  if constexpr (!is_zero<T>{}) {
+    double* values = reinterpret_cast<double*>(&x);
+    for (std::size_t k = 0; k < sizeof(T) / sizeof(double); k++) {
+      values[k] = std::sin(counter++);
+    }
+  }
+}
+
+// this test compares the sum-factorized element gradients for H1 elements on quadrilaterals and hexahedra
+// against the general approach of integrating one column of the element gradient at a time
+template <mfem::Geometry::Type g, typename test, typename trial, int Q, typename derivative_type>
+void element_gradient_test()
+{
+  using test_element  = finite_element<g, test>;
+  using trial_element = finite_element<g, trial>;
+
+  constexpr int                                   nquad = num_quadrature_points(g, Q);
+  static constexpr TensorProductQuadratureRule<Q> rule{};
+
+  double                         counter = 1.0;
+  tensor<derivative_type, nquad> derivatives{};
+  for (int q = 0; q < nquad; q++) {
+    fill_with_arbitrary_values(serac::get<0>(serac::get<0>(derivatives[q])), counter);
+    fill_with_arbitrary_values(serac::get<1>(serac::get<0>(derivatives[q])), counter);
+    fill_with_arbitrary_values(serac::get<0>(serac::get<1>(derivatives[q])), counter);
+    fill_with_arbitrary_values(serac::get<1>(serac::get<1>(derivatives[q])), counter);
+  }
+
+  constexpr int                                ntrial = trial_element::ndof * trial_element::components;
+  std::vector<typename test_element::dof_type> K_columns(ntrial);
+  std::vector<typename test_element::dof_type> K_sum_factorized(ntrial);
+
+  for (int J = 0; J < trial_element::ndof; J++) {
+    auto source_and_flux = trial_element::batch_apply_shape_fn(J, derivatives, rule);
+    test_element::integrate(source_and_flux, rule, &K_columns[uint64_t(J)], trial_element::ndof);
+  }
+
+  test_element::template element_gradient<trial_element>(&derivatives[0], rule, K_sum_factorized.data());
+
+  double error = 0.0;
+  double total = 0.0;
+  for (int J = 0; J < ntrial; J++) {
+    error += squared_norm(K_columns[uint64_t(J)] - K_sum_factorized[uint64_t(J)]);
+    total += squared_norm(K_columns[uint64_t(J)]);
+  }
+  EXPECT_NEAR(0.0, std::sqrt(error / total), 1.e-14);
+}
+
+TEST(ElementGradient, QuadrilateralSumFactorization)
+{
+  constexpr auto geom = mfem::Geometry::SQUARE;
+  element_gradient_test<geom, H1<1>, H1<1>, 2, scalar_derivatives_t<2>>();
+  element_gradient_test<geom, H1<2>, H1<2>, 3, scalar_derivatives_t<2>>();
+  element_gradient_test<geom, H1<3>, H1<3>, 4, scalar_derivatives_t<2>>();
+  element_gradient_test<geom, H1<2, 2>, H1<2, 2>, 3, derivatives_t<2, 2, 2>>();
+  element_gradient_test<geom, H1<2, 2>, H1<2, 2>, 3, flux_only_derivatives_t<2, 2>>();
+  element_gradient_test<geom, H1<2, 1>, H1<1, 2>, 3, derivatives_t<1, 2, 2>>();
+}
+
+TEST(ElementGradient, HexahedronSumFactorization)
+{
+  constexpr auto geom = mfem::Geometry::CUBE;
+  element_gradient_test<geom, H1<1>, H1<1>, 2, scalar_derivatives_t<3>>();
+  element_gradient_test<geom, H1<2>, H1<2>, 3, scalar_derivatives_t<3>>();
+  element_gradient_test<geom, H1<1, 3>, H1<1, 3>, 2, derivatives_t<3, 3, 3>>();
+  element_gradient_test<geom, H1<2, 3>, H1<2, 3>, 3, derivatives_t<3, 3, 3>>();
+  element_gradient_test<geom, H1<3, 3>, H1<3, 3>, 4, flux_only_derivatives_t<3, 3>>();
+  element_gradient_test<geom, H1<2, 3>, H1<1, 2>, 3, derivatives_t<3, 2, 3>>();
+}
+
 #ifndef SERAC_USE_CUDA_KERNEL_EVALUATION
 TEST(Thermal, 2DLinear) { functional_test(*mesh2D, H1<1>{}, H1<1>{}, Dimension<2>{}); }
 TEST(Thermal, 2DQuadratic) { functional_test(*mesh2D, H1<2>{}, H1<2>{}, Dimension<2>{}); }
@@ -0,0 +1,151 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include "serac/numerics/functional/functional.hpp"
+#include "serac/numerics/functional/tensor.hpp"
+#include "serac/numerics/functional/tests/neo_hookean_qfunction.hpp"
+
+using namespace serac;
+
+std::unique_ptr<mfem::ParMesh> mesh2D;
+std::unique_ptr<mfem::ParMesh> mesh3D;
+
+/// the relative difference between two vectors
+double relative_error(const mfem::Vector& a, const mfem::Vector& b)
+{
+  mfem::Vector difference(a);
+  difference -= b;
+  return difference.Normlinf() / std::max(b.Normlinf(), 1.0);
+}
+
+// check that each derivative storage policy gives the same residual, jacobian-vector product and
+// assembled jacobian as storing all of the derivatives, and compare the memory they use
+template <int p, int dim>
+void derivative_storage_test(mfem::ParMesh& mesh)
+{
+  using space     = H1<p, dim>;
+  using parameter = H1<1>;
+
+  using functional_type = Functional<space(space, parameter)>;
+
+  auto [fespace, fec]          = serac::generateParFiniteElementSpace<space>(&mesh);
+  auto [parameter_space, pfec] = serac::generateParFiniteElementSpace<parameter>(&mesh);
+
+  NeoHookeanQFunction<dim> qf{};
+
+  mfem::ParGridFunction u_global(fespace.get());
+  u_global.Randomize();
+  u_global *= 0.1;
+  mfem::Vector U(fespace->TrueVSize());
+  u_global.GetTrueDofs(U);
+
+  mfem::ParGridFunction parameter_global(parameter_space.get());
+  parameter_global.Randomize(1);
+  mfem::Vector P(parameter_space->TrueVSize());
+  parameter_global.GetTrueDofs(P);
+
+  mfem::Vector dU(U.Size());
+  dU.Randomize(2);
+
+  functional_type all(fespace.get(), {fespace.get(), parameter_space.get()});
+  all.AddDomainIntegral(Dimension<dim>{}, DependsOn<0, 1>{}, qf, mesh);
+
+  std::size_t all_bytes = all.storedDerivativeBytes();
+  EXPECT_GT(all_bytes, std::size_t{0});
+
+  double t = 0.0;
+
+  auto [r_expected, dr_expected] = all(t, differentiate_wrt(U), P);
+  mfem::Vector jvp_expected      = dr_expected(dU);
+  EXPECT_EQ(all.storedDerivativeBytes(), all_bytes);
+
+  std::size_t previous_bytes = all_bytes;
+
+  auto check_policy = [&](auto policy, const std::string& name) {
+    SCOPED_TRACE(name);
+
+    functional_type f(fespace.get(), {fespace.get(), parameter_space.get()});
+    f.AddDomainIntegral(Dimension<dim>{}, DependsOn<0, 1>{}, with_derivative_storage<decltype(policy)::value>(qf),
+                        mesh);
+
+    // nothing is stored until the integral is differentiated
+    EXPECT_EQ(f.storedDerivativeBytes(), std::size_t{0});
+
+    auto [r, dr] = f(t, differentiate_wrt(U), P);
+    EXPECT_LT(relative_error(r, r_expected), 1.0e-14);
+
+    mfem::Vector jvp = dr(dU);
+    EXPECT_LT(relative_error(jvp, jvp_expected), 1.0e-12);
+
+    std::unique_ptr<mfem::HypreParMatrix> K = assemble(dr);
+    mfem::Vector                          K_dU(U.Size());
+    K->Mult(dU, K_dU);
+    EXPECT_LT(relative_error(K_dU, jvp_expected), 1.0e-12);
+
+    // each policy stores less than the one before it
+    std::size_t bytes = f.storedDerivativeBytes();
+    EXPECT_GT(bytes, std::size_t{0});
+    EXPECT_LT(bytes, previous_bytes);
+    previous_bytes = bytes;
+  };
+
+  check_policy(std::integral_constant<DerivativeStorage, DerivativeStorage::Differentiated>{}, "Differentiated");
+  check_policy(std::integral_constant<DerivativeStorage, DerivativeStorage::Symmetric>{}, "Symmetric");
+  check_policy(std::integral_constant<DerivativeStorage, DerivativeStorage::Recompute>{}, "Recompute");
+}
+
+TEST(DerivativeStorage, 2DLinear) { derivative_storage_test<1, 2>(*mesh2D); }
+TEST(DerivativeStorage, 2DQuadratic) { derivative_storage_test<2, 2>(*mesh2D); }
+TEST(DerivativeStorage, 3DLinear) { derivative_storage_test<1, 3>(*mesh3D); }
+TEST(DerivativeStorage, 3DQuadratic) { derivative_storage_test<2, 3>(*mesh3D); }
+
+TEST(DerivativeStorage, MajorSymmetryRoundTrip)
+{
+  tensor<double, 3, 2, 3, 2> A{};
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 2; j++) {
+      for (int k = 0; k < 3; k++) {
+        for (int l = 0; l < 2; l++) {
+          A[i][j][k][l] = (i + 1) * (k + 1) + (j + 1) * (l + 1) + i + k;
+        }
+      }
+    }
+  }
+
+  using derivative_type = tuple<tensor<double, 3, 3>, tensor<double, 3, 2, 3, 2> >;
+  tensor<double, 3, 3> B{{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}, {7.0, 8.0, 9.0}}};
+  derivative_type      original{B, A};
+
+  SymmetricDerivative<derivative_type> stored;
+  stored = original;
+  static_assert(sizeof(stored) == sizeof(double) * (9 + 6 * 7 / 2));
+
+  derivative_type recovered = stored.get();
+  EXPECT_EQ(norm(get<0>(recovered) - get<0>(original)), 0.0);
+  EXPECT_EQ(norm(get<1>(recovered) - get<1>(original)), 0.0);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  mesh2D = buildPatchMesh(2);
+  mesh3D = buildPatchMesh(3);
+
+  int result = RUN_ALL_TESTS();
+  MPI_Finalize();
+
+  return result;
+}
@@ -80,6 +80,98 @@ TEST(FunctionalMultiphysics, NonlinearThermalTest3D)
   check_gradient(residual, t, U, dU_dt);
 }
 
+TEST(FunctionalMultiphysics, CombinedDerivative3D)
+{
+  int serial_refinement   = 1;
+  int parallel_refinement = 0;
+
+  constexpr auto p = 2;
+
+  std::string meshfile = SERAC_REPO_DIR "/data/meshes/patch3D_tets_and_hexes.mesh";
+  auto        mesh3D   = mesh::refineAndDistribute(buildMeshFromFile(meshfile), serial_refinement, parallel_refinement);
+
+  using test_space  = H1<p>;
+  using trial_space = H1<p>;
+
+  auto [fespace, fec] = serac::generateParFiniteElementSpace<test_space>(mesh3D.get());
+
+  mfem::Vector U(fespace->TrueVSize());
+  mfem::Vector dU_dt(fespace->TrueVSize());
+  mfem::Vector dU(fespace->TrueVSize());
+  int          seed = 0;
+  U.Randomize(seed);
+  dU_dt.Randomize(seed + 1);
+  dU.Randomize(seed + 2);
+
+  Functional<test_space(trial_space, trial_space)> residual(fespace.get(), {fespace.get(), fespace.get()});
+
+  residual.AddDomainIntegral(
+      Dimension<3>{}, DependsOn<0, 1>{}, CombinedDerivative<0, 1>{},
+      [=](double /*t*/, auto position, auto temperature, auto dtemperature_dt) {
+        auto [X, dX_dxi]     = position;
+        auto [u, du_dX]      = temperature;
+        auto [du_dt, unused] = dtemperature_dt;
+        auto source          = u * du_dt * du_dt - (100 * X[0] * X[1]);
+        auto flux            = (1.0 + u * u) * du_dX;
+        return serac::tuple{source, flux};
+      },
+      *mesh3D);
+
+  residual.AddBoundaryIntegral(
+      Dimension<2>{}, DependsOn<0, 1>{}, CombinedDerivative<0, 1>{},
+      [=](double /*t*/, auto position, auto temperature, auto dtemperature_dt) {
+        auto [X, dX_dxi] = position;
+        auto [u, _0]     = temperature;
+        auto [du_dt, _1] = dtemperature_dt;
+        return X[0] + X[1] - cos(u) * du_dt;
+      },
+      *mesh3D);
+
+  double t = 0.0;
+  double a = 0.25;
+  double b = 3.0;
+
+  // the storage for the combined derivative is only allocated when it is first evaluated
+  std::size_t bytes_before = residual.storedDerivativeBytes();
+
+  // note: the residual returned by each evaluation refers to the same internal vector, so it is copied here
+  auto [r, J] = residual(t, differentiate_wrt(U, a), differentiate_wrt(dU_dt, b));
+  mfem::Vector r_combined(r);
+
+  EXPECT_GT(residual.storedDerivativeBytes(), bytes_before);
+
+  auto [r_K, K] = residual(t, differentiate_wrt(U), dU_dt);
+  auto [r_M, M] = residual(t, U, differentiate_wrt(dU_dt));
+
+  // the residual itself is unaffected by the derivative weights
+  mfem::Vector r_diff(r_combined);
+  r_diff -= r_K;
+  EXPECT_LT(r_diff.Normlinf(), 1.0e-12 * r_combined.Normlinf());
+
+  // J should be the action of a * K + b * M ...
+  mfem::Vector J_dU(fespace->TrueVSize());
+  mfem::Vector K_dU(fespace->TrueVSize());
+  mfem::Vector M_dU(fespace->TrueVSize());
+  J.Mult(dU, J_dU);
+  K.Mult(dU, K_dU);
+  M.Mult(dU, M_dU);
+
+  mfem::Vector expected(fespace->TrueVSize());
+  add(a, K_dU, b, M_dU, expected);
+
+  mfem::Vector diff(J_dU);
+  diff -= expected;
+  EXPECT_LT(diff.Normlinf(), 1.0e-10 * expected.Normlinf());
+
+  // ... and so should its assembled form
+  std::unique_ptr<mfem::HypreParMatrix> J_mat = assemble(J);
+  J_mat->Mult(dU, J_dU);
+
+  diff = J_dU;
+  diff -= expected;
+  EXPECT_LT(diff.Normlinf(), 1.0e-10 * expected.Normlinf());
+}
+
 int main(int argc, char* argv[])
 {
   int num_procs, myid;
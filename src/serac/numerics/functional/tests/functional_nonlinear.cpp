@@ -4,6 +4,7 @@
 //
 // SPDX-License-Identifier: (BSD-3-Clause)
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
@@ -43,6 +44,34 @@ struct hcurl_qfunction {
   }
 };
 
+// check that applying the gradient to several vectors at once agrees with applying it to each one separately
+template <typename T>
+void check_batched_gradient(Functional<T>& f, double t, const mfem::Vector& U)
+{
+  constexpr int num_vectors = 5;
+
+  auto [value, dfdU] = f(t, differentiate_wrt(U));
+
+  mfem::DenseMatrix dU(U.Size(), num_vectors);
+  for (int k = 0; k < num_vectors; k++) {
+    mfem::Vector column(dU.GetColumn(k), U.Size());
+    column.Randomize(k + 1);
+  }
+
+  mfem::DenseMatrix df;
+  dfdU.Mult(dU, df);
+
+  mfem::Vector column_df(dfdU.Height());
+  for (int k = 0; k < num_vectors; k++) {
+    mfem::Vector column(dU.GetColumn(k), U.Size());
+    dfdU.Mult(column, column_df);
+
+    mfem::Vector batched_df(df.GetColumn(k), df.Height());
+    batched_df -= column_df;
+    EXPECT_LT(batched_df.Normlinf(), 1.0e-12 * std::max(column_df.Normlinf(), 1.0));
+  }
+}
+
 // this test sets up a toy "thermal" problem where the residual includes contributions
 // from a temperature-dependent source term and a temperature-gradient-dependent flux
 //
@@ -143,6 +172,7 @@ void functional_test(mfem::ParMesh& mesh, H1<p, dim> test, H1<p, dim> trial, Dim
 
   double t = 0.0;
   check_gradient(residual, t, U);
+  check_batched_gradient(residual, t, U);
 
   serac::profiling::finalize();
 }
@@ -364,6 +364,21 @@ TEST(QoI, DependsOnVectorValuedInput)
   double relative_error = (f(t, U) - exact_answer) / exact_answer;
   EXPECT_NEAR(0.0, relative_error, 1.0e-10);
 
+  // the directional derivatives in several directions at once agree with those in each direction separately
+  auto [value, dfdU] = f(t, differentiate_wrt(U));
+
+  mfem::DenseMatrix dU(U.Size(), 4);
+  for (int k = 0; k < dU.Width(); k++) {
+    mfem::Vector column(dU.GetColumn(k), U.Size());
+    column.Randomize(k + 1);
+  }
+
+  mfem::Vector batched = dfdU(dU);
+  for (int k = 0; k < dU.Width(); k++) {
+    mfem::Vector column(dU.GetColumn(k), U.Size());
+    EXPECT_NEAR(batched[k], dfdU(column), 1.0e-12 * std::abs(batched[k]) + 1.0e-14);
+  }
+
   delete tmp;
 }
 
@@ -422,6 +437,34 @@ TEST(QoI, AddVolumeIntegral)
   delete tmp;
 }
 
+TEST(QoI, UpdateMeshNodes)
+{
+  constexpr int p = 1;
+
+  // copy the mesh, so that moving its nodes does not affect the other tests
+  mfem::ParMesh mesh(*mesh3D);
+
+  using trial_space = H1<p>;
+
+  auto [fespace, fec] = serac::generateParFiniteElementSpace<trial_space>(&mesh);
+
+  mfem::HypreParVector* tmp = fespace->NewTrueDofVector();
+  mfem::HypreParVector  U   = *tmp;
+  U                         = 0.0;
+
+  Functional<double(trial_space)> measure({fespace.get()});
+  measure.AddVolumeIntegral(DependsOn<>{}, TrivialIntegrator{}, mesh);
+  double initial_volume = measure(t, U);
+
+  // doubling each coordinate scales the volume by a factor of 8
+  *mesh.GetNodes() *= 2.0;
+  measure.updateMeshNodes();
+  EXPECT_NEAR(measure(t, U), 8.0 * initial_volume, 1.0e-10 * initial_volume);
+  EXPECT_NEAR(measure(t, U), measure_mfem(mesh), 1.0e-10 * initial_volume);
+
+  delete tmp;
+}
+
 TEST(QoI, UsingL2)
 {
   constexpr int p = 1;
@@ -0,0 +1,107 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include "serac/numerics/functional/functional.hpp"
+#include "serac/numerics/functional/simd.hpp"
+#include "serac/numerics/functional/tensor.hpp"
+#include "serac/numerics/functional/tests/neo_hookean_qfunction.hpp"
+
+using namespace serac;
+
+std::unique_ptr<mfem::ParMesh> mesh2D;
+std::unique_ptr<mfem::ParMesh> mesh3D;
+
+TEST(Simd, LaneWiseEvaluationMatchesScalar)
+{
+  auto f = [](auto x) {
+    using std::exp, std::log1p, std::sqrt;
+    return x * exp(-x) + log1p(x * x) / sqrt(1.0 + x) - max(x, 0.5) + pow(x, 1.5);
+  };
+
+  constexpr int W         = 4;
+  double        values[W] = {0.1, 0.7, 1.3, 2.9};
+
+  dual<simd<W>> x{};
+  for (int lane = 0; lane < W; lane++) {
+    insert_lane(x, lane, make_dual(values[lane]));
+  }
+
+  auto packed = f(x);
+  for (int lane = 0; lane < W; lane++) {
+    auto         expected = f(make_dual(values[lane]));
+    dual<double> actual{};
+    extract_lane(packed, lane, actual);
+    EXPECT_DOUBLE_EQ(actual.value, expected.value);
+    EXPECT_DOUBLE_EQ(actual.gradient, expected.gradient);
+  }
+}
+
+// check that the vectorized q-function gives the same residual and jacobian-vector product as the scalar one
+template <int p, int dim, int W>
+void vectorized_qfunction_test(mfem::ParMesh& mesh)
+{
+  using space = H1<p, dim>;
+
+  auto [fespace, fec] = serac::generateParFiniteElementSpace<space>(&mesh);
+
+  mfem::ParGridFunction u_global(fespace.get());
+  u_global.Randomize();
+  u_global *= 0.1;
+
+  mfem::Vector U(fespace->TrueVSize());
+  u_global.GetTrueDofs(U);
+
+  Functional<space(space)> scalar(fespace.get(), {fespace.get()});
+  scalar.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, NeoHookeanQFunction<dim>{}, mesh);
+
+  Functional<space(space)> vectorized(fespace.get(), {fespace.get()});
+  vectorized.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, vectorize<W>(NeoHookeanQFunction<dim>{}), mesh);
+
+  double t = 0.0;
+
+  auto [r_scalar, dr_scalar]         = scalar(t, differentiate_wrt(U));
+  auto [r_vectorized, dr_vectorized] = vectorized(t, differentiate_wrt(U));
+
+  mfem::Vector difference(r_scalar);
+  difference -= r_vectorized;
+  EXPECT_LT(difference.Normlinf(), 1.0e-12 * std::max(r_scalar.Normlinf(), 1.0));
+
+  mfem::Vector dU(U.Size());
+  dU.Randomize(1);
+
+  mfem::Vector jvp_scalar     = dr_scalar(dU);
+  mfem::Vector jvp_vectorized = dr_vectorized(dU);
+  jvp_vectorized -= jvp_scalar;
+  EXPECT_LT(jvp_vectorized.Normlinf(), 1.0e-12 * std::max(jvp_scalar.Normlinf(), 1.0));
+}
+
+TEST(Simd, 2DLinear) { vectorized_qfunction_test<1, 2, 4>(*mesh2D); }
+TEST(Simd, 2DQuadratic) { vectorized_qfunction_test<2, 2, 4>(*mesh2D); }
+TEST(Simd, 3DLinear) { vectorized_qfunction_test<1, 3, 8>(*mesh3D); }
+TEST(Simd, 3DQuadratic) { vectorized_qfunction_test<2, 3, 4>(*mesh3D); }
+TEST(Simd, 3DDefaultWidth) { vectorized_qfunction_test<2, 3, default_simd_width>(*mesh3D); }
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  mesh2D = buildPatchMesh(2);
+  mesh3D = buildPatchMesh(3);
+
+  int result = RUN_ALL_TESTS();
+  MPI_Finalize();
+
+  return result;
+}
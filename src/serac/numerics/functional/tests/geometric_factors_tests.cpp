@@ -88,6 +88,39 @@ TEST(geometric_factors, with_3D_domains)
   }
 }
 
+TEST(geometric_factors, update_after_moving_nodes)
+{
+  auto mesh = import_mesh("patch3D_tets_and_hexes.mesh");
+
+  Domain d = Domain::ofElements(mesh, std::function([](std::vector<vec3>, int) { return true; }));
+
+  int q = 2;
+
+  GeometricFactors gf(d, q, mfem::Geometry::TETRAHEDRON);
+  const double*    positions = gf.X.Read();
+  const double*    jacobians = gf.J.Read();
+
+  // stretch the mesh
+  mfem::GridFunction& nodes = *mesh.GetNodes();
+  for (int i = 0; i < nodes.Size(); i++) {
+    nodes[i] = 2.0 * nodes[i] + 0.1 * std::sin(double(i));
+  }
+
+  gf.update(d);
+
+  // the factors are updated in place, and match those computed from scratch
+  EXPECT_EQ(gf.X.Read(), positions);
+  EXPECT_EQ(gf.J.Read(), jacobians);
+
+  GeometricFactors expected(d, q, mfem::Geometry::TETRAHEDRON);
+  for (int i = 0; i < gf.X.Size(); i++) {
+    EXPECT_DOUBLE_EQ(gf.X[i], expected.X[i]);
+  }
+  for (int i = 0; i < gf.J.Size(); i++) {
+    EXPECT_DOUBLE_EQ(gf.J[i], expected.J[i]);
+  }
+}
+
 int main(int argc, char* argv[])
 {
   int num_procs, myid;
@@ -0,0 +1,63 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "mfem.hpp"
+
+#include "serac/serac_config.hpp"
+#include "serac/mesh/mesh_utils_base.hpp"
+#include "serac/numerics/functional/functional.hpp"
+#include "serac/numerics/functional/tensor.hpp"
+
+namespace serac {
+
+// a compressible neo-Hookean solid with a linear body force, written without any branches so that
+// it can also be evaluated on simd numbers. Its shear modulus may be scaled by a parameter field,
+// which keeps the major symmetry of its tangent w.r.t. the displacement gradient.
+template <int dim>
+struct NeoHookeanQFunction {
+  template <typename X, typename Displacement, typename Parameter>
+  SERAC_HOST_DEVICE auto operator()(double /*t*/, X /*x*/, Displacement displacement, Parameter parameter) const
+  {
+    using std::log1p;
+    auto [u, du_dX]         = displacement;
+    auto [scale, dscale_dX] = parameter;
+
+    constexpr auto I         = Identity<dim>();
+    auto           B_minus_I = du_dX * transpose(du_dX) + transpose(du_dX) + du_dX;
+    auto           J_minus_1 = detApIm1(du_dX);
+    auto           J         = J_minus_1 + 1;
+    auto           stress    = (lambda * log1p(J_minus_1) * I + G * (1.0 + scale) * B_minus_I) / J;
+    auto           F         = du_dX + I;
+    return serac::tuple{0.1 * u, dot(stress, transpose(inv(F))) * J};
+  }
+
+  /// @overload
+  template <typename X, typename Displacement>
+  SERAC_HOST_DEVICE auto operator()(double t, X x, Displacement displacement) const
+  {
+    return (*this)(t, x, displacement, serac::tuple{0.0, zero{}});
+  }
+
+  double lambda = 1.5;  ///< first Lame parameter
+  double G      = 0.7;  ///< shear modulus
+};
+
+/// build the once-refined patch mesh of mixed element geometries that the q-function tests run on
+inline std::unique_ptr<mfem::ParMesh> buildPatchMesh(int dim)
+{
+  int serial_refinement   = 1;
+  int parallel_refinement = 0;
+
+  std::string meshfile = (dim == 2) ? SERAC_REPO_DIR "/data/meshes/patch2D_tris_and_quads.mesh"
+                                    : SERAC_REPO_DIR "/data/meshes/patch3D_tets_and_hexes.mesh";
+  return mesh::refineAndDistribute(buildMeshFromFile(meshfile), serial_refinement, parallel_refinement);
+}
+
+}  // namespace serac
@@ -22,14 +22,14 @@ struct is_tensor_of_dual_number<tensor<dual<T>, n...>> {
 
 /**
  * @brief multiply a tensor by a scalar value
- * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int) or a dual number
+ * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int), a dual number or a simd number
  * @tparam T the underlying type of the tensor (righthand) argument
  * @tparam n integers describing the tensor shape
  * @param[in] scale The scaling factor
  * @param[in] A The tensor to be scaled
  */
 template <typename S, typename T, int m, int... n,
-          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value>>
+          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value || is_simd<S>::value>>
 SERAC_HOST_DEVICE constexpr auto operator*(S scale, const tensor<T, m, n...>& A)
 {
   tensor<decltype(S{} * T{}), m, n...> C{};
@@ -41,14 +41,14 @@ SERAC_HOST_DEVICE constexpr auto operator*(S scale, const tensor<T, m, n...>& A)
 
 /**
  * @brief multiply a tensor by a scalar value
- * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int) or a dual number
+ * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int), a dual number or a simd number
  * @tparam T the underlying type of the tensor (righthand) argument
  * @tparam n integers describing the tensor shape
  * @param[in] A The tensor to be scaled
  * @param[in] scale The scaling factor
  */
 template <typename S, typename T, int m, int... n,
-          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value>>
+          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value || is_simd<S>::value>>
 SERAC_HOST_DEVICE constexpr auto operator*(const tensor<T, m, n...>& A, S scale)
 {
   tensor<decltype(T{} * S{}), m, n...> C{};
@@ -60,14 +60,14 @@ SERAC_HOST_DEVICE constexpr auto operator*(const tensor<T, m, n...>& A, S scale)
 
 /**
  * @brief divide a scalar by each element in a tensor
- * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int) or a dual number
+ * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int), a dual number or a simd number
  * @tparam T the underlying type of the tensor (righthand) argument
  * @tparam n integers describing the tensor shape
  * @param[in] scale The numerator
  * @param[in] A The tensor of denominators
  */
 template <typename S, typename T, int m, int... n,
-          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value>>
+          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value || is_simd<S>::value>>
 SERAC_HOST_DEVICE constexpr auto operator/(S scale, const tensor<T, m, n...>& A)
 {
   tensor<decltype(S{} * T{}), n...> C{};
@@ -79,14 +79,14 @@ SERAC_HOST_DEVICE constexpr auto operator/(S scale, const tensor<T, m, n...>& A)
 
 /**
  * @brief divide a tensor by a scalar
- * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int) or a dual number
+ * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int), a dual number or a simd number
  * @tparam T the underlying type of the tensor (righthand) argument
  * @tparam n integers describing the tensor shape
  * @param[in] A The tensor of numerators
  * @param[in] scale The denominator
  */
 template <typename S, typename T, int m, int... n,
-          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value>>
+          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value || is_simd<S>::value>>
 SERAC_HOST_DEVICE constexpr auto operator/(const tensor<T, m, n...>& A, S scale)
 {
   tensor<decltype(T{} * S{}), m, n...> C{};
@@ -121,7 +121,7 @@ using one_hot_t = typename one_hot<i, n, T>::type;
 
 /// @overload
 template <int i, int N>
-SERAC_HOST_DEVICE constexpr auto make_dual_helper(zero /*arg*/)
+SERAC_HOST_DEVICE constexpr auto make_dual_helper(zero /*arg*/, double /*seed*/ = 1.0)
 {
   return zero{};
 }
@@ -132,14 +132,15 @@ SERAC_HOST_DEVICE constexpr auto make_dual_helper(zero /*arg*/)
  *
  * @brief promote a double value to dual number with a one_hot_t< i, N, double > gradient type
  * @param arg the value to be promoted
+ * @param seed the value of the nonzero gradient entry
  */
 template <int i, int N>
-SERAC_HOST_DEVICE constexpr auto make_dual_helper(double arg)
+SERAC_HOST_DEVICE constexpr auto make_dual_helper(double arg, double seed = 1.0)
 {
   using gradient_t = one_hot_t<i, N, double>;
   dual<gradient_t> arg_dual{};
   arg_dual.value                   = arg;
-  serac::get<i>(arg_dual.gradient) = 1.0;
+  serac::get<i>(arg_dual.gradient) = seed;
   return arg_dual;
 }
 
@@ -149,15 +150,16 @@ SERAC_HOST_DEVICE constexpr auto make_dual_helper(double arg)
  *
  * @brief promote a tensor value to dual number with a one_hot_t< i, N, tensor > gradient type
  * @param arg the value to be promoted
+ * @param seed the value of the nonzero gradient entries
  */
 template <int i, int N, typename T, int... n>
-SERAC_HOST_DEVICE constexpr auto make_dual_helper(const tensor<T, n...>& arg)
+SERAC_HOST_DEVICE constexpr auto make_dual_helper(const tensor<T, n...>& arg, double seed = 1.0)
 {
   using gradient_t = one_hot_t<i, N, tensor<T, n...>>;
   tensor<dual<gradient_t>, n...> arg_dual{};
   for_constexpr<n...>([&](auto... j) {
     arg_dual(j...).value                         = arg(j...);
-    serac::get<i>(arg_dual(j...).gradient)(j...) = 1.0;
+    serac::get<i>(arg_dual(j...).gradient)(j...) = seed;
   });
   return arg_dual;
 }
@@ -168,6 +170,7 @@ SERAC_HOST_DEVICE constexpr auto make_dual_helper(const tensor<T, n...>& arg)
  *
  * @brief Promote a tuple of values to their corresponding dual types
  * @param args the values to be promoted
+ * @param seed the value of the nonzero gradient entries (derivatives propagated through them are scaled by seed)
  *
  * example:
  * @code{.cpp}
@@ -180,17 +183,17 @@ SERAC_HOST_DEVICE constexpr auto make_dual_helper(const tensor<T, n...>& arg)
  * @endcode
  */
 template <typename T0, typename T1>
-SERAC_HOST_DEVICE constexpr auto make_dual(const tuple<T0, T1>& args)
+SERAC_HOST_DEVICE constexpr auto make_dual(const tuple<T0, T1>& args, double seed = 1.0)
 {
-  return tuple{make_dual_helper<0, 2>(get<0>(args)), make_dual_helper<1, 2>(get<1>(args))};
+  return tuple{make_dual_helper<0, 2>(get<0>(args), seed), make_dual_helper<1, 2>(get<1>(args), seed)};
 }
 
 /// @overload
 template <typename T0, typename T1, typename T2>
-SERAC_HOST_DEVICE constexpr auto make_dual(const tuple<T0, T1, T2>& args)
+SERAC_HOST_DEVICE constexpr auto make_dual(const tuple<T0, T1, T2>& args, double seed = 1.0)
 {
-  return tuple{make_dual_helper<0, 3>(get<0>(args)), make_dual_helper<1, 3>(get<1>(args)),
-               make_dual_helper<2, 3>(get<2>(args))};
+  return tuple{make_dual_helper<0, 3>(get<0>(args), seed), make_dual_helper<1, 3>(get<1>(args), seed),
+               make_dual_helper<2, 3>(get<2>(args), seed)};
 }
 
 /**
@@ -218,15 +221,16 @@ SERAC_HOST_DEVICE auto promote_to_dual_when(const T& x)
  * @tparam T the type of the values passed in
  * @tparam n how many values were passed in
  * @param x the values to be promoted
+ * @param seed the scale of the gradients of the dual numbers (see `make_dual`)
  */
 template <bool dualify, typename T, int n>
-SERAC_HOST_DEVICE auto promote_each_to_dual_when(const tensor<T, n>& x)
+SERAC_HOST_DEVICE auto promote_each_to_dual_when(const tensor<T, n>& x, [[maybe_unused]] double seed = 1.0)
 {
   if constexpr (dualify) {
     using return_type = decltype(make_dual(T{}));
     tensor<return_type, n> output;
     for (int i = 0; i < n; i++) {
-      output[i] = make_dual(x[i]);
+      output[i] = make_dual(x[i], seed);
     }
     return output;
   }
@@ -271,6 +275,29 @@ constexpr auto make_dual_wrt(const serac::tuple<T...>& args)
   return make_dual_helper<n>(args, std::make_integer_sequence<int, static_cast<int>(sizeof...(T))>{});
 }
 
+/// @brief layer of indirection required to implement `make_dual_wrt` for two arguments
+template <int n, int m, typename... T, int... i>
+SERAC_HOST_DEVICE constexpr auto make_dual_helper(const serac::tuple<T...>& args, std::integer_sequence<int, i...>)
+{
+  return serac::make_tuple(promote_to_dual_when<i == n || i == m>(serac::get<i>(args))...);
+}
+
+/**
+ * @tparam n the index of the first tuple argument to be made into a dual number
+ * @tparam m the index of the second tuple argument to be made into a dual number
+ * @tparam T the types of the values in the tuple
+ *
+ * @brief take a tuple of values, and promote the `n`th and `m`th ones to dual numbers of the appropriate type
+ * @param args the values to be promoted
+ *
+ * @note the `n`th and `m`th values must have the same type, so that their dual numbers share a gradient type
+ */
+template <int n, int m, typename... T>
+constexpr auto make_dual_wrt(const serac::tuple<T...>& args)
+{
+  return make_dual_helper<n, m>(args, std::make_integer_sequence<int, static_cast<int>(sizeof...(T))>{});
+}
+
 /**
  * @brief Extracts all of the values from a tensor of dual numbers
  *
@@ -461,6 +488,51 @@ SERAC_HOST_DEVICE constexpr auto make_dual(const tensor<T, m, n>& x, const tenso
   return make_tensor<m, n>([&](int i, int j) { return dual<T>{x[i][j], dx[i][j]}; });
 }
 
+/**
+ * @overload
+ * @note Uses the same shortcut as for 2-by-2 matrices of doubles, since partial pivoting can not be applied
+ * to simd numbers
+ */
+template <int W>
+SERAC_HOST_DEVICE constexpr tensor<simd<W>, 2, 2> inv(const tensor<simd<W>, 2, 2>& A)
+{
+  simd<W> inv_detA(1.0 / det(A));
+
+  tensor<simd<W>, 2, 2> invA{};
+
+  invA[0][0] = A[1][1] * inv_detA;
+  invA[0][1] = -A[0][1] * inv_detA;
+  invA[1][0] = -A[1][0] * inv_detA;
+  invA[1][1] = A[0][0] * inv_detA;
+
+  return invA;
+}
+
+/**
+ * @overload
+ * @note Uses the same shortcut as for 3-by-3 matrices of doubles, since partial pivoting can not be applied
+ * to simd numbers
+ */
+template <int W>
+SERAC_HOST_DEVICE constexpr tensor<simd<W>, 3, 3> inv(const tensor<simd<W>, 3, 3>& A)
+{
+  simd<W> inv_detA(1.0 / det(A));
+
+  tensor<simd<W>, 3, 3> invA{};
+
+  invA[0][0] = (A[1][1] * A[2][2] - A[1][2] * A[2][1]) * inv_detA;
+  invA[0][1] = (A[0][2] * A[2][1] - A[0][1] * A[2][2]) * inv_detA;
+  invA[0][2] = (A[0][1] * A[1][2] - A[0][2] * A[1][1]) * inv_detA;
+  invA[1][0] = (A[1][2] * A[2][0] - A[1][0] * A[2][2]) * inv_detA;
+  invA[1][1] = (A[0][0] * A[2][2] - A[0][2] * A[2][0]) * inv_detA;
+  invA[1][2] = (A[0][2] * A[1][0] - A[0][0] * A[1][2]) * inv_detA;
+  invA[2][0] = (A[1][0] * A[2][1] - A[1][1] * A[2][0]) * inv_detA;
+  invA[2][1] = (A[0][1] * A[2][0] - A[0][0] * A[2][1]) * inv_detA;
+  invA[2][2] = (A[0][0] * A[1][1] - A[0][1] * A[1][0]) * inv_detA;
+
+  return invA;
+}
+
 /**
  * @overload
  * @note when inverting a tensor of dual numbers,
@@ -493,7 +565,7 @@ SERAC_HOST_DEVICE constexpr auto inv(tensor<dual<gradient_type>, n, n> A)
 template <typename T, int... n>
 SERAC_HOST_DEVICE auto get_value(const tensor<dual<T>, n...>& arg)
 {
-  tensor<double, n...> value{};
+  tensor<typename dual<T>::value_type, n...> value{};
   for_constexpr<n...>([&](auto... i) { value(i...) = arg(i...).value; });
   return value;
 }
@@ -1054,4 +1126,185 @@ auto sqrt_symm(tensor<T, 3, 3> A)
       A, [](double x) { return std::sqrt(x); }, g);
 }
 
+/// @brief multiply each component of a tuple by a simd number on the left
+template <int W, typename... T>
+SERAC_HOST_DEVICE constexpr auto operator*(const simd<W>& a, const tuple<T...>& x)
+{
+  return serac::apply([&](const auto&... each_value) { return serac::tuple{a * each_value...}; }, x);
+}
+
+/// @brief multiply each component of a tuple by a simd number on the right
+template <int W, typename... T>
+SERAC_HOST_DEVICE constexpr auto operator*(const tuple<T...>& x, const simd<W>& a)
+{
+  return serac::apply([&](const auto&... each_value) { return serac::tuple{each_value * a...}; }, x);
+}
+
+/// @brief divide a simd number by each component of a tuple
+template <int W, typename... T>
+SERAC_HOST_DEVICE constexpr auto operator/(const simd<W>& a, const tuple<T...>& x)
+{
+  return serac::apply([&](const auto&... each_value) { return serac::tuple{a / each_value...}; }, x);
+}
+
+/// @brief divide each component of a tuple by a simd number
+template <int W, typename... T>
+SERAC_HOST_DEVICE constexpr auto operator/(const tuple<T...>& x, const simd<W>& a)
+{
+  return serac::apply([&](const auto&... each_value) { return serac::tuple{each_value / a...}; }, x);
+}
+
+/// @overload
+SERAC_HOST_DEVICE constexpr zero select(bool, zero, zero) { return zero{}; }
+
+/// @overload
+template <int W>
+SERAC_HOST_DEVICE constexpr zero select(const simd_mask<W>&, zero, zero)
+{
+  return zero{};
+}
+
+/** @brief the branch-free equivalent of `condition ? A : B` for tensors of simd numbers, evaluated in each lane */
+template <int W, typename T, int m, int... n>
+SERAC_HOST_DEVICE constexpr auto select(const simd_mask<W>& condition, const tensor<T, m, n...>& A,
+                                        const tensor<T, m, n...>& B)
+{
+  tensor<T, m, n...> C{};
+  for (int i = 0; i < m; i++) {
+    C[i] = select(condition, A[i], B[i]);
+  }
+  return C;
+}
+
+/// @overload
+template <int W, typename... T>
+SERAC_HOST_DEVICE constexpr auto select(const simd_mask<W>& condition, const tuple<T...>& a, const tuple<T...>& b)
+{
+  tuple<T...> c{};
+  for_constexpr<sizeof...(T)>([&](auto i) { get<i>(c) = select(condition, get<i>(a), get<i>(b)); });
+  return c;
+}
+
+/**
+ * @brief The type obtained by replacing each `double` in T by a `simd<W>`, which holds the values of W copies of T
+ *
+ * @tparam W the number of lanes
+ * @tparam T a double, or a tensor, tuple or dual number made of doubles
+ */
+template <int W, typename T>
+struct simd_pack {
+  using type = T;  ///< the packed type
+};
+
+/// @overload
+template <int W>
+struct simd_pack<W, double> {
+  using type = simd<W>;  ///< the packed type
+};
+
+/// @overload
+template <int W, typename T, int... n>
+struct simd_pack<W, tensor<T, n...>> {
+  using type = tensor<typename simd_pack<W, T>::type, n...>;  ///< the packed type
+};
+
+/// @overload
+template <int W, typename... T>
+struct simd_pack<W, tuple<T...>> {
+  using type = tuple<typename simd_pack<W, T>::type...>;  ///< the packed type
+};
+
+/// @overload
+template <int W, typename T>
+struct simd_pack<W, dual<T>> {
+  using type = dual<typename simd_pack<W, T>::type>;  ///< the packed type
+};
+
+/// @brief shorthand for `simd_pack<W, T>::type`
+template <int W, typename T>
+using simd_pack_t = typename simd_pack<W, T>::type;
+
+/**
+ * @brief Write a value into one lane of its packed counterpart, see simd_pack
+ *
+ * @param[out] packed the packed value
+ * @param[in] lane the lane to write to
+ * @param[in] x the value to write
+ */
+template <int W>
+SERAC_HOST_DEVICE constexpr void insert_lane(simd<W>& packed, int lane, double x)
+{
+  packed[lane] = x;
+}
+
+/// @overload
+SERAC_HOST_DEVICE constexpr void insert_lane(zero&, int, zero) {}
+
+/// @overload
+template <typename S, typename T, int m, int... n>
+SERAC_HOST_DEVICE constexpr void insert_lane(tensor<S, m, n...>& packed, int lane, const tensor<T, m, n...>& x)
+{
+  for (int i = 0; i < m; i++) {
+    insert_lane(packed[i], lane, x[i]);
+  }
+}
+
+/// @overload
+template <typename... S, typename... T>
+SERAC_HOST_DEVICE constexpr void insert_lane(tuple<S...>& packed, int lane, const tuple<T...>& x)
+{
+  for_constexpr<sizeof...(T)>([&](auto i) { insert_lane(get<i>(packed), lane, get<i>(x)); });
+}
+
+/// @overload
+template <typename S, typename T>
+SERAC_HOST_DEVICE constexpr void insert_lane(dual<S>& packed, int lane, const dual<T>& x)
+{
+  insert_lane(packed.value, lane, x.value);
+  insert_lane(packed.gradient, lane, x.gradient);
+}
+
+/**
+ * @brief Read one lane of a packed value, see simd_pack
+ *
+ * @param[in] packed the packed value, where any part that is not packed holds the same value in every lane
+ * @param[in] lane the lane to read
+ * @param[out] x the value of that lane
+ */
+template <int W>
+SERAC_HOST_DEVICE constexpr void extract_lane(const simd<W>& packed, int lane, double& x)
+{
+  x = packed[lane];
+}
+
+/// @overload
+SERAC_HOST_DEVICE constexpr void extract_lane(double packed, int, double& x) { x = packed; }
+
+/// @overload
+SERAC_HOST_DEVICE constexpr void extract_lane(zero, int, zero&) {}
+
+/// @overload
+template <typename S, typename T, int m, int... n>
+SERAC_HOST_DEVICE constexpr void extract_lane(const tensor<S, m, n...>& packed, int lane, tensor<T, m, n...>& x)
+{
+  for (int i = 0; i < m; i++) {
+    extract_lane(packed[i], lane, x[i]);
+  }
+}
+
+/// @overload
+template <typename... S, typename... T>
+SERAC_HOST_DEVICE constexpr void extract_lane(const tuple<S...>& packed, int lane, tuple<T...>& x)
+{
+  for_constexpr<sizeof...(T)>([&](auto i) { extract_lane(get<i>(packed), lane, get<i>(x)); });
+}
+
+/// @overload
+template <typename S, typename T>
+SERAC_HOST_DEVICE constexpr void extract_lane(const dual<S>& packed, int lane, dual<T>& x)
+{
+  extract_lane(packed.value, lane, x.value);
+  extract_lane(packed.gradient, lane, x.gradient);
+}
+
 }  // namespace serac
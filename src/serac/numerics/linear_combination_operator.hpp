@@ -0,0 +1,86 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file linear_combination_operator.hpp
+ *
+ * @brief A matrix-free linear combination of two mfem::Operators
+ */
+
+#pragma once
+
+#include "mfem.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief LinearCombinationOperator implements the action of a * A + b * B without forming
+ *   the sum as a sparse matrix. Unlike mfem::SumOperator, it also supports AssembleDiagonal(),
+ *   so that it can be used with diagonal (e.g. Jacobi) preconditioners.
+ *
+ * @note A and B are not owned by this class, and must outlive it
+ */
+class LinearCombinationOperator : public mfem::Operator {
+public:
+  /**
+   * @brief Constructs the operator a * A + b * B
+   *
+   * @param[in] a The coefficient of A
+   * @param[in] A The first operator
+   * @param[in] b The coefficient of B
+   * @param[in] B The second operator
+   */
+  LinearCombinationOperator(double a, const mfem::Operator& A, double b, const mfem::Operator& B)
+      : mfem::Operator(A.Height(), A.Width()), a_(a), A_(A), b_(b), B_(B), tmp_(A.Height())
+  {
+    MFEM_VERIFY(A.Height() == B.Height() && A.Width() == B.Width(), "incompatible operator dimensions");
+  }
+
+  /**
+   * @brief Computes y = (a * A + b * B) x
+   *
+   * @param[in] x The input vector
+   * @param[out] y The output vector
+   */
+  void Mult(const mfem::Vector& x, mfem::Vector& y) const override
+  {
+    A_.Mult(x, y);
+    B_.Mult(x, tmp_);
+    y *= a_;
+    y.Add(b_, tmp_);
+  }
+
+  /**
+   * @brief Computes the diagonal of a * A + b * B from the diagonals of A and B
+   *
+   * @param[out] diag The diagonal entries
+   */
+  void AssembleDiagonal(mfem::Vector& diag) const override
+  {
+    A_.AssembleDiagonal(diag);
+    B_.AssembleDiagonal(tmp_);
+    diag *= a_;
+    diag.Add(b_, tmp_);
+  }
+
+private:
+  /// @brief The coefficient of A_
+  double a_;
+
+  /// @brief The first operator
+  const mfem::Operator& A_;
+
+  /// @brief The coefficient of B_
+  double b_;
+
+  /// @brief The second operator
+  const mfem::Operator& B_;
+
+  /// @brief Storage for the action (or diagonal) of B_
+  mutable mfem::Vector tmp_;
+};
+
+}  // namespace serac::mfem_ext
@@ -8,6 +8,36 @@
 
 namespace serac::mfem_ext {
 
+namespace {
+
+/**
+ * @brief The Newmark beta of the displacement update of a second order method, which determines the
+ * Zienkiewicz-Xie error estimate used by SecondOrderODE::AdaptiveStep()
+ */
+double newmarkBeta(TimestepMethod timestepper)
+{
+  switch (timestepper) {
+    case TimestepMethod::Newmark:              // mfem::NewmarkSolver's default (beta = 1/4, gamma = 1/2)
+    case TimestepMethod::AverageAcceleration:  // alpha_m = alpha_f = 1/2, beta = 1/4, gamma = 1/2
+      return 0.25;
+    case TimestepMethod::FoxGoodwin:
+      return 1.0 / 12.0;
+    case TimestepMethod::CentralDifference:
+      return 0.0;
+    case TimestepMethod::LinearAcceleration:
+      // beta = 1/6 cancels the leading error term, so the estimate would always be zero
+      SLIC_ERROR_ROOT("Adaptive timestepping is not supported for LinearAcceleration, whose beta = 1/6 makes the "
+                      "Zienkiewicz-Xie error estimate vanish");
+      break;
+    default:
+      SLIC_ERROR_ROOT("Adaptive timestepping requires a Newmark-type second-order timestepper (Newmark, "
+                      "AverageAcceleration, FoxGoodwin, or CentralDifference)");
+  }
+  return 0.0;
+}
+
+}  // namespace
+
 SecondOrderODE::SecondOrderODE(int n, State&& state, const EquationSolver& solver, const BoundaryConditionManager& bcs)
     : mfem::SecondOrderTimeDependentOperator(n, 0.0), state_(std::move(state)), solver_(solver), bcs_(bcs), zero_(n)
 {
@@ -117,6 +147,67 @@ void SecondOrderODE::Step(mfem::Vector& x, mfem::Vector& dxdt, double& time, dou
   }
 }
 
+void SecondOrderODE::AdaptiveStep(mfem::Vector& x, mfem::Vector& dxdt, double& time, double& dt,
+                                  TimestepController& controller)
+{
+  const double beta = newmarkBeta(timestepper_);
+
+  x_start_                 = x;
+  dxdt_start_              = dxdt;
+  mfem::Vector d2u_dt2     = state_.d2u_dt2;
+  double       time_start  = time;
+  double       state_start = state_.time;
+
+  adaptive_step_ = true;
+  for (int attempts = 1;; attempts++) {
+    double step_time = time_start;
+    double timestep  = controller.suggestedTimestep(dt);
+
+    // Mult() replaces this if the integrator solves for a consistent initial acceleration
+    d2u_dt2_start_                 = d2u_dt2;
+    computed_initial_acceleration_ = false;
+    converged_                     = true;
+
+    Step(x, dxdt, step_time, timestep);
+
+    if (converged_) {
+      // Zienkiewicz-Xie estimate: e = h^2 (beta - 1/6) (a_{n+1} - a_n)
+      subtract(timestep * timestep * (beta - 1.0 / 6.0), state_.d2u_dt2, d2u_dt2_start_, error_);
+      double error_norm = controller.errorNorm(error_, x_start_, x, solver_.nonlinearSolver().GetComm());
+      if (controller.accept(timestep, error_norm)) {
+        time = step_time;
+        dt   = timestep;
+        break;
+      }
+    } else {
+      controller.rejectNonconverged(timestep);
+    }
+
+    SLIC_ERROR_ROOT_IF(!controller.canRetry(attempts, timestep),
+                       axom::fmt::format("Adaptive timestep at t = {} failed after {} attempts, the last with dt = {}",
+                                         time_start, attempts, timestep));
+
+    // go back to the start of the step, including the acceleration that the integrator carries between steps
+    x              = x_start_;
+    dxdt           = dxdt_start_;
+    state_.d2u_dt2 = d2u_dt2;
+    state_.time    = state_start;
+    Restart(!computed_initial_acceleration_);
+  }
+  adaptive_step_ = false;
+}
+
+void SecondOrderODE::Restart(bool use_state_acceleration)
+{
+  if (second_order_ode_solver_) {
+    // the mfem solvers compute their initial acceleration with Mult() on the first step after Init()
+    use_state_acceleration_ = use_state_acceleration;
+    second_order_ode_solver_->Init(*this);
+  } else if (first_order_system_ode_solver_) {
+    first_order_system_ode_solver_->Init(*this);
+  }
+}
+
 void SecondOrderODE::ImplicitSolve(const double dt, const mfem::Vector& u, mfem::Vector& du_dt)
 {
   /* A second order o.d.e can be recast as a first order system
@@ -242,7 +333,8 @@ void SecondOrderODE::Solve(const double time, const double c0, const double c1,
   d2u_dt2 += d2U_dt2_;
 
   solver_.solve(d2u_dt2);
-  SLIC_WARNING_ROOT_IF(!solver_.nonlinearSolver().GetConverged(), "Newton Solver did not converge.");
+  converged_ = converged_ && solver_.nonlinearSolver().GetConverged();
+  SLIC_WARNING_ROOT_IF(!adaptive_step_ && !solver_.nonlinearSolver().GetConverged(), "Newton Solver did not converge.");
 
   state_.d2u_dt2 = d2u_dt2;
 }
@@ -299,6 +391,51 @@ void FirstOrderODE::SetTimestepper(const serac::TimestepMethod timestepper)
   ode_solver_->Init(*this);
 }
 
+void FirstOrderODE::AdaptiveStep(mfem::Vector& x, double& time, double& dt, TimestepController& controller)
+{
+  SLIC_ERROR_ROOT_IF(!ode_solver_, "ode_solver_ unspecified");
+
+  x_start_                 = x;
+  du_dt_start_             = state_.du_dt;
+  double time_start        = time;
+  double state_start       = state_.time;
+  double previous_dt_start = state_.previous_dt;
+
+  adaptive_step_ = true;
+  for (int attempts = 1;; attempts++) {
+    double step_time = time_start;
+    double timestep  = controller.suggestedTimestep(dt);
+    converged_       = true;
+
+    ode_solver_->Step(x, step_time, timestep);
+
+    if (converged_) {
+      // difference between backward Euler and the trapezoid rule: e = h/2 (du_dt_{n+1} - du_dt_n)
+      subtract(0.5 * timestep, state_.du_dt, du_dt_start_, error_);
+      double error_norm = controller.errorNorm(error_, x_start_, x, solver_.nonlinearSolver().GetComm());
+      if (controller.accept(timestep, error_norm)) {
+        time = step_time;
+        dt   = timestep;
+        break;
+      }
+    } else {
+      controller.rejectNonconverged(timestep);
+    }
+
+    SLIC_ERROR_ROOT_IF(!controller.canRetry(attempts, timestep),
+                       axom::fmt::format("Adaptive timestep at t = {} failed after {} attempts, the last with dt = {}",
+                                         time_start, attempts, timestep));
+
+    // go back to the start of the step, discarding any history kept by the integrator
+    x                  = x_start_;
+    state_.du_dt       = du_dt_start_;
+    state_.time        = state_start;
+    state_.previous_dt = previous_dt_start;
+    ode_solver_->Init(*this);
+  }
+  adaptive_step_ = false;
+}
+
 void FirstOrderODE::Solve(const double time, const double dt, const mfem::Vector& u, mfem::Vector& du_dt) const
 {
   // assign these values to variables with greater scope,
@@ -358,7 +495,8 @@ void FirstOrderODE::Solve(const double time, const double dt, const mfem::Vector
   du_dt += dU_dt_;
 
   solver_.solve(du_dt);
-  SLIC_WARNING_ROOT_IF(!solver_.nonlinearSolver().GetConverged(), "Newton Solver did not converge.");
+  converged_ = converged_ && solver_.nonlinearSolver().GetConverged();
+  SLIC_WARNING_ROOT_IF(!adaptive_step_ && !solver_.nonlinearSolver().GetConverged(), "Newton Solver did not converge.");
 
   state_.du_dt       = du_dt;
   state_.previous_dt = dt;
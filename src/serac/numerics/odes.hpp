@@ -18,6 +18,7 @@
 
 #include "serac/physics/boundary_conditions/boundary_condition_manager.hpp"
 #include "serac/numerics/equation_solver.hpp"
+#include "serac/numerics/timestep_controller.hpp"
 
 namespace serac::mfem_ext {
 
@@ -110,7 +111,16 @@ public:
    */
   void Mult(const mfem::Vector& u, const mfem::Vector& du_dt, mfem::Vector& d2u_dt2) const override
   {
+    if (use_state_acceleration_) {
+      d2u_dt2                 = state_.d2u_dt2;
+      use_state_acceleration_ = false;
+      return;
+    }
     Solve(t, 0.0, 0.0, u, du_dt, d2u_dt2);
+
+    // this is the acceleration at the start of the step that the error estimate of AdaptiveStep() compares against
+    computed_initial_acceleration_ = true;
+    d2u_dt2_start_                 = d2u_dt2;
   }
 
   /**
@@ -158,6 +168,34 @@ public:
    */
   void Step(mfem::Vector& x, mfem::Vector& dxdt, double& time, double& dt);
 
+  /**
+   * @brief Performs a time step whose size is chosen by a timestep controller, retrying with smaller timesteps
+   * until the estimated local truncation error is within tolerance and the nonlinear solver converges
+   *
+   * The error of the displacement is estimated as \f$h^2 (\beta - 1/6) (a_{n+1} - a_n)\f$ (Zienkiewicz and Xie),
+   * with the Newmark \f$\beta\f$ of the timestepper: 1/4 for Newmark and AverageAcceleration, 1/12 for FoxGoodwin,
+   * and 0 for CentralDifference. Other timesteppers are rejected, since their displacement update is not of this form
+   * (or, for LinearAcceleration, its \f$\beta = 1/6\f$ makes the estimate vanish).
+   *
+   * @param[inout] x The predicted solution
+   * @param[inout] dxdt The predicted rate
+   * @param[inout] time The current time
+   * @param[inout] dt On input, an upper bound on the timestep. On output, the timestep that was taken.
+   * @param[inout] controller The controller choosing the timestep
+   */
+  void AdaptiveStep(mfem::Vector& x, mfem::Vector& dxdt, double& time, double& dt, TimestepController& controller);
+
+  /**
+   * @brief Discard the history carried over between steps by the time integrator
+   *
+   * This is needed when the solution vectors are overwritten between steps, e.g. when
+   * restarting from a checkpoint.
+   *
+   * @param[in] use_state_acceleration If true, the next step starts from the acceleration currently
+   * stored in the state instead of solving for a consistent initial acceleration
+   */
+  void Restart(bool use_state_acceleration);
+
   /**
    * @brief Get a reference to the current state
    */
@@ -222,6 +260,34 @@ private:
   mutable mfem::Vector dU_dt_;
   mutable mfem::Vector d2U_dt2_;
 
+  /**
+   * @brief Whether the next call to Mult() should return the acceleration in the state, see Restart()
+   */
+  mutable bool use_state_acceleration_ = false;
+
+  /**
+   * @brief Working vectors holding the start of an adaptive step, so that it can be retried, and its error estimate
+   */
+  mfem::Vector         x_start_;
+  mfem::Vector         dxdt_start_;
+  mutable mfem::Vector d2u_dt2_start_;
+  mfem::Vector         error_;
+
+  /**
+   * @brief Whether the current adaptive step solved for its initial acceleration, which a retry must do again
+   */
+  mutable bool computed_initial_acceleration_ = false;
+
+  /**
+   * @brief Whether the nonlinear solves of the current adaptive step converged
+   */
+  mutable bool converged_ = true;
+
+  /**
+   * @brief Whether an adaptive step is in progress, which retries nonconverged solves instead of warning about them
+   */
+  bool adaptive_step_ = false;
+
   serac::TimestepMethod timestepper_;
 };
 
@@ -347,6 +413,21 @@ public:
     }
   }
 
+  /**
+   * @brief Performs a time step whose size is chosen by a timestep controller, retrying with smaller timesteps
+   * until the estimated local truncation error is within tolerance and the nonlinear solver converges
+   *
+   * The error is estimated as \f$\frac{h}{2} (\dot{u}_{n+1} - \dot{u}_n)\f$, the difference between backward Euler
+   * and the trapezoid rule, which is the local truncation error of backward Euler and a conservative estimate for
+   * higher order methods.
+   *
+   * @param[inout] x The predicted solution
+   * @param[inout] time The current time
+   * @param[inout] dt On input, an upper bound on the timestep. On output, the timestep that was taken.
+   * @param[inout] controller The controller choosing the timestep
+   */
+  void AdaptiveStep(mfem::Vector& x, double& time, double& dt, TimestepController& controller);
+
   /**
    * @brief Query the timestep method for the ode solver
    *
@@ -395,6 +476,23 @@ private:
   mutable mfem::Vector U_plus_;
   mutable mfem::Vector dU_dt_;
 
+  /**
+   * @brief Working vectors holding the start of an adaptive step, so that it can be retried, and its error estimate
+   */
+  mfem::Vector x_start_;
+  mfem::Vector du_dt_start_;
+  mfem::Vector error_;
+
+  /**
+   * @brief Whether the nonlinear solves of the current adaptive step converged
+   */
+  mutable bool converged_ = true;
+
+  /**
+   * @brief Whether an adaptive step is in progress, which retries nonconverged solves instead of warning about them
+   */
+  bool adaptive_step_ = false;
+
   TimestepMethod timestepper_;
 };
 
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <limits>
+#include <optional>
 #include <variant>
 
 #include "mfem.hpp"
@@ -49,7 +51,7 @@ enum class TimestepMethod
   WBZAlpha,            /**< SecondOrderODE option */
   AverageAcceleration, /**< SecondOrderODE option */
   LinearAcceleration,  /**< SecondOrderODE option */
-  CentralDifference,   /**< SecondOrderODE option */
+  CentralDifference,   /**< SecondOrderODE option, explicit with a lumped mass in SolidMechanics */
   FoxGoodwin           /**< SecondOrderODE option */
 };
 
@@ -88,6 +90,36 @@ enum class DirichletEnforcementMethod
   FullControl
 };
 
+/// Parameters for choosing the timesteps of a dynamic solver from an estimate of the local truncation error
+struct AdaptiveTimesteppingOptions {
+  /// Relative tolerance on the local truncation error of each step
+  double relative_tol = 1.0e-4;
+
+  /// Absolute tolerance on the local truncation error of each step
+  double absolute_tol = 1.0e-8;
+
+  /// Smallest allowed timestep, the simulation stops if a step of this size fails
+  double min_timestep = 0.0;
+
+  /// Largest allowed timestep
+  double max_timestep = std::numeric_limits<double>::max();
+
+  /// Factor applied to the optimal timestep predicted by the controller, to make the next step more likely to succeed
+  double safety_factor = 0.9;
+
+  /// Smallest factor by which the timestep may shrink from one step to the next
+  double min_factor = 0.2;
+
+  /// Largest factor by which the timestep may grow from one step to the next
+  double max_factor = 5.0;
+
+  /// Factor by which the timestep shrinks when the nonlinear solver does not converge
+  double nonconvergence_factor = 0.25;
+
+  /// Maximum number of times a step is retried with a smaller timestep
+  int max_retries = 10;
+};
+
 /// A timestep and boundary condition enforcement method for a dynamic solver
 struct TimesteppingOptions {
   /// The timestepping method to be applied
@@ -95,6 +127,9 @@ struct TimesteppingOptions {
 
   /// The essential boundary enforcement method to use
   DirichletEnforcementMethod enforcement_method = DirichletEnforcementMethod::RateControl;
+
+  /// If given, the timesteps are chosen adaptively, see TimestepController
+  std::optional<AdaptiveTimesteppingOptions> adaptive = std::nullopt;
 };
 
 // _linear_solvers_start
@@ -303,6 +338,7 @@ enum class Preconditioner
   HypreGaussSeidel, /**< Hypre-based Gauss-Seidel */
   HypreAMG,         /**< Hypre's BoomerAMG algebraic multi-grid */
   HypreILU,         /**< Hypre's Incomplete LU */
+  OperatorJacobi,   /**< Jacobi smoothing using the operator's AssembleDiagonal(), works with matrix-free Jacobians */
   AMGX,             /**< NVIDIA's AMGX GPU-enabled algebraic multi-grid, GPU builds only */
   Petsc,            /**< PETSc preconditioner,  */
   None              /**< No preconditioner used */
@@ -323,6 +359,8 @@ inline std::string preconditionerName(Preconditioner p)
       return "HypreAMG";
     case Preconditioner::HypreILU:
       return "HypreILU";
+    case Preconditioner::OperatorJacobi:
+      return "OperatorJacobi";
     case Preconditioner::AMGX:
       return "AMGX";
     case Preconditioner::Petsc:
@@ -366,6 +404,15 @@ struct LinearSolverOptions {
 
   /// Debugging print level for the preconditioner
   int preconditioner_print_level = 0;
+
+  /**
+   * @brief Keep the Jacobian matrix-free, rather than assembling it into a sparse matrix
+   *
+   * Physics modules that support this option hand the linear solver an operator that only
+   * implements the action of the Jacobian. This requires an iterative linear solver (CG or GMRES)
+   * and a preconditioner that doesn't need an assembled matrix (OperatorJacobi or None).
+   */
+  bool matrix_free = false;
 };
 // _linear_options_end
 
@@ -395,6 +442,32 @@ struct NonlinearSolverOptions {
 
   /// Should the gradient be converted to a monolithic matrix
   bool force_monolithic = false;
+
+  /**
+   * @brief Number of Newton iterations between Jacobian reassemblies
+   *
+   * A value of 1 reassembles every iteration (full Newton), values greater than 1 reuse the Jacobian
+   * (modified Newton), and a value of 0 only assembles the Jacobian at the start of each solve.
+   * @note only supported by NonlinearSolver::Newton and NonlinearSolver::NewtonLineSearch
+   */
+  int jacobian_reassembly_interval = 1;
+
+  /**
+   * @brief When positive, a reused Jacobian is also reassembled whenever an iteration fails to reduce
+   * the residual by this factor, i.e. when ||r_k|| > jacobian_reassembly_ratio * ||r_{k-1}||
+   * @note only supported by NonlinearSolver::Newton and NonlinearSolver::NewtonLineSearch
+   */
+  double jacobian_reassembly_ratio = 0.0;
+
+  /**
+   * @brief Keep the preconditioner across Newton iterations and solves (e.g. load steps), only refreshing the
+   * operator of the iterative linear solver. The preconditioner is rebuilt if the linear solver fails to converge.
+   * The solver keeps a copy of the Jacobian that the preconditioner was built from, so the Jacobian returned by the
+   * residual operator may be freed after each assembly.
+   * @note only supported by NonlinearSolver::Newton and NonlinearSolver::NewtonLineSearch, with Jacobians that are
+   * mfem::HypreParMatrix (the preconditioner is rebuilt every time for other Jacobians)
+   */
+  bool reuse_preconditioner = false;
 };
 // _nonlinear_options_end
 
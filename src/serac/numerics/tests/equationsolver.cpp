@@ -7,6 +7,7 @@
 #include <array>
 #include <fstream>
 #include <functional>
+#include <limits>
 
 #include <gtest/gtest.h>
 #include "mfem.hpp"
@@ -162,6 +163,106 @@ INSTANTIATE_TEST_SUITE_P(AllEquationSolverTests, EquationSolverSuite,
                            return name;
                          });
 
+TEST(EquationSolver, JacobianReuse)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(4, 4, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  pmesh.EnsureNodes();
+  pmesh.ExchangeFaceNbrData();
+
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  using space = H1<p>;
+
+  auto [fes, fec] = serac::generateParFiniteElementSpace<space>(&pmesh);
+
+  mfem::HypreParVector x_exact(fes.get());
+  x_exact.Randomize(0);
+
+  std::unique_ptr<mfem::HypreParMatrix> J;
+
+  Functional<space(space)> residual(fes.get(), {fes.get()});
+
+  residual.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0>{},
+      [&](double /*t*/, auto, auto scalar) {
+        auto [u, du_dx] = scalar;
+        return serac::tuple{u + 0.5 * sin(u), du_dx};
+      },
+      pmesh);
+
+  StdFunctionOperator residual_opr(
+      fes->TrueVSize(),
+      [&x_exact, &residual](const mfem::Vector& x, mfem::Vector& r) {
+        const mfem::Vector res = residual(0.0, x);
+
+        r = res;
+        r -= residual(0.0, x_exact);
+      },
+      [&residual, &J](const mfem::Vector& x) -> mfem::Operator& {
+        // poison the previous Jacobian before it is freed, so that any solver
+        // still referring to it gives NaNs rather than silently reading freed memory
+        if (J) {
+          mfem::SparseMatrix diag;
+          J->GetDiag(diag);
+          diag = std::numeric_limits<double>::quiet_NaN();
+        }
+        auto [val, grad] = residual(0.0, differentiate_wrt(x));
+        J                = assemble(grad);
+        return *J;
+      });
+
+  const LinearSolverOptions lin_opts = {.linear_solver  = LinearSolver::GMRES,
+                                        .preconditioner = Preconditioner::HypreJacobi,
+                                        .relative_tol   = 1.0e-10,
+                                        .absolute_tol   = 1.0e-12,
+                                        .max_iterations = 500,
+                                        .print_level    = 0};
+
+  auto solve_twice = [&](NonlinearSolverOptions nonlin_opts) {
+    nonlin_opts.nonlin_solver  = NonlinearSolver::Newton;
+    nonlin_opts.relative_tol   = 1.0e-10;
+    nonlin_opts.absolute_tol   = 1.0e-12;
+    nonlin_opts.max_iterations = 100;
+
+    EquationSolver eq_solver(nonlin_opts, lin_opts);
+    eq_solver.setOperator(residual_opr);
+
+    // solve from two different initial guesses, to emulate consecutive load steps
+    for (double initial_guess : {0.0, 0.5}) {
+      mfem::HypreParVector x_computed(fes.get());
+      x_computed = initial_guess;
+      eq_solver.solve(x_computed);
+
+      EXPECT_TRUE(eq_solver.nonlinearSolver().GetConverged());
+      x_computed -= x_exact;
+      EXPECT_LT(x_computed.Normlinf(), 1.0e-6);
+    }
+
+    return eq_solver.counts();
+  };
+
+  auto full_newton = solve_twice({});
+  EXPECT_EQ(full_newton.solves, 2);
+  EXPECT_EQ(full_newton.jacobian_assemblies, full_newton.nonlinear_iterations);
+  EXPECT_EQ(full_newton.preconditioner_setups, full_newton.jacobian_assemblies);
+
+  auto every_other_iteration = solve_twice({.jacobian_reassembly_interval = 2});
+  EXPECT_LT(every_other_iteration.jacobian_assemblies, every_other_iteration.nonlinear_iterations);
+
+  auto modified_newton = solve_twice({.jacobian_reassembly_interval = 0});
+  EXPECT_EQ(modified_newton.jacobian_assemblies, 2);
+
+  auto ratio_based = solve_twice({.jacobian_reassembly_interval = 0, .jacobian_reassembly_ratio = 0.1});
+  EXPECT_GE(ratio_based.jacobian_assemblies, modified_newton.jacobian_assemblies);
+
+  auto keep_preconditioner = solve_twice({.reuse_preconditioner = true});
+  EXPECT_EQ(keep_preconditioner.jacobian_assemblies, keep_preconditioner.nonlinear_iterations);
+  EXPECT_LT(keep_preconditioner.preconditioner_setups, keep_preconditioner.jacobian_assemblies);
+}
+
 int main(int argc, char* argv[])
 {
   testing::InitGoogleTest(&argc, argv);
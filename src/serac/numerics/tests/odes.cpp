@@ -4,6 +4,7 @@
 //
 // SPDX-License-Identifier: (BSD-3-Clause)
 
+#include <algorithm>
 #include <array>
 #include <fstream>
 #include <functional>
@@ -237,7 +238,7 @@ int which_kind_of_ode(serac::TimestepMethod m)
 }
 
 double first_order_ode_test(int nsteps, ode_type type, constraint_type constraint, TimestepMethod timestepper,
-                            DirichletEnforcementMethod enforcement)
+                            DirichletEnforcementMethod enforcement, TimestepController* controller = nullptr)
 {
   double t                      = 0.0;
   double ode_residual_eval_time = 0.0;
@@ -326,8 +327,16 @@ double first_order_ode_test(int nsteps, ode_type type, constraint_type constrain
   soln[1] = 2.0;
   soln[2] = 3.0;
 
-  for (int i = 0; i < nsteps; i++) {
-    ode.Step(soln, t, dt);
+  if (controller) {
+    // with adaptive timestepping, nsteps only bounds the timestep
+    while (t < 1.0 - 1.0e-12) {
+      double max_dt = std::min(dt, 1.0 - t);
+      ode.AdaptiveStep(soln, t, max_dt, *controller);
+    }
+  } else {
+    for (int i = 0; i < nsteps; i++) {
+      ode.Step(soln, t, dt);
+    }
   }
 
   // these solutions are computed to machine precision in
@@ -358,7 +367,7 @@ double first_order_ode_test(int nsteps, ode_type type, constraint_type constrain
 }
 
 double second_order_ode_test(int nsteps, ode_type type, constraint_type constraint, TimestepMethod timestepper,
-                             DirichletEnforcementMethod enforcement)
+                             DirichletEnforcementMethod enforcement, TimestepController* controller = nullptr)
 {
   double t                      = 0.0;
   double ode_residual_eval_time = 0.0;
@@ -465,8 +474,16 @@ double second_order_ode_test(int nsteps, ode_type type, constraint_type constrai
     velocity[0] = 4.0;
   }
 
-  for (int i = 0; i < nsteps; i++) {
-    ode.Step(displacement, velocity, t, dt);
+  if (controller) {
+    // with adaptive timestepping, nsteps only bounds the timestep
+    while (t < 1.0 - 1.0e-12) {
+      double max_dt = std::min(dt, 1.0 - t);
+      ode.AdaptiveStep(displacement, velocity, t, max_dt, *controller);
+    }
+  } else {
+    for (int i = 0; i < nsteps; i++) {
+      ode.Step(displacement, velocity, t, dt);
+    }
   }
 
   // these solutions are computed to machine precision in
@@ -552,6 +569,64 @@ TEST_P(FirstOrderODESuite, All)
   EXPECT_LT(pow(2.0, 0.9 * order_of_convergence(timestepper)), (errors[1] / errors[2]));
 }
 
+TEST(TimestepController, GrowsAndShrinksTheTimestep)
+{
+  TimestepController controller({.min_factor = 0.2, .max_factor = 5.0}, 1);
+
+  // before the first step, the timestep is only limited by the caller
+  EXPECT_DOUBLE_EQ(controller.suggestedTimestep(0.1), 0.1);
+
+  // a step well within tolerance is accepted, and the next one may be larger
+  EXPECT_TRUE(controller.accept(0.1, 0.01));
+  EXPECT_GT(controller.suggestedTimestep(1.0), 0.1);
+  EXPECT_LE(controller.suggestedTimestep(1.0), 0.5);
+
+  // a step that exceeds the tolerance is rejected and retried with a smaller timestep
+  EXPECT_FALSE(controller.accept(0.1, 4.0));
+  EXPECT_LT(controller.suggestedTimestep(1.0), 0.1);
+  EXPECT_GE(controller.suggestedTimestep(1.0), 0.02);
+
+  // the timestep does not grow right after a rejection
+  double retry = controller.suggestedTimestep(1.0);
+  EXPECT_TRUE(controller.accept(retry, 1.0e-6));
+  EXPECT_LE(controller.suggestedTimestep(1.0), retry);
+
+  controller.rejectNonconverged(retry);
+  EXPECT_EQ(controller.numRejected(), 2);
+
+  controller.reset();
+  EXPECT_EQ(controller.numRejected(), 0);
+
+  // a zero-length step, as SolidMechanics takes to compute the initial acceleration, does not stall the controller
+  EXPECT_TRUE(controller.accept(0.0, 0.0));
+  EXPECT_DOUBLE_EQ(controller.suggestedTimestep(0.1), 0.1);
+}
+
+TEST(TimestepController, AdaptiveBackwardEuler)
+{
+  TimestepController controller({.relative_tol = 1.0e-3, .absolute_tol = 1.0e-6}, 1);
+
+  double error = first_order_ode_test(10, LINEAR, UNCONSTRAINED, TimestepMethod::BackwardEuler,
+                                      DirichletEnforcementMethod::RateControl, &controller);
+
+  // the same tolerance that FirstOrderODESuite applies to its finest fixed timestep
+  EXPECT_LT(error, 3.0e-3);
+}
+
+TEST(TimestepController, AdaptiveSecondOrder)
+{
+  // these methods scale the Zienkiewicz-Xie error estimate by different Newmark betas
+  for (auto timestepper : {TimestepMethod::Newmark, TimestepMethod::AverageAcceleration, TimestepMethod::FoxGoodwin}) {
+    TimestepController controller({.relative_tol = 1.0e-4, .absolute_tol = 1.0e-7}, 2);
+
+    double error = second_order_ode_test(10, LINEAR, UNCONSTRAINED, timestepper,
+                                         DirichletEnforcementMethod::RateControl, &controller);
+
+    // the same tolerance that SecondOrderODESuite applies to its finest fixed timestep
+    EXPECT_LT(error, 1.0e-3) << to_string(timestepper);
+  }
+}
+
 // clang-format off
 INSTANTIATE_TEST_SUITE_P(AllFirstOrderTests, FirstOrderODESuite,
   testing::Combine(
@@ -0,0 +1,115 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/timestep_controller.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+namespace {
+
+/// @brief Gustafsson's exponents of the current and previous error norms, before dividing by k
+constexpr double integral_exponent     = 0.7;
+constexpr double proportional_exponent = 0.4;
+
+/// @brief A lower bound on error norms, so that exact steps grow the timestep by max_factor instead of dividing by zero
+constexpr double min_error_norm = 1.0e-10;
+
+}  // namespace
+
+TimestepController::TimestepController(const AdaptiveTimesteppingOptions& options, int order)
+    : options_(options), k_(order + 1.0), next_timestep_(options.max_timestep)
+{
+  SLIC_ERROR_ROOT_IF(order < 1, "The error estimate of an adaptive timestep controller must be at least first order");
+  SLIC_ERROR_ROOT_IF(options_.relative_tol <= 0.0 && options_.absolute_tol <= 0.0,
+                     "Adaptive timestepping requires a positive relative or absolute tolerance");
+  SLIC_ERROR_ROOT_IF(options_.min_timestep > options_.max_timestep,
+                     "The minimum timestep for adaptive timestepping exceeds the maximum timestep");
+  SLIC_ERROR_ROOT_IF(options_.min_factor <= 0.0 || options_.min_factor > 1.0 || options_.max_factor < 1.0,
+                     "Adaptive timestepping requires 0 < min_factor <= 1 <= max_factor");
+}
+
+double TimestepController::suggestedTimestep(double max_timestep) const
+{
+  double timestep = std::clamp(next_timestep_, options_.min_timestep, options_.max_timestep);
+  return std::min(timestep, max_timestep);
+}
+
+double TimestepController::errorNorm(const mfem::Vector& error, const mfem::Vector& u_start, const mfem::Vector& u_end,
+                                     MPI_Comm comm) const
+{
+  const double* e  = error.HostRead();
+  const double* u0 = u_start.HostRead();
+  const double* u1 = u_end.HostRead();
+
+  // local sum of squares and number of entries, reduced together
+  double sums[2] = {0.0, static_cast<double>(error.Size())};
+  for (int i = 0; i < error.Size(); i++) {
+    double scale = options_.absolute_tol + options_.relative_tol * std::max(std::abs(u0[i]), std::abs(u1[i]));
+    sums[0] += (e[i] / scale) * (e[i] / scale);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, sums, 2, MPI_DOUBLE, MPI_SUM, comm);
+
+  return (sums[1] > 0.0) ? std::sqrt(sums[0] / sums[1]) : 0.0;
+}
+
+bool TimestepController::accept(double timestep, double error_norm)
+{
+  // a zero-length step, e.g. one that only computes the initial acceleration, says nothing about the next timestep
+  if (timestep <= 0.0) {
+    return true;
+  }
+
+  // this also rejects steps whose error is not a number
+  if (!(error_norm <= 1.0)) {
+    double factor = std::isfinite(error_norm) ? options_.safety_factor * std::pow(error_norm, -1.0 / k_) : 0.0;
+    next_timestep_ = timestep * std::clamp(factor, options_.min_factor, 1.0);
+    last_rejected_ = true;
+    num_rejected_++;
+    return false;
+  }
+
+  error_norm    = std::max(error_norm, min_error_norm);
+  double factor = options_.safety_factor * std::pow(error_norm, -integral_exponent / k_) *
+                  std::pow(previous_error_norm_, proportional_exponent / k_);
+  factor = std::clamp(factor, options_.min_factor, options_.max_factor);
+
+  // don't grow the timestep right after a rejection, it was just shown to be too large
+  if (last_rejected_) {
+    factor = std::min(factor, 1.0);
+  }
+
+  next_timestep_       = timestep * factor;
+  previous_error_norm_ = error_norm;
+  last_rejected_       = false;
+  return true;
+}
+
+void TimestepController::rejectNonconverged(double timestep)
+{
+  next_timestep_ = timestep * options_.nonconvergence_factor;
+  last_rejected_ = true;
+  num_rejected_++;
+}
+
+bool TimestepController::canRetry(int attempts, double timestep) const
+{
+  return attempts <= options_.max_retries && timestep > options_.min_timestep;
+}
+
+void TimestepController::reset()
+{
+  next_timestep_       = options_.max_timestep;
+  previous_error_norm_ = 1.0;
+  last_rejected_       = false;
+  num_rejected_        = 0;
+}
+
+}  // namespace serac
@@ -0,0 +1,119 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file timestep_controller.hpp
+ *
+ * @brief A PI controller that chooses timesteps from estimates of the local truncation error
+ */
+
+#pragma once
+
+#include "mfem.hpp"
+
+#include "serac/numerics/solver_config.hpp"
+
+namespace serac {
+
+/**
+ * @brief Chooses the timesteps of a dynamic solver so that the estimated local truncation error of each step stays
+ * within a tolerance
+ *
+ * After each step, the time integrator provides an estimate of its local truncation error, which is scaled by
+ * \f$\mathrm{atol} + \mathrm{rtol} \, |u|\f$ and measured in the root mean square norm. A step is accepted if the
+ * scaled error \f$e_n\f$ is at most 1, and the next timestep is then chosen by the PI controller of Gustafsson,
+ * \f[
+ *   h_{n+1} = h_n \, s \, e_n^{-0.7 / k} \, e_{n-1}^{0.4 / k},
+ * \f]
+ * where \f$s\f$ is the safety factor and \f$k\f$ is one more than the order of the error estimate. The proportional
+ * term \f$e_{n-1}^{0.4 / k}\f$ damps the oscillations in the timestep that a purely integral controller produces
+ * when the step size is limited by stability. A rejected step is retried with the timestep of the integral controller,
+ * or shrunk by a fixed factor if the nonlinear solver did not converge.
+ */
+class TimestepController {
+public:
+  /**
+   * @brief Construct a new timestep controller
+   *
+   * @param options The tolerances and limits of the controller
+   * @param order The order of the local truncation error estimate, i.e. the error is \f$O(h^{order + 1})\f$
+   */
+  TimestepController(const AdaptiveTimesteppingOptions& options, int order);
+
+  /**
+   * @brief Get the timestep to attempt next
+   *
+   * @param max_timestep An upper bound on the timestep, e.g. the time remaining until the next output
+   * @return The timestep proposed by the controller, limited by @a max_timestep and the options
+   */
+  double suggestedTimestep(double max_timestep) const;
+
+  /**
+   * @brief Compute the scaled root mean square norm of a local truncation error estimate
+   *
+   * @param error The estimated local truncation error of the step
+   * @param u_start The solution at the start of the step
+   * @param u_end The solution at the end of the step
+   * @param comm The communicator over which the vectors are distributed
+   * @return The scaled error norm, where values of at most 1 satisfy the tolerances
+   */
+  double errorNorm(const mfem::Vector& error, const mfem::Vector& u_start, const mfem::Vector& u_end,
+                   MPI_Comm comm) const;
+
+  /**
+   * @brief Decide whether to accept a step, and update the proposed timestep accordingly
+   *
+   * A zero-length step is always accepted and leaves the proposed timestep unchanged.
+   *
+   * @param timestep The timestep that was taken
+   * @param error_norm The scaled error norm of the step, see errorNorm()
+   * @return Whether the step is accepted
+   */
+  bool accept(double timestep, double error_norm);
+
+  /**
+   * @brief Reject a step whose nonlinear solve did not converge, and shrink the proposed timestep
+   *
+   * @param timestep The timestep that was attempted
+   */
+  void rejectNonconverged(double timestep);
+
+  /**
+   * @brief Whether another attempt is allowed after a rejected step
+   *
+   * @param attempts The number of attempts of the current step so far
+   * @param timestep The timestep of the rejected attempt
+   * @return True if the step can be retried with suggestedTimestep()
+   */
+  bool canRetry(int attempts, double timestep) const;
+
+  /// @brief The number of rejected steps since the controller was constructed or reset
+  int numRejected() const { return num_rejected_; }
+
+  /// @brief Forget the error history and the proposed timestep, e.g. when restarting a simulation
+  void reset();
+
+private:
+  /// @brief The tolerances and limits of the controller
+  AdaptiveTimesteppingOptions options_;
+
+  /// @brief One more than the order of the error estimate, which is the exponent of the timestep in the error
+  double k_;
+
+  /// @brief The timestep proposed for the next attempt, which is unlimited before the first step
+  double next_timestep_;
+
+  /// @brief The scaled error norm of the last accepted step
+  double previous_error_norm_ = 1.0;
+
+  /// @brief Whether the last attempt was rejected, in which case the timestep may not grow
+  bool last_rejected_ = false;
+
+  /// @brief The number of rejected steps
+  int num_rejected_ = 0;
+};
+
+}  // namespace serac
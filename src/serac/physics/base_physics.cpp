@@ -6,12 +6,15 @@
 
 #include "serac/physics/base_physics.hpp"
 
+#include <algorithm>
 #include <fstream>
+#include <limits>
 
 #include "axom/fmt.hpp"
 
 #include "serac/infrastructure/initialize.hpp"
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/output.hpp"
 #include "serac/infrastructure/terminator.hpp"
 #include "serac/physics/state/finite_element_state.hpp"
 #include "serac/physics/state/state_manager.hpp"
@@ -59,10 +62,23 @@ int BasePhysics::minCycle() const { return min_cycle_; }
 
 const std::vector<double>& BasePhysics::timesteps() const { return timesteps_; }
 
+double BasePhysics::suggestedTimestep() const
+{
+  SLIC_ERROR_ROOT_IF(!timestep_controller_,
+                     axom::fmt::format("Adaptive timestepping is not enabled in physics module {}", name_));
+  return timestep_controller_->suggestedTimestep(std::numeric_limits<double>::max());
+}
+
+int BasePhysics::numRejectedTimesteps() const { return timestep_controller_ ? timestep_controller_->numRejected() : 0; }
+
 void BasePhysics::initializeBasePhysicsStates(int cycle, double time)
 {
   timesteps_.clear();
 
+  if (timestep_controller_) {
+    timestep_controller_->reset();
+  }
+
   time_           = time;
   max_time_       = time;
   min_time_       = time;
@@ -216,6 +232,9 @@ void BasePhysics::outputStateToDisk(std::optional<std::string> paraview_output_d
 
 void BasePhysics::initializeSummary(axom::sidre::DataStore& datastore, double t_final, double dt) const
 {
+  // A background write of a restart file may be reading the datastore
+  output::flush();
+
   // Summary Sidre Structure
   // Sidre root
   // └── serac_summary
@@ -269,6 +288,9 @@ void BasePhysics::initializeSummary(axom::sidre::DataStore& datastore, double t_
 
 void BasePhysics::saveSummary(axom::sidre::DataStore& datastore, const double t) const
 {
+  // A background write of a restart file may be reading the datastore
+  output::flush();
+
   auto [_, rank] = getMPIInfo();
 
   // Find curves sidre group
@@ -331,9 +353,42 @@ void BasePhysics::saveSummary(axom::sidre::DataStore& datastore, const double t)
   }
 }
 
+void BasePhysics::setCheckpointing(BinomialCheckpointing checkpointing)
+{
+  SLIC_ERROR_ROOT_IF(
+      checkpoint_to_disk_,
+      axom::fmt::format("Binomial checkpointing requested for physics module {}, which checkpoints to disk.", name_));
+  SLIC_ERROR_ROOT_IF(
+      snapshot_store_,
+      axom::fmt::format("Binomial checkpointing requested for physics module {}, which uses a snapshot store.", name_));
+  SLIC_ERROR_ROOT_IF(
+      cycle_ != min_cycle_,
+      axom::fmt::format("Binomial checkpointing must be set before advancing physics module {}.", name_));
+
+  binomial_checkpointing_ = std::move(checkpointing);
+  checkpoint_states_.clear();
+  restartCheckpoints();
+}
+
+void BasePhysics::setCheckpointing(SnapshotStore store)
+{
+  SLIC_ERROR_ROOT_IF(
+      checkpoint_to_disk_,
+      axom::fmt::format("Snapshot store requested for physics module {}, which checkpoints to disk.", name_));
+  SLIC_ERROR_ROOT_IF(
+      binomial_checkpointing_,
+      axom::fmt::format("Snapshot store requested for physics module {}, which uses binomial checkpointing.", name_));
+  SLIC_ERROR_ROOT_IF(cycle_ != min_cycle_,
+                     axom::fmt::format("Snapshot store must be set before advancing physics module {}.", name_));
+
+  snapshot_store_ = std::move(store);
+  checkpoint_states_.clear();
+  restartCheckpoints();
+}
+
 FiniteElementState BasePhysics::loadCheckpointedState(const std::string& state_name, int cycle) const
 {
-  if (checkpoint_to_disk_) {
+  if (checkpoint_to_disk_ || binomial_checkpointing_ || snapshot_store_) {
     // See if the requested cycle has been checkpointed previously
     if (!cached_checkpoint_cycle_ || *cached_checkpoint_cycle_ != cycle) {
       // If not, get the checkpoint from disk
@@ -368,6 +423,16 @@ std::unordered_map<std::string, FiniteElementState> BasePhysics::getCheckpointed
     }
     StateManager::loadCheckpointedStates(cycle_to_load, previous_states_ptrs);
     return previous_states_map;
+  } else if (binomial_checkpointing_) {
+    return recomputeCheckpointedStates(cycle_to_load);
+  } else if (snapshot_store_) {
+    for (const auto& state_name : stateNames()) {
+      previous_states_map.emplace(state_name, state(state_name));
+    }
+    for (auto& [state_name, previous_state] : previous_states_map) {
+      previous_states_ptrs.emplace_back(&previous_state);
+    }
+    snapshot_store_->read(cycle_to_load, previous_states_ptrs);
   } else {
     for (const auto& state_name : stateNames()) {
       previous_states_map.emplace(state_name, checkpoint_states_.at(state_name)[static_cast<size_t>(cycle_to_load)]);
@@ -377,6 +442,176 @@ std::unordered_map<std::string, FiniteElementState> BasePhysics::getCheckpointed
   return previous_states_map;
 }
 
+void BasePhysics::restartCheckpoints()
+{
+  cached_checkpoint_cycle_.reset();
+
+  if (binomial_checkpointing_) {
+    binomial_checkpointing_->clear();
+    binomial_checkpointing_->recordForwardStep(cycle_, {time_, currentStates()});
+    return;
+  }
+
+  if (snapshot_store_) {
+    snapshot_store_->clear();
+    snapshot_store_->write(cycle_, currentStatePointers());
+    return;
+  }
+
+  checkpoint_states_.clear();
+  for (const auto& state_name : stateNames()) {
+    checkpoint_states_[state_name].push_back(state(state_name));
+  }
+}
+
+void BasePhysics::checkpointStates()
+{
+  // binomial checkpointing places its own snapshots while recomputing states, and trial timesteps are only
+  // checkpointed once they are accepted
+  if (recomputing_checkpoints_ || inTrialTimestep()) {
+    return;
+  }
+
+  cached_checkpoint_cycle_.reset();
+
+  if (binomial_checkpointing_) {
+    binomial_checkpointing_->recordForwardStep(cycle_, {time_, currentStates()});
+    return;
+  }
+
+  if (snapshot_store_) {
+    snapshot_store_->write(cycle_, currentStatePointers());
+    return;
+  }
+
+  for (const auto& state_name : stateNames()) {
+    checkpoint_states_[state_name].push_back(state(state_name));
+  }
+}
+
+void BasePhysics::updateCheckpointedState(const std::string& state_name)
+{
+  cached_checkpoint_cycle_.reset();
+
+  if (binomial_checkpointing_) {
+    if (auto* snapshot = binomial_checkpointing_->find(cycle_)) {
+      if (auto it = snapshot->states.find(state_name); it != snapshot->states.end()) {
+        it->second = state(state_name);
+      }
+    }
+    return;
+  }
+
+  if (snapshot_store_) {
+    // snapshots are written as a whole, so the other states of this cycle are written again as well
+    snapshot_store_->write(cycle_, currentStatePointers());
+    return;
+  }
+
+  checkpoint_states_[state_name][static_cast<size_t>(cycle_)] = state(state_name);
+}
+
+std::vector<const FiniteElementState*> BasePhysics::currentStatePointers() const
+{
+  std::vector<const FiniteElementState*> states;
+  for (const auto& state_name : stateNames()) {
+    states.push_back(&state(state_name));
+  }
+  return states;
+}
+
+std::unordered_map<std::string, FiniteElementState> BasePhysics::currentStates() const
+{
+  std::unordered_map<std::string, FiniteElementState> states;
+  for (const auto& state_name : stateNames()) {
+    states.emplace(state_name, state(state_name));
+  }
+  return states;
+}
+
+void BasePhysics::restoreStates(int cycle, const BinomialCheckpointing::Snapshot& snapshot)
+{
+  for (const auto& [state_name, value] : snapshot.states) {
+    auto primal = std::find(states_.begin(), states_.end(), &state(state_name));
+    SLIC_ERROR_ROOT_IF(primal == states_.end(),
+                       axom::fmt::format("Checkpointed state '{}' is not a primal state of physics module '{}'",
+                                         state_name, name_));
+    **primal = value;
+  }
+  time_  = snapshot.time;
+  cycle_ = cycle;
+  restartTimeIntegration();
+}
+
+void BasePhysics::beginTrialTimestep()
+{
+  SLIC_ERROR_ROOT_IF(
+      timestep_controller_,
+      axom::fmt::format("Trial timesteps are not supported with adaptive timestepping in physics module {}.", name_));
+  trial_timestep_.emplace(cycle_, BinomialCheckpointing::Snapshot{time_, currentStates()});
+}
+
+void BasePhysics::repeatTrialTimestep()
+{
+  SLIC_ERROR_ROOT_IF(!trial_timestep_, axom::fmt::format("No trial timestep to repeat in physics module {}.", name_));
+  restoreStates(trial_timestep_->first, trial_timestep_->second);
+}
+
+void BasePhysics::acceptTrialTimestep()
+{
+  SLIC_ERROR_ROOT_IF(!trial_timestep_, axom::fmt::format("No trial timestep to accept in physics module {}.", name_));
+  trial_timestep_.reset();
+
+  if (checkpoint_to_disk_) {
+    outputStateToDisk();
+  } else {
+    checkpointStates();
+  }
+}
+
+std::unordered_map<std::string, FiniteElementState> BasePhysics::recomputeCheckpointedStates(int cycle_to_load) const
+{
+  if (auto* snapshot = binomial_checkpointing_->find(cycle_to_load)) {
+    return snapshot->states;
+  }
+
+  if (cached_checkpoint_cycle_ && *cached_checkpoint_cycle_ == cycle_to_load) {
+    return cached_checkpoint_states_;
+  }
+
+  SLIC_ERROR_ROOT_IF(
+      cycle_to_load > max_cycle_,
+      axom::fmt::format("States for cycle {} requested, but physics module {} has only reached cycle {}.",
+                        cycle_to_load, name_, max_cycle_));
+
+  // recomputing advances the physics module in place, so its current states are restored afterwards
+  auto*                            physics       = const_cast<BasePhysics*>(this);
+  int                              current_cycle = cycle_;
+  BinomialCheckpointing::Snapshot current{time_, currentStates()};
+
+  auto [start_cycle, start] = binomial_checkpointing_->previous(cycle_to_load);
+  physics->restoreStates(start_cycle, start);
+
+  recomputing_checkpoints_ = true;
+  while (cycle_ < cycle_to_load) {
+    int steps = binomial_checkpointing_->stepsToNextSnapshot(cycle_, cycle_to_load);
+    for (int i = 0; i < steps; i++) {
+      physics->advanceTimestep(getCheckpointedTimestep(cycle_));
+    }
+    if (cycle_ < cycle_to_load) {
+      binomial_checkpointing_->store(cycle_, {time_, currentStates()}, cycle_to_load);
+    }
+  }
+  recomputing_checkpoints_ = false;
+
+  cached_checkpoint_states_ = currentStates();
+  cached_checkpoint_cycle_  = cycle_to_load;
+
+  physics->restoreStates(current_cycle, current);
+
+  return cached_checkpoint_states_;
+}
+
 double BasePhysics::getCheckpointedTimestep(int cycle) const
 {
   SLIC_ERROR_ROOT_IF(cycle < 0, axom::fmt::format("Negative cycle number requested for physics module {}.", name_));
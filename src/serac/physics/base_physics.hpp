@@ -20,8 +20,11 @@
 
 #include "serac/physics/boundary_conditions/boundary_condition_manager.hpp"
 #include "serac/numerics/equation_solver.hpp"
+#include "serac/numerics/timestep_controller.hpp"
 #include "serac/physics/state/finite_element_state.hpp"
 #include "serac/physics/state/finite_element_dual.hpp"
+#include "serac/physics/state/binomial_checkpointing.hpp"
+#include "serac/physics/state/snapshot_store.hpp"
 #include "serac/physics/state/state_manager.hpp"
 #include "serac/physics/common.hpp"
 
@@ -125,6 +128,21 @@ public:
    */
   virtual const std::vector<double>& timesteps() const;
 
+  /**
+   * @brief Get the timestep that the adaptive timestep controller proposes for the next call to advanceTimestep()
+   *
+   * @return The proposed timestep, which is only limited by the options before the first step
+   * @pre Adaptive timestepping must be enabled through TimesteppingOptions::adaptive
+   */
+  double suggestedTimestep() const;
+
+  /**
+   * @brief Get the number of steps rejected by the adaptive timestep controller
+   *
+   * @return The number of rejected steps since the states were last initialized, or 0 without adaptive timestepping
+   */
+  int numRejectedTimesteps() const;
+
   /**
    * @brief Base method to reset physics states to the initial time.  This does not reset design parameters or shape.
    *
@@ -409,10 +427,35 @@ public:
    *
    * Advance the underlying ODE with the requested time integration scheme using the previously set timestep.
    *
+   * With adaptive timestepping (see TimesteppingOptions::adaptive), this takes a single accepted step of at most
+   * @a dt, whose size is chosen from the estimated local truncation error and recorded in timesteps().
+   *
    * @param dt The increment of simulation time to advance the underlying physical system
    */
   virtual void advanceTimestep(double dt) = 0;
 
+  /**
+   * @brief Start a timestep that may be repeated before it is accepted, e.g. by the iterations of a coupled solver
+   *
+   * Until acceptTrialTimestep() is called, advanceTimestep() does not checkpoint the primal states or write them to
+   * disk, and does not update the quadrature point data of history-dependent materials.
+   *
+   * @pre The physics module must not use adaptive timestepping, since every attempt must take the same timestep
+   */
+  void beginTrialTimestep();
+
+  /**
+   * @brief Restore the primal states, time, and cycle saved by beginTrialTimestep(), so that the timestep can be
+   * taken again
+   */
+  void repeatTrialTimestep();
+
+  /**
+   * @brief Accept the last attempt of a trial timestep, checkpointing its primal states as advanceTimestep() would
+   * have
+   */
+  virtual void acceptTrialTimestep();
+
   /**
    * @brief Set the loads for the adjoint reverse timestep solve
    */
@@ -436,6 +479,10 @@ public:
    *  if \p paraview_output_dir is given.
    *
    * @param[in] paraview_output_dir Optional output directory for paraview visualization files
+   *
+   * @note With output::setAsyncWrites(true), the Sidre file is written on a background I/O thread. The Paraview files
+   * are always written before this returns, since mfem's writer communicates over the mesh's communicator, which the
+   * simulation keeps using.
    */
   virtual void outputStateToDisk(std::optional<std::string> paraview_output_dir = {}) const;
 
@@ -449,6 +496,30 @@ public:
    */
   FiniteElementState loadCheckpointedState(const std::string& state_name, int cycle) const;
 
+  /**
+   * @brief Keep at most a fixed number of in-memory snapshots of the primal states for transient adjoint solves,
+   * recomputing the states of the other cycles from the closest earlier snapshot when they are needed
+   *
+   * @param checkpointing The checkpointing policy, see BinomialCheckpointing
+   *
+   * @pre This must be called before the first call to advanceTimestep(), and cannot be combined with checkpointing to
+   * disk
+   * @note Recomputed timesteps update the quadrature point data again, so this should not be used with
+   * history-dependent materials
+   */
+  void setCheckpointing(BinomialCheckpointing checkpointing);
+
+  /**
+   * @brief Checkpoint the primal states for transient adjoint solves in a per-rank binary snapshot file, which is much
+   * cheaper to read back than the sidre data collections used when checkpointing to disk
+   *
+   * @param store The snapshot store to write to, see SnapshotStore
+   *
+   * @pre This must be called before the first call to advanceTimestep(), and cannot be combined with checkpointing to
+   * disk or binomial checkpointing
+   */
+  void setCheckpointing(SnapshotStore store);
+
   /**
    * @brief Get a timestep increment which has been previously checkpointed at the give cycle
    * @param cycle The previous 'timestep' number where the timestep increment is requested
@@ -491,6 +562,29 @@ protected:
    */
   void CreateParaviewDataCollection() const;
 
+  /**
+   * @brief Get copies of the current primal states
+   *
+   * @return A map containing the primal field names and their current values
+   */
+  std::unordered_map<std::string, FiniteElementState> currentStates() const;
+
+  /**
+   * @brief Overwrite the current primal states, time, and cycle with checkpointed values
+   *
+   * @param cycle The cycle of the checkpoint
+   * @param snapshot The time and primal states to restore
+   */
+  void restoreStates(int cycle, const BinomialCheckpointing::Snapshot& snapshot);
+
+  /**
+   * @brief Recompute the primal states at a cycle which does not have a binomial checkpoint
+   *
+   * @param cycle The cycle to retrieve state from
+   * @return A map containing the primal field names and their associated FiniteElementStates at the requested cycle
+   */
+  std::unordered_map<std::string, FiniteElementState> recomputeCheckpointedStates(int cycle) const;
+
   /**
    * @brief Update the paraview states, duals, parameters, and metadata (cycle, time) in preparation for output
    *
@@ -516,6 +610,42 @@ protected:
    */
   std::unordered_map<std::string, FiniteElementState> getCheckpointedStates(int cycle) const;
 
+  /**
+   * @brief Discard any checkpointed primal states and checkpoint the current ones as the start of a forward sweep
+   *
+   * @note This is not used when checkpointing to disk
+   */
+  void restartCheckpoints();
+
+  /// @brief The current primal states, in the form written to a SnapshotStore
+  std::vector<const FiniteElementState*> currentStatePointers() const;
+
+  /**
+   * @brief Checkpoint the current primal states at the end of a forward timestep
+   *
+   * @note This is not used when checkpointing to disk
+   */
+  void checkpointStates();
+
+  /**
+   * @brief Overwrite the checkpointed value of a primal state at the current cycle, e.g. after setting an initial
+   * condition
+   *
+   * @param state_name The name of the primal state
+   *
+   * @note This is not used when checkpointing to disk
+   */
+  void updateCheckpointedState(const std::string& state_name);
+
+  /**
+   * @brief Called after the primal states have been overwritten with checkpointed values, so that the time integrator
+   * can discard any history it carries over between timesteps
+   */
+  virtual void restartTimeIntegration() {}
+
+  /// @brief Whether the current timestep is a trial timestep, see beginTrialTimestep()
+  bool inTrialTimestep() const { return trial_timestep_.has_value(); }
+
   /// @brief Name of the physics module
   std::string name_ = {};
 
@@ -535,7 +665,7 @@ protected:
   /**
    * @brief List of finite element primal states associated with this physics module
    */
-  std::vector<const serac::FiniteElementState*> states_;
+  std::vector<serac::FiniteElementState*> states_;
 
   /**
    * @brief List of finite element adjoint states associated with this physics module
@@ -614,6 +744,21 @@ protected:
   /// @brief An optional int for disk-based checkpointing containing the cycle number of the last retrieved checkpoint
   mutable std::optional<int> cached_checkpoint_cycle_;
 
+  /// @brief The optional policy for keeping a fixed number of in-memory checkpoints, see setCheckpointing()
+  mutable std::optional<BinomialCheckpointing> binomial_checkpointing_;
+
+  /// @brief Whether the forward timesteps being taken are recomputing states for binomial checkpointing
+  mutable bool recomputing_checkpoints_ = false;
+
+  /// @brief The optional per-rank binary file used to checkpoint the primal states, see setCheckpointing()
+  mutable std::optional<SnapshotStore> snapshot_store_;
+
+  /// @brief The cycle, time, and primal states at the start of the current trial timestep, see beginTrialTimestep()
+  std::optional<std::pair<int, BinomialCheckpointing::Snapshot>> trial_timestep_;
+
+  /// @brief The optional controller choosing the timesteps from error estimates, see TimesteppingOptions::adaptive
+  std::optional<TimestepController> timestep_controller_;
+
   /**
    *@brief Whether the simulation is time-independent
    */
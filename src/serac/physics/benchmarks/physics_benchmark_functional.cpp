@@ -4,6 +4,7 @@
 //
 // SPDX-License-Identifier: (BSD-3-Clause)
 
+#include <algorithm>
 #include <fstream>
 
 #include "axom/slic/core/SimpleLogger.hpp"
@@ -12,6 +13,7 @@
 #include "serac/serac_config.hpp"
 #include "serac/infrastructure/profiling.hpp"
 #include "serac/mesh/mesh_utils.hpp"
+#include "serac/numerics/functional/finite_element.hpp"
 #include "serac/physics/materials/thermal_material.hpp"
 #include "serac/physics/state/state_manager.hpp"
 #include "serac/physics/heat_transfer.hpp"
@@ -75,6 +77,58 @@ void functional_test(int parallel_refinement)
   SERAC_MARK_END("assemble gradient");
 }
 
+// compares two ways of calculating element gradients for H1 elements on quadrilaterals and hexahedra:
+//  - "columns"           : integrate one column of the element gradient at a time
+//  - "sum factorization" : contract the q-function derivatives with products of 1D shape functions
+template <mfem::Geometry::Type geom, int p, int components>
+void element_gradient_test(uint32_t num_elements)
+{
+  using element = serac::finite_element<geom, serac::H1<p, components>>;
+
+  constexpr int dim   = element::dim;
+  constexpr int c     = components;
+  constexpr int Q     = p + 1;
+  constexpr int nquad = serac::num_quadrature_points(geom, Q);
+  constexpr int ndof  = element::ndof * components;
+
+  static constexpr serac::TensorProductQuadratureRule<Q> rule{};
+
+  using derivative_type =
+      serac::tuple<serac::tuple<serac::tensor<double, c, c>, serac::tensor<double, c, c, dim>>,
+                   serac::tuple<serac::tensor<double, c, dim, c>, serac::tensor<double, c, dim, c, dim>>>;
+
+  // fill the q-function derivatives with some arbitrary values
+  std::vector<derivative_type> qf_derivatives(num_elements * nquad);
+  double*                      values = reinterpret_cast<double*>(qf_derivatives.data());
+  for (std::size_t k = 0; k < qf_derivatives.size() * sizeof(derivative_type) / sizeof(double); k++) {
+    values[k] = double(k % 7) - 3.0;
+  }
+
+  std::vector<typename element::dof_type> K(num_elements * ndof);
+
+  SERAC_MARK_BEGIN("columns");
+  for (uint32_t e = 0; e < num_elements; e++) {
+    serac::tensor<derivative_type, nquad> derivatives{};
+    for (int q = 0; q < nquad; q++) {
+      derivatives[q] = qf_derivatives[e * nquad + uint32_t(q)];
+    }
+
+    for (int J = 0; J < element::ndof; J++) {
+      auto source_and_flux = element::batch_apply_shape_fn(J, derivatives, rule);
+      element::integrate(source_and_flux, rule, &K[e * ndof + uint32_t(J)], element::ndof);
+    }
+  }
+  SERAC_MARK_END("columns");
+
+  std::fill(K.begin(), K.end(), typename element::dof_type{});
+
+  SERAC_MARK_BEGIN("sum factorization");
+  for (uint32_t e = 0; e < num_elements; e++) {
+    element::template element_gradient<element>(&qf_derivatives[e * nquad], rule, &K[e * ndof]);
+  }
+  SERAC_MARK_END("sum factorization");
+}
+
 int main(int argc, char* argv[])
 {
   MPI_Init(&argc, &argv);
@@ -129,6 +183,36 @@ int main(int argc, char* argv[])
 
   SERAC_MARK_END("vector H1");
 
+  constexpr uint32_t num_elements = 1000;
+
+  SERAC_MARK_BEGIN("element gradients");
+
+  SERAC_MARK_BEGIN("quadrilateral, order 1");
+  element_gradient_test<mfem::Geometry::SQUARE, 1, 2>(num_elements);
+  SERAC_MARK_END("quadrilateral, order 1");
+
+  SERAC_MARK_BEGIN("quadrilateral, order 2");
+  element_gradient_test<mfem::Geometry::SQUARE, 2, 2>(num_elements);
+  SERAC_MARK_END("quadrilateral, order 2");
+
+  SERAC_MARK_BEGIN("quadrilateral, order 3");
+  element_gradient_test<mfem::Geometry::SQUARE, 3, 2>(num_elements);
+  SERAC_MARK_END("quadrilateral, order 3");
+
+  SERAC_MARK_BEGIN("hexahedron, order 1");
+  element_gradient_test<mfem::Geometry::CUBE, 1, 3>(num_elements);
+  SERAC_MARK_END("hexahedron, order 1");
+
+  SERAC_MARK_BEGIN("hexahedron, order 2");
+  element_gradient_test<mfem::Geometry::CUBE, 2, 3>(num_elements);
+  SERAC_MARK_END("hexahedron, order 2");
+
+  SERAC_MARK_BEGIN("hexahedron, order 3");
+  element_gradient_test<mfem::Geometry::CUBE, 3, 3>(num_elements);
+  SERAC_MARK_END("hexahedron, order 3");
+
+  SERAC_MARK_END("element gradients");
+
   // Finalize profiling
   serac::profiling::finalize();
 
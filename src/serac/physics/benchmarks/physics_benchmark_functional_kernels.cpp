@@ -0,0 +1,367 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+// Sweeps the element geometry, polynomial order, number of components, q-function and mesh size of the Functional
+// kernels (evaluation, evaluation with derivatives, jacobian-vector products and gradient assembly), and reports
+// the throughput and estimated work of each one.
+//
+// The work of each kernel (elements, quadrature points and bytes moved) comes from the built-in performance counters
+// of the integrals, see serac::profiling::enableCounters(). The floating point operations are estimated from the
+// sizes of the element interpolation and integration operators, and exclude the q-function itself.
+//
+// The q-functions without internal variables are also benchmarked with serac::vectorize(), which evaluates them at
+// serac::default_simd_width quadrature points at once. That width follows the instruction set the benchmark is
+// compiled for (e.g. -mavx2 or -mavx512f), so comparing builds for different instruction sets compares the scalar
+// and vectorized q-function evaluation on each of them.
+//
+// The results are written to a JSON file, so that they can be compared between builds.
+
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "axom/CLI11.hpp"
+#include "axom/fmt.hpp"
+#include "mfem.hpp"
+
+#include "serac/serac_config.hpp"
+#include "serac/infrastructure/initialize.hpp"
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
+#include "serac/infrastructure/terminator.hpp"
+#include "serac/mesh/mesh_utils.hpp"
+#include "serac/numerics/functional/functional.hpp"
+#include "serac/physics/materials/solid_material.hpp"
+
+namespace {
+
+/// the settings of the sweep
+struct Options {
+  /// the largest number of uniform refinements of the base mesh
+  int max_refinements = 1;
+
+  /// the number of times each kernel is applied per measurement
+  int repetitions = 3;
+
+  /// the file the results are written to
+  std::string output = "functional_kernels.json";
+};
+
+/// the timing and work of one kernel for one configuration
+struct Result {
+  std::string geometry;           ///< the element geometry
+  int         order;              ///< the polynomial order of the H1 space
+  int         components;         ///< the number of components of the H1 space
+  std::string qfunction;          ///< the name of the q-function
+  int         refinements;        ///< the number of uniform refinements of the base mesh
+  long long   elements;           ///< the total number of elements
+  long long   dofs;               ///< the total number of true degrees of freedom
+  std::string kernel;             ///< the name of the kernel
+  double      seconds;            ///< the wall-clock time of one application of the kernel
+  double      kernel_seconds;     ///< the time spent in the element kernels, as recorded by the integrals
+  double      quadrature_points;  ///< the number of quadrature points processed by one application
+  double      bytes;              ///< the estimated number of bytes moved by the element kernels per application
+  double      flops;              ///< the estimated floating point operations of the element kernels per application
+};
+
+std::vector<Result> results;
+
+/// a q-function with the cost of a linear mass and diffusion operator, for any number of components
+struct Linear {
+  /// @brief the q-function does not have any internal variables
+  using State = serac::Empty;
+
+  /// @brief return the value and gradient of the field as the source and flux
+  template <typename X, typename Field>
+  auto operator()(double, X, State&, Field field) const
+  {
+    auto [u, du_dx] = field;
+    return serac::tuple{u, du_dx};
+  }
+};
+
+/// a q-function that evaluates the stress of a solid material model, with any internal variables
+template <typename Material>
+struct Stress {
+  /// @brief the internal variables of the material model
+  using State = typename Material::State;
+
+  /// @brief the material model
+  Material material;
+
+  /// @brief return the stress of the material model as the flux
+  template <typename X, typename Displacement>
+  auto operator()(double, X, State& state, Displacement displacement) const
+  {
+    auto stress = material(state, serac::get<serac::DERIVATIVE>(displacement));
+    return serac::tuple{serac::zero{}, stress};
+  }
+};
+
+/**
+ * @brief apply a kernel repeatedly, and combine its wall-clock time with the work recorded by the integrals
+ *
+ * @param operation the integral operation that the kernel performs, see serac::Integral::startCounter()
+ * @param repetitions the number of times to apply the kernel
+ * @param kernel the kernel
+ * @param result the result to fill in with the timing and work per application
+ */
+template <typename Kernel>
+void measure(const std::string& operation, int repetitions, Kernel&& kernel, Result& result)
+{
+  serac::profiling::resetCounters();
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < repetitions; r++) {
+    kernel();
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  serac::profiling::Counter work;
+  std::string               suffix = "/" + operation;
+  for (const auto& [name, counter] : serac::profiling::getCounters()) {
+    if (name.rfind("Functional/", 0) == 0 && name.size() > suffix.size() &&
+        name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+      work += counter;
+    }
+  }
+
+  // the slowest rank determines the time, while the work is summed over the ranks
+  double times[2] = {seconds, work.seconds};
+  double sums[2]  = {double(work.quadrature_points), double(work.bytes)};
+  MPI_Allreduce(MPI_IN_PLACE, times, 2, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, sums, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+  result.seconds           = times[0] / repetitions;
+  result.kernel_seconds    = times[1] / repetitions;
+  result.quadrature_points = sums[0] / repetitions;
+  result.bytes             = sums[1] / repetitions;
+}
+
+/**
+ * @brief benchmark the kernels of a Functional with a single H1 trial space on a refined Cartesian mesh
+ *
+ * @tparam geom the element geometry
+ * @tparam p the polynomial order
+ * @tparam components the number of components of the field
+ * @param qfunction_name the name of the q-function, for the results
+ * @param qfunction the q-function
+ * @param initial_state the initial value of the q-function's internal variables
+ * @param options the settings of the sweep
+ */
+template <mfem::Geometry::Type geom, int p, int components, typename QFunction, typename State>
+void benchmark_kernels(const std::string& qfunction_name, const QFunction& qfunction, State initial_state,
+                       const Options& options)
+{
+  using space      = serac::H1<p, components>;
+  using element    = serac::finite_element<geom, space>;
+  using state_type = State;
+
+  constexpr int dim = serac::dimension_of(geom);
+  constexpr int Q   = p + 1;
+
+  // per element: the number of degrees of freedom, quadrature points, and values + gradients at each quadrature point
+  constexpr double ndof        = element::ndof;
+  constexpr double n           = ndof * components;
+  constexpr double m           = serac::num_quadrature_points(geom, Q);
+  constexpr double k           = (1 + dim) * components;
+  constexpr double interpolate = 2.0 * ndof * m * k;
+
+  for (int refinements = 0; refinements <= options.max_refinements; refinements++) {
+    std::string configuration = axom::fmt::format("{}, order {}, {} components, {}, {} refinements",
+                                                  mfem::Geometry::Name[geom], p, components, qfunction_name,
+                                                  refinements);
+    SERAC_MARK_SCOPE(configuration.c_str());
+
+    mfem::Mesh serial_mesh;
+    if constexpr (geom == mfem::Geometry::TRIANGLE || geom == mfem::Geometry::SQUARE) {
+      auto type   = (geom == mfem::Geometry::TRIANGLE) ? mfem::Element::TRIANGLE : mfem::Element::QUADRILATERAL;
+      serial_mesh = mfem::Mesh::MakeCartesian2D(8, 8, type, true);
+    } else {
+      auto type   = (geom == mfem::Geometry::TETRAHEDRON) ? mfem::Element::TETRAHEDRON : mfem::Element::HEXAHEDRON;
+      serial_mesh = mfem::Mesh::MakeCartesian3D(4, 4, 4, type);
+    }
+    auto mesh = serac::mesh::refineAndDistribute(std::move(serial_mesh), 0, refinements);
+
+    auto [fespace, fec] = serac::generateParFiniteElementSpace<space>(mesh.get());
+
+    std::shared_ptr<serac::QuadratureData<state_type>> qdata;
+    if constexpr (std::is_same_v<state_type, serac::Empty>) {
+      qdata = serac::EmptyQData;
+    } else {
+      std::array<uint32_t, mfem::Geometry::NUM_GEOMETRIES> qpts_per_element{};
+      qpts_per_element[geom] = uint32_t(m);
+      qdata = std::make_shared<serac::QuadratureData<state_type>>(serac::geometry_counts(*mesh), qpts_per_element,
+                                                                  initial_state);
+    }
+
+    serac::Functional<space(space)> residual(fespace.get(), {fespace.get()});
+    residual.AddDomainIntegral(serac::Dimension<dim>{}, serac::DependsOn<0>{}, qfunction, *mesh, qdata);
+
+    mfem::ParGridFunction u_global(fespace.get());
+    u_global.Randomize();
+    u_global *= 0.01;
+
+    mfem::Vector U(fespace->TrueVSize());
+    u_global.GetTrueDofs(U);
+
+    double t = 0.0;
+
+    Result result{mfem::Geometry::Name[geom],
+                  p,
+                  components,
+                  qfunction_name,
+                  refinements,
+                  mesh->GetGlobalNE(),
+                  fespace->GlobalTrueVSize(),
+                  "",
+                  0.0,
+                  0.0,
+                  0.0,
+                  0.0,
+                  0.0};
+
+    double num_elements = double(result.elements);
+
+    result.kernel = "evaluate";
+    result.flops  = num_elements * 2.0 * interpolate;
+    measure("evaluate", options.repetitions, [&]() { residual(t, U); }, result);
+    results.push_back(result);
+
+    result.kernel = "gradient";
+    measure("evaluate", options.repetitions, [&]() { residual(t, serac::differentiate_wrt(U)); }, result);
+    results.push_back(result);
+
+    auto [r, dr_dU] = residual(t, serac::differentiate_wrt(U));
+
+    result.kernel = "jvp";
+    result.flops  = num_elements * (2.0 * interpolate + 2.0 * k * k * m);
+    measure("jvp", options.repetitions, [&]() { dr_dU(U); }, result);
+    results.push_back(result);
+
+    // a dense estimate of B^T D B at each quadrature point, where B maps the element dofs to the values and gradients
+    result.kernel = "assemble";
+    result.flops  = num_elements * m * (2.0 * k * k * n + 2.0 * k * n * n);
+    measure("assemble", options.repetitions, [&]() { assemble(dr_dU); }, result);
+    results.push_back(result);
+  }
+}
+
+/// benchmark the q-functions that apply to a given element geometry and polynomial order
+template <mfem::Geometry::Type geom, int p>
+void benchmark_qfunctions(const Options& options)
+{
+  constexpr int dim = serac::dimension_of(geom);
+
+  benchmark_kernels<geom, p, 1>("linear", Linear{}, serac::Empty{}, options);
+  benchmark_kernels<geom, p, dim>("linear", Linear{}, serac::Empty{}, options);
+
+  using NeoHookean = serac::solid_mechanics::NeoHookean;
+  NeoHookean neo_hookean{1.0, 1.0, 1.0};
+  benchmark_kernels<geom, p, dim>("NeoHookean", Stress<NeoHookean>{neo_hookean}, serac::Empty{}, options);
+
+  std::string simd = axom::fmt::format(" simd<{}>", serac::default_simd_width);
+  benchmark_kernels<geom, p, dim>("linear" + simd, serac::vectorize(Linear{}), serac::Empty{}, options);
+  benchmark_kernels<geom, p, dim>("NeoHookean" + simd, serac::vectorize(Stress<NeoHookean>{neo_hookean}),
+                                  serac::Empty{}, options);
+
+  // the J2 model is only implemented in 3D
+  if constexpr (dim == 3) {
+    using J2 = serac::solid_mechanics::J2<serac::solid_mechanics::LinearHardening>;
+    J2 j2{100.0, 0.25, serac::solid_mechanics::LinearHardening{1.0, 0.1}, 1.0};
+    benchmark_kernels<geom, p, dim>("J2", Stress<J2>{j2}, J2::State{}, options);
+  }
+}
+
+/// benchmark all of the polynomial orders for a given element geometry
+template <mfem::Geometry::Type geom>
+void benchmark_orders(const Options& options)
+{
+  benchmark_qfunctions<geom, 1>(options);
+  benchmark_qfunctions<geom, 2>(options);
+  benchmark_qfunctions<geom, 3>(options);
+}
+
+/// write the results to a JSON file on rank 0, and summarize them in the log
+void write_results(const std::string& filename)
+{
+  std::string json = "{\n  \"benchmarks\": [";
+  for (std::size_t i = 0; i < results.size(); i++) {
+    const auto& r = results[i];
+    json += axom::fmt::format(
+        "{}\n    {{\"geometry\": \"{}\", \"order\": {}, \"components\": {}, \"qfunction\": \"{}\", "
+        "\"refinements\": {}, \"elements\": {}, \"dofs\": {}, \"kernel\": \"{}\", \"seconds\": {}, "
+        "\"kernel_seconds\": {}, \"dofs_per_second\": {}, \"quadrature_points_per_second\": {}, \"bytes\": {}, "
+        "\"flops\": {}}}",
+        (i == 0) ? "" : ",", r.geometry, r.order, r.components, r.qfunction, r.refinements, r.elements, r.dofs,
+        r.kernel, r.seconds, r.kernel_seconds, double(r.dofs) / r.seconds, r.quadrature_points / r.seconds, r.bytes,
+        r.flops);
+
+    SLIC_INFO_ROOT(axom::fmt::format(
+        "{:<12} p={} c={} {:<18} {:>9} dofs {:<8}: {:10.3e} s, {:10.3e} dofs/s, {:7.2f} GB/s, {:7.2f} GFLOP/s",
+        r.geometry, r.order, r.components, r.qfunction, r.dofs, r.kernel, r.seconds, double(r.dofs) / r.seconds,
+        1.0e-9 * r.bytes / r.kernel_seconds, 1.0e-9 * r.flops / r.kernel_seconds));
+  }
+  json += "\n  ]\n}\n";
+
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0) {
+    std::ofstream file(filename);
+    file << json;
+    SLIC_WARNING_IF(!file, axom::fmt::format("Could not write the benchmark results to '{}'", filename));
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  serac::initialize(argc, argv);
+
+  Options options;
+
+  axom::CLI::App app{"Functional Kernel Benchmark"};
+  app.add_option("-r,--max-refinements", options.max_refinements, "Largest number of refinements of the base meshes")
+      ->check(axom::CLI::NonNegativeNumber);
+  app.add_option("-n,--repetitions", options.repetitions, "Number of applications of each kernel per measurement")
+      ->check(axom::CLI::PositiveNumber);
+  app.add_option("-o,--output", options.output, "JSON file to write the results to");
+
+  // Parse the arguments and check if they are good
+  try {
+    CLI11_PARSE(app, argc, argv);
+  } catch (const axom::CLI::ParseError& e) {
+    serac::logger::flush();
+    if (e.get_name() == "CallForHelp") {
+      auto msg = app.help();
+      SLIC_INFO_ROOT(msg);
+      serac::exitGracefully();
+    } else {
+      auto err_msg = axom::CLI::FailureMessage::simple(&app, e);
+      SLIC_ERROR_ROOT(err_msg);
+    }
+  }
+
+  SERAC_SET_METADATA("test", "functional_kernels");
+
+  // the counters are only used to measure the work of each kernel, so they are not written when finalizing
+  serac::profiling::enableCounters("");
+
+  benchmark_orders<mfem::Geometry::TRIANGLE>(options);
+  benchmark_orders<mfem::Geometry::SQUARE>(options);
+  benchmark_orders<mfem::Geometry::TETRAHEDRON>(options);
+  benchmark_orders<mfem::Geometry::CUBE>(options);
+
+  write_results(options.output);
+
+  serac::exitGracefully(0);
+}
@@ -0,0 +1,178 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <algorithm>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include "mfem.hpp"
+
+#include "serac/serac_config.hpp"
+#include "serac/infrastructure/profiling.hpp"
+#include "serac/mesh/mesh_utils.hpp"
+#include "serac/numerics/functional/functional.hpp"
+#include "serac/numerics/functional/dof_numbering.hpp"
+
+// compares two ways of accumulating element matrices into the values array of a CSR matrix:
+//  - "nonzero hash map" : look up each (row, col) pair in GradientAssemblyLookupTables::nz_LUT
+//  - "element LUT"      : use the precomputed per-element nonzero indices and signs
+template <int p, int dim, int components>
+void gradient_assembly_test(int parallel_refinement)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  int serial_refinement = 1;
+
+  constexpr int num_repetitions = 10;
+
+  static_assert(dim == 2 || dim == 3, "Dimension must be 2 or 3 for gradient assembly test");
+
+  std::string filename =
+      (dim == 2) ? SERAC_REPO_DIR "/data/meshes/star.mesh" : SERAC_REPO_DIR "/data/meshes/beam-hex.mesh";
+
+  auto mesh =
+      serac::mesh::refineAndDistribute(serac::buildMeshFromFile(filename), serial_refinement, parallel_refinement);
+
+  using space         = serac::H1<p, components>;
+  auto [fespace, fec] = serac::generateParFiniteElementSpace<space>(mesh.get());
+
+  serac::BlockElementRestriction G(fespace.get());
+
+  SERAC_MARK_BEGIN("initialize lookup tables");
+  serac::GradientAssemblyLookupTables lookup_tables;
+  lookup_tables.init(G, G);
+  SERAC_MARK_END("initialize lookup tables");
+
+  // fill the element matrices with some arbitrary values
+  std::map<mfem::Geometry::Type, serac::CPUArray<double, 3>> element_matrices;
+  for (auto& [geom, restriction] : G.restrictions) {
+    auto n                 = restriction.nodes_per_elem * restriction.components;
+    element_matrices[geom] = serac::CPUArray<double, 3>(restriction.num_elements, n, n);
+
+    auto& K = element_matrices[geom];
+    for (axom::IndexType k = 0; k < K.size(); k++) {
+      K.data()[k] = double(k % 7) - 3.0;
+    }
+  }
+
+  std::vector<double> hash_map_values(lookup_tables.nnz);
+  std::vector<double> element_LUT_values(lookup_tables.nnz);
+
+  SERAC_MARK_BEGIN("nonzero hash map");
+  for (int r = 0; r < num_repetitions; r++) {
+    std::fill(hash_map_values.begin(), hash_map_values.end(), 0.0);
+    for (auto& [geom, K] : element_matrices) {
+      const auto&      restriction = G.restrictions.at(geom);
+      std::vector<DoF> vdofs(restriction.nodes_per_elem * restriction.components);
+
+      for (axom::IndexType e = 0; e < K.shape()[0]; e++) {
+        restriction.GetElementVDofs(int(e), vdofs);
+        for (axom::IndexType i = 0; i < K.shape()[1]; i++) {
+          auto col = vdofs[uint64_t(i)];
+          for (axom::IndexType j = 0; j < K.shape()[2]; j++) {
+            auto row = vdofs[uint64_t(j)];
+            hash_map_values[lookup_tables(int(row.index()), int(col.index()))] +=
+                row.sign() * col.sign() * K(e, i, j);
+          }
+        }
+      }
+    }
+  }
+  SERAC_MARK_END("nonzero hash map");
+
+  SERAC_MARK_BEGIN("element LUT");
+  for (int r = 0; r < num_repetitions; r++) {
+    std::fill(element_LUT_values.begin(), element_LUT_values.end(), 0.0);
+    for (auto& [geom, K] : element_matrices) {
+      const uint32_t* nonzeros = lookup_tables.element_nonzero_LUT[serac::Domain::Type::Elements].at(geom).data();
+      const int8_t*   signs    = lookup_tables.element_signs[serac::Domain::Type::Elements].at(geom).data();
+      for (axom::IndexType k = 0; k < K.size(); k++) {
+        element_LUT_values[nonzeros[k]] += signs[k] * K.data()[k];
+      }
+    }
+  }
+  SERAC_MARK_END("element LUT");
+
+  // both paths accumulate the contributions in the same order, so the results should agree exactly
+  SLIC_ERROR_ROOT_IF(hash_map_values != element_LUT_values, "gradient assembly paths produced different values");
+}
+
+int main(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  int parallel_refinement = 2;
+
+  axom::slic::SimpleLogger logger;
+
+  // Initialize profiling
+  serac::profiling::initialize();
+
+  // Add metadata
+  SERAC_SET_METADATA("test", "gradient_assembly");
+
+  SERAC_MARK_BEGIN("scalar H1");
+
+  SERAC_MARK_BEGIN("dimension 2, order 1");
+  gradient_assembly_test<1, 2, 1>(parallel_refinement);
+  SERAC_MARK_END("dimension 2, order 1");
+
+  SERAC_MARK_BEGIN("dimension 2, order 2");
+  gradient_assembly_test<2, 2, 1>(parallel_refinement);
+  SERAC_MARK_END("dimension 2, order 2");
+
+  SERAC_MARK_BEGIN("dimension 2, order 3");
+  gradient_assembly_test<3, 2, 1>(parallel_refinement);
+  SERAC_MARK_END("dimension 2, order 3");
+
+  SERAC_MARK_BEGIN("dimension 3, order 1");
+  gradient_assembly_test<1, 3, 1>(parallel_refinement);
+  SERAC_MARK_END("dimension 3, order 1");
+
+  SERAC_MARK_BEGIN("dimension 3, order 2");
+  gradient_assembly_test<2, 3, 1>(parallel_refinement);
+  SERAC_MARK_END("dimension 3, order 2");
+
+  SERAC_MARK_BEGIN("dimension 3, order 3");
+  gradient_assembly_test<3, 3, 1>(parallel_refinement);
+  SERAC_MARK_END("dimension 3, order 3");
+
+  SERAC_MARK_END("scalar H1");
+
+  SERAC_MARK_BEGIN("vector H1");
+
+  SERAC_MARK_BEGIN("dimension 2, order 1");
+  gradient_assembly_test<1, 2, 2>(parallel_refinement);
+  SERAC_MARK_END("dimension 2, order 1");
+
+  SERAC_MARK_BEGIN("dimension 2, order 2");
+  gradient_assembly_test<2, 2, 2>(parallel_refinement);
+  SERAC_MARK_END("dimension 2, order 2");
+
+  SERAC_MARK_BEGIN("dimension 2, order 3");
+  gradient_assembly_test<3, 2, 2>(parallel_refinement);
+  SERAC_MARK_END("dimension 2, order 3");
+
+  SERAC_MARK_BEGIN("dimension 3, order 1");
+  gradient_assembly_test<1, 3, 3>(parallel_refinement);
+  SERAC_MARK_END("dimension 3, order 1");
+
+  SERAC_MARK_BEGIN("dimension 3, order 2");
+  gradient_assembly_test<2, 3, 3>(parallel_refinement);
+  SERAC_MARK_END("dimension 3, order 2");
+
+  SERAC_MARK_BEGIN("dimension 3, order 3");
+  gradient_assembly_test<3, 3, 3>(parallel_refinement);
+  SERAC_MARK_END("dimension 3, order 3");
+
+  SERAC_MARK_END("vector H1");
+
+  // Finalize profiling
+  serac::profiling::finalize();
+
+  MPI_Finalize();
+
+  return 0;
+}
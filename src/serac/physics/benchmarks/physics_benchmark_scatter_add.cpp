@@ -0,0 +1,161 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <algorithm>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include "mfem.hpp"
+
+#include "serac/serac_config.hpp"
+#include "serac/infrastructure/profiling.hpp"
+#include "serac/mesh/mesh_utils.hpp"
+#include "serac/numerics/functional/functional.hpp"
+#include "serac/numerics/functional/element_restriction.hpp"
+
+// compares three ways of summing the E-vector contributions into an L-vector:
+//  - "serial"           : the original loop over elements
+//  - "element coloring" : elements that share no nodes are processed concurrently
+//  - "L-dof reduction"  : each L-vector entry sums its own contributions concurrently
+template <int p, int dim, int components>
+void scatter_add_test(int parallel_refinement)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  int serial_refinement = 1;
+
+  constexpr int num_repetitions = 10;
+
+  static_assert(dim == 2 || dim == 3, "Dimension must be 2 or 3 for scatter add test");
+
+  std::string filename =
+      (dim == 2) ? SERAC_REPO_DIR "/data/meshes/star.mesh" : SERAC_REPO_DIR "/data/meshes/beam-hex.mesh";
+
+  auto mesh =
+      serac::mesh::refineAndDistribute(serac::buildMeshFromFile(filename), serial_refinement, parallel_refinement);
+
+  using space         = serac::H1<p, components>;
+  auto [fespace, fec] = serac::generateParFiniteElementSpace<space>(mesh.get());
+
+  SERAC_MARK_BEGIN("initialize restriction");
+  serac::BlockElementRestriction G(fespace.get());
+  SERAC_MARK_END("initialize restriction");
+
+  mfem::BlockVector E(G.bOffsets());
+  for (int i = 0; i < E.Size(); i++) {
+    E[i] = double(i % 7) - 3.0;
+  }
+
+  mfem::Vector L_serial(fespace->GetVSize());
+  mfem::Vector L_coloring(fespace->GetVSize());
+  mfem::Vector L_reduction(fespace->GetVSize());
+
+  SERAC_MARK_BEGIN("serial");
+  for (int r = 0; r < num_repetitions; r++) {
+    L_serial = 0.0;
+    G.ScatterAdd(E, L_serial, serac::ScatterAddStrategy::Serial);
+  }
+  SERAC_MARK_END("serial");
+
+  SERAC_MARK_BEGIN("element coloring");
+  for (int r = 0; r < num_repetitions; r++) {
+    L_coloring = 0.0;
+    G.ScatterAdd(E, L_coloring, serac::ScatterAddStrategy::ElementColoring);
+  }
+  SERAC_MARK_END("element coloring");
+
+  SERAC_MARK_BEGIN("L-dof reduction");
+  for (int r = 0; r < num_repetitions; r++) {
+    L_reduction = 0.0;
+    G.ScatterAdd(E, L_reduction, serac::ScatterAddStrategy::LDofReduction);
+  }
+  SERAC_MARK_END("L-dof reduction");
+
+  // the L-dof reduction sums the contributions in the same order as the serial loop
+  bool reproducible = std::equal(L_serial.begin(), L_serial.end(), L_reduction.begin());
+  SLIC_ERROR_ROOT_IF(!reproducible, "L-dof reduction is not bitwise identical to the serial scatter-add");
+
+  L_coloring -= L_serial;
+  SLIC_ERROR_ROOT_IF(L_coloring.Normlinf() > 1.0e-12 * (1.0 + L_serial.Normlinf()),
+                     "element coloring scatter-add disagrees with the serial scatter-add");
+}
+
+int main(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  int parallel_refinement = 2;
+
+  axom::slic::SimpleLogger logger;
+
+  // Initialize profiling
+  serac::profiling::initialize();
+
+  // Add metadata
+  SERAC_SET_METADATA("test", "scatter_add");
+
+  SERAC_MARK_BEGIN("scalar H1");
+
+  SERAC_MARK_BEGIN("dimension 2, order 1");
+  scatter_add_test<1, 2, 1>(parallel_refinement);
+  SERAC_MARK_END("dimension 2, order 1");
+
+  SERAC_MARK_BEGIN("dimension 2, order 2");
+  scatter_add_test<2, 2, 1>(parallel_refinement);
+  SERAC_MARK_END("dimension 2, order 2");
+
+  SERAC_MARK_BEGIN("dimension 2, order 3");
+  scatter_add_test<3, 2, 1>(parallel_refinement);
+  SERAC_MARK_END("dimension 2, order 3");
+
+  SERAC_MARK_BEGIN("dimension 3, order 1");
+  scatter_add_test<1, 3, 1>(parallel_refinement);
+  SERAC_MARK_END("dimension 3, order 1");
+
+  SERAC_MARK_BEGIN("dimension 3, order 2");
+  scatter_add_test<2, 3, 1>(parallel_refinement);
+  SERAC_MARK_END("dimension 3, order 2");
+
+  SERAC_MARK_BEGIN("dimension 3, order 3");
+  scatter_add_test<3, 3, 1>(parallel_refinement);
+  SERAC_MARK_END("dimension 3, order 3");
+
+  SERAC_MARK_END("scalar H1");
+
+  SERAC_MARK_BEGIN("vector H1");
+
+  SERAC_MARK_BEGIN("dimension 2, order 1");
+  scatter_add_test<1, 2, 2>(parallel_refinement);
+  SERAC_MARK_END("dimension 2, order 1");
+
+  SERAC_MARK_BEGIN("dimension 2, order 2");
+  scatter_add_test<2, 2, 2>(parallel_refinement);
+  SERAC_MARK_END("dimension 2, order 2");
+
+  SERAC_MARK_BEGIN("dimension 2, order 3");
+  scatter_add_test<3, 2, 2>(parallel_refinement);
+  SERAC_MARK_END("dimension 2, order 3");
+
+  SERAC_MARK_BEGIN("dimension 3, order 1");
+  scatter_add_test<1, 3, 3>(parallel_refinement);
+  SERAC_MARK_END("dimension 3, order 1");
+
+  SERAC_MARK_BEGIN("dimension 3, order 2");
+  scatter_add_test<2, 3, 3>(parallel_refinement);
+  SERAC_MARK_END("dimension 3, order 2");
+
+  SERAC_MARK_BEGIN("dimension 3, order 3");
+  scatter_add_test<3, 3, 3>(parallel_refinement);
+  SERAC_MARK_END("dimension 3, order 3");
+
+  SERAC_MARK_END("vector H1");
+
+  // Finalize profiling
+  serac::profiling::finalize();
+
+  MPI_Finalize();
+
+  return 0;
+}
@@ -0,0 +1,248 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+// Measures the weak or strong scaling of quasi-static SolidMechanics solves.
+//
+// A block of material is clamped at its base and compressed by a pressure on its top, for each combination of
+// material (NeoHookean, J2), polynomial order (1, 2) and element geometry (hexahedra, tetrahedra). For weak scaling,
+// the mesh has a fixed number of elements per rank, and for strong scaling a fixed total number of elements.
+//
+// The time of each solve is split into residual evaluation, Jacobian assembly, preconditioner setup and linear solves
+// using the built-in performance counters of EquationSolver (see serac::profiling::enableCounters()). Each run appends
+// one row per configuration to a CSV file, so that running the benchmark with increasing numbers of MPI ranks (or
+// OpenMP threads) builds up the scaling table, e.g.
+//
+//   for n in 1 2 4 8; do mpirun -np $n physics_benchmark_solid_scaling --scaling weak -o weak.csv; done
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <type_traits>
+
+#include "axom/CLI11.hpp"
+#include "axom/core.hpp"
+#include "axom/fmt.hpp"
+#include "mfem.hpp"
+
+#ifdef SERAC_USE_OPENMP
+#include <omp.h>
+#endif
+
+#include "serac/serac_config.hpp"
+#include "serac/infrastructure/initialize.hpp"
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
+#include "serac/infrastructure/terminator.hpp"
+#include "serac/mesh/mesh_utils.hpp"
+#include "serac/physics/materials/solid_material.hpp"
+#include "serac/physics/solid_mechanics.hpp"
+#include "serac/physics/state/state_manager.hpp"
+
+namespace {
+
+/// the kind of scaling study
+enum class Scaling
+{
+  Weak,
+  Strong
+};
+
+/// the settings of the benchmark
+struct Options {
+  /// whether the problem size grows with the number of ranks
+  Scaling scaling = Scaling::Weak;
+
+  /// the number of elements along each edge of the cube assigned to each rank, for weak scaling
+  int elements_per_rank = 8;
+
+  /// the number of elements along each edge of the whole cube, for strong scaling
+  int elements = 16;
+
+  /// the file the rows of the scaling table are appended to
+  std::string output = "solid_scaling.csv";
+};
+
+/// the columns of the scaling table
+const std::string header =
+    "scaling,material,order,geometry,ranks,threads,elements,dofs,newton_iterations,linear_iterations,"
+    "jacobian_assemblies,preconditioner_setups,solve_seconds,residual_seconds,assembly_seconds,"
+    "preconditioner_seconds,linear_solve_seconds";
+
+/// get a solver counter, whose work is the same on every rank, with its time replaced by the maximum over all ranks
+serac::profiling::Counter reduce(const std::string& name)
+{
+  auto   counter = serac::profiling::getCounter(name);
+  double seconds = counter.seconds;
+  MPI_Allreduce(MPI_IN_PLACE, &seconds, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  counter.seconds = seconds;
+  return counter;
+}
+
+/**
+ * @brief solve one configuration of the benchmark problem, and append its row to the scaling table
+ *
+ * @tparam p the polynomial order of the displacement
+ * @tparam Material the type of the material model
+ * @param material_name the name of the material model, for the scaling table
+ * @param material the material model
+ * @param element_type the type of the elements
+ * @param options the settings of the benchmark
+ */
+template <int p, typename Material>
+void solid_scaling_test(const std::string& material_name, const Material& material, mfem::Element::Type element_type,
+                        const Options& options)
+{
+  constexpr int dim = 3;
+
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  auto [num_ranks, rank] = serac::getMPIInfo();
+
+  int threads = 1;
+#ifdef SERAC_USE_OPENMP
+  threads = omp_get_max_threads();
+#endif
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_scaling");
+
+  // for weak scaling, the cubes of elements assigned to each rank are stacked on top of each other
+  int nx = (options.scaling == Scaling::Weak) ? options.elements_per_rank : options.elements;
+  int nz = (options.scaling == Scaling::Weak) ? options.elements_per_rank * num_ranks : options.elements;
+
+  std::string mesh_tag = "mesh";
+  auto        mesh     = serac::mesh::refineAndDistribute(
+      mfem::Mesh::MakeCartesian3D(nx, nx, nz, element_type, 1.0, 1.0, double(nz) / nx));
+  auto& pmesh = serac::StateManager::setMesh(std::move(mesh), mesh_tag);
+
+  serac::NonlinearSolverOptions nonlinear_options{.nonlin_solver  = serac::NonlinearSolver::Newton,
+                                                  .relative_tol   = 1.0e-8,
+                                                  .absolute_tol   = 1.0e-10,
+                                                  .max_iterations = 20,
+                                                  .print_level    = 0};
+
+  serac::LinearSolverOptions linear_options{.linear_solver  = serac::LinearSolver::CG,
+                                            .preconditioner = serac::Preconditioner::HypreAMG,
+                                            .relative_tol   = 1.0e-10,
+                                            .absolute_tol   = 1.0e-14,
+                                            .max_iterations = 2000,
+                                            .print_level    = 0};
+
+  serac::SolidMechanics<p, dim> solid(nonlinear_options, linear_options,
+                                      serac::solid_mechanics::default_quasistatic_options,
+                                      serac::GeometricNonlinearities::On, "solid_scaling", mesh_tag);
+
+  if constexpr (std::is_same_v<typename Material::State, serac::Empty>) {
+    solid.setMaterial(material);
+  } else {
+    solid.setMaterial(material, solid.createQuadratureDataBuffer(typename Material::State{}));
+  }
+
+  solid.setDisplacementBCs({1}, [](const mfem::Vector&, mfem::Vector& u) { u = 0.0; });
+
+  serac::Domain top = serac::Domain::ofBoundaryElements(pmesh, serac::by_attr<dim>(6));
+  solid.setPressure([](auto, auto t) { return 0.01 * t; }, top);
+
+  solid.completeSetup();
+
+  serac::profiling::resetCounters();
+  solid.advanceTimestep(1.0);
+
+  auto solve          = reduce("EquationSolver/solve");
+  auto residual       = reduce("EquationSolver/residual");
+  auto assembly       = reduce("EquationSolver/jacobian_assembly");
+  auto preconditioner = reduce("EquationSolver/preconditioner_setup");
+  auto linear_solve   = reduce("EquationSolver/linear_solve");
+
+  std::string row = axom::fmt::format(
+      "{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{}", (options.scaling == Scaling::Weak) ? "weak" : "strong",
+      material_name, p, (element_type == mfem::Element::HEXAHEDRON) ? "hexahedron" : "tetrahedron", num_ranks, threads,
+      pmesh.GetGlobalNE(), solid.displacement().GlobalSize(), solve.iterations, linear_solve.iterations,
+      assembly.calls, preconditioner.calls, solve.seconds, residual.seconds, assembly.seconds, preconditioner.seconds,
+      linear_solve.seconds);
+
+  SLIC_INFO_ROOT(header);
+  SLIC_INFO_ROOT(row);
+
+  if (rank == 0) {
+    bool          write_header = !axom::utilities::filesystem::pathExists(options.output);
+    std::ofstream file(options.output, std::ios::app);
+    if (write_header) {
+      file << header << '\n';
+    }
+    file << row << '\n';
+    SLIC_WARNING_IF(!file, axom::fmt::format("Could not write the scaling table to '{}'", options.output));
+  }
+
+  serac::StateManager::reset();
+}
+
+/// run each material with a given polynomial order and element geometry
+template <int p>
+void solid_scaling_materials(mfem::Element::Type element_type, const Options& options)
+{
+  double E  = 1.0;
+  double nu = 0.3;
+  double K  = E / (3.0 * (1.0 - 2.0 * nu));
+  double G  = E / (2.0 * (1.0 + nu));
+
+  serac::solid_mechanics::NeoHookean neo_hookean{1.0, K, G};
+  solid_scaling_test<p>("NeoHookean", neo_hookean, element_type, options);
+
+  using J2 = serac::solid_mechanics::J2<serac::solid_mechanics::LinearHardening>;
+  J2 j2{E, nu, serac::solid_mechanics::LinearHardening{0.005, 0.1 * E}, 1.0};
+  solid_scaling_test<p>("J2", j2, element_type, options);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  serac::initialize(argc, argv);
+
+  SERAC_MARK_FUNCTION;
+
+  Options options;
+
+  std::map<std::string, Scaling> scaling_map = {{"weak", Scaling::Weak}, {"strong", Scaling::Strong}};
+
+  axom::CLI::App app{"Solid Mechanics Scaling Benchmark"};
+  app.add_option("-s,--scaling", options.scaling, "Kind of scaling study (weak or strong)")
+      ->transform(axom::CLI::CheckedTransformer(scaling_map, axom::CLI::ignore_case));
+  app.add_option("--elements-per-rank", options.elements_per_rank,
+                 "Elements along each edge of the cube assigned to each rank, for weak scaling")
+      ->check(axom::CLI::PositiveNumber);
+  app.add_option("--elements", options.elements, "Elements along each edge of the whole cube, for strong scaling")
+      ->check(axom::CLI::PositiveNumber);
+  app.add_option("-o,--output", options.output, "CSV file to append the rows of the scaling table to");
+
+  // Parse the arguments and check if they are good
+  try {
+    CLI11_PARSE(app, argc, argv);
+  } catch (const axom::CLI::ParseError& e) {
+    serac::logger::flush();
+    if (e.get_name() == "CallForHelp") {
+      auto msg = app.help();
+      SLIC_INFO_ROOT(msg);
+      serac::exitGracefully();
+    } else {
+      auto err_msg = axom::CLI::FailureMessage::simple(&app, e);
+      SLIC_ERROR_ROOT(err_msg);
+    }
+  }
+
+  SERAC_SET_METADATA("test", "solid_scaling");
+
+  // the counters split the solve time into its phases, so they are not written when finalizing
+  serac::profiling::enableCounters("");
+
+  solid_scaling_materials<1>(mfem::Element::HEXAHEDRON, options);
+  solid_scaling_materials<2>(mfem::Element::HEXAHEDRON, options);
+  solid_scaling_materials<1>(mfem::Element::TETRAHEDRON, options);
+  solid_scaling_materials<2>(mfem::Element::TETRAHEDRON, options);
+
+  serac::exitGracefully(0);
+}
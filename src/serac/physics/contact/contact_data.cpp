@@ -8,6 +8,8 @@
 
 #include "axom/slic.hpp"
 
+#include "serac/infrastructure/profiling.hpp"
+
 #ifdef SERAC_USE_TRIBOL
 #include "tribol/interface/tribol.hpp"
 #include "tribol/interface/mfem_tribol.hpp"
@@ -43,6 +45,7 @@ void ContactData::addContactInteraction(int interaction_id, const std::set<int>&
 
 void ContactData::update(int cycle, double time, double& dt)
 {
+  profiling::ScopedCounter counter("ContactData/geometry_update");
   cycle_ = cycle;
   time_  = time;
   dt_    = dt;
@@ -53,6 +56,27 @@ void ContactData::update(int cycle, double time, double& dt)
   // fields (with the exception of pressure) are stored on the redecomposed surface mesh until transferred by calling
   // forces(), mergedGaps(), etc.
   tribol::update(cycle, time, dt);
+  // the interaction Jacobians depend on the geometry, so they are retrieved again when needed
+  interaction_jacobians_.clear();
+}
+
+void ContactData::updateGeometry(const mfem::Vector& u)
+{
+  // the geometry update is collective, so every rank has to agree on whether it is needed
+  int changed = !geometry_up_to_date_ || geometry_displacement_.Size() != u.Size();
+  for (int i = 0; !changed && i < u.Size(); ++i) {
+    changed = (u[i] != geometry_displacement_[i]);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_MAX, mesh_.GetComm());
+  if (!changed) {
+    profiling::addToCounter("ContactData/geometry_reuse", {1});
+    return;
+  }
+
+  setDisplacements(u);
+  update(cycle_, time_, dt_);
+  geometry_displacement_ = u;
+  geometry_up_to_date_   = true;
 }
 
 FiniteElementDual ContactData::forces() const
@@ -64,6 +88,20 @@ FiniteElementDual ContactData::forces() const
   return f;
 }
 
+FiniteElementDual ContactData::pressureForces() const
+{
+  const auto& interaction_jacobians = interactionJacobians(false);
+
+  FiniteElementDual f(*reference_nodes_->ParFESpace(), "contact force");
+  f = 0.0;
+  for (size_t i{0}; i < interactions_.size(); ++i) {
+    if (interaction_jacobians[i].dfdp) {
+      interaction_jacobians[i].dfdp->Mult(1.0, interactions_[i].pressure(), 1.0, f);
+    }
+  }
+  return f;
+}
+
 mfem::HypreParVector ContactData::mergedPressures() const
 {
   updateDofOffsets();
@@ -105,6 +143,8 @@ mfem::HypreParVector ContactData::mergedGaps(bool zero_inactive) const
 
 std::unique_ptr<mfem::BlockOperator> ContactData::mergedJacobian() const
 {
+  profiling::ScopedCounter counter("ContactData/jacobian");
+
   updateDofOffsets();
   // this is the BlockOperator we are returning with the following blocks:
   //  | df_(contact)/dx  df_(contact)/dp |
@@ -112,118 +152,170 @@ std::unique_ptr<mfem::BlockOperator> ContactData::mergedJacobian() const
   // where I_(inactive) is a matrix with ones on the diagonal of inactive pressure true degrees of freedom
   auto block_J         = std::make_unique<mfem::BlockOperator>(jacobian_offsets_);
   block_J->owns_blocks = true;
-  // rather than returning different blocks for each contact interaction with Lagrange multipliers, merge them all into
-  // a single block
-  mfem::Array2D<const mfem::HypreParMatrix*> constraint_matrices(static_cast<int>(interactions_.size()), 1);
+
+  // pressureForces() only needs the df_(contact)/dp blocks, so the blocks that are modified here are taken over
+  auto& interaction_jacobians = interactionJacobians(true);
+
+  // rather than returning different blocks for each contact interaction, the constraint matrices of the interactions
+  // with Lagrange multipliers are merged into a single block, and those of the interactions with penalty enforcement
+  // are merged so that their contribution to df_(contact)/dx is computed with a single product
+  mfem::Array2D<const mfem::HypreParMatrix*>         constraint_matrices(static_cast<int>(interactions_.size()), 1);
+  std::vector<const mfem::HypreParMatrix*>           penalty_matrices;
+  std::vector<double>                                penalties;
+  std::vector<std::unique_ptr<mfem::HypreParMatrix>> active_constraints;
+
+  std::unique_ptr<mfem::HypreParMatrix> dfdx;
 
   for (size_t i{0}; i < interactions_.size(); ++i) {
-    // this is the BlockOperator for one of the contact interactions
-    auto interaction_J         = interactions_[i].jacobian();
-    interaction_J->owns_blocks = false;  // we'll manage the ownership of the blocks on our own...
+    auto& interaction_J                         = interaction_jacobians[i];
+    constraint_matrices(static_cast<int>(i), 0) = nullptr;
+    interaction_J.taken                         = true;
+
     // add the contact interaction's contribution to df_(contact)/dx (the 0, 0 block)
-    if (!interaction_J->IsZeroBlock(0, 0)) {
-      SLIC_ERROR_ROOT_IF(!dynamic_cast<mfem::HypreParMatrix*>(&interaction_J->GetBlock(0, 0)),
-                         "Only HypreParMatrix constraint matrix blocks are currently supported.");
-      if (block_J->IsZeroBlock(0, 0)) {
-        block_J->SetBlock(0, 0, &interaction_J->GetBlock(0, 0));
+    if (interaction_J.dfdx) {
+      if (dfdx) {
+        dfdx.reset(mfem::Add(1.0, *dfdx, 1.0, *interaction_J.dfdx));
+        interaction_J.dfdx.reset();
       } else {
-        if (block_J->IsZeroBlock(0, 0)) {
-          block_J->SetBlock(0, 0, &interaction_J->GetBlock(0, 0));
-        } else {
-          block_J->SetBlock(0, 0,
-                            mfem::Add(1.0, static_cast<mfem::HypreParMatrix&>(block_J->GetBlock(0, 0)), 1.0,
-                                      static_cast<mfem::HypreParMatrix&>(interaction_J->GetBlock(0, 0))));
-        }
-        delete &interaction_J->GetBlock(0, 0);
+        dfdx = std::move(interaction_J.dfdx);
       }
     }
     // add the contact interaction's (other) contribution to df_(contact)/dx (for penalty) or to df_(contact)/dp and
     // dg/dx (for Lagrange multipliers)
-    if (!interaction_J->IsZeroBlock(1, 0)) {
-      auto B = dynamic_cast<mfem::HypreParMatrix*>(&interaction_J->GetBlock(1, 0));
-      SLIC_ERROR_ROOT_IF(!B, "Only HypreParMatrix constraint matrix blocks are currently supported.");
+    if (interaction_J.dgdx) {
+      if (!interaction_J.dfdp) {
+        SLIC_ERROR_ROOT("Only symmetric constraint matrices are currently supported.");
+      }
       // zero out rows not in the active set
+      auto B = std::move(interaction_J.dgdx);
       B->EliminateRows(interactions_[i].inactiveDofs());
       if (interactions_[i].getContactOptions().enforcement == ContactEnforcement::Penalty) {
-        // compute contribution to df_(contact)/dx (the 0, 0 block) for penalty
-        std::unique_ptr<mfem::HypreParMatrix> BTB(
-            mfem::ParMult(std::unique_ptr<mfem::HypreParMatrix>(B->Transpose()).get(), B, true));
-        delete &interaction_J->GetBlock(1, 0);
-        if (block_J->IsZeroBlock(0, 0)) {
-          mfem::Vector penalty(reference_nodes_->ParFESpace()->GetTrueVSize());
-          penalty = interactions_[i].getContactOptions().penalty;
-          BTB->ScaleRows(penalty);
-          block_J->SetBlock(0, 0, BTB.release());
-        } else {
-          block_J->SetBlock(0, 0,
-                            mfem::Add(1.0, static_cast<mfem::HypreParMatrix&>(block_J->GetBlock(0, 0)),
-                                      interactions_[i].getContactOptions().penalty, *BTB));
-        }
-        constraint_matrices(static_cast<int>(i), 0) = nullptr;
+        penalty_matrices.push_back(B.get());
+        penalties.insert(penalties.end(), static_cast<size_t>(B->Height()),
+                         interactions_[i].getContactOptions().penalty);
       } else  // enforcement == ContactEnforcement::LagrangeMultiplier
       {
-        // compute contribution to off-diagonal blocks for Lagrange multiplier
-        constraint_matrices(static_cast<int>(i), 0) = static_cast<mfem::HypreParMatrix*>(B);
-      }
-      if (interaction_J->IsZeroBlock(0, 1)) {
-        SLIC_ERROR_ROOT("Only symmetric constraint matrices are currently supported.");
-      }
-      delete &interaction_J->GetBlock(0, 1);
-      if (!interaction_J->IsZeroBlock(1, 1)) {
-        // we track our own active set, so get rid of the tribol inactive dof block
-        delete &interaction_J->GetBlock(1, 1);
+        constraint_matrices(static_cast<int>(i), 0) = B.get();
       }
+      active_constraints.push_back(std::move(B));
+    }
+  }
+
+  if (!penalty_matrices.empty()) {
+    // compute the contribution B^T diag(penalty) B of all of the penalty interactions to df_(contact)/dx
+    mfem::Array2D<const mfem::HypreParMatrix*> penalty_blocks(static_cast<int>(penalty_matrices.size()), 1);
+    for (size_t i{0}; i < penalty_matrices.size(); ++i) {
+      penalty_blocks(static_cast<int>(i), 0) = penalty_matrices[i];
+    }
+    std::unique_ptr<mfem::HypreParMatrix> B(mfem::HypreParMatrixFromBlocks(penalty_blocks));
+    std::unique_ptr<mfem::HypreParMatrix> BT(B->Transpose());
+    mfem::Vector                          penalty(penalties.data(), static_cast<int>(penalties.size()));
+    B->ScaleRows(penalty);
+    std::unique_ptr<mfem::HypreParMatrix> BTB(mfem::ParMult(BT.get(), B.get(), true));
+    if (dfdx) {
+      dfdx.reset(mfem::Add(1.0, *dfdx, 1.0, *BTB));
+    } else {
+      dfdx = std::move(BTB);
     }
   }
+  if (dfdx) {
+    block_J->SetBlock(0, 0, dfdx.release());
+  }
+
   if (haveLagrangeMultipliers()) {
     // merge all of the contributions from all of the contact interactions
     block_J->SetBlock(1, 0, mfem::HypreParMatrixFromBlocks(constraint_matrices));
     // store the transpose explicitly (rather than as a TransposeOperator) for solvers that need HypreParMatrixs
     block_J->SetBlock(0, 1, static_cast<mfem::HypreParMatrix&>(block_J->GetBlock(1, 0)).Transpose());
-    // build I_(inactive): a diagonal matrix with ones on inactive dofs and zeros elsewhere
-    mfem::Array<const mfem::Array<int>*> inactive_tdofs_vector(static_cast<int>(interactions_.size()));
-    int                                  inactive_tdofs_ct = 0;
-    for (int i{0}; i < inactive_tdofs_vector.Size(); ++i) {
-      inactive_tdofs_vector[i] = &interactions_[static_cast<size_t>(i)].inactiveDofs();
-      inactive_tdofs_ct += inactive_tdofs_vector[i]->Size();
-    }
-    mfem::Array<int> inactive_tdofs(inactive_tdofs_ct);
-    inactive_tdofs_ct = 0;
-    for (int i{0}; i < inactive_tdofs_vector.Size(); ++i) {
-      if (inactive_tdofs_vector[i]) {
-        for (int d{0}; d < inactive_tdofs_vector[i]->Size(); ++d) {
-          inactive_tdofs[d + inactive_tdofs_ct] = (*inactive_tdofs_vector[i])[d] + pressure_dof_offsets_[i];
+    // I_(inactive) is a copy of a cached matrix, which is only rebuilt when the inactive set changes
+    auto& block_1_0 = static_cast<mfem::HypreParMatrix&>(block_J->GetBlock(1, 0));
+    block_J->SetBlock(1, 1, new mfem::HypreParMatrix(inactiveDiagonal(block_1_0)));
+  }
+  return block_J;
+}
+
+std::vector<ContactData::InteractionJacobian>& ContactData::interactionJacobians(bool all_blocks) const
+{
+  bool taken = !interaction_jacobians_.empty() && interaction_jacobians_.front().taken;
+  if (interaction_jacobians_.size() != interactions_.size() || (all_blocks && taken)) {
+    profiling::ScopedCounter counter("ContactData/interaction_jacobians");
+    interaction_jacobians_.clear();
+    for (const auto& interaction : interactions_) {
+      // the blocks are handed over to InteractionJacobian, except for the unused 1, 1 block
+      auto interaction_J         = interaction.jacobian();
+      interaction_J->owns_blocks = false;
+      for (int i{0}; i < 2; ++i) {
+        for (int j{0}; j < 2; ++j) {
+          SLIC_ERROR_ROOT_IF(!interaction_J->IsZeroBlock(i, j) &&
+                                 !dynamic_cast<mfem::HypreParMatrix*>(&interaction_J->GetBlock(i, j)),
+                             "Only HypreParMatrix constraint matrix blocks are currently supported.");
         }
-        inactive_tdofs_ct += inactive_tdofs_vector[i]->Size();
       }
-    }
-    inactive_tdofs.GetMemory().SetHostPtrOwner(false);
-    mfem::Array<int> rows(numPressureDofs() + 1);
-    rows              = 0;
-    inactive_tdofs_ct = 0;
-    for (int i{0}; i < numPressureDofs(); ++i) {
-      if (inactive_tdofs_ct < inactive_tdofs.Size() && inactive_tdofs[inactive_tdofs_ct] == i) {
-        ++inactive_tdofs_ct;
+      auto block = [&interaction_J](int i, int j) {
+        return std::unique_ptr<mfem::HypreParMatrix>(
+            interaction_J->IsZeroBlock(i, j) ? nullptr
+                                             : static_cast<mfem::HypreParMatrix*>(&interaction_J->GetBlock(i, j)));
+      };
+      interaction_jacobians_.push_back({block(0, 0), block(0, 1), block(1, 0)});
+      if (!interaction_J->IsZeroBlock(1, 1)) {
+        delete &interaction_J->GetBlock(1, 1);
       }
-      rows[i + 1] = inactive_tdofs_ct;
     }
-    rows.GetMemory().SetHostPtrOwner(false);
-    mfem::Vector ones(inactive_tdofs_ct);
-    ones = 1.0;
-    ones.GetMemory().SetHostPtrOwner(false);
-    mfem::SparseMatrix inactive_diag(rows.GetData(), inactive_tdofs.GetData(), ones.GetData(), numPressureDofs(),
-                                     numPressureDofs(), false, false, true);
-    // if the size of ones is zero, SparseMatrix creates its own memory which it
-    // owns.  explicitly prevent this...
-    inactive_diag.SetDataOwner(false);
-    auto& block_1_0 = static_cast<mfem::HypreParMatrix&>(block_J->GetBlock(1, 0));
-    auto  block_1_1 = new mfem::HypreParMatrix(block_1_0.GetComm(), block_1_0.GetGlobalNumRows(),
-                                               block_1_0.GetRowStarts(), &inactive_diag);
-    block_1_1->SetOwnerFlags(3, 3, 1);
-    block_J->SetBlock(1, 1, block_1_1);
-    // end building I_(inactive)
   }
-  return block_J;
+  return interaction_jacobians_;
+}
+
+const mfem::HypreParMatrix& ContactData::inactiveDiagonal(const mfem::HypreParMatrix& constraints) const
+{
+  // merge the inactive pressure true degrees of freedom of the contact interactions with Lagrange multipliers
+  mfem::Array<int> inactive_tdofs;
+  for (size_t i{0}; i < interactions_.size(); ++i) {
+    if (interactions_[i].getContactOptions().enforcement != ContactEnforcement::LagrangeMultiplier) {
+      continue;
+    }
+    const auto& interaction_inactive_tdofs = interactions_[i].inactiveDofs();
+    for (int d{0}; d < interaction_inactive_tdofs.Size(); ++d) {
+      inactive_tdofs.Append(interaction_inactive_tdofs[d] + pressure_dof_offsets_[static_cast<int>(i)]);
+    }
+  }
+
+  // building the matrix is collective, so every rank has to agree on whether the inactive set changed
+  int changed = !inactive_diag_ || inactive_tdofs.Size() != merged_inactive_tdofs_.Size();
+  for (int d{0}; !changed && d < inactive_tdofs.Size(); ++d) {
+    changed = (inactive_tdofs[d] != merged_inactive_tdofs_[d]);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_MAX, mesh_.GetComm());
+  if (!changed) {
+    return *inactive_diag_;
+  }
+
+  profiling::ScopedCounter counter("ContactData/inactive_rebuild");
+  merged_inactive_tdofs_ = inactive_tdofs;
+
+  // build I_(inactive): a diagonal matrix with ones on inactive dofs and zeros elsewhere
+  mfem::Array<int> rows(numPressureDofs() + 1);
+  rows                  = 0;
+  int inactive_tdofs_ct = 0;
+  for (int i{0}; i < numPressureDofs(); ++i) {
+    if (inactive_tdofs_ct < inactive_tdofs.Size() && inactive_tdofs[inactive_tdofs_ct] == i) {
+      ++inactive_tdofs_ct;
+    }
+    rows[i + 1] = inactive_tdofs_ct;
+  }
+  inactive_tdofs.GetMemory().SetHostPtrOwner(false);
+  rows.GetMemory().SetHostPtrOwner(false);
+  mfem::Vector ones(inactive_tdofs_ct);
+  ones = 1.0;
+  ones.GetMemory().SetHostPtrOwner(false);
+  mfem::SparseMatrix inactive_diag(rows.GetData(), inactive_tdofs.GetData(), ones.GetData(), numPressureDofs(),
+                                   numPressureDofs(), false, false, true);
+  // if the size of ones is zero, SparseMatrix creates its own memory which it
+  // owns.  explicitly prevent this...
+  inactive_diag.SetDataOwner(false);
+  inactive_diag_ = std::make_unique<mfem::HypreParMatrix>(constraints.GetComm(), constraints.GetGlobalNumRows(),
+                                                          constraints.GetRowStarts(), &inactive_diag);
+  inactive_diag_->SetOwnerFlags(3, 3, 1);
+  return *inactive_diag_;
 }
 
 void ContactData::residualFunction(const mfem::Vector& u, mfem::Vector& r)
@@ -239,15 +331,12 @@ void ContactData::residualFunction(const mfem::Vector& u, mfem::Vector& r)
   mfem::Vector r_blk(r, 0, disp_size);
   mfem::Vector g_blk(r, disp_size, numPressureDofs());
 
-  setDisplacements(u_blk);
-  // we need to call update first to update gaps
-  update(cycle_, time_, dt_);
+  // the geometry (and the gaps) only depend on the displacement
+  updateGeometry(u_blk);
   // with updated gaps, we can update pressure for contact interactions with penalty enforcement
   setPressures(p_blk);
-  // call update again with the right pressures
-  update(cycle_, time_, dt_);
-
-  r_blk += forces();
+  // the forces are linear in the pressures, so they don't need another update
+  r_blk += pressureForces();
   // calling mergedGaps() with true will zero out gap on inactive dofs (so the residual converges and the linearized
   // system makes sense)
   g_blk.Set(1.0, mergedGaps(true));
@@ -299,6 +388,7 @@ void ContactData::setDisplacements(const mfem::Vector& u)
 {
   reference_nodes_->ParFESpace()->GetProlongationMatrix()->Mult(u, current_coords_);
   current_coords_ += *reference_nodes_;
+  geometry_up_to_date_ = false;
 }
 
 void ContactData::updateDofOffsets() const
@@ -336,6 +426,8 @@ void ContactData::updateDofOffsets() const
       global_pressure_dof_offsets_.SetSize(3);
     }
   }
+  // the pressure true dofs have changed, so I_(inactive) has to be rebuilt
+  inactive_diag_.reset();
   offsets_up_to_date_ = true;
 }
 
@@ -358,6 +450,8 @@ void ContactData::addContactInteraction([[maybe_unused]] int                  in
 
 void ContactData::update([[maybe_unused]] int cycle, [[maybe_unused]] double time, [[maybe_unused]] double& dt) {}
 
+void ContactData::updateGeometry([[maybe_unused]] const mfem::Vector& u) {}
+
 FiniteElementDual ContactData::forces() const
 {
   FiniteElementDual f(*reference_nodes_->ParFESpace(), "contact force");
@@ -365,6 +459,8 @@ FiniteElementDual ContactData::forces() const
   return f;
 }
 
+FiniteElementDual ContactData::pressureForces() const { return forces(); }
+
 mfem::HypreParVector ContactData::mergedPressures() const { return mfem::HypreParVector(); }
 
 mfem::HypreParVector ContactData::mergedGaps([[maybe_unused]] bool zero_inactive) const
@@ -74,13 +74,37 @@ public:
    */
   void update(int cycle, double time, double& dt);
 
+  /**
+   * @brief Updates the contact geometry (surface decomposition, projections, gaps and mortar weights) for a new
+   * displacement field
+   *
+   * The geometry only depends on the displacement, so the update is skipped if the displacement has not changed since
+   * the last call.
+   *
+   * @param u Current displacement true dof values
+   */
+  void updateGeometry(const mfem::Vector& u);
+
   /**
    * @brief Get the contact constraint residual (i.e. nodal forces) from all contact interactions
    *
+   * @note These are the forces computed by the last call to update(), i.e. using the pressures at that time
+   *
    * @return Nodal contact forces on the true DOFs
    */
   FiniteElementDual forces() const;
 
+  /**
+   * @brief Get the nodal contact forces of the current pressures, using the contact geometry of the last update
+   *
+   * For the mortar method, the nodal forces are linear in the pressures, \f$ f = \frac{\partial f}{\partial p} p \f$,
+   * where \f$ \frac{\partial f}{\partial p} \f$ only depends on the geometry. This block of the contact Jacobian is
+   * assembled once per update(), so that new pressures (e.g. from setPressures()) do not need another update().
+   *
+   * @return Nodal contact forces on the true DOFs
+   */
+  FiniteElementDual pressureForces() const;
+
   /**
    * @brief Returns pressures from all contact interactions on the contact surface true degrees of freedom
    *
@@ -108,9 +132,10 @@ public:
    * @brief Returns a 2x2 block Jacobian on displacement/pressure true degrees of
    * freedom from contact constraints
    *
-   * The element Jacobian contributions are computed upon calling update(). This method does MPI communication to move
-   * Jacobian contributions to the correct rank, then assembles the contributions.  The pressure degrees of freedom for
-   * all contact interactions are merged into a single block.
+   * The element Jacobian contributions are computed upon calling update(). The first call after an update does MPI
+   * communication to move Jacobian contributions to the correct rank, then assembles the contributions, which are
+   * reused until the next update.  The pressure degrees of freedom for all contact interactions are merged into a
+   * single block, and the I_(inactive) block is only rebuilt when the inactive set changes.
    *
    * @note The blocks are owned by the BlockOperator
    *
@@ -188,6 +213,23 @@ public:
 
 private:
 #ifdef SERAC_USE_TRIBOL
+  /**
+   * @brief The blocks of the Jacobian of a contact interaction, where a null block is zero
+   */
+  struct InteractionJacobian {
+    /// The (0, 0) block df_(contact)/dx, which mergedJacobian() takes over
+    std::unique_ptr<mfem::HypreParMatrix> dfdx;
+
+    /// The (0, 1) block df_(contact)/dp, which stays cached for pressureForces()
+    std::unique_ptr<mfem::HypreParMatrix> dfdp;
+
+    /// The (1, 0) block dg/dx, which mergedJacobian() takes over
+    std::unique_ptr<mfem::HypreParMatrix> dgdx;
+
+    /// Whether mergedJacobian() has taken over dfdx and dgdx
+    bool taken = false;
+  };
+
   /**
    * @brief Computes interaction pressure T-dof offsets and global pressure T-dof offsets
    *
@@ -195,6 +237,23 @@ private:
    */
   void updateDofOffsets() const;
 
+  /**
+   * @brief Get the Jacobian blocks of each contact interaction, retrieving them from Tribol if they are out of date
+   *
+   * @param all_blocks Whether the blocks taken over by a previous mergedJacobian() are needed again, in which case they
+   * are retrieved again. Otherwise, only the df_(contact)/dp blocks are guaranteed to be present.
+   * @return The Jacobian blocks of each contact interaction
+   */
+  std::vector<InteractionJacobian>& interactionJacobians(bool all_blocks) const;
+
+  /**
+   * @brief Get the diagonal matrix with ones on the inactive pressure T-dofs, rebuilding it if the inactive set changed
+   *
+   * @param constraints The merged constraint matrix, whose rows define the parallel partitioning of the pressure T-dofs
+   * @return The I_(inactive) block of the Jacobian
+   */
+  const mfem::HypreParMatrix& inactiveDiagonal(const mfem::HypreParMatrix& constraints) const;
+
   /**
    * @brief The volume mesh for the problem
    */
@@ -216,6 +275,41 @@ private:
    * @brief The contact boundary condition information
    */
   std::vector<ContactInteraction> interactions_;
+
+  /**
+   * @brief The displacement true dof values of the last geometry update
+   */
+  mfem::Vector geometry_displacement_;
+
+  /**
+   * @brief True if the contact geometry was last updated with geometry_displacement_
+   */
+  bool geometry_up_to_date_{false};
+
+  /**
+   * @brief The Jacobian blocks of each contact interaction from the last update
+   *
+   * These only depend on the contact geometry, so they are retrieved from Tribol (which requires MPI communication and
+   * assembly) once per update() in the usual sequence of pressureForces() followed by mergedJacobian(). The latter
+   * takes over the blocks it modifies instead of copying them.
+   *
+   * @note This is mutable so it can be filled when forces or Jacobians are retrieved, and is cleared by update().
+   */
+  mutable std::vector<InteractionJacobian> interaction_jacobians_;
+
+  /**
+   * @brief The merged inactive pressure T-dofs of the cached I_(inactive) block
+   *
+   * @note This is mutable so it can be updated when Jacobians are retrieved.
+   */
+  mutable mfem::Array<int> merged_inactive_tdofs_;
+
+  /**
+   * @brief The I_(inactive) block of the Jacobian, which is only rebuilt when the inactive set or the offsets change
+   *
+   * @note This is mutable so it can be updated when Jacobians are retrieved.
+   */
+  mutable std::unique_ptr<mfem::HypreParMatrix> inactive_diag_;
 #endif
 
   /**
@@ -19,6 +19,7 @@
 #include "serac/physics/heat_transfer_input.hpp"
 #include "serac/physics/base_physics.hpp"
 #include "serac/numerics/odes.hpp"
+#include "serac/numerics/linear_combination_operator.hpp"
 #include "serac/numerics/stdfunction_operator.hpp"
 #include "serac/numerics/functional/shape_aware_functional.hpp"
 #include "serac/physics/state/state_manager.hpp"
@@ -176,6 +177,11 @@ public:
       is_quasistatic_ = true;
     }
 
+    if (timestepping_opts.adaptive) {
+      SLIC_ERROR_ROOT_IF(is_quasistatic_, "Adaptive timestepping requires a dynamic timestepper in HeatTransfer");
+      timestep_controller_.emplace(*timestepping_opts.adaptive, 1);
+    }
+
     states_.push_back(&temperature_);
     if (!is_quasistatic_) {
       states_.push_back(&temperature_rate_);
@@ -288,11 +294,7 @@ public:
     temperature_rate_adjoint_load_                  = 0.0;
 
     if (!checkpoint_to_disk_) {
-      checkpoint_states_.clear();
-      auto state_names = stateNames();
-      for (const auto& state_name : state_names) {
-        checkpoint_states_[state_name].push_back(state(state_name));
-      }
+      restartCheckpoints();
     }
   }
 
@@ -352,18 +354,23 @@ public:
       // but at the moment, the double times creates a lot of confusion, so
       // we short circuit the extra time here by passing a dummy time and ignoring it.
       double time_tmp = time_;
-      ode_.Step(temperature_, time_tmp, dt);
+      if (timestep_controller_ && !recomputing_checkpoints_) {
+        // dt becomes the accepted timestep, which is recorded for the adjoint and checkpoint recomputation
+        ode_.AdaptiveStep(temperature_, time_tmp, dt, *timestep_controller_);
+      } else {
+        ode_.Step(temperature_, time_tmp, dt);
+      }
     }
 
     cycle_ += 1;
 
+    // trial timesteps are checkpointed once they are accepted
     if (checkpoint_to_disk_) {
-      outputStateToDisk();
-    } else {
-      auto state_names = stateNames();
-      for (const auto& state_name : state_names) {
-        checkpoint_states_[state_name].push_back(state(state_name));
+      if (!inTrialTimestep()) {
+        outputStateToDisk();
       }
+    } else {
+      checkpointStates();
     }
 
     if (cycle_ > max_cycle_) {
@@ -622,7 +629,7 @@ public:
     if (state_name == "temperature") {
       temperature_ = state;
       if (!checkpoint_to_disk_) {
-        checkpoint_states_["temperature"][static_cast<size_t>(cycle_)] = temperature_;
+        updateCheckpointedState("temperature");
       }
       return;
     }
@@ -694,6 +701,57 @@ public:
     return adjoint_temperature_;
   }
 
+  /// @brief Build the quasi-static operator, whose residual and gradient have the essential rows eliminated
+  std::unique_ptr<mfem_ext::StdFunctionOperator> buildQuasistaticOperator()
+  {
+    return std::make_unique<mfem_ext::StdFunctionOperator>(
+        temperature_.space().TrueVSize(),
+
+        [this](const mfem::Vector& u, mfem::Vector& r) {
+          const mfem::Vector res = (*residual_)(time_, shape_displacement_, u, temperature_rate_,
+                                                *parameters_[parameter_indices].state...);
+
+          // TODO this copy is required as the sundials solvers do not allow move assignments because of their memory
+          // tracking strategy
+          // See https://github.com/mfem/mfem/issues/3531
+          r = res;
+          r.SetSubVector(bcs_.allEssentialTrueDofs(), 0.0);
+        },
+
+        [this](const mfem::Vector& u) -> mfem::Operator& {
+          auto [r, drdu] = (*residual_)(time_, shape_displacement_, differentiate_wrt(u), temperature_rate_,
+                                        *parameters_[parameter_indices].state...);
+
+          if (nonlin_solver_->matrixFree()) {
+            J_matrix_free_ = std::make_unique<mfem::ConstrainedOperator>(&drdu, bcs_.allEssentialTrueDofs());
+            return *J_matrix_free_;
+          }
+
+          J_   = assemble(drdu);
+          J_e_ = bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
+          return *J_;
+        });
+  }
+
+  /**
+   * @brief Assemble the derivative of the residual with respect to a parameter field at the current temperature
+   *
+   * @param parameter_field The index of the parameter to take a derivative with respect to
+   * @return The assembled derivative, with the rows of the essential temperature degrees of freedom set to zero
+   */
+  std::unique_ptr<mfem::HypreParMatrix> parameterJacobian(size_t parameter_field)
+  {
+    SLIC_ERROR_ROOT_IF(
+        parameter_field >= sizeof...(parameter_indices),
+        axom::fmt::format("Parameter '{}' requested when only '{}' parameters exist in physics module '{}'",
+                          parameter_field, sizeof...(parameter_indices), name_));
+
+    auto drdparam     = serac::get<DERIVATIVE>(d_residual_d_[parameter_field](time_));
+    auto drdparam_mat = assemble(drdparam);
+    drdparam_mat->EliminateRows(bcs_.allEssentialTrueDofs());
+    return drdparam_mat;
+  }
+
   /**
    * @brief Complete the initialization and allocation of the data structures.
    *
@@ -705,27 +763,7 @@ public:
     temperature_.space().BuildDofToArrays();
 
     if (is_quasistatic_) {
-      residual_with_bcs_ = mfem_ext::StdFunctionOperator(
-          temperature_.space().TrueVSize(),
-
-          [this](const mfem::Vector& u, mfem::Vector& r) {
-            const mfem::Vector res = (*residual_)(time_, shape_displacement_, u, temperature_rate_,
-                                                  *parameters_[parameter_indices].state...);
-
-            // TODO this copy is required as the sundials solvers do not allow move assignments because of their memory
-            // tracking strategy
-            // See https://github.com/mfem/mfem/issues/3531
-            r = res;
-            r.SetSubVector(bcs_.allEssentialTrueDofs(), 0.0);
-          },
-
-          [this](const mfem::Vector& u) -> mfem::Operator& {
-            auto [r, drdu] = (*residual_)(time_, shape_displacement_, differentiate_wrt(u), temperature_rate_,
-                                          *parameters_[parameter_indices].state...);
-            J_             = assemble(drdu);
-            J_e_           = bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
-            return *J_;
-          });
+      residual_with_bcs_ = std::move(*buildQuasistaticOperator());
     } else {
       residual_with_bcs_ = mfem_ext::StdFunctionOperator(
           temperature_.space().TrueVSize(),
@@ -745,6 +783,19 @@ public:
           [this](const mfem::Vector& du_dt) -> mfem::Operator& {
             add(1.0, u_, dt_, du_dt, u_predicted_);
 
+            if (nonlin_solver_->matrixFree()) {
+              auto [r_K, K] = (*residual_)(time_, shape_displacement_, differentiate_wrt(u_predicted_), du_dt,
+                                           *parameters_[parameter_indices].state...);
+              auto [r_M, M] = (*residual_)(time_, shape_displacement_, u_predicted_, differentiate_wrt(du_dt),
+                                           *parameters_[parameter_indices].state...);
+
+              // J := M + dt K, applied without assembling either matrix
+              auto J         = std::make_unique<mfem_ext::LinearCombinationOperator>(1.0, M, dt_, K);
+              J_matrix_free_ = std::make_unique<mfem::ConstrainedOperator>(J.release(), bcs_.allEssentialTrueDofs(),
+                                                                           /* own_A = */ true);
+              return *J_matrix_free_;
+            }
+
             // K := dR/du
             auto K = serac::get<DERIVATIVE>((*residual_)(time_, shape_displacement_, differentiate_wrt(u_predicted_),
                                                          du_dt, *parameters_[parameter_indices].state...));
@@ -767,11 +818,7 @@ public:
     if (checkpoint_to_disk_) {
       outputStateToDisk();
     } else {
-      checkpoint_states_.clear();
-      auto state_names = stateNames();
-      for (const auto& state_name : state_names) {
-        checkpoint_states_[state_name].push_back(state(state_name));
-      }
+      restartCheckpoints();
     }
   }
 
@@ -978,6 +1025,10 @@ public:
   virtual ~HeatTransfer() = default;
 
 protected:
+  /// The coupled thermomechanics module registers this module's temperature as its own primal states
+  template <int, int, typename...>
+  friend class Thermomechanics;
+
   /// The compile-time finite element trial space for heat transfer (H1 of order p)
   using scalar_trial = H1<order>;
 
@@ -1037,6 +1088,9 @@ protected:
   /// because are associated with essential boundary conditions
   std::unique_ptr<mfem::HypreParMatrix> J_e_;
 
+  /// matrix-free Jacobian (with essential boundary conditions applied), used when the linear solver is matrix-free
+  std::unique_ptr<mfem::ConstrainedOperator> J_matrix_free_;
+
   /// The current timestep
   double dt_;
 
@@ -208,6 +208,16 @@ public:
       is_quasistatic_ = true;
     }
 
+    // central differences are integrated explicitly with a lumped mass, without the nonlinear solver
+    explicit_dynamics_ = timestepping_opts.timestepper == TimestepMethod::CentralDifference;
+
+    if (timestepping_opts.adaptive) {
+      SLIC_ERROR_ROOT_IF(is_quasistatic_, "Adaptive timestepping requires a dynamic timestepper in SolidMechanics");
+      SLIC_ERROR_ROOT_IF(explicit_dynamics_, "Adaptive timestepping is not supported for explicit dynamics, use "
+                                             "stableTimestep() to choose the timestep instead");
+      timestep_controller_.emplace(*timestepping_opts.adaptive, 2);
+    }
+
     states_.push_back(&displacement_);
     if (!is_quasistatic_) {
       states_.push_back(&velocity_);
@@ -392,14 +402,13 @@ public:
     du_                     = 0.0;
     predicted_displacement_ = 0.0;
 
+    // the lumped mass is recomputed at the start of the next explicit run, in case the density or mesh has changed
+    lumped_mass_.Destroy();
+
     if (checkpoint_to_disk_) {
       outputStateToDisk();
     } else {
-      checkpoint_states_.clear();
-      auto state_names = stateNames();
-      for (const auto& state_name : state_names) {
-        checkpoint_states_[state_name].push_back(state(state_name));
-      }
+      restartCheckpoints();
     }
   }
 
@@ -665,13 +674,13 @@ public:
     if (state_name == "displacement") {
       displacement_ = state;
       if (!checkpoint_to_disk_) {
-        checkpoint_states_["displacement"][static_cast<size_t>(cycle_)] = displacement_;
+        updateCheckpointedState("displacement");
       }
       return;
     } else if (state_name == "velocity") {
       velocity_ = state;
       if (!checkpoint_to_disk_) {
-        checkpoint_states_["velocity"][static_cast<size_t>(cycle_)] = velocity_;
+        updateCheckpointedState("velocity");
       }
       return;
     }
@@ -719,7 +728,7 @@ public:
     Domain domain = (optional_domain) ? *optional_domain : EntireBoundary(mesh_);
 
     residual_->AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
-                                   qfunction, domain);
+                                   CombinedDerivative<0, 1>{}, qfunction, domain);
   }
 
   /// @overload
@@ -797,8 +806,8 @@ public:
   void addCustomDomainIntegral(DependsOn<active_parameters...>, callable qfunction,
                                qdata_type<StateType> qdata = NoQData)
   {
-    residual_->AddDomainIntegral(Dimension<dim>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{}, qfunction,
-                                 mesh_, qdata);
+    residual_->AddDomainIntegral(Dimension<dim>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
+                                 CombinedDerivative<0, 1>{}, qfunction, mesh_, qdata);
   }
 
   /**
@@ -890,7 +899,23 @@ public:
                                                              // fact that the displacement, acceleration, and shape
                                                              // fields are always-on and come first, so the `n`th
                                                              // parameter will actually be argument `n + NUM_STATE_VARS`
-        std::move(material_functor), mesh_, qdata);
+        CombinedDerivative<0, 1>{}, std::move(material_functor), mesh_, qdata);
+  }
+
+  /**
+   * @overload
+   * @note A material marked with serac::vectorize() is evaluated at several quadrature points at once. It must not have
+   * internal variables, and its operator() must not branch on the displacement gradient or parameters.
+   */
+  template <int... active_parameters, int W, typename MaterialType, typename StateType = Empty>
+  void setMaterial(DependsOn<active_parameters...>, const Vectorized<W, MaterialType>& material,
+                   qdata_type<StateType> qdata = EmptyQData)
+  {
+    static_assert(std::is_same_v<StateType, Empty> && std::is_same_v<typename MaterialType::State, Empty>,
+                  "only materials without internal variables can be vectorized");
+    MaterialStressFunctor<MaterialType> material_functor(material.qf, geom_nonlin_);
+    residual_->AddDomainIntegral(Dimension<dim>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
+                                 CombinedDerivative<0, 1>{}, vectorize<W>(std::move(material_functor)), mesh_, qdata);
   }
 
   /// @overload
@@ -987,7 +1012,7 @@ public:
   {
     Domain domain = (optional_domain) ? *optional_domain : EntireDomain(mesh_);
     residual_->AddDomainIntegral(Dimension<dim>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
-                                 BodyForceIntegrand<BodyForceType>(body_force), domain);
+                                 CombinedDerivative<0, 1>{}, BodyForceIntegrand<BodyForceType>(body_force), domain);
   }
 
   /// @overload
@@ -1027,7 +1052,7 @@ public:
     Domain domain = (optional_domain) ? *optional_domain : EntireBoundary(mesh_);
 
     residual_->AddBoundaryIntegral(
-        Dimension<dim - 1>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
+        Dimension<dim - 1>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{}, CombinedDerivative<0, 1>{},
         [traction_function](double t, auto X, auto /* displacement */, auto /* acceleration */, auto... params) {
           auto n = cross(get<DERIVATIVE>(X));
 
@@ -1072,7 +1097,7 @@ public:
     Domain domain = (optional_domain) ? *optional_domain : EntireBoundary(mesh_);
 
     residual_->AddBoundaryIntegral(
-        Dimension<dim - 1>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
+        Dimension<dim - 1>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{}, CombinedDerivative<0, 1>{},
         [pressure_function, geom_nonlin = geom_nonlin_](double t, auto X, auto displacement, auto /* acceleration */,
                                                         auto... params) {
           // Calculate the position and normal in the shape perturbed deformed configuration
@@ -1134,8 +1159,14 @@ public:
           SERAC_MARK_FUNCTION;
           auto [r, drdu] = (*residual_)(time_, shape_displacement_, differentiate_wrt(u), acceleration_,
                                         *parameters_[parameter_indices].state...);
-          J_             = assemble(drdu);
-          J_e_           = bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
+
+          if (nonlin_solver_->matrixFree()) {
+            J_matrix_free_ = std::make_unique<mfem::ConstrainedOperator>(&drdu, bcs_.allEssentialTrueDofs());
+            return *J_matrix_free_;
+          }
+
+          J_   = assemble(drdu);
+          J_e_ = bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
           return *J_;
         });
   }
@@ -1148,16 +1179,76 @@ public:
    * 1 on the diagonal and K_e contains the zeroed rows and columns, e.g. K_total = K + K_e.
    *
    * @warning This interface is not stable and may change in the future.
+   * @note The stiffness matrix is never assembled when the linear solver is matrix-free
    *
    * @return A pair of the eliminated stiffness matrix and a matrix containing the eliminated rows and cols
    */
   std::pair<const mfem::HypreParMatrix&, const mfem::HypreParMatrix&> stiffnessMatrix() const
   {
+    SLIC_ERROR_ROOT_IF(nonlin_solver_->matrixFree(),
+                       "The stiffness matrix is not assembled when the linear solver is matrix-free "
+                       "(LinearSolverOptions::matrix_free).");
     SLIC_ERROR_ROOT_IF(!J_ || !J_e_, "Stiffness matrix has not yet been assembled.");
 
     return {*J_, *J_e_};
   }
 
+  /**
+   * @brief Estimate the largest stable timestep of explicit central difference dynamics
+   *
+   * Central differences are stable for \f$\Delta t \leq 2 / \omega_{max}\f$, where \f$\omega_{max}^2\f$ is the
+   * largest eigenvalue of \f$M_L^{-1} K\f$, with the lumped mass \f$M_L\f$ and the tangent stiffness \f$K\f$ at the
+   * current displacement. The eigenvalue is estimated by power iteration, which approaches it from below, so the
+   * estimate is scaled by a safety factor. Since the stiffness depends on the deformation for nonlinear materials and
+   * geometry, the estimate should be updated periodically during a simulation.
+   *
+   * @param safety_factor The fraction of the estimated critical timestep to return
+   * @param iterations The number of power iterations
+   * @return The estimated stable timestep
+   *
+   * @pre completeSetup() must be called prior to this method
+   */
+  double stableTimestep(double safety_factor = 0.9, int iterations = 30)
+  {
+    SERAC_MARK_FUNCTION;
+    SLIC_ERROR_ROOT_IF(!residual_, "completeSetup() must be called prior to stableTimestep() in SolidMechanics.");
+
+    if (lumped_mass_.Size() == 0) {
+      computeLumpedMass();
+    }
+
+    auto [_, K] = (*residual_)(time_, shape_displacement_, differentiate_wrt(displacement_), acceleration_,
+                               *parameters_[parameter_indices].state...);
+
+    MPI_Comm      comm             = displacement_.space().GetComm();
+    const auto&   constrained_dofs = bcs_.allEssentialTrueDofs();
+    constexpr int seed             = 1;
+    double        eigenvalue       = 0.0;
+
+    mfem::Vector x(lumped_mass_.Size()), Kx(lumped_mass_.Size()), Mx(lumped_mass_.Size());
+
+    // power iteration on M_L^{-1} K in the inner product weighted by the lumped mass
+    x.Randomize(seed);
+    for (int i = 0; i <= iterations; i++) {
+      x.SetSubVector(constrained_dofs, 0.0);
+      Mx = x;
+      Mx *= lumped_mass_;
+      x /= std::sqrt(mfem::InnerProduct(comm, x, Mx));
+
+      K.Mult(x, Kx);
+      Kx.SetSubVector(constrained_dofs, 0.0);
+      eigenvalue = mfem::InnerProduct(comm, x, Kx);
+
+      x = Kx;
+      x /= lumped_mass_;
+    }
+
+    SLIC_ERROR_ROOT_IF(eigenvalue <= 0.0, "The tangent stiffness is not positive definite, so explicit central "
+                                          "differences have no stable timestep");
+
+    return safety_factor * 2.0 / std::sqrt(eigenvalue);
+  }
+
   /// @overload
   void completeSetup() override
   {
@@ -1188,20 +1279,16 @@ public:
           [this](const mfem::Vector& d2u_dt2) -> mfem::Operator& {
             add(1.0, u_, c0_, d2u_dt2, predicted_displacement_);
 
-            // K := dR/du
-            auto                                  K = serac::get<DERIVATIVE>((*residual_)(time_, shape_displacement_,
-                                                         differentiate_wrt(predicted_displacement_), d2u_dt2,
-                                                         *parameters_[parameter_indices].state...));
-            std::unique_ptr<mfem::HypreParMatrix> k_mat(assemble(K));
+            // J = M + c0 * K, where K := dR/du and M := dR/da are evaluated together in a single sweep
+            auto [r, J] = (*residual_)(time_, shape_displacement_, differentiate_wrt(predicted_displacement_, c0_),
+                                       differentiate_wrt(d2u_dt2, 1.0), *parameters_[parameter_indices].state...);
 
-            // M := dR/da
-            auto M = serac::get<DERIVATIVE>((*residual_)(time_, shape_displacement_, predicted_displacement_,
-                                                         differentiate_wrt(d2u_dt2),
-                                                         *parameters_[parameter_indices].state...));
-            std::unique_ptr<mfem::HypreParMatrix> m_mat(assemble(M));
+            if (nonlin_solver_->matrixFree()) {
+              J_matrix_free_ = std::make_unique<mfem::ConstrainedOperator>(&J, bcs_.allEssentialTrueDofs());
+              return *J_matrix_free_;
+            }
 
-            // J = M + c0 * K
-            J_.reset(mfem::Add(1.0, *m_mat, c0_, *k_mat));
+            J_   = assemble(J);
             J_e_ = bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
 
             return *J_;
@@ -1223,11 +1310,7 @@ public:
     if (checkpoint_to_disk_) {
       outputStateToDisk();
     } else {
-      checkpoint_states_.clear();
-      auto state_names = stateNames();
-      for (const auto& state_name : state_names) {
-        checkpoint_states_[state_name].push_back(state(state_name));
-      }
+      restartCheckpoints();
     }
   }
 
@@ -1244,6 +1327,8 @@ public:
   {
     SERAC_MARK_FUNCTION;
     SLIC_ERROR_ROOT_IF(!residual_, "completeSetup() must be called prior to advanceTimestep(dt) in SolidMechanics.");
+    SLIC_ERROR_ROOT_IF(explicit_dynamics_ && inTrialTimestep(),
+                       "Trial timesteps are not supported with explicit dynamics in SolidMechanics.");
 
     // If this is the first call, initialize the previous parameter values as the initial values
     if (cycle_ == 0) {
@@ -1254,6 +1339,8 @@ public:
 
     if (is_quasistatic_) {
       quasiStaticSolve(dt);
+    } else if (explicit_dynamics_) {
+      explicitStep(dt);
     } else {
       // The current ode interface tracks 2 times, one internally which we have a handle to via time_,
       // and one here via the step interface.
@@ -1262,29 +1349,28 @@ public:
       // but at the moment, the double times creates a lot of confusion, so
       // we short circuit the extra time here by passing a dummy time and ignoring it.
       double time_tmp = time_;
-      ode2_.Step(displacement_, velocity_, time_tmp, dt);
+      if (timestep_controller_ && !recomputing_checkpoints_) {
+        // dt becomes the accepted timestep, which is recorded for the adjoint and checkpoint recomputation
+        ode2_.AdaptiveStep(displacement_, velocity_, time_tmp, dt, *timestep_controller_);
+      } else {
+        ode2_.Step(displacement_, velocity_, time_tmp, dt);
+      }
     }
 
     cycle_ += 1;
 
+    // trial timesteps are checkpointed, and update the material state, once they are accepted
     if (checkpoint_to_disk_) {
-      outputStateToDisk();
-    } else {
-      for (const auto& state_name : stateNames()) {
-        checkpoint_states_[state_name].push_back(state(state_name));
+      if (!inTrialTimestep()) {
+        outputStateToDisk();
       }
+    } else {
+      checkpointStates();
     }
 
-    {
-      // after finding displacements that satisfy equilibrium,
-      // compute the residual one more time, this time enabling
-      // the material state buffers to be updated
-      residual_->updateQdata(true);
-
-      reactions_ = (*residual_)(time_, shape_displacement_, displacement_, acceleration_,
-                                *parameters_[parameter_indices].state...);
-
-      residual_->updateQdata(false);
+    // explicitStep() already updated the material state and reactions with its only residual evaluation
+    if (!explicit_dynamics_ && !inTrialTimestep()) {
+      updateMaterialState();
     }
 
     if (cycle_ > max_cycle_) {
@@ -1294,6 +1380,34 @@ public:
     }
   }
 
+  /// @overload
+  void acceptTrialTimestep() override
+  {
+    BasePhysics::acceptTrialTimestep();
+    if (!explicit_dynamics_) {
+      updateMaterialState();
+    }
+  }
+
+  /**
+   * @brief Assemble the derivative of the residual with respect to a parameter field at the current displacement
+   *
+   * @param parameter_field The index of the parameter to take a derivative with respect to
+   * @return The assembled derivative, with the rows of the essential displacement degrees of freedom set to zero
+   */
+  std::unique_ptr<mfem::HypreParMatrix> parameterJacobian(size_t parameter_field)
+  {
+    SLIC_ERROR_ROOT_IF(
+        parameter_field >= sizeof...(parameter_indices),
+        axom::fmt::format("Parameter '{}' requested when only '{}' parameters exist in physics module '{}'",
+                          parameter_field, sizeof...(parameter_indices), name_));
+
+    auto drdparam     = serac::get<DERIVATIVE>(d_residual_d_[parameter_field](time_));
+    auto drdparam_mat = assemble(drdparam);
+    drdparam_mat->EliminateRows(bcs_.allEssentialTrueDofs());
+    return drdparam_mat;
+  }
+
   /**
    * @brief Set the loads for the adjoint reverse timestep solve
    *
@@ -1340,6 +1454,9 @@ public:
   /// @overload
   void reverseAdjointTimestep() override
   {
+    SLIC_ERROR_ROOT_IF(explicit_dynamics_,
+                       "Adjoint timesteps are not supported with explicit dynamics in SolidMechanics.");
+
     auto& lin_solver = nonlin_solver_->linearSolver();
 
     // By default, use a homogeneous essential boundary condition
@@ -1504,6 +1621,10 @@ public:
   };
 
 protected:
+  /// The coupled thermomechanics module registers this module's displacement and velocity as its own primal states
+  template <int, int, typename...>
+  friend class Thermomechanics;
+
   /// The compile-time finite element trial space for displacement and velocity (H1 of order p)
   using trial = H1<order, dim>;
 
@@ -1571,6 +1692,9 @@ protected:
   /// because are associated with essential boundary conditions
   std::unique_ptr<mfem::HypreParMatrix> J_e_;
 
+  /// matrix-free Jacobian (with essential boundary conditions applied), used when the linear solver is matrix-free
+  std::unique_ptr<mfem::ConstrainedOperator> J_matrix_free_;
+
   /// an intermediate variable used to store the predicted end-step displacement
   mfem::Vector predicted_displacement_;
 
@@ -1599,6 +1723,12 @@ protected:
   /// @brief A flag denoting whether to compute the warm start for improved robustness
   bool use_warm_start_;
 
+  /// @brief Whether dynamics are integrated with explicit central differences, see explicitStep()
+  bool explicit_dynamics_ = false;
+
+  /// @brief The row-summed mass matrix used by explicit dynamics, which is empty until the first explicit step
+  mfem::Vector lumped_mass_;
+
   /// @brief Coefficient containing the essential boundary values
   std::shared_ptr<mfem::VectorCoefficient> disp_bdr_coef_;
 
@@ -1616,6 +1746,29 @@ protected:
                             displacement_, acceleration_, *parameters_[parameter_indices].state...);
       }...};
 
+  /// @overload
+  void restartTimeIntegration() override
+  {
+    if (!is_quasistatic_) {
+      // the acceleration is only an equilibrium solution once the first timestep has computed it
+      ode2_.Restart(cycle_ > min_cycle_);
+    }
+  }
+
+  /**
+   * @brief Compute the residual one more time at the equilibrium displacements, this time enabling the material state
+   * buffers to be updated, and keep it as the reaction forces
+   */
+  void updateMaterialState()
+  {
+    residual_->updateQdata(true);
+
+    reactions_ = (*residual_)(time_, shape_displacement_, displacement_, acceleration_,
+                              *parameters_[parameter_indices].state...);
+
+    residual_->updateQdata(false);
+  }
+
   /// @brief Solve the Quasi-static Newton system
   virtual void quasiStaticSolve(double dt)
   {
@@ -1768,6 +1921,113 @@ protected:
 
     displacement_ += du_;
   }
+
+  /**
+   * @brief Compute the lumped mass by summing the rows of the consistent mass matrix
+   *
+   * The row sums are computed by applying the mass matrix, i.e. the derivative of the residual with respect to the
+   * acceleration, to a vector of ones, which gives the row sums of every displacement component at once.
+   *
+   * @note Row summing gives nonpositive masses for some higher order elements, e.g. quadratic triangles and tetrahedra
+   */
+  void computeLumpedMass()
+  {
+    SERAC_MARK_FUNCTION;
+
+    auto [_, M] = (*residual_)(time_, shape_displacement_, displacement_, differentiate_wrt(acceleration_),
+                               *parameters_[parameter_indices].state...);
+
+    mfem::Vector ones(displacement_.space().TrueVSize());
+    ones = 1.0;
+    lumped_mass_.SetSize(ones.Size());
+    M.Mult(ones, lumped_mass_);
+
+    // the constrained degrees of freedom are prescribed, so their mass is never used
+    lumped_mass_.SetSubVector(bcs_.allEssentialTrueDofs(), 1.0);
+
+    double min_mass = lumped_mass_.Size() > 0 ? lumped_mass_.Min() : 1.0;
+    MPI_Allreduce(MPI_IN_PLACE, &min_mass, 1, MPI_DOUBLE, MPI_MIN, displacement_.space().GetComm());
+    SLIC_ERROR_ROOT_IF(min_mass <= 0.0,
+                       axom::fmt::format("The lumped mass has a nonpositive entry ({}), which explicit dynamics "
+                                         "cannot integrate. Use linear or tensor product elements.",
+                                         min_mass));
+  }
+
+  /**
+   * @brief Compute the acceleration \f$a = -M_L^{-1} r(u, 0)\f$ of the current displacement
+   *
+   * Since the residual is linear in the acceleration, its value at zero acceleration is the net internal and external
+   * force. The reactions are the residual of the lumped system, which vanishes away from the essential boundary.
+   */
+  void computeExplicitAcceleration()
+  {
+    acceleration_ = 0.0;
+    reactions_    = (*residual_)(time_, shape_displacement_, displacement_, acceleration_,
+                                 *parameters_[parameter_indices].state...);
+
+    auto& constrained_dofs = bcs_.allEssentialTrueDofs();
+
+    acceleration_.Set(-1.0, reactions_);
+    acceleration_ /= lumped_mass_;
+    acceleration_.SetSubVector(constrained_dofs, 0.0);
+
+    mfem::Vector constrained_reactions;
+    reactions_.GetSubVector(constrained_dofs, constrained_reactions);
+    reactions_ = 0.0;
+    reactions_.SetSubVector(constrained_dofs, constrained_reactions);
+  }
+
+  /**
+   * @brief Take a step of the explicit central difference method in its velocity Verlet form
+   *
+   * \f[
+   *   v_{n+1/2} = v_n + \frac{\Delta t}{2} a_n, \quad u_{n+1} = u_n + \Delta t \, v_{n+1/2}, \quad
+   *   a_{n+1} = -M_L^{-1} r(u_{n+1}, 0), \quad v_{n+1} = v_{n+1/2} + \frac{\Delta t}{2} a_{n+1}
+   * \f]
+   *
+   * Each step costs one residual evaluation and a diagonal scaling. The essential boundary conditions prescribe the
+   * displacement at the end of the step, and the velocity of the constrained dofs is the change of their displacement
+   * over the step, divided by the timestep.
+   * The method is only stable for timesteps below the critical one, see stableTimestep().
+   *
+   * @param dt The timestep
+   */
+  void explicitStep(double dt)
+  {
+    SERAC_MARK_FUNCTION;
+
+    if (lumped_mass_.Size() == 0) {
+      computeLumpedMass();
+    }
+
+    // the acceleration of the initial conditions
+    if (cycle_ == min_cycle_) {
+      computeExplicitAcceleration();
+    }
+
+    // the displacement at the start of the step, whose constrained values give the velocity of the constrained dofs
+    u_ = displacement_;
+
+    velocity_.Add(0.5 * dt, acceleration_);
+    displacement_.Add(dt, velocity_);
+    time_ += dt;
+
+    for (const auto& bc : bcs_.essentials()) {
+      bc.setDofs(displacement_, time_);
+    }
+
+    residual_->updateQdata(true);
+    computeExplicitAcceleration();
+    residual_->updateQdata(false);
+
+    velocity_.Add(0.5 * dt, acceleration_);
+
+    auto& constrained_dofs = bcs_.allEssentialTrueDofs();
+    for (int i = 0; i < constrained_dofs.Size(); i++) {
+      int j        = constrained_dofs[i];
+      velocity_[j] = (displacement_[j] - u_[j]) / dt;
+    }
+  }
 };
 
 }  // namespace serac
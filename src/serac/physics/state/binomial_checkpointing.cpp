@@ -0,0 +1,102 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/state/binomial_checkpointing.hpp"
+
+#include <algorithm>
+
+#include "axom/fmt.hpp"
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+namespace {
+
+/// @brief (n choose k), in floating point since only comparisons against step counts are needed
+double binomial(int n, int k)
+{
+  double value = 1.0;
+  for (int i = 1; i <= k; i++) {
+    value = value * (n - k + i) / i;
+  }
+  return value;
+}
+
+}  // namespace
+
+BinomialCheckpointing::BinomialCheckpointing(int max_snapshots) : max_snapshots_(max_snapshots)
+{
+  SLIC_ERROR_ROOT_IF(max_snapshots_ < 2,
+                     axom::fmt::format("Binomial checkpointing requires at least 2 snapshots, {} given.", max_snapshots));
+}
+
+void BinomialCheckpointing::recordForwardStep(int cycle, Snapshot snapshot)
+{
+  // the total number of timesteps is not known yet, so the remaining snapshots
+  // are only placed once the reverse sweep starts recomputing states
+  if (snapshots_.size() > 1) {
+    snapshots_.erase(std::prev(snapshots_.end()));
+  }
+  snapshots_.insert_or_assign(cycle, std::move(snapshot));
+}
+
+BinomialCheckpointing::Snapshot* BinomialCheckpointing::find(int cycle)
+{
+  auto it = snapshots_.find(cycle);
+  return (it != snapshots_.end()) ? &it->second : nullptr;
+}
+
+std::pair<int, const BinomialCheckpointing::Snapshot&> BinomialCheckpointing::previous(int cycle) const
+{
+  auto it = snapshots_.lower_bound(cycle);
+  SLIC_ERROR_ROOT_IF(it == snapshots_.begin(),
+                     axom::fmt::format("No checkpointed states available to recompute cycle {}.", cycle));
+  --it;
+  return {it->first, it->second};
+}
+
+int BinomialCheckpointing::numSnapshotsUpTo(int cycle) const
+{
+  return static_cast<int>(std::distance(snapshots_.begin(), snapshots_.upper_bound(cycle)));
+}
+
+int BinomialCheckpointing::stepsToNextSnapshot(int cycle, int target_cycle) const
+{
+  int steps          = target_cycle - cycle;
+  int free_snapshots = max_snapshots_ - numSnapshotsUpTo(target_cycle);
+
+  if (steps <= 1 || free_snapshots <= 0) {
+    return steps;
+  }
+
+  // find the smallest number of repetitions t for which the remaining steps can be reversed
+  // with the snapshot we are starting from plus the free ones, i.e. beta(s, t) = (s + t choose s) >= steps
+  int s = free_snapshots + 1;
+  int t = 0;
+  while (binomial(s + t, t) < steps) {
+    t++;
+  }
+
+  // then advance just far enough that the steps after the new snapshot
+  // can still be reversed with one snapshot fewer and t repetitions
+  double steps_after_snapshot = std::min(binomial(s - 1 + t, t), static_cast<double>(steps));
+  return std::max(1, steps - static_cast<int>(steps_after_snapshot));
+}
+
+void BinomialCheckpointing::store(int cycle, Snapshot snapshot, int target_cycle)
+{
+  if (numSnapshots() >= max_snapshots_) {
+    auto latest = std::prev(snapshots_.end());
+    if (latest->first <= target_cycle) {
+      return;
+    }
+    snapshots_.erase(latest);
+  }
+  snapshots_.insert_or_assign(cycle, std::move(snapshot));
+}
+
+}  // namespace serac
@@ -0,0 +1,122 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file binomial_checkpointing.hpp
+ *
+ * @brief A fixed-size store of primal state snapshots for reversing transient simulations
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#include "serac/physics/state/finite_element_state.hpp"
+
+namespace serac {
+
+/**
+ * @brief A checkpointing policy for transient adjoint solves that keeps at most a fixed number of
+ * primal state snapshots in memory
+ *
+ * States at cycles without a snapshot are recomputed by restarting the forward solve from the closest
+ * earlier snapshot. While recomputing, new snapshots are placed according to the binomial schedule of
+ * Griewank and Walther ("Revolve"): with \f$s\f$ snapshots, \f$n\f$ timesteps can be reversed while
+ * advancing every timestep at most \f$t\f$ times, where \f$t\f$ is the smallest integer with
+ * \f$\binom{s + t}{s} \geq n\f$.
+ *
+ * During the forward sweep, only the initial states and the states of the most recent cycle are kept,
+ * since the total number of timesteps is not known in advance.
+ */
+class BinomialCheckpointing {
+public:
+  /// @brief The primal states of a physics module at a checkpointed cycle
+  struct Snapshot {
+    /// @brief The simulation time at the checkpointed cycle
+    double time;
+
+    /// @brief The primal states, by name
+    std::unordered_map<std::string, FiniteElementState> states;
+  };
+
+  /**
+   * @brief Construct a new binomial checkpointing policy
+   *
+   * @param max_snapshots The maximum number of snapshots kept in memory, which must be at least 2
+   */
+  explicit BinomialCheckpointing(int max_snapshots);
+
+  /// @brief The maximum number of snapshots kept in memory
+  int maxSnapshots() const { return max_snapshots_; }
+
+  /// @brief The number of snapshots currently kept in memory
+  int numSnapshots() const { return static_cast<int>(snapshots_.size()); }
+
+  /// @brief Discard all snapshots
+  void clear() { snapshots_.clear(); }
+
+  /**
+   * @brief Record the states at the end of a forward timestep
+   *
+   * @param cycle The cycle of the states
+   * @param snapshot The time and primal states at that cycle
+   *
+   * @note Only the first recorded snapshot and the most recent one are kept
+   */
+  void recordForwardStep(int cycle, Snapshot snapshot);
+
+  /**
+   * @brief Get the snapshot at the given cycle, if there is one
+   *
+   * @param cycle The requested cycle
+   * @return A pointer to the snapshot, or nullptr if the cycle is not checkpointed
+   */
+  Snapshot* find(int cycle);
+
+  /**
+   * @brief Get the latest snapshot before the given cycle, which is where recomputing its states starts from
+   *
+   * @param cycle The requested cycle
+   * @return The cycle of the snapshot and a reference to it
+   */
+  std::pair<int, const Snapshot&> previous(int cycle) const;
+
+  /**
+   * @brief Get the number of timesteps to advance before storing the next snapshot, when recomputing
+   * the states of a target cycle
+   *
+   * @param cycle The cycle that the recomputation has reached
+   * @param target_cycle The cycle whose states are being recomputed
+   * @return The number of timesteps to advance, which reaches the target cycle when no snapshot should be stored
+   */
+  int stepsToNextSnapshot(int cycle, int target_cycle) const;
+
+  /**
+   * @brief Store a snapshot taken while recomputing the states of a target cycle
+   *
+   * @param cycle The cycle of the states
+   * @param snapshot The time and primal states at that cycle
+   * @param target_cycle The cycle whose states are being recomputed
+   *
+   * @note When all snapshots are in use, the latest snapshot after the target cycle is discarded to make room, since
+   * the reverse sweep will not need it again
+   */
+  void store(int cycle, Snapshot snapshot, int target_cycle);
+
+private:
+  /// @brief The number of snapshots that are at or before the given cycle
+  int numSnapshotsUpTo(int cycle) const;
+
+  /// @brief The maximum number of snapshots kept in memory
+  int max_snapshots_;
+
+  /// @brief The snapshots, by cycle
+  std::map<int, Snapshot> snapshots_;
+};
+
+}  // namespace serac
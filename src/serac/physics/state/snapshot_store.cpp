@@ -0,0 +1,188 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/state/snapshot_store.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#include "axom/core.hpp"
+#include "axom/fmt.hpp"
+
+#include "serac/infrastructure/initialize.hpp"
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+SnapshotStore::SnapshotStore(const std::string& path_prefix, MPI_Comm comm, bool prefetch) : prefetch_(prefetch)
+{
+  int rank   = getMPIInfo(comm).second;
+  file_name_ = axom::fmt::format("{}.{}.dat", path_prefix, rank);
+
+  std::string directory = axom::utilities::filesystem::getDirName(file_name_);
+  if (!directory.empty()) {
+    axom::utilities::filesystem::makeDirsForPath(directory);
+  }
+
+  file_descriptor_ = ::open(file_name_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  SLIC_ERROR_IF(file_descriptor_ < 0,
+                axom::fmt::format("Could not open snapshot file '{}': {}", file_name_, std::strerror(errno)));
+}
+
+SnapshotStore::SnapshotStore(SnapshotStore&& other) noexcept
+    : file_name_(std::move(other.file_name_)),
+      file_descriptor_(std::exchange(other.file_descriptor_, -1)),
+      file_size_(std::exchange(other.file_size_, 0)),
+      mapping_(std::exchange(other.mapping_, nullptr)),
+      mapping_size_(std::exchange(other.mapping_size_, 0)),
+      prefetch_(other.prefetch_),
+      index_(std::move(other.index_))
+{
+}
+
+SnapshotStore& SnapshotStore::operator=(SnapshotStore&& other) noexcept
+{
+  if (this != &other) {
+    unmap();
+    if (file_descriptor_ >= 0) {
+      ::close(file_descriptor_);
+    }
+
+    file_name_       = std::move(other.file_name_);
+    file_descriptor_ = std::exchange(other.file_descriptor_, -1);
+    file_size_       = std::exchange(other.file_size_, 0);
+    mapping_         = std::exchange(other.mapping_, nullptr);
+    mapping_size_    = std::exchange(other.mapping_size_, 0);
+    prefetch_        = other.prefetch_;
+    index_           = std::move(other.index_);
+  }
+  return *this;
+}
+
+SnapshotStore::~SnapshotStore()
+{
+  unmap();
+  if (file_descriptor_ >= 0) {
+    ::close(file_descriptor_);
+  }
+}
+
+void SnapshotStore::clear()
+{
+  unmap();
+  index_.clear();
+  file_size_ = 0;
+
+  SLIC_ERROR_IF(::ftruncate(file_descriptor_, 0) != 0,
+                axom::fmt::format("Could not truncate snapshot file '{}': {}", file_name_, std::strerror(errno)));
+}
+
+void SnapshotStore::write(int cycle, const std::vector<const FiniteElementState*>& states)
+{
+  // Snapshots are only ever appended, so that the memory mapping of the earlier ones stays valid.
+  // Replacing a cycle leaves its previous snapshot in the file, which is reclaimed by clear().
+  Record new_record{file_size_, 0, {}};
+
+  for (auto state : states) {
+    const char* data  = reinterpret_cast<const char*>(state->HostRead());
+    std::size_t bytes = static_cast<std::size_t>(state->Size()) * sizeof(double);
+
+    new_record.fields[state->name()] = {file_size_, static_cast<std::size_t>(state->Size())};
+
+    while (bytes > 0) {
+      auto written = ::pwrite(file_descriptor_, data, bytes, static_cast<off_t>(file_size_));
+      SLIC_ERROR_IF(written < 0, axom::fmt::format("Could not write cycle {} to snapshot file '{}': {}", cycle,
+                                                   file_name_, std::strerror(errno)));
+      data += written;
+      bytes -= static_cast<std::size_t>(written);
+      file_size_ += static_cast<std::size_t>(written);
+    }
+  }
+
+  new_record.bytes = file_size_ - new_record.offset;
+  index_.insert_or_assign(cycle, std::move(new_record));
+}
+
+void SnapshotStore::read(int cycle, const std::vector<FiniteElementState*>& states)
+{
+  const auto& cycle_record = record(cycle);
+  map(cycle_record.offset + cycle_record.bytes);
+
+  for (auto state : states) {
+    auto field = cycle_record.fields.find(state->name());
+    SLIC_ERROR_IF(field == cycle_record.fields.end(),
+                  axom::fmt::format("State '{}' is not in the snapshot of cycle {}", state->name(), cycle));
+    SLIC_ERROR_IF(field->second.size != static_cast<std::size_t>(state->Size()),
+                  axom::fmt::format("State '{}' has {} true degrees of freedom, but its snapshot at cycle {} has {}",
+                                    state->name(), state->Size(), cycle, field->second.size));
+
+    std::memcpy(state->HostWrite(), static_cast<const char*>(mapping_) + field->second.offset,
+                field->second.size * sizeof(double));
+  }
+
+  if (prefetch_) {
+    auto it = index_.lower_bound(cycle);
+    if (it != index_.begin()) {
+      prefetch(std::prev(it)->first);
+    }
+  }
+}
+
+void SnapshotStore::prefetch(int cycle)
+{
+  auto it = index_.find(cycle);
+  if (it == index_.end()) {
+    return;
+  }
+
+  const auto& cycle_record = it->second;
+  map(cycle_record.offset + cycle_record.bytes);
+
+  // posix_madvise requires a page-aligned address
+  auto        page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  std::size_t start     = cycle_record.offset - cycle_record.offset % page_size;
+  ::posix_madvise(static_cast<char*>(mapping_) + start, cycle_record.offset + cycle_record.bytes - start,
+                  POSIX_MADV_WILLNEED);
+}
+
+const SnapshotStore::Record& SnapshotStore::record(int cycle) const
+{
+  auto it = index_.find(cycle);
+  SLIC_ERROR_IF(it == index_.end(),
+                axom::fmt::format("Cycle {} was not written to snapshot file '{}'", cycle, file_name_));
+  return it->second;
+}
+
+void SnapshotStore::map(std::size_t bytes)
+{
+  if (bytes <= mapping_size_) {
+    return;
+  }
+
+  // The file has grown since it was last mapped, so map all of it again
+  unmap();
+  mapping_ = ::mmap(nullptr, file_size_, PROT_READ, MAP_SHARED, file_descriptor_, 0);
+  SLIC_ERROR_IF(mapping_ == MAP_FAILED,
+                axom::fmt::format("Could not map snapshot file '{}': {}", file_name_, std::strerror(errno)));
+  mapping_size_ = file_size_;
+}
+
+void SnapshotStore::unmap()
+{
+  if (mapping_) {
+    ::munmap(mapping_, mapping_size_);
+    mapping_      = nullptr;
+    mapping_size_ = 0;
+  }
+}
+
+}  // namespace serac
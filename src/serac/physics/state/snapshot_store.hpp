@@ -0,0 +1,162 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file snapshot_store.hpp
+ *
+ * @brief A per-rank binary file of primal state snapshots for reversing transient simulations
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mpi.h"
+
+#include "serac/physics/state/finite_element_state.hpp"
+
+namespace serac {
+
+/**
+ * @brief A disk-based checkpointing backend for transient adjoint solves that stores only the true degrees of freedom
+ * of the primal states
+ *
+ * Each MPI rank appends the raw true-dof vectors of every checkpointed cycle to its own file,
+ * `<path_prefix>.<rank>.dat`, and keeps a small in-memory index of where each cycle and state was written. Unlike
+ * the sidre data collections written by StateManager::save(), retrieving a cycle does not re-read any mesh or blueprint
+ * metadata: the file is memory-mapped and the requested vectors are copied out of the mapping directly.
+ *
+ * Since the reverse sweep of an adjoint solve retrieves the cycles in descending order, the store can optionally ask
+ * the operating system to asynchronously read the previous cycle into the page cache after each retrieval, so
+ * the file I/O overlaps with the adjoint solve of the current cycle.
+ */
+class SnapshotStore {
+public:
+  /**
+   * @brief Construct a new snapshot store, discarding any snapshots previously written to the same files
+   *
+   * @param path_prefix The path and file name prefix of the per-rank snapshot files
+   * @param comm The MPI communicator of the states that will be stored
+   * @param prefetch Whether to prefetch the previous cycle after each retrieval
+   */
+  explicit SnapshotStore(const std::string& path_prefix, MPI_Comm comm = MPI_COMM_WORLD, bool prefetch = true);
+
+  /// @brief Snapshot stores own a file and its mapping, so they cannot be copied
+  SnapshotStore(const SnapshotStore&) = delete;
+
+  /// @brief Snapshot stores own a file and its mapping, so they cannot be copied
+  SnapshotStore& operator=(const SnapshotStore&) = delete;
+
+  /// @brief Move construct a snapshot store, taking ownership of the file and its mapping
+  SnapshotStore(SnapshotStore&& other) noexcept;
+
+  /// @brief Move assign a snapshot store, taking ownership of the file and its mapping
+  SnapshotStore& operator=(SnapshotStore&& other) noexcept;
+
+  /// @brief Unmap and close the snapshot file
+  ~SnapshotStore();
+
+  /// @brief The name of the snapshot file of this rank
+  const std::string& fileName() const { return file_name_; }
+
+  /// @brief The number of cycles with a snapshot
+  int numSnapshots() const { return static_cast<int>(index_.size()); }
+
+  /**
+   * @brief Check if there is a snapshot for the given cycle
+   *
+   * @param cycle The requested cycle
+   * @return True if the cycle has been written
+   */
+  bool contains(int cycle) const { return index_.find(cycle) != index_.end(); }
+
+  /// @brief Discard all snapshots and truncate the snapshot file
+  void clear();
+
+  /**
+   * @brief Write the true degrees of freedom of the given states as the snapshot of a cycle
+   *
+   * @param cycle The cycle of the states
+   * @param states The states to write
+   *
+   * @note Writing a cycle that already has a snapshot replaces it
+   */
+  void write(int cycle, const std::vector<const FiniteElementState*>& states);
+
+  /**
+   * @brief Read the true degrees of freedom of a previously written cycle into the given states
+   *
+   * @param cycle The cycle to read
+   * @param states The states to read, which are identified by name
+   *
+   * @note If prefetching is enabled, this also starts reading the snapshot of the previous cycle
+   */
+  void read(int cycle, const std::vector<FiniteElementState*>& states);
+
+  /**
+   * @brief Ask the operating system to start reading the snapshot of a cycle into memory, without waiting for it
+   *
+   * @param cycle The cycle to prefetch, which is ignored if it has not been written
+   */
+  void prefetch(int cycle);
+
+private:
+  /// @brief The location of a state's true degrees of freedom within the snapshot file
+  struct Field {
+    /// @brief The offset of the first true degree of freedom, in bytes
+    std::size_t offset;
+
+    /// @brief The number of true degrees of freedom
+    std::size_t size;
+  };
+
+  /// @brief The location of a cycle's snapshot within the snapshot file
+  struct Record {
+    /// @brief The offset of the snapshot, in bytes
+    std::size_t offset;
+
+    /// @brief The size of the snapshot, in bytes
+    std::size_t bytes;
+
+    /// @brief The location of each state of the snapshot, by name
+    std::map<std::string, Field> fields;
+  };
+
+  /// @brief Get the record of a cycle, which must have been written
+  const Record& record(int cycle) const;
+
+  /// @brief Make sure that the memory mapping covers the first @a bytes bytes of the snapshot file
+  void map(std::size_t bytes);
+
+  /// @brief Remove the memory mapping of the snapshot file
+  void unmap();
+
+  /// @brief The name of the snapshot file of this rank
+  std::string file_name_;
+
+  /// @brief The file descriptor of the snapshot file
+  int file_descriptor_ = -1;
+
+  /// @brief The size of the snapshot file, in bytes
+  std::size_t file_size_ = 0;
+
+  /// @brief The start of the memory mapping of the snapshot file
+  void* mapping_ = nullptr;
+
+  /// @brief The size of the memory mapping of the snapshot file, in bytes
+  std::size_t mapping_size_ = 0;
+
+  /// @brief Whether to prefetch the previous cycle after each retrieval
+  bool prefetch_;
+
+  /// @brief The location of each written snapshot, by cycle
+  std::map<int, Record> index_;
+};
+
+}  // namespace serac
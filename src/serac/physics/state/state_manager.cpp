@@ -25,6 +25,9 @@ double StateManager::newDataCollection(const std::string& name, const std::optio
   SLIC_ERROR_ROOT_IF(!ds_, "Cannot construct a DataCollection without a DataStore");
   std::string coll_name = name + "_datacoll";
 
+  // A background write may be reading the datastore, or writing the cycle to load
+  output::flush();
+
   auto global_grp   = ds_->getRoot()->createGroup(coll_name + "_global");
   auto bp_index_grp = global_grp->createGroup("blueprint_index/" + coll_name);
   auto domain_grp   = ds_->getRoot()->createGroup(coll_name);
@@ -98,6 +101,9 @@ void StateManager::loadCheckpointedStates(int cycle_to_load, std::vector<FiniteE
 
   std::string coll_name = mesh_name + "_datacoll";
 
+  // The requested cycle may still be being written in the background
+  output::flush();
+
   axom::sidre::MFEMSidreDataCollection previous_datacoll(coll_name);
 
   previous_datacoll.SetComm(meshPtr->GetComm());
@@ -219,9 +225,16 @@ void StateManager::save(const double t, const int cycle, const std::string& mesh
   SLIC_INFO_ROOT(
       axom::fmt::format("Saving data collection at time: '{}' and cycle: '{}' to path: '{}'", t, cycle, file_path));
 
+  // The previous write must finish before the datastore it reads from is modified
+  output::flush();
+
   datacoll.SetTime(t);
   datacoll.SetCycle(cycle);
-  datacoll.Save();
+
+  // Collective operations of a background write use their own communicator so that they cannot be matched with those
+  // of the simulation, which continues while the file is written
+  datacoll.SetComm(output::asyncWrites() ? output::asyncWriteComm() : MPI_COMM_WORLD);
+  output::write([&datacoll]() { datacoll.Save(); });
 }
 
 mfem::ParMesh& StateManager::setMesh(std::unique_ptr<mfem::ParMesh> pmesh, const std::string& mesh_tag)
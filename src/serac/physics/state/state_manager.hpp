@@ -19,6 +19,7 @@
 #include "axom/sidre/core/MFEMSidreDataCollection.hpp"
 
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/output.hpp"
 #include "serac/physics/state/finite_element_state.hpp"
 #include "serac/physics/state/finite_element_dual.hpp"
 #include "serac/numerics/functional/quadrature_data.hpp"
@@ -181,7 +182,8 @@ public:
    * @brief Updates the StateManager-owned grid function using the values from a given
    * FiniteElementState.
    *
-   * This sync operation must occur prior to writing a restart file.
+   * This sync operation must occur prior to writing a restart file. If the previous restart file is still being
+   * written in the background, this waits for it to finish first.
    *
    * @param state The state used to update the internal grid function
    */
@@ -190,6 +192,7 @@ public:
     SLIC_ERROR_ROOT_IF(!hasState(state.name()),
                        axom::fmt::format("State manager does not contain state named '{}'", state.name()));
 
+    output::flush();
     state.fillGridFunction(*named_states_[state.name()]);
   }
 
@@ -197,7 +200,8 @@ public:
    * @brief Updates the StateManager-owned grid function using the values from a given
    * FiniteElementDual.
    *
-   * This sync operation must occur prior to writing a restart file.
+   * This sync operation must occur prior to writing a restart file. If the previous restart file is still being
+   * written in the background, this waits for it to finish first.
    *
    * @param dual The dual used to update the internal grid function
    */
@@ -206,6 +210,7 @@ public:
     SLIC_ERROR_ROOT_IF(!hasDual(dual.name()),
                        axom::fmt::format("State manager does not contain dual named '{}'", dual.name()));
 
+    output::flush();
     dual.space().GetRestrictionMatrix()->MultTranspose(dual, *named_duals_[dual.name()]);
   }
 
@@ -214,6 +219,10 @@ public:
    * @param[in] t The current sim time
    * @param[in] cycle The current iteration number of the simulation
    * @param[in] mesh_tag A string that uniquely identifies the mesh (and accompanying fields) to save
+   *
+   * @note If output::asyncWrites() is enabled, the file is written on the background I/O thread and this returns
+   * immediately. The datastore then serves as the staging buffer of the write, so updateState(), updateDual(), and
+   * the next save wait for it to finish before modifying the datastore.
    */
   static void save(const double t, const int cycle, const std::string& mesh_tag);
 
@@ -241,6 +250,7 @@ public:
    */
   static void reset()
   {
+    output::flush();
     named_states_.clear();
     named_duals_.clear();
     shape_displacements_.clear();
@@ -92,6 +92,69 @@ TEST(BeamBending, TwoDimensional)
   solid_solver.outputStateToDisk("paraview_output");
 }
 
+/// solve the 2D beam bending problem, with either an assembled or a matrix-free Jacobian
+mfem::Vector solve_beam_bending(bool matrix_free)
+{
+  constexpr int p   = 2;
+  constexpr int dim = 2;
+
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  std::string name = matrix_free ? "beam_bending_matrix_free" : "beam_bending_assembled";
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, name + "_data");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/beam-quad.mesh";
+
+  std::string mesh_tag{"mesh"};
+  serac::StateManager::setMesh(mesh::refineAndDistribute(buildMeshFromFile(filename), 0, 0), mesh_tag);
+
+  serac::LinearSolverOptions linear_options{
+      .linear_solver  = LinearSolver::GMRES,
+      .preconditioner = matrix_free ? Preconditioner::OperatorJacobi : Preconditioner::HypreJacobi,
+      .relative_tol   = 1.0e-12,
+      .absolute_tol   = 1.0e-14,
+      .max_iterations = 5000,
+      .print_level    = 0,
+      .matrix_free    = matrix_free};
+
+  serac::NonlinearSolverOptions nonlinear_options{.nonlin_solver  = NonlinearSolver::Newton,
+                                                  .relative_tol   = 1.0e-10,
+                                                  .absolute_tol   = 1.0e-12,
+                                                  .max_iterations = 20,
+                                                  .print_level    = 1};
+
+  SolidMechanics<p, dim> solid_solver(nonlinear_options, linear_options, solid_mechanics::default_quasistatic_options,
+                                      GeometricNonlinearities::On, name, mesh_tag);
+
+  solid_mechanics::StVenantKirchhoff mat{1.0, 1.91666666666667, 1.0};
+  solid_solver.setMaterial(mat);
+
+  auto bc = [](const mfem::Vector&, mfem::Vector& bc_vec) -> void { bc_vec = 0.0; };
+  solid_solver.setDisplacementBCs({1}, bc);
+  solid_solver.setDisplacement(bc);
+
+  solid_solver.setTraction([](const auto& x, const auto& n, const double) { return -0.01 * n * (x[1] > 0.99); },
+                           EntireBoundary(StateManager::mesh(mesh_tag)));
+
+  solid_solver.completeSetup();
+  solid_solver.advanceTimestep(1.0);
+
+  return mfem::Vector(solid_solver.displacement());
+}
+
+TEST(BeamBending, MatrixFreeJacobian)
+{
+  mfem::Vector assembled   = solve_beam_bending(false);
+  mfem::Vector matrix_free = solve_beam_bending(true);
+
+  EXPECT_GT(assembled.Norml2(), 0.0);
+
+  matrix_free -= assembled;
+  EXPECT_LT(matrix_free.Norml2(), 1.0e-8 * assembled.Norml2());
+}
+
 }  // namespace serac
 
 int main(int argc, char* argv[])
@@ -6,6 +6,7 @@
 #include <functional>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "serac/physics/solid_mechanics.hpp"
 #include "serac/physics/materials/solid_material.hpp"
@@ -122,13 +123,36 @@ double computeSolidMechanicsQoi(BasePhysics& solid_solver, const TimeSteppingInf
   return qoi;
 }
 
-std::tuple<double, FiniteElementDual, FiniteElementDual, FiniteElementDual> computeSolidMechanicsQoiSensitivities(
-    BasePhysics& solid_solver, const TimeSteppingInfo& ts_info)
+// Advance with adaptive timesteps up to end_time, recording the accepted timesteps in accepted in the layout of
+// TimeSteppingInfo, i.e. with the initial zero-length step and a trailing zero
+double computeAdaptiveSolidMechanicsQoi(BasePhysics& solid_solver, double end_time, TimeSteppingInfo& accepted)
 {
-  EXPECT_EQ(0, solid_solver.cycle());
+  solid_solver.advanceTimestep(0.0);  // advance by 0.0 seconds to get initial acceleration
+  FiniteElementState previous_displacement = solid_solver.state("displacement");
+
+  // each step contributes half its timestep to the weights of the displacements at its start and end
+  std::vector<double> dts{0.0};
+  double              qoi = 0.0;
+  while (solid_solver.time() < end_time - 1.0e-12) {
+    solid_solver.advanceTimestep(end_time - solid_solver.time());
+    double dt = solid_solver.getCheckpointedTimestep(solid_solver.cycle() - 1);
+    qoi += computeStepQoi(previous_displacement, 0.5 * dt);
+    qoi += computeStepQoi(solid_solver.state("displacement"), 0.5 * dt);
+    previous_displacement = solid_solver.state("displacement");
+    dts.push_back(dt);
+  }
+  dts.push_back(0.0);
 
-  double qoi = computeSolidMechanicsQoi(solid_solver, ts_info);
+  accepted.dts.SetSize(static_cast<int>(dts.size()));
+  for (int i = 0; i < accepted.dts.Size(); ++i) {
+    accepted.dts[i] = dts[static_cast<size_t>(i)];
+  }
+  return qoi;
+}
 
+std::tuple<FiniteElementDual, FiniteElementDual, FiniteElementDual> computeSolidMechanicsSensitivities(
+    BasePhysics& solid_solver)
+{
   FiniteElementDual initial_displacement_sensitivity(solid_solver.state("displacement").space(),
                                                      "init_displacement_sensitivity");
   initial_displacement_sensitivity = 0.0;
@@ -164,6 +188,18 @@ std::tuple<double, FiniteElementDual, FiniteElementDual, FiniteElementDual> comp
   initial_displacement_sensitivity = initialDisplacementSensitivityIter->second;
   initial_velocity_sensitivity     = initialVelocitySensitivityIter->second;
 
+  return std::make_tuple(initial_displacement_sensitivity, initial_velocity_sensitivity, shape_sensitivity);
+}
+
+std::tuple<double, FiniteElementDual, FiniteElementDual, FiniteElementDual> computeSolidMechanicsQoiSensitivities(
+    BasePhysics& solid_solver, const TimeSteppingInfo& ts_info)
+{
+  EXPECT_EQ(0, solid_solver.cycle());
+
+  double qoi = computeSolidMechanicsQoi(solid_solver, ts_info);
+
+  auto [initial_displacement_sensitivity, initial_velocity_sensitivity, shape_sensitivity] =
+      computeSolidMechanicsSensitivities(solid_solver);
   return std::make_tuple(qoi, initial_displacement_sensitivity, initial_velocity_sensitivity, shape_sensitivity);
 }
 
@@ -331,6 +367,70 @@ TEST_F(SolidMechanicsSensitivityFixture, WhenShapeSensitivitiesCalledTwice_GetSa
   EXPECT_EQ(directional_deriv1, directional_deriv2);
 }
 
+TEST_F(SolidMechanicsSensitivityFixture, AdaptiveTimestepSensitivities)
+{
+  TimesteppingOptions adaptive_opts = dyn_opts;
+  adaptive_opts.adaptive            = AdaptiveTimesteppingOptions{.relative_tol = 1.0e-2, .absolute_tol = 1.0e-4};
+
+  auto adaptive_solver = createNonlinearSolidMechanicsSolver(nonlinear_opts, adaptive_opts, mat);
+
+  TimeSteppingInfo accepted;
+  double           qoi = computeAdaptiveSolidMechanicsQoi(*adaptive_solver, tsInfo.dts.Sum(), accepted);
+  ASSERT_GT(accepted.numTimesteps(), 1);
+
+  auto [_, init_velo_sensitivity, shape_sensitivity] = computeSolidMechanicsSensitivities(*adaptive_solver);
+
+  // The adjoint differentiates the accepted timesteps, which an adaptive rerun with perturbed inputs could change,
+  // so the finite differences replay them with fixed timesteps
+  auto solid_solver = createNonlinearSolidMechanicsSolver(nonlinear_opts, dyn_opts, mat);
+  EXPECT_NEAR(computeSolidMechanicsQoi(*solid_solver, accepted), qoi, 1.0e-12 * std::abs(qoi));
+
+  solid_solver->resetStates();
+  applyInitialAndBoundaryConditions(*solid_solver);
+  FiniteElementState velocity_direction(solid_solver->velocity().space(), "velocity_direction");
+  fillDirection(velocity_direction);
+  solid_solver->zeroEssentials(velocity_direction);
+
+  double qoi_plus = computeSolidMechanicsQoiAdjustingInitialVelocity(*solid_solver, accepted, velocity_direction, eps);
+  double directional_deriv = innerProduct(velocity_direction, init_velo_sensitivity);
+  EXPECT_NEAR(directional_deriv, (qoi_plus - qoi) / eps, 16 * eps);
+
+  solid_solver->resetStates();
+  applyInitialAndBoundaryConditions(*solid_solver);
+  FiniteElementState shape_direction(shape_sensitivity.space(), "shape_direction");
+  fillDirection(shape_direction);
+
+  qoi_plus          = computeSolidMechanicsQoiAdjustingShape(*solid_solver, accepted, shape_direction, eps);
+  directional_deriv = innerProduct(shape_direction, shape_sensitivity);
+  EXPECT_NEAR(directional_deriv, (qoi_plus - qoi) / eps, eps);
+}
+
+TEST_F(SolidMechanicsSensitivityFixture, BinomialCheckpointingMatchesStoringAllStates)
+{
+  auto solid_solver = createNonlinearSolidMechanicsSolver(nonlinear_opts, dyn_opts, mat);
+  auto [qoi, init_disp_sensitivity, init_velo_sensitivity, shape_sensitivity] =
+      computeSolidMechanicsQoiSensitivities(*solid_solver, tsInfo);
+
+  // keep only 3 of the 6 primal states, so that some of them are recomputed during the reverse sweep
+  auto checkpointed_solver = createNonlinearSolidMechanicsSolver(nonlinear_opts, dyn_opts, mat);
+  checkpointed_solver->setCheckpointing(BinomialCheckpointing(3));
+  auto [checkpointed_qoi, checkpointed_init_disp_sensitivity, checkpointed_init_velo_sensitivity,
+        checkpointed_shape_sensitivity] = computeSolidMechanicsQoiSensitivities(*checkpointed_solver, tsInfo);
+
+  EXPECT_NEAR(qoi, checkpointed_qoi, 1.0e-12 * std::abs(qoi));
+
+  auto expect_same_sensitivity = [this](const FiniteElementDual& expected, const FiniteElementDual& actual) {
+    FiniteElementState direction(expected.space(), "derivative_direction");
+    fillDirection(direction);
+    double directional_deriv = innerProduct(direction, expected);
+    EXPECT_NEAR(directional_deriv, innerProduct(direction, actual), 1.0e-10 * std::abs(directional_deriv));
+  };
+
+  expect_same_sensitivity(init_disp_sensitivity, checkpointed_init_disp_sensitivity);
+  expect_same_sensitivity(init_velo_sensitivity, checkpointed_init_velo_sensitivity);
+  expect_same_sensitivity(shape_sensitivity, checkpointed_shape_sensitivity);
+}
+
 }  // namespace serac
 
 int main(int argc, char* argv[])
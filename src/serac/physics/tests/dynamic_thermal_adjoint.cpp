@@ -5,9 +5,12 @@
 // SPDX-License-Identifier: (BSD-3-Clause)
 #include "serac/physics/heat_transfer.hpp"
 
+#include <cstdlib>
+#include <filesystem>
 #include <functional>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "axom/slic/core/SimpleLogger.hpp"
 #include <gtest/gtest.h>
@@ -123,6 +126,25 @@ double computeThermalQoi(BasePhysics& physics_solver, const TimeSteppingInfo& ts
   return qoi;
 }
 
+// Advance with adaptive timesteps up to end_time, recording the accepted timesteps in accepted
+double computeAdaptiveThermalQoi(BasePhysics& physics_solver, double end_time, TimeSteppingInfo& accepted)
+{
+  std::vector<double> dts;
+  double              qoi = 0.0;
+  while (physics_solver.time() < end_time - 1.0e-12) {
+    physics_solver.advanceTimestep(end_time - physics_solver.time());
+    double dt = physics_solver.getCheckpointedTimestep(physics_solver.cycle() - 1);
+    qoi += computeStepQoi(physics_solver.state("temperature"), dt);
+    dts.push_back(dt);
+  }
+
+  accepted.dts.SetSize(static_cast<int>(dts.size()));
+  for (int i = 0; i < accepted.dts.Size(); ++i) {
+    accepted.dts[i] = dts[static_cast<size_t>(i)];
+  }
+  return qoi;
+}
+
 double computeThermalQoiAdjustingInitalTemperature(BasePhysics& solver, const TimeSteppingInfo& ts_info,
                                                    const FiniteElementState& init_temp_derivative_direction,
                                                    double                    pertubation)
@@ -167,11 +189,9 @@ double computeThermalQoiAdjustingConductivity(BasePhysics& solver, const TimeSte
   return computeThermalQoi(solver, ts_info);
 }
 
-std::tuple<double, FiniteElementDual, FiniteElementDual> computeThermalQoiAndInitialTemperatureAndShapeSensitivity(
-    BasePhysics& solver, const TimeSteppingInfo& ts_info)
+std::tuple<FiniteElementDual, FiniteElementDual> computeThermalInitialTemperatureAndShapeSensitivity(
+    BasePhysics& solver)
 {
-  double qoi = computeThermalQoi(solver, ts_info);
-
   FiniteElementDual initial_temperature_sensitivity(solver.state("temperature").space(), "init_temp_sensitivity");
   initial_temperature_sensitivity = 0.0;
   FiniteElementDual shape_sensitivity(StateManager::mesh(mesh_tag), H1<SHAPE_ORDER, dim>{}, "shape_sensitivity");
@@ -195,6 +215,16 @@ std::tuple<double, FiniteElementDual, FiniteElementDual> computeThermalQoiAndIni
                   "Could not find temperature in the computed initial condition sensitivities.");
   initial_temperature_sensitivity += initialTemperatureSensitivityIter->second;
 
+  return std::make_tuple(initial_temperature_sensitivity, shape_sensitivity);
+}
+
+std::tuple<double, FiniteElementDual, FiniteElementDual> computeThermalQoiAndInitialTemperatureAndShapeSensitivity(
+    BasePhysics& solver, const TimeSteppingInfo& ts_info)
+{
+  double qoi = computeThermalQoi(solver, ts_info);
+
+  auto [initial_temperature_sensitivity, shape_sensitivity] =
+      computeThermalInitialTemperatureAndShapeSensitivity(solver);
   return std::make_tuple(qoi, initial_temperature_sensitivity, shape_sensitivity);
 }
 
@@ -325,6 +355,103 @@ TEST_F(HeatTransferSensitivityFixture, NonlinearConductivityParameterSensitiviti
   EXPECT_NEAR(directional_deriv, (qoi_plus - qoi_base) / eps, eps);
 }
 
+TEST_F(HeatTransferSensitivityFixture, AdaptiveTimestepSensitivities)
+{
+  TimesteppingOptions adaptive_opts = dyn_opts;
+  adaptive_opts.adaptive            = AdaptiveTimesteppingOptions{.relative_tol = 1.0e-2, .absolute_tol = 1.0e-4};
+
+  auto adaptive_solver = createNonlinearHeatTransfer(data_store, nonlinear_opts, adaptive_opts, nonlinearMat);
+
+  TimeSteppingInfo accepted;
+  double           qoi = computeAdaptiveThermalQoi(*adaptive_solver, tsInfo.dts.Sum(), accepted);
+  ASSERT_GT(accepted.numTimesteps(), 1);
+
+  auto [temperature_sensitivity, shape_sensitivity] =
+      computeThermalInitialTemperatureAndShapeSensitivity(*adaptive_solver);
+
+  // The adjoint differentiates the accepted timesteps, which an adaptive rerun with perturbed inputs could change,
+  // so the finite differences replay them with fixed timesteps
+  auto thermal_solver = createNonlinearHeatTransfer(data_store, nonlinear_opts, dyn_opts, nonlinearMat);
+  EXPECT_NEAR(computeThermalQoi(*thermal_solver, accepted), qoi, 1.0e-12 * std::abs(qoi));
+
+  thermal_solver->resetStates();
+  FiniteElementState temperature_direction(temperature_sensitivity.space(), "temperature_direction");
+  fillDirection(temperature_direction);
+  double qoi_plus = computeThermalQoiAdjustingInitalTemperature(*thermal_solver, accepted, temperature_direction, eps);
+  double directional_deriv = innerProduct(temperature_direction, temperature_sensitivity);
+  ASSERT_TRUE(std::abs(directional_deriv) > 1e-13);
+  EXPECT_NEAR(directional_deriv, (qoi_plus - qoi) / eps, eps);
+
+  thermal_solver->resetStates();
+  FiniteElementState shape_direction(shape_sensitivity.space(), "shape_direction");
+  fillDirection(shape_direction);
+  qoi_plus          = computeThermalQoiAdjustingShape(*thermal_solver, accepted, shape_direction, eps);
+  directional_deriv = innerProduct(shape_direction, shape_sensitivity);
+  ASSERT_TRUE(std::abs(directional_deriv) > 1e-13);
+  EXPECT_NEAR(directional_deriv, (qoi_plus - qoi) / eps, eps);
+}
+
+TEST_F(HeatTransferSensitivityFixture, BinomialCheckpointingMatchesStoringAllStates)
+{
+  auto thermal_solver = createNonlinearHeatTransfer(data_store, nonlinear_opts, dyn_opts, nonlinearMat);
+  auto [qoi, temperature_sensitivity, shape_sensitivity] =
+      computeThermalQoiAndInitialTemperatureAndShapeSensitivity(*thermal_solver, tsInfo);
+
+  // keep only 2 of the 6 primal states, so that most of them are recomputed during the reverse sweep
+  auto checkpointed_solver = createNonlinearHeatTransfer(data_store, nonlinear_opts, dyn_opts, nonlinearMat);
+  checkpointed_solver->setCheckpointing(BinomialCheckpointing(2));
+  auto [checkpointed_qoi, checkpointed_temperature_sensitivity, checkpointed_shape_sensitivity] =
+      computeThermalQoiAndInitialTemperatureAndShapeSensitivity(*checkpointed_solver, tsInfo);
+
+  EXPECT_EQ(thermal_solver->time(), checkpointed_solver->time());
+  EXPECT_NEAR(qoi, checkpointed_qoi, 1.0e-12 * std::abs(qoi));
+
+  FiniteElementState temperature_direction(temperature_sensitivity.space(), "temperature_direction");
+  fillDirection(temperature_direction);
+  double directional_deriv              = innerProduct(temperature_direction, temperature_sensitivity);
+  double checkpointed_directional_deriv = innerProduct(temperature_direction, checkpointed_temperature_sensitivity);
+  EXPECT_NEAR(directional_deriv, checkpointed_directional_deriv, 1.0e-10 * std::abs(directional_deriv));
+
+  FiniteElementState shape_direction(shape_sensitivity.space(), "shape_direction");
+  fillDirection(shape_direction);
+  directional_deriv              = innerProduct(shape_direction, shape_sensitivity);
+  checkpointed_directional_deriv = innerProduct(shape_direction, checkpointed_shape_sensitivity);
+  EXPECT_NEAR(directional_deriv, checkpointed_directional_deriv, 1.0e-10 * std::abs(directional_deriv));
+}
+
+TEST_F(HeatTransferSensitivityFixture, SnapshotStoreMatchesStoringAllStates)
+{
+  auto thermal_solver = createNonlinearHeatTransfer(data_store, nonlinear_opts, dyn_opts, nonlinearMat);
+  auto [qoi, temperature_sensitivity, shape_sensitivity] =
+      computeThermalQoiAndInitialTemperatureAndShapeSensitivity(*thermal_solver, tsInfo);
+
+  // Keep the per-rank snapshot files out of the working directory
+  std::string snapshot_directory = (std::filesystem::temp_directory_path() / "serac_snapshots_XXXXXX").string();
+  ASSERT_NE(::mkdtemp(snapshot_directory.data()), nullptr);
+
+  auto checkpointed_solver = createNonlinearHeatTransfer(data_store, nonlinear_opts, dyn_opts, nonlinearMat);
+  checkpointed_solver->setCheckpointing(SnapshotStore(snapshot_directory + "/thermal_snapshots"));
+  auto [checkpointed_qoi, checkpointed_temperature_sensitivity, checkpointed_shape_sensitivity] =
+      computeThermalQoiAndInitialTemperatureAndShapeSensitivity(*checkpointed_solver, tsInfo);
+
+  EXPECT_NEAR(qoi, checkpointed_qoi, 1.0e-12 * std::abs(qoi));
+
+  FiniteElementState temperature_direction(temperature_sensitivity.space(), "temperature_direction");
+  fillDirection(temperature_direction);
+  double directional_deriv              = innerProduct(temperature_direction, temperature_sensitivity);
+  double checkpointed_directional_deriv = innerProduct(temperature_direction, checkpointed_temperature_sensitivity);
+  EXPECT_NEAR(directional_deriv, checkpointed_directional_deriv, 1.0e-12 * std::abs(directional_deriv));
+
+  FiniteElementState shape_direction(shape_sensitivity.space(), "shape_direction");
+  fillDirection(shape_direction);
+  directional_deriv              = innerProduct(shape_direction, shape_sensitivity);
+  checkpointed_directional_deriv = innerProduct(shape_direction, checkpointed_shape_sensitivity);
+  EXPECT_NEAR(directional_deriv, checkpointed_directional_deriv, 1.0e-12 * std::abs(directional_deriv));
+
+  checkpointed_solver.reset();
+  std::filesystem::remove_all(snapshot_directory);
+}
+
 }  // namespace serac
 
 int main(int argc, char* argv[])
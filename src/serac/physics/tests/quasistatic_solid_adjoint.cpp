@@ -132,30 +132,21 @@ void adjointPass(serac::BasePhysics* solid, qoiType* qoi, int nTimeSteps, double
   vderiv = vgrad(0);
 }
 
-TEST(quasistatic, finiteDifference)
-{
-  // set up mesh
-  ::axom::sidre::DataStore datastore;
-  ::serac::StateManager::initialize(datastore, "sidreDataStore");
-
-  mfem::Mesh mesh = mfem::Mesh::MakeCartesian3D(1, 1, 1, mfem::Element::HEXAHEDRON);
-  assert(mesh.SpaceDimension() == DIM);
-  auto             pmesh   = ::std::make_unique<::mfem::ParMesh>(MPI_COMM_WORLD, mesh);
-  ::mfem::ParMesh* meshPtr = &::serac::StateManager::setMesh(::std::move(pmesh), mesh_tag);
+using solidType    = serac::SolidMechanics<ORDER, DIM, ::serac::Parameters<paramFES, paramFES>>;
+using materialType = ParameterizedNeoHookeanSolid;
 
-  // set up solver
-  using solidType        = serac::SolidMechanics<ORDER, DIM, ::serac::Parameters<paramFES, paramFES>>;
+/// create a solid solver that compresses the unit cube, using the given linear solver options
+std::unique_ptr<solidType> buildSolid(const LinearSolverOptions& linear_options, double E0, double v0)
+{
   auto nonlinear_options = serac::NonlinearSolverOptions{.nonlin_solver  = ::serac::NonlinearSolver::Newton,
                                                          .relative_tol   = 1e-6,
                                                          .absolute_tol   = 1e-8,
                                                          .max_iterations = 10,
                                                          .print_level    = 1};
-  auto seracSolid = ::std::make_unique<solidType>(nonlinear_options, serac::solid_mechanics::direct_linear_options,
-                                                  ::serac::solid_mechanics::default_quasistatic_options,
-                                                  ::serac::GeometricNonlinearities::On, physics_prefix, mesh_tag,
-                                                  std::vector<std::string>{"E", "v"});
+  auto seracSolid        = ::std::make_unique<solidType>(
+      nonlinear_options, linear_options, ::serac::solid_mechanics::default_quasistatic_options,
+      ::serac::GeometricNonlinearities::On, physics_prefix, mesh_tag, std::vector<std::string>{"E", "v"});
 
-  using materialType = ParameterizedNeoHookeanSolid;
   materialType material;
   seracSolid->setMaterial(::serac::DependsOn<0, 1>{}, material);
 
@@ -170,8 +161,6 @@ TEST(quasistatic, finiteDifference)
   // seracSolid->setTraction([](auto, auto n, auto) {return 1.0*n;}, loadRegion);
   seracSolid->setDisplacementBCs({6}, [](const mfem::Vector&, double time, mfem::Vector& u) { return u[2] = time; });
 
-  double                      E0 = 1.0;
-  double                      v0 = 0.3;
   ::serac::FiniteElementState Estate(seracSolid->parameter(seracSolid->parameterNames()[0]));
   ::serac::FiniteElementState vstate(seracSolid->parameter(seracSolid->parameterNames()[1]));
   Estate = E0;
@@ -181,21 +170,56 @@ TEST(quasistatic, finiteDifference)
 
   seracSolid->completeSetup();
 
-  // set up QoI
-  auto [param_space, _]                        = ::serac::generateParFiniteElementSpace<paramFES>(meshPtr);
-  const ::mfem::ParFiniteElementSpace* u_space = &seracSolid->state("displacement").space();
+  return seracSolid;
+}
 
-  std::array<const ::mfem::ParFiniteElementSpace*, 3> qoiFES = {param_space.get(), param_space.get(), u_space};
+/// create the quantity of interest, the time integral of the zz-stress
+std::unique_ptr<qoiType> buildQoI(solidType& solid, mfem::ParMesh& mesh, const mfem::ParFiniteElementSpace& param_space)
+{
+  const ::mfem::ParFiniteElementSpace* u_space = &solid.state("displacement").space();
+
+  std::array<const ::mfem::ParFiniteElementSpace*, 3> qoiFES = {&param_space, &param_space, u_space};
   auto                                                qoi    = std::make_unique<qoiType>(qoiFES);
   qoi->AddDomainIntegral(
       serac::Dimension<DIM>{}, serac::DependsOn<0, 1, 2>{},
-      [&](auto time, auto, auto E, auto v, auto u) {
+      [](auto time, auto, auto E, auto v, auto u) {
         auto du_dx  = ::serac::get<1>(u);
         auto state  = ::serac::Empty{};
-        auto stress = material(state, du_dx, E, v);
+        auto stress = materialType{}(state, du_dx, E, v);
         return stress[2][2] * time;
       },
-      *meshPtr);
+      mesh);
+  return qoi;
+}
+
+/// create the unit cube mesh used by these tests
+mfem::ParMesh* buildMesh()
+{
+  mfem::Mesh mesh = mfem::Mesh::MakeCartesian3D(1, 1, 1, mfem::Element::HEXAHEDRON);
+  assert(mesh.SpaceDimension() == DIM);
+  auto pmesh = ::std::make_unique<::mfem::ParMesh>(MPI_COMM_WORLD, mesh);
+  return &::serac::StateManager::setMesh(::std::move(pmesh), mesh_tag);
+}
+
+TEST(quasistatic, finiteDifference)
+{
+  // set up mesh
+  ::axom::sidre::DataStore datastore;
+  ::serac::StateManager::initialize(datastore, "sidreDataStore");
+
+  ::mfem::ParMesh* meshPtr = buildMesh();
+
+  // set up solver
+  double E0         = 1.0;
+  double v0         = 0.3;
+  auto   seracSolid = buildSolid(serac::solid_mechanics::direct_linear_options, E0, v0);
+
+  ::serac::FiniteElementState Estate(seracSolid->parameter(seracSolid->parameterNames()[0]));
+  ::serac::FiniteElementState vstate(seracSolid->parameter(seracSolid->parameterNames()[1]));
+
+  // set up QoI
+  auto [param_space, _] = ::serac::generateParFiniteElementSpace<paramFES>(meshPtr);
+  auto qoi              = buildQoI(*seracSolid, *meshPtr, *param_space);
 
   int    nTimeSteps = 3;
   double timeStep   = 0.8;
@@ -238,6 +262,46 @@ TEST(quasistatic, finiteDifference)
   ASSERT_NEAR(vderiv, (fpv - fmv) / (2. * h), 1e-7);
 }
 
+// the adjoint solves assemble their own (transposed) Jacobians, so they also
+// work when the forward solves use a matrix-free Jacobian
+TEST(quasistatic, matrixFreeAdjoint)
+{
+  int    nTimeSteps = 3;
+  double timeStep   = 0.8;
+
+  auto sensitivities = [&](const LinearSolverOptions& linear_options, const std::string& name) {
+    ::axom::sidre::DataStore datastore;
+    ::serac::StateManager::initialize(datastore, name);
+
+    ::mfem::ParMesh* meshPtr    = buildMesh();
+    auto             seracSolid = buildSolid(linear_options, 1.0, 0.3);
+
+    auto [param_space, _] = ::serac::generateParFiniteElementSpace<paramFES>(meshPtr);
+    auto qoi              = buildQoI(*seracSolid, *meshPtr, *param_space);
+
+    forwardPass(seracSolid.get(), qoi.get(), meshPtr, nTimeSteps, timeStep, name);
+
+    std::array<double, 2> derivs;
+    adjointPass(seracSolid.get(), qoi.get(), nTimeSteps, timeStep, *param_space, derivs[0], derivs[1]);
+    return derivs;
+  };
+
+  LinearSolverOptions iterative_options{.linear_solver  = LinearSolver::GMRES,
+                                        .preconditioner = Preconditioner::OperatorJacobi,
+                                        .relative_tol   = 1.0e-12,
+                                        .absolute_tol   = 1.0e-14,
+                                        .max_iterations = 500,
+                                        .print_level    = 0};
+
+  auto assembled = sensitivities(iterative_options, "assembled");
+
+  iterative_options.matrix_free = true;
+  auto matrix_free              = sensitivities(iterative_options, "matrix_free");
+
+  EXPECT_NEAR(matrix_free[0], assembled[0], 1.0e-8 * std::abs(assembled[0]));
+  EXPECT_NEAR(matrix_free[1], assembled[1], 1.0e-8 * std::abs(assembled[1]));
+}
+
 }  // namespace serac
 
 int main(int argc, char* argv[])
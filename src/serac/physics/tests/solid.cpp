@@ -6,6 +6,7 @@
 
 #include "serac/physics/solid_mechanics.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <fstream>
 #include <set>
@@ -362,12 +363,111 @@ void functional_parameterized_solid_test(double expected_disp_norm)
   EXPECT_NEAR(expected_disp_norm, norm(solid_solver.displacement()), 1.0e-6);
 }
 
+// check that a vectorized material gives the same residual, stiffness, and implicit dynamics as the scalar material.
+// The implicit dynamics exercise the jacobian that combines the derivatives w.r.t. the displacement and acceleration.
+void functional_solid_vectorized_material()
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  constexpr int p                   = 2;
+  constexpr int dim                 = 3;
+  int           serial_refinement   = 0;
+  int           parallel_refinement = 0;
+
+  // Create DataStore
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_mechanics_vectorized_material_test");
+
+  // Construct the appropriate dimension mesh and give it to the data store
+  std::string filename = SERAC_REPO_DIR "/data/meshes/beam-hex.mesh";
+
+  auto mesh = mesh::refineAndDistribute(buildMeshFromFile(filename), serial_refinement, parallel_refinement);
+
+  std::string mesh_tag{"mesh"};
+
+  serac::StateManager::setMesh(std::move(mesh), mesh_tag);
+
+  serac::LinearSolverOptions linear_options{.linear_solver = LinearSolver::SuperLU};
+
+  serac::NonlinearSolverOptions nonlinear_options{.nonlin_solver  = NonlinearSolver::Newton,
+                                                  .relative_tol   = 1.0e-12,
+                                                  .absolute_tol   = 1.0e-12,
+                                                  .max_iterations = 10,
+                                                  .print_level    = 1};
+
+  SolidMechanics<p, dim> scalar_solid(nonlinear_options, linear_options, solid_mechanics::default_timestepping_options,
+                                      GeometricNonlinearities::On, "scalar_solid", mesh_tag);
+  SolidMechanics<p, dim> vectorized_solid(nonlinear_options, linear_options,
+                                          solid_mechanics::default_timestepping_options, GeometricNonlinearities::On,
+                                          "vectorized_solid", mesh_tag);
+
+  solid_mechanics::NeoHookean material{.density = 1.0, .K = 1.0, .G = 0.5};
+  scalar_solid.setMaterial(material);
+  vectorized_solid.setMaterial(vectorize(material));
+
+  // bend the beam, which is supported at one end, and pull it down with a growing body force
+  std::set<int> support           = {1};
+  auto          zero_displacement = [](const mfem::Vector&, mfem::Vector& u) -> void { u = 0.0; };
+
+  auto bent = [](const mfem::Vector& X, mfem::Vector& u) -> void {
+    u    = 0.0;
+    u[2] = 0.01 * X[0] * X[0];
+  };
+
+  for (auto* solid : {&scalar_solid, &vectorized_solid}) {
+    solid->setDisplacementBCs(support, zero_displacement);
+    solid->setDisplacement(bent);
+    solid->addBodyForce([](auto X, auto t) {
+      auto f = 0.0 * X;
+      f[2]   = -0.1 * t;
+      return f;
+    });
+    solid->completeSetup();
+  }
+
+  // compare the residuals and the actions of the stiffness matrices
+  auto scalar_residual     = scalar_solid.buildQuasistaticOperator();
+  auto vectorized_residual = vectorized_solid.buildQuasistaticOperator();
+
+  mfem::Vector u(scalar_solid.displacement());
+  mfem::Vector r_scalar(u.Size());
+  mfem::Vector r_vectorized(u.Size());
+  scalar_residual->Mult(u, r_scalar);
+  vectorized_residual->Mult(u, r_vectorized);
+
+  r_vectorized -= r_scalar;
+  EXPECT_LT(r_vectorized.Normlinf(), 1.0e-12 * std::max(r_scalar.Normlinf(), 1.0));
+
+  mfem::Vector du(u.Size());
+  du.Randomize(1);
+
+  mfem::Vector jvp_scalar(u.Size());
+  mfem::Vector jvp_vectorized(u.Size());
+  scalar_residual->GetGradient(u).Mult(du, jvp_scalar);
+  vectorized_residual->GetGradient(u).Mult(du, jvp_vectorized);
+
+  jvp_vectorized -= jvp_scalar;
+  EXPECT_LT(jvp_vectorized.Normlinf(), 1.0e-12 * std::max(jvp_scalar.Normlinf(), 1.0));
+
+  // compare a few implicit dynamic steps
+  for (int i = 0; i < 3; i++) {
+    scalar_solid.advanceTimestep(0.1);
+    vectorized_solid.advanceTimestep(0.1);
+  }
+
+  mfem::Vector difference(vectorized_solid.displacement());
+  difference -= scalar_solid.displacement();
+  EXPECT_LT(difference.Normlinf(), 1.0e-10 * std::max(scalar_solid.displacement().Normlinf(), 1.0));
+}
+
 TEST(SolidMechanics, 2DQuadParameterizedStatic) { functional_parameterized_solid_test<2, 2>(2.1773851975471392); }
 
 TEST(SolidMechanics, 3DQuadStaticJ2) { functional_solid_test_static_J2(); }
 
 TEST(SolidMechanics, SpatialBoundaryCondition) { functional_solid_spatial_essential_bc(); }
 
+TEST(SolidMechanics, VectorizedMaterial) { functional_solid_vectorized_material(); }
+
 }  // namespace serac
 
 int main(int argc, char* argv[])
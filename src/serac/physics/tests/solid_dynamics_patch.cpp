@@ -6,6 +6,8 @@
 
 #include "serac/physics/solid_mechanics.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
 #include <set>
 #include <string>
@@ -251,6 +253,9 @@ private:
  *
  * @param exact_solution Exact solution of problem
  * @param bc Specifier for boundary condition type to test
+ * @param timestepper The time integration method
+ * @param constrained_velocity_error If given, set to the largest difference between the velocity of the dofs with
+ * essential boundary conditions and the exact velocity at the midpoint of the last step
  * @return double L2 norm (continuous) of error in computed solution
  * *
  * @pre exact_solution must implement operator() that is an MFEM
@@ -263,7 +268,9 @@ private:
  * solid functional that should lead to the exact solution
  */
 template <typename element_type, typename solution_type>
-double solution_error(solution_type exact_solution, PatchBoundaryCondition bc)
+double solution_error(solution_type exact_solution, PatchBoundaryCondition bc,
+                      TimestepMethod timestepper                = TimestepMethod::Newmark,
+                      double*        constrained_velocity_error = nullptr)
 {
   MPI_Barrier(MPI_COMM_WORLD);
 
@@ -308,7 +315,7 @@ double solution_error(solution_type exact_solution, PatchBoundaryCondition bc)
   serac::NonlinearSolverOptions nonlin_opts{.relative_tol = 1.0e-13, .absolute_tol = 1.0e-13};
 
   SolidMechanics<p, dim> solid(nonlin_opts, serac::solid_mechanics::default_linear_options,
-                               TimesteppingOptions{TimestepMethod::Newmark, DirichletEnforcementMethod::DirectControl},
+                               TimesteppingOptions{timestepper, DirichletEnforcementMethod::DirectControl},
                                GeometricNonlinearities::On, "solid_dynamics", mesh_tag);
 
   solid_mechanics::NeoHookean mat{.density = 1.0, .K = 1.0, .G = 1.0};
@@ -325,9 +332,15 @@ double solution_error(solution_type exact_solution, PatchBoundaryCondition bc)
   // Finalize the data structures
   solid.completeSetup();
 
-  // Integrate in time
-  for (int i = 0; i < 3; i++) {
-    solid.advanceTimestep(1.0);
+  // Integrate in time, with as many explicit steps as stability requires
+  int nsteps = 3;
+  if (timestepper == TimestepMethod::CentralDifference) {
+    nsteps = static_cast<int>(std::ceil(3.0 / solid.stableTimestep()));
+  }
+
+  double dt = 3.0 / nsteps;
+  for (int i = 0; i < nsteps; i++) {
+    solid.advanceTimestep(dt);
 
     // Output solution for debugging
     // solid.outputStateToDisk("paraview_output");
@@ -347,6 +360,32 @@ double solution_error(solution_type exact_solution, PatchBoundaryCondition bc)
     // std::cout << "resultant = " << resultant << std::endl;
   }
 
+  if (constrained_velocity_error) {
+    // the constrained dofs move with the prescribed displacement change over the step
+    auto exact_velocity = [exact_solution](const mfem::Vector& X, double t, mfem::Vector& v) {
+      exact_solution.velocity(X, t, v);
+    };
+    mfem::VectorFunctionCoefficient exact_velocity_coef(dim, exact_velocity);
+    exact_velocity_coef.SetTime(solid.time() - 0.5 * dt);
+
+    FiniteElementState expected_velocity(solid.velocity());
+    expected_velocity.project(exact_velocity_coef);
+
+    mfem::Array<int> essential_markers(solid.mesh().bdr_attributes.Max());
+    essential_markers = 0;
+    for (int attribute : essentialBoundaryAttributes<dim>(bc)) {
+      essential_markers[attribute - 1] = 1;
+    }
+    mfem::Array<int> constrained_dofs;
+    solid.velocity().space().GetEssentialTrueDofs(essential_markers, constrained_dofs);
+
+    double error = 0.0;
+    for (int j : constrained_dofs) {
+      error = std::max(error, std::abs(solid.velocity()[j] - expected_velocity[j]));
+    }
+    MPI_Allreduce(&error, constrained_velocity_error, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  }
+
   // Compute norm of error
   mfem::VectorFunctionCoefficient exact_solution_coef(dim, exact_solution);
   exact_solution_coef.SetTime(solid.time());
@@ -361,10 +400,17 @@ double affine_velocity_test(PatchBoundaryCondition bc)
 }
 
 template <typename element_type>
-double constant_acceleration_test(PatchBoundaryCondition bc)
+double constant_acceleration_test(PatchBoundaryCondition bc, TimestepMethod timestepper = TimestepMethod::Newmark)
 {
   constexpr int dim = dimension_of(element_type::geometry);
-  return solution_error<element_type>(ConstantAccelerationSolution<dim>(), bc);
+  return solution_error<element_type>(ConstantAccelerationSolution<dim>(), bc, timestepper);
+}
+
+template <typename element_type>
+double explicit_affine_velocity_test(PatchBoundaryCondition bc)
+{
+  constexpr int dim = dimension_of(element_type::geometry);
+  return solution_error<element_type>(AffineSolution<dim>(), bc, TimestepMethod::CentralDifference);
 }
 
 const double tol = 1e-12;
@@ -584,6 +630,42 @@ TEST(SolidMechanicsDynamic, ConstantAccelerationHexQ2EssentialAndNaturalBcs)
   EXPECT_LT(error, tol);
 }
 
+//
+// Explicit central differences with a lumped mass, which is exact for uniform accelerations
+//
+TEST(SolidMechanicsDynamic, ExplicitPatchTestQuadQ1EssentialBcs)
+{
+  using element_type = finite_element<mfem::Geometry::SQUARE, H1<LINEAR> >;
+  double error       = explicit_affine_velocity_test<element_type>(PatchBoundaryCondition::Essential);
+  EXPECT_LT(error, tol);
+}
+
+TEST(SolidMechanicsDynamic, ExplicitPatchTestHexQ1EssentialAndNaturalBcs)
+{
+  using element_type = finite_element<mfem::Geometry::CUBE, H1<LINEAR> >;
+  double error       = explicit_affine_velocity_test<element_type>(PatchBoundaryCondition::EssentialAndNatural);
+  EXPECT_LT(error, tol);
+}
+
+TEST(SolidMechanicsDynamic, ExplicitConstrainedVelocityQuadQ1EssentialBcs)
+{
+  using element_type = finite_element<mfem::Geometry::SQUARE, H1<LINEAR> >;
+  constexpr int dim  = dimension_of(element_type::geometry);
+
+  double velocity_error = 0.0;
+  solution_error<element_type>(ConstantAccelerationSolution<dim>(), PatchBoundaryCondition::Essential,
+                               TimestepMethod::CentralDifference, &velocity_error);
+  EXPECT_LT(velocity_error, tol);
+}
+
+TEST(SolidMechanicsDynamic, ExplicitConstantAccelerationQuadQ1EssentialAndNaturalBcs)
+{
+  using element_type = finite_element<mfem::Geometry::SQUARE, H1<LINEAR> >;
+  double error       = constant_acceleration_test<element_type>(PatchBoundaryCondition::EssentialAndNatural,
+                                                                TimestepMethod::CentralDifference);
+  EXPECT_LT(error, tol);
+}
+
 }  // namespace serac
 
 int main(int argc, char* argv[])
@@ -9,12 +9,14 @@
 #include "serac/physics/materials/solid_material.hpp"
 #include "serac/physics/materials/green_saint_venant_thermoelastic.hpp"
 
+#include <cmath>
 #include <fstream>
 
 #include <gtest/gtest.h>
 #include "mfem.hpp"
 
 #include "serac/serac_config.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/mesh/mesh_utils.hpp"
 #include "serac/physics/state/state_manager.hpp"
 
@@ -103,7 +105,7 @@ void functional_test_static_3D(double expected_norm)
 }
 
 template <int p>
-void functional_test_shrinking_3D(double expected_norm)
+void functional_test_shrinking_3D(double expected_norm, ThermomechanicalCouplingOptions coupling_options = {})
 {
   MPI_Barrier(MPI_COMM_WORLD);
 
@@ -175,6 +177,8 @@ void functional_test_shrinking_3D(double expected_norm)
   thermal_solid_solver.setDisplacementBCs(constraint_bdr, zeroVector);
   thermal_solid_solver.setDisplacement(zeroVector);
 
+  thermal_solid_solver.setCouplingOptions(coupling_options);
+
   // Finalize the data structures
   thermal_solid_solver.completeSetup();
 
@@ -185,6 +189,137 @@ void functional_test_shrinking_3D(double expected_norm)
   EXPECT_NEAR(expected_norm, norm(thermal_solid_solver.displacement()), 1.0e-4);
 }
 
+/**
+ * @brief A Green-Saint Venant thermoelastic material whose heat flux is the pull-back of Fourier's law in the current
+ * configuration, so that the temperature also depends on the displacement
+ */
+struct DeformingConductorMaterial : public GreenSaintVenantThermoelasticMaterial {
+  /// @brief Evaluate the constitutive variables, see GreenSaintVenantThermoelasticMaterial::operator()
+  template <typename T1, typename T2, typename T3>
+  auto operator()(State& state, const tensor<T1, 3, 3>& grad_u, T2 theta, const tensor<T3, 3>& grad_theta) const
+  {
+    auto [sigma, heat_capacity, s0, unused] =
+        GreenSaintVenantThermoelasticMaterial::operator()(state, grad_u, theta, grad_theta);
+
+    auto       F     = grad_u + Identity<3>();
+    const auto C_inv = inv(dot(transpose(F), F));
+    const auto q0    = -k * det(F) * dot(C_inv, grad_theta);
+
+    return serac::tuple{sigma, heat_capacity, s0, q0};
+  }
+};
+
+/// @brief The displacement and temperature true dofs of a thermomechanical solve
+struct ThermomechanicalSolution {
+  mfem::Vector displacement;  ///< The displacement true dofs
+  mfem::Vector temperature;   ///< The temperature true dofs
+};
+
+/// @brief The norm of the difference of two thermomechanical solutions, relative to the norm of the reference one
+double relativeDifference(const ThermomechanicalSolution& solution, const ThermomechanicalSolution& reference)
+{
+  auto squared_norm = [](const mfem::Vector& v) { return mfem::InnerProduct(MPI_COMM_WORLD, v, v); };
+
+  mfem::Vector displacement_difference(solution.displacement);
+  mfem::Vector temperature_difference(solution.temperature);
+  displacement_difference -= reference.displacement;
+  temperature_difference -= reference.temperature;
+
+  return std::sqrt((squared_norm(displacement_difference) + squared_norm(temperature_difference)) /
+                   (squared_norm(reference.displacement) + squared_norm(reference.temperature)));
+}
+
+/// @brief The coupling options of a monolithic solve with full Newton steps and an exact linear solver
+ThermomechanicalCouplingOptions monolithicCouplingOptions(int max_iterations)
+{
+  ThermomechanicalCouplingOptions coupling_options{.coupling = ThermomechanicalCoupling::Monolithic};
+  coupling_options.nonlinear_options = {.nonlin_solver  = NonlinearSolver::Newton,
+                                        .relative_tol   = 1.0e-12,
+                                        .absolute_tol   = 1.0e-14,
+                                        .max_iterations = max_iterations};
+  coupling_options.linear_options    = {.linear_solver = LinearSolver::SuperLU};
+  return coupling_options;
+}
+
+/**
+ * @brief Heat a beam from one end, with a conductivity that changes as the beam expands
+ *
+ * @param coupling_options The coupling of the thermal and mechanical solves
+ * @return The displacement and temperature after a quasi-static step
+ */
+template <int p>
+ThermomechanicalSolution functional_test_two_way_coupled_3D(ThermomechanicalCouplingOptions coupling_options)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  constexpr int dim                 = 3;
+  int           serial_refinement   = 1;
+  int           parallel_refinement = 0;
+
+  // Create DataStore
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "thermal_functional_two_way_solve");
+
+  // Construct the appropriate dimension mesh and give it to the data store
+  std::string filename = SERAC_REPO_DIR "/data/meshes/beam-hex.mesh";
+
+  auto mesh = mesh::refineAndDistribute(buildMeshFromFile(filename), serial_refinement, parallel_refinement);
+
+  std::string mesh_tag{"mesh"};
+
+  serac::StateManager::setMesh(std::move(mesh), mesh_tag);
+
+  // Define the boundary attribute sets of the fixed end, and of both ends
+  std::set<int> constraint_bdr = {1};
+  std::set<int> temp_bdr       = {1, 2};
+
+  // the staggered solves are converged tightly, so that the iterative and monolithic couplings can be compared
+  const LinearSolverOptions    linear_options    = {.linear_solver = LinearSolver::SuperLU};
+  const NonlinearSolverOptions nonlinear_options = {.nonlin_solver  = NonlinearSolver::Newton,
+                                                    .relative_tol   = 1.0e-12,
+                                                    .absolute_tol   = 1.0e-14,
+                                                    .max_iterations = 20};
+
+  Thermomechanics<p, dim> thermal_solid_solver(nonlinear_options, linear_options, heat_transfer::default_static_options,
+                                               nonlinear_options, linear_options,
+                                               solid_mechanics::default_quasistatic_options,
+                                               GeometricNonlinearities::On, "thermal_solid_functional", mesh_tag);
+
+  double                            rho       = 1.0;
+  double                            E         = 1.0;
+  double                            nu        = 0.25;
+  double                            c         = 1.0;
+  double                            alpha     = 5.0e-2;
+  double                            theta_ref = 1.0;
+  double                            k         = 1.0;
+  DeformingConductorMaterial        material{{rho, E, nu, c, alpha, theta_ref, k}};
+  DeformingConductorMaterial::State initial_state{};
+  auto                              qdata = thermal_solid_solver.createQuadratureDataBuffer(initial_state);
+  thermal_solid_solver.setMaterial(material, qdata);
+
+  // Heat the free end of the beam, starting from the linear temperature profile of a constant conductivity
+  auto temperature_field = [](const mfem::Vector& x, double) -> double { return 1.0 + x[0] / 8.0; };
+  thermal_solid_solver.setTemperatureBCs(temp_bdr, temperature_field);
+  thermal_solid_solver.setTemperature(temperature_field);
+
+  // Define the function for the displacement boundary condition
+  auto zeroVector = [](const mfem::Vector&, mfem::Vector& u) { u = 0.0; };
+
+  // Set the initial displacement and boundary condition
+  thermal_solid_solver.setDisplacementBCs(constraint_bdr, zeroVector);
+  thermal_solid_solver.setDisplacement(zeroVector);
+
+  thermal_solid_solver.setCouplingOptions(coupling_options);
+
+  // Finalize the data structures
+  thermal_solid_solver.completeSetup();
+
+  // Perform the quasi-static solve
+  thermal_solid_solver.advanceTimestep(1.0);
+
+  return {thermal_solid_solver.displacement(), thermal_solid_solver.temperature()};
+}
+
 // TODO: investigate this failing test
 template <int p>
 void parameterized()
@@ -339,6 +474,70 @@ TEST(Thermomechanics, thermalContraction)
   serac::functional_test_shrinking_3D<p>(std::sqrt(L * L * L / 3.0) * alpha * delta_theta);
 }
 
+TEST(Thermomechanics, thermalContractionIterative)
+{
+  constexpr int p           = 2;
+  double        alpha       = 1e-3;
+  double        L           = 8;
+  double        delta_theta = 1.0;
+
+  serac::ThermomechanicalCouplingOptions coupling_options{.coupling = serac::ThermomechanicalCoupling::Iterative};
+  serac::functional_test_shrinking_3D<p>(std::sqrt(L * L * L / 3.0) * alpha * delta_theta, coupling_options);
+}
+
+TEST(Thermomechanics, thermalContractionMonolithic)
+{
+  constexpr int p           = 2;
+  double        alpha       = 1e-3;
+  double        L           = 8;
+  double        delta_theta = 1.0;
+
+  serac::ThermomechanicalCouplingOptions coupling_options{.coupling = serac::ThermomechanicalCoupling::Monolithic};
+  coupling_options.nonlinear_options = {.relative_tol = 1.0e-8, .absolute_tol = 1.0e-10, .max_iterations = 10};
+  serac::functional_test_shrinking_3D<p>(std::sqrt(L * L * L / 3.0) * alpha * delta_theta, coupling_options);
+}
+
+TEST(Thermomechanics, twoWayCoupledIterativeMatchesMonolithic)
+{
+  constexpr int p = 2;
+
+  serac::ThermomechanicalCouplingOptions iterative_options{.coupling       = serac::ThermomechanicalCoupling::Iterative,
+                                                           .relative_tol   = 1.0e-10,
+                                                           .absolute_tol   = 1.0e-12,
+                                                           .max_iterations = 50};
+
+  serac::profiling::enableCounters("");
+  serac::profiling::resetCounters();
+  auto iterative = serac::functional_test_two_way_coupled_3D<p>(iterative_options);
+  auto coupling  = serac::profiling::getCounter("Thermomechanics/coupling");
+  serac::profiling::disableCounters();
+
+  // a one-way coupled solve converges in its second iteration, since the temperature of the first one is final
+  EXPECT_GT(coupling.iterations, 2);
+
+  auto monolithic = serac::functional_test_two_way_coupled_3D<p>(serac::monolithicCouplingOptions(20));
+  EXPECT_LT(serac::relativeDifference(iterative, monolithic), 1.0e-6);
+}
+
+TEST(Thermomechanics, twoWayCoupledMonolithicConvergesQuadratically)
+{
+  constexpr int p = 2;
+
+  auto reference = serac::functional_test_two_way_coupled_3D<p>(serac::monolithicCouplingOptions(20));
+
+  // the monolithic Newton iterations start from the staggered solution
+  auto staggered   = serac::functional_test_two_way_coupled_3D<p>({});
+  auto one_newton  = serac::functional_test_two_way_coupled_3D<p>(serac::monolithicCouplingOptions(1));
+  auto two_newtons = serac::functional_test_two_way_coupled_3D<p>(serac::monolithicCouplingOptions(2));
+
+  double error_0 = serac::relativeDifference(staggered, reference);
+  double error_1 = serac::relativeDifference(one_newton, reference);
+  double error_2 = serac::relativeDifference(two_newtons, reference);
+
+  // an inexact coupled Jacobian, e.g. a wrong sign of an off-diagonal block, only converges linearly
+  EXPECT_GT(std::log(error_2 / error_1) / std::log(error_1 / error_0), 1.5);
+}
+
 TEST(Thermomechanics, parameterized)
 {
   // this is the small strain solution, which works with a loose enought tolerance
@@ -12,8 +12,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+
 #include "mfem.hpp"
 
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/physics/base_physics.hpp"
 #include "serac/physics/thermomechanics_input.hpp"
 #include "serac/physics/solid_mechanics.hpp"
@@ -23,6 +27,43 @@
 
 namespace serac {
 
+/// @brief The ways of coupling the thermal and mechanical solves of a timestep
+enum class ThermomechanicalCoupling
+{
+  Staggered,  ///< A single thermal solve with the previous displacement, followed by a mechanical solve
+  Iterative,  ///< Staggered solves repeated until the displacement and temperature converge
+  Monolithic  ///< Newton's method on the coupled thermal and mechanical equations
+};
+
+/// @brief The options for coupling the thermal and mechanical solves of a timestep
+struct ThermomechanicalCouplingOptions {
+  /// The way of coupling the thermal and mechanical solves
+  ThermomechanicalCoupling coupling = ThermomechanicalCoupling::Staggered;
+
+  /// Relative tolerance on the change of the displacement and temperature between staggered iterations
+  double relative_tol = 1.0e-6;
+
+  /// Absolute tolerance on the change of the displacement and temperature between staggered iterations
+  double absolute_tol = 1.0e-10;
+
+  /// Maximum number of staggered iterations
+  int max_iterations = 20;
+
+  /// Whether to relax the displacement given to the thermal solve with Aitken's dynamic relaxation factor
+  bool aitken_relaxation = true;
+
+  /// The relaxation factor of the first staggered iteration
+  double initial_relaxation = 1.0;
+
+  /// The options for the Newton solver of the monolithic coupling
+  NonlinearSolverOptions nonlinear_options = {};
+
+  /// The options for the linear solver of the monolithic coupling, whose preconditioner is applied to each diagonal
+  /// block of the coupled Jacobian
+  LinearSolverOptions linear_options = {.linear_solver  = LinearSolver::GMRES,
+                                        .preconditioner = Preconditioner::HypreAMG};
+};
+
 /**
  * @brief The operator-split thermal-structural solver
  *
@@ -86,9 +127,9 @@ public:
     SLIC_ERROR_ROOT_IF(mesh_.Dimension() != dim,
                        axom::fmt::format("Compile time dimension and runtime mesh dimension mismatch"));
 
-    states_.push_back(&thermal_.temperature());
-    states_.push_back(&solid_.velocity());
-    states_.push_back(&solid_.displacement());
+    states_.push_back(&thermal_.temperature_);
+    states_.push_back(&solid_.velocity_);
+    states_.push_back(&solid_.displacement_);
   }
 
   /**
@@ -140,8 +181,22 @@ public:
   {
     thermal_.completeSetup();
     solid_.completeSetup();
+
+    if (coupling_options_.coupling == ThermomechanicalCoupling::Monolithic) {
+      buildMonolithicSolver();
+    }
   }
 
+  /**
+   * @brief Set how the thermal and mechanical solves of each timestep are coupled
+   *
+   * @param options The coupling options
+   *
+   * @pre This must be called before completeSetup()
+   * @note The monolithic coupling requires quasi-static thermal and solid physics with assembled Jacobians
+   */
+  void setCouplingOptions(const ThermomechanicalCouplingOptions& options) { coupling_options_ = options; }
+
   /**
    * @brief Method to reset physics states to zero.  This does not reset design parameters or shape.
    *
@@ -240,11 +295,13 @@ public:
    */
   void advanceTimestep(double dt) override
   {
-    thermal_.setParameter(0, solid_.displacement());
-    thermal_.advanceTimestep(dt);
-
-    solid_.setParameter(0, thermal_.temperature());
-    solid_.advanceTimestep(dt);
+    if (coupling_options_.coupling == ThermomechanicalCoupling::Iterative) {
+      iterativeTimestep(dt);
+    } else if (coupling_options_.coupling == ThermomechanicalCoupling::Monolithic) {
+      monolithicTimestep(dt);
+    } else {
+      staggeredTimestep(dt, solid_.displacement());
+    }
 
     cycle_ += 1;
     time_ += dt;
@@ -530,11 +587,236 @@ protected:
   using displacement_field = H1<order, dim>;  ///< the function space for the displacement field
   using temperature_field  = H1<order>;       ///< the function space for the temperature field
 
+  /**
+   * @brief Solve the thermal equations with a given displacement, followed by the mechanical equations with the new
+   * temperature
+   *
+   * @param dt The timestep
+   * @param displacement The displacement used by the thermal solve
+   */
+  void staggeredTimestep(double dt, const FiniteElementState& displacement)
+  {
+    thermal_.setParameter(0, displacement);
+    thermal_.advanceTimestep(dt);
+
+    solid_.setParameter(0, thermal_.temperature());
+    solid_.advanceTimestep(dt);
+  }
+
+  /**
+   * @brief Repeat the staggered solves of a timestep until the displacement and temperature converge
+   *
+   * The displacement given to the thermal solve is relaxed between iterations with the dynamic factor of Aitken,
+   * \f$\omega_{k+1} = -\omega_k \, r_k \cdot (r_{k+1} - r_k) / \|r_{k+1} - r_k\|^2\f$, where \f$r_k\f$ is the
+   * difference between the displacement computed by the solid solve and the one given to the thermal solve.
+   *
+   * @param dt The timestep
+   */
+  void iterativeTimestep(double dt)
+  {
+    MPI_Comm comm = mesh_.GetComm();
+
+    auto parallel_norm = [comm](const mfem::Vector& v) { return std::sqrt(mfem::InnerProduct(comm, v, v)); };
+
+    FiniteElementState coupled_displacement(solid_.displacement());
+    mfem::Vector       previous_temperature(thermal_.temperature());
+    mfem::Vector       temperature_change(previous_temperature.Size());
+    mfem::Vector       residual(coupled_displacement.Size());
+    mfem::Vector       previous_residual(coupled_displacement.Size());
+    mfem::Vector       residual_change(coupled_displacement.Size());
+    double             relaxation = coupling_options_.initial_relaxation;
+
+    thermal_.beginTrialTimestep();
+    solid_.beginTrialTimestep();
+
+    bool converged  = false;
+    int  iterations = 0;
+    while (!converged && iterations < coupling_options_.max_iterations) {
+      if (iterations > 0) {
+        thermal_.repeatTrialTimestep();
+        solid_.repeatTrialTimestep();
+      }
+
+      staggeredTimestep(dt, coupled_displacement);
+      iterations++;
+
+      subtract(solid_.displacement(), coupled_displacement, residual);
+      subtract(thermal_.temperature(), previous_temperature, temperature_change);
+
+      double displacement_tol = std::max(coupling_options_.relative_tol * parallel_norm(solid_.displacement()),
+                                         coupling_options_.absolute_tol);
+      double temperature_tol  = std::max(coupling_options_.relative_tol * parallel_norm(thermal_.temperature()),
+                                         coupling_options_.absolute_tol);
+
+      converged = parallel_norm(residual) <= displacement_tol && parallel_norm(temperature_change) <= temperature_tol;
+
+      if (coupling_options_.aitken_relaxation && iterations > 1) {
+        subtract(residual, previous_residual, residual_change);
+        double change_squared = mfem::InnerProduct(comm, residual_change, residual_change);
+        if (change_squared > 0.0) {
+          relaxation *= -mfem::InnerProduct(comm, previous_residual, residual_change) / change_squared;
+        }
+      }
+
+      coupled_displacement.Add(relaxation, residual);
+      previous_residual    = residual;
+      previous_temperature = thermal_.temperature();
+    }
+
+    thermal_.acceptTrialTimestep();
+    solid_.acceptTrialTimestep();
+
+    profiling::addToCounter("Thermomechanics/coupling", {.calls = 1, .iterations = iterations});
+
+    SLIC_WARNING_ROOT_IF(!converged,
+                         axom::fmt::format("Thermomechanical coupling did not converge in {} iterations at cycle {} of "
+                                           "physics module {}",
+                                           iterations, cycle_, name_));
+  }
+
+  /**
+   * @brief Solve the coupled thermal and mechanical equations of a timestep with Newton's method
+   *
+   * A staggered solve applies the boundary conditions of the new time, and provides the initial guess.
+   *
+   * @param dt The timestep
+   */
+  void monolithicTimestep(double dt)
+  {
+    SLIC_ERROR_ROOT_IF(!monolithic_solver_, "completeSetup() must be called prior to advanceTimestep(dt) with the "
+                                            "monolithic thermomechanical coupling");
+
+    thermal_.beginTrialTimestep();
+    solid_.beginTrialTimestep();
+
+    staggeredTimestep(dt, solid_.displacement());
+
+    mfem::Vector coupled_states(block_offsets_.Last());
+    coupled_states.SetVector(solid_.displacement(), block_offsets_[0]);
+    coupled_states.SetVector(thermal_.temperature(), block_offsets_[1]);
+
+    monolithic_solver_->solve(coupled_states);
+    setCoupledStates(coupled_states);
+
+    thermal_.acceptTrialTimestep();
+    solid_.acceptTrialTimestep();
+  }
+
+  /**
+   * @brief Set the displacement and temperature of both physics modules from a vector of the coupled states
+   *
+   * @param coupled_states The displacement true dofs followed by the temperature true dofs
+   */
+  void setCoupledStates(const mfem::Vector& coupled_states)
+  {
+    const double* states = coupled_states.GetData();
+    std::copy_n(states + block_offsets_[0], block_offsets_[1] - block_offsets_[0], solid_.displacement_.GetData());
+    std::copy_n(states + block_offsets_[1], block_offsets_[2] - block_offsets_[1], thermal_.temperature_.GetData());
+
+    thermal_.setParameter(0, solid_.displacement());
+    solid_.setParameter(0, thermal_.temperature());
+  }
+
+  /// @brief Build the residual of the coupled equations, its block Jacobian, and the Newton solver of the monolithic
+  /// coupling
+  void buildMonolithicSolver()
+  {
+    SLIC_ERROR_ROOT_IF(!thermal_.isQuasistatic() || !solid_.isQuasistatic(),
+                       "The monolithic thermomechanical coupling requires quasi-static thermal and solid physics");
+
+    solid_residual_   = solid_.buildQuasistaticOperator();
+    thermal_residual_ = thermal_.buildQuasistaticOperator();
+
+    int displacement_size = solid_.displacement().space().TrueVSize();
+    int temperature_size  = thermal_.temperature().space().TrueVSize();
+    block_offsets_        = mfem::Array<int>({0, displacement_size, displacement_size + temperature_size});
+
+    coupled_residual_ = std::make_unique<mfem_ext::StdFunctionOperator>(
+        block_offsets_.Last(),
+
+        [this](const mfem::Vector& x, mfem::Vector& r) {
+          setCoupledStates(x);
+
+          mfem::Vector solid_r(r, block_offsets_[0], block_offsets_[1] - block_offsets_[0]);
+          mfem::Vector thermal_r(r, block_offsets_[1], block_offsets_[2] - block_offsets_[1]);
+          solid_residual_->Mult(solid_.displacement(), solid_r);
+          thermal_residual_->Mult(thermal_.temperature(), thermal_r);
+        },
+
+        [this](const mfem::Vector& x) -> mfem::Operator& {
+          setCoupledStates(x);
+
+          // the off-diagonal blocks only have the essential rows eliminated, since the Newton updates of the
+          // essential dofs are zero
+          solid_temperature_jacobian_    = solid_.parameterJacobian(0);
+          thermal_displacement_jacobian_ = thermal_.parameterJacobian(0);
+
+          coupled_jacobian_ = std::make_unique<mfem::BlockOperator>(block_offsets_);
+          coupled_jacobian_->SetBlock(0, 0, &solid_residual_->GetGradient(solid_.displacement()));
+          coupled_jacobian_->SetBlock(0, 1, solid_temperature_jacobian_.get());
+          coupled_jacobian_->SetBlock(1, 0, thermal_displacement_jacobian_.get());
+          coupled_jacobian_->SetBlock(1, 1, &thermal_residual_->GetGradient(thermal_.temperature()));
+          return *coupled_jacobian_;
+        });
+
+    MPI_Comm comm = mesh_.GetComm();
+
+    // the preconditioner of the linear options is applied to each diagonal block instead of the coupled Jacobian
+    auto linear_options           = coupling_options_.linear_options;
+    auto block_options            = linear_options;
+    linear_options.preconditioner = Preconditioner::None;
+
+    auto [linear_solver, unused] = buildLinearSolverAndPreconditioner(linear_options, comm);
+
+    std::vector<std::unique_ptr<mfem::Solver>> block_preconditioners;
+    block_preconditioners.push_back(buildPreconditioner(block_options, comm));
+    block_preconditioners.push_back(buildPreconditioner(block_options, comm));
+    auto preconditioner = std::make_unique<BlockDiagonalPreconditioner>(std::move(block_preconditioners));
+
+    // direct solvers assemble the block system into a single matrix, and do not use the preconditioner
+    if (auto* iterative_solver = dynamic_cast<mfem::IterativeSolver*>(linear_solver.get())) {
+      iterative_solver->SetPreconditioner(*preconditioner);
+    }
+
+    auto nonlinear_solver =
+        buildNonlinearSolver(coupling_options_.nonlinear_options, block_options, *preconditioner, comm);
+    monolithic_solver_ = std::make_unique<EquationSolver>(std::move(nonlinear_solver), std::move(linear_solver),
+                                                          std::move(preconditioner));
+    monolithic_solver_->setOperator(*coupled_residual_);
+  }
+
   /// Submodule to compute the heat transfer physics
   HeatTransfer<order, dim, Parameters<displacement_field, parameter_space...>> thermal_;
 
   /// Submodule to compute the mechanics
   SolidMechanics<order, dim, Parameters<temperature_field, parameter_space...>> solid_;
+
+  /// The options for coupling the thermal and mechanical solves of a timestep
+  ThermomechanicalCouplingOptions coupling_options_;
+
+  /// The offsets of the displacement and temperature blocks of the monolithic coupling
+  mfem::Array<int> block_offsets_;
+
+  /// The residual of the solid mechanics equations, with the essential rows eliminated
+  std::unique_ptr<mfem_ext::StdFunctionOperator> solid_residual_;
+
+  /// The residual of the heat transfer equations, with the essential rows eliminated
+  std::unique_ptr<mfem_ext::StdFunctionOperator> thermal_residual_;
+
+  /// The residual of the coupled equations of the monolithic coupling
+  std::unique_ptr<mfem_ext::StdFunctionOperator> coupled_residual_;
+
+  /// The derivative of the solid mechanics residual with respect to the temperature
+  std::unique_ptr<mfem::HypreParMatrix> solid_temperature_jacobian_;
+
+  /// The derivative of the heat transfer residual with respect to the displacement
+  std::unique_ptr<mfem::HypreParMatrix> thermal_displacement_jacobian_;
+
+  /// The block Jacobian of the coupled equations, whose diagonal blocks are owned by the physics modules
+  std::unique_ptr<mfem::BlockOperator> coupled_jacobian_;
+
+  /// The Newton solver of the monolithic coupling
+  std::unique_ptr<EquationSolver> monolithic_solver_;
 };
 
 }  // namespace serac